@@ -57,7 +57,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter() // All data members
   fEvtCuts(0),
   fTrkCuts(0),
   fSetter(0),
-  fSaveCutsFlag(0)
+  fSaveCutsFlag(0),
+  fColumnar(0)
 {
   // Dummy constructor ALWAYS needed for I/O.
 }
@@ -71,7 +72,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter(const char *name, Boo
    fEvtCuts(0),
    fTrkCuts(0),
    fSetter(0),
-   fSaveCutsFlag(saveCutsFlag)
+   fSaveCutsFlag(saveCutsFlag),
+   fColumnar(0)
      
 {
   // Constructor
@@ -125,11 +127,12 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
      
   cout<<"rep: "<<rep<<endl;
   rep->SetCustomSetter(fSetter);
+  rep->SetColumnar(fColumnar);
   std::cout << "SETTER: " << fSetter << " " << rep->GetCustomSetter() << std::endl;
   
   ext->DropUnspecifiedBranches(); // all branches not part of a FilterBranch call (below) will be dropped
       
-  ext->FilterBranch("tracks",rep);
+  ext->FilterBranch("tracks",rep); // in the columnar format this writes the track_* branches
   ext->FilterBranch("vertices",rep);  
   ext->FilterBranch("header",rep);  
             
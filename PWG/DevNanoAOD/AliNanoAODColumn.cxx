@@ -0,0 +1,58 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     Columnar NanoAOD storage: one variable of all tracks of an event
+//-------------------------------------------------------------------------
+
+#include "AliNanoAODColumn.h"
+
+ClassImp(AliNanoAODColumn)
+ClassImp(AliNanoAODIntColumn)
+ClassImp(AliNanoAODColumnOffset)
+
+namespace {
+  // names in the order of AliNanoAODColumn::EVar
+  const char * gkNanoAODColumnVarNames[AliNanoAODColumn::kNVars] = {
+    "pt", "phi", "theta", "chi2perNDF", "posx", "posy", "posz",
+    "posDCAx", "posDCAy", "pDCAx", "pDCAy", "pDCAz", "RAtAbsorberEnd",
+    "TPCncls", "id", "TPCnclsF", "TPCNCrossedRows",
+    "TrackPhiOnEMCal", "TrackEtaOnEMCal", "TrackPtOnEMCal",
+    "ITSsignal", "TPCsignal", "TPCsignalTuned", "TPCsignalN", "TPCmomentum", "TPCTgl",
+    "TOFsignal", "integratedLength", "TOFsignalTuned", "HMPIDsignal", "HMPIDoccupancy",
+    "TRDsignal", "TRDChi2", "TRDnSlices",
+    "charge", "label"
+  };
+}
+
+//______________________________________________________________________________
+const char * AliNanoAODColumn::GetVarName(Int_t var)
+{
+  // name of the variable with index var (EVar)
+  if (var < 0 || var >= kNVars) return "";
+  return gkNanoAODColumnVarNames[var];
+}
+
+//______________________________________________________________________________
+Int_t AliNanoAODColumn::FindVar(const char * varName)
+{
+  // index (EVar) of the variable, -1 for custom variables
+  TString name(varName);
+  for (Int_t var = 0; var < kNVars; var++) {
+    if (name == gkNanoAODColumnVarNames[var]) return var;
+  }
+  return -1;
+}
@@ -0,0 +1,112 @@
+#ifndef AliNanoAODColumn_H
+#define AliNanoAODColumn_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     Columnar NanoAOD storage
+//     In the columnar format (AliNanoAODReplicator::SetColumnar) the tracks
+//     are not stored as AliNanoAODTrack objects but each variable is stored
+//     in its own branch (AliNanoAODColumn "track_<var>"), holding the values
+//     of all tracks of the event. The branch "track_offset"
+//     (AliNanoAODColumnOffset) holds the number of tracks of the event and the
+//     index of its first track in the file.
+//
+//     The variables known to the NanoAOD (see AliNanoAODTrack) are mapped at
+//     compile time (EVar), custom variables ("cst...") are looked up by name.
+//     The track id and the MC label are stored as integers
+//     (AliNanoAODIntColumn), all other variables as floats.
+//     The columns are read with AliNanoAODColumnInputHandler which presents
+//     the tracks as AliNanoAODTrackView.
+//-------------------------------------------------------------------------
+
+#include <vector>
+#include "TNamed.h"
+
+class AliNanoAODColumn : public TNamed {
+
+public:
+
+  // variables with a fixed index (same names as in the variable list of AliNanoAODTrack)
+  enum EVar {
+    kPt = 0, kPhi, kTheta, kChi2PerNDF, kPosX, kPosY, kPosZ,
+    kPosDCAx, kPosDCAy, kPDCAx, kPDCAy, kPDCAz, kRAtAbsorberEnd,
+    kTPCncls, kID, kTPCnclsF, kTPCNCrossedRows,
+    kTrackPhiOnEMCal, kTrackEtaOnEMCal, kTrackPtOnEMCal,
+    kITSsignal, kTPCsignal, kTPCsignalTuned, kTPCsignalN, kTPCmomentum, kTPCTgl,
+    kTOFsignal, kIntegratedLength, kTOFsignalTuned, kHMPIDsignal, kHMPIDoccupancy,
+    kTRDsignal, kTRDChi2, kTRDnSlices,
+    kCharge, kLabel,
+    kNVars
+  };
+
+  AliNanoAODColumn() : TNamed(), fValues() { }
+  AliNanoAODColumn(const char * var) : TNamed(GetBranchName(var), ""), fValues() { }
+  virtual ~AliNanoAODColumn() { }
+
+  virtual void Clear(Option_t * /*opt*/ = "") { fValues.clear(); }
+
+  void           Add(Float_t value)       { fValues.push_back(value); }
+  void           SetValue(Int_t i, Float_t value) { fValues[i] = value; }
+  Int_t          GetSize() const          { return fValues.size(); }
+  const Float_t* GetValues() const        { return fValues.empty() ? 0 : &fValues[0]; }
+  Float_t        GetValue(Int_t i) const  { return fValues[i]; }
+
+  static const char * GetVarName(Int_t var);
+  static Int_t        FindVar(const char * varName);
+  static Bool_t       IsIntVar(Int_t var) { return var == kID || var == kLabel; } // stored in an AliNanoAODIntColumn
+  static TString      GetBranchName(const char * varName) { return TString("track_") + varName; }
+
+private:
+
+  std::vector<Float_t> fValues; // values of all tracks of the event
+
+  ClassDef(AliNanoAODColumn, 1);
+};
+
+class AliNanoAODIntColumn : public TNamed {
+
+public:
+
+  AliNanoAODIntColumn() : TNamed(), fValues() { }
+  AliNanoAODIntColumn(const char * var) : TNamed(AliNanoAODColumn::GetBranchName(var), ""), fValues() { }
+  virtual ~AliNanoAODIntColumn() { }
+
+  virtual void Clear(Option_t * /*opt*/ = "") { fValues.clear(); }
+
+  void         Add(Int_t value)       { fValues.push_back(value); }
+  void         SetValue(Int_t i, Int_t value) { fValues[i] = value; }
+  Int_t        GetSize() const        { return fValues.size(); }
+  const Int_t* GetValues() const      { return fValues.empty() ? 0 : &fValues[0]; }
+  Int_t        GetValue(Int_t i) const { return fValues[i]; }
+
+private:
+
+  std::vector<Int_t> fValues; // values of all tracks of the event
+
+  ClassDef(AliNanoAODIntColumn, 1);
+};
+
+class AliNanoAODColumnOffset : public TNamed {
+
+public:
+
+  AliNanoAODColumnOffset() : TNamed("track_offset", ""), fOffset(0), fNTracks(0) { }
+  virtual ~AliNanoAODColumnOffset() { }
+
+  virtual void Clear(Option_t * /*opt*/ = "") { fNTracks = 0; }
+
+  void     Set(Long64_t offset, Int_t nTracks) { fOffset = offset; fNTracks = nTracks; }
+  Long64_t GetOffset() const  { return fOffset; }
+  Int_t    GetNTracks() const { return fNTracks; }
+
+private:
+
+  Long64_t fOffset;  // index of the first track of the event in the file
+  Int_t    fNTracks; // number of tracks of the event
+
+  ClassDef(AliNanoAODColumnOffset, 1);
+};
+
+#endif
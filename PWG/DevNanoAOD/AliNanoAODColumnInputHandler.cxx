@@ -0,0 +1,211 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     Input handler for the columnar NanoAOD
+//-------------------------------------------------------------------------
+
+#include "TTree.h"
+#include "TClonesArray.h"
+#include "AliLog.h"
+#include "AliAODEvent.h"
+
+#include "AliNanoAODColumnInputHandler.h"
+
+ClassImp(AliNanoAODColumnInputHandler)
+
+//______________________________________________________________________________
+AliNanoAODColumnInputHandler::AliNanoAODColumnInputHandler() :
+  AliAODInputHandler(),
+  fCustomVars(),
+  fCustomColumns(),
+  fOffset(0),
+  fColumnData(),
+  fTracks(0),
+  fResolved(kFALSE)
+{
+  // default constructor
+  for (Int_t var = 0; var < AliNanoAODColumn::kNVars; var++) { fColumns[var] = 0; fIntColumns[var] = 0; }
+}
+
+//______________________________________________________________________________
+AliNanoAODColumnInputHandler::AliNanoAODColumnInputHandler(const char* name, const char* title) :
+  AliAODInputHandler(name, title),
+  fCustomVars(),
+  fCustomColumns(),
+  fOffset(0),
+  fColumnData(),
+  fTracks(new TClonesArray("AliNanoAODTrackView", 1000)),
+  fResolved(kFALSE)
+{
+  // constructor
+  for (Int_t var = 0; var < AliNanoAODColumn::kNVars; var++) { fColumns[var] = 0; fIntColumns[var] = 0; }
+  fTracks->SetName("tracks");
+}
+
+//______________________________________________________________________________
+AliNanoAODColumnInputHandler::~AliNanoAODColumnInputHandler()
+{
+  // destructor, the views are owned by the AOD event once it is connected
+  if (fTracks && !(GetEvent() && GetEvent()->FindListObject("tracks") == fTracks))
+    delete fTracks;
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODColumnInputHandler::Init(TTree* tree, Option_t* opt)
+{
+  // connects the AOD event and replaces its track array by the views
+
+  Bool_t ok = AliAODInputHandler::Init(tree, opt);
+
+  AliAODEvent* event = GetEvent();
+  if (event && fTracks) {
+    TObject* tracks = event->FindListObject("tracks");
+    if (tracks != fTracks) {
+      // a track array without branch (the columnar file has no "tracks" branch)
+      if (tracks) {
+        event->GetList()->Remove(tracks);
+        delete tracks;
+      }
+      event->AddObject(fTracks);
+      event->GetStdContent();
+    }
+  }
+
+  fResolved = kFALSE;
+  return ok;
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODColumnInputHandler::Notify(const char* path)
+{
+  // new file: the columns are looked up again in the next event
+  fResolved = kFALSE;
+  return AliAODInputHandler::Notify(path);
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODColumnInputHandler::BeginEvent(Long64_t entry)
+{
+  // points the views to the columns of the event
+
+  Bool_t ok = AliAODInputHandler::BeginEvent(entry);
+
+  if (!fResolved)
+    ResolveColumns();
+
+  // the data of the vectors can move when an entry is read
+  for (Int_t var = 0; var < AliNanoAODColumn::kNVars; var++) {
+    fColumnData.fData[var] = (fColumns[var]) ? fColumns[var]->GetValues() : 0;
+    fColumnData.fIntData[var] = (fIntColumns[var]) ? fIntColumns[var]->GetValues() : 0;
+  }
+  for (UInt_t index = 0; index < fCustomColumns.size(); index++)
+    fColumnData.fCustom[index] = (fCustomColumns[index]) ? fCustomColumns[index]->GetValues() : 0;
+
+  Int_t nTracks = (fOffset) ? fOffset->GetNTracks() : 0;
+  if (fTracks) {
+    // the views of previous events are reused (no destructor called by Clear, no constructor by ConstructedAt)
+    fTracks->Clear();
+    for (Int_t i = 0; i < nTracks; i++)
+      static_cast<AliNanoAODTrackView*>(fTracks->ConstructedAt(i))->SetIndex(&fColumnData, i);
+  }
+
+  return ok;
+}
+
+//______________________________________________________________________________
+Int_t AliNanoAODColumnInputHandler::GetNumberOfTracks() const
+{
+  // number of tracks of the current event
+  return (fTracks) ? fTracks->GetEntriesFast() : 0;
+}
+
+//______________________________________________________________________________
+AliNanoAODTrackView* AliNanoAODColumnInputHandler::GetTrack(Int_t i) const
+{
+  // view of track i of the current event
+  return static_cast<AliNanoAODTrackView*>(fTracks->UncheckedAt(i));
+}
+
+//______________________________________________________________________________
+Int_t AliNanoAODColumnInputHandler::GetCustomVarIndex(const char* varName)
+{
+  // index of the custom variable <varName> (e.g. "cstKBayes") for AliNanoAODTrackView::GetCustomVar
+  // to be called once, e.g. in UserCreateOutputObjects
+
+  for (UInt_t index = 0; index < fCustomVars.size(); index++) {
+    if (fCustomVars[index] == varName) return index;
+  }
+
+  fCustomVars.push_back(varName);
+  fCustomColumns.push_back(0);
+  fColumnData.fCustom.push_back(0);
+  fResolved = kFALSE;
+
+  return fCustomVars.size() - 1;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumnInputHandler::ResolveColumns()
+{
+  // finds the columns of the current file
+
+  for (Int_t var = 0; var < AliNanoAODColumn::kNVars; var++) {
+    if (AliNanoAODColumn::IsIntVar(var))
+      fIntColumns[var] = FindIntColumn(AliNanoAODColumn::GetVarName(var));
+    else
+      fColumns[var] = FindColumn(AliNanoAODColumn::GetVarName(var));
+  }
+  for (UInt_t index = 0; index < fCustomVars.size(); index++)
+    fCustomColumns[index] = FindColumn(fCustomVars[index]);
+
+  fOffset = (GetEvent()) ? dynamic_cast<AliNanoAODColumnOffset*>(GetEvent()->FindListObject("track_offset")) : 0;
+  if (!fOffset)
+    AliError("No branch track_offset, this is not a columnar NanoAOD");
+
+  fResolved = kTRUE;
+}
+
+//______________________________________________________________________________
+AliNanoAODColumn* AliNanoAODColumnInputHandler::FindColumn(const char* varName) const
+{
+  // column of the variable in the current file, 0 if not available
+
+  if (!GetEvent()) return 0;
+
+  TString branchName = AliNanoAODColumn::GetBranchName(varName);
+
+  // the objects of the AOD event are created from the first file, the variable may be missing in this one
+  TTree* tree = (fTree) ? fTree->GetTree() : 0;
+  if (tree && !tree->GetBranch(branchName)) return 0;
+
+  return dynamic_cast<AliNanoAODColumn*>(GetEvent()->FindListObject(branchName));
+}
+
+//______________________________________________________________________________
+AliNanoAODIntColumn* AliNanoAODColumnInputHandler::FindIntColumn(const char* varName) const
+{
+  // integer column of the variable in the current file, 0 if not available
+
+  if (!GetEvent()) return 0;
+
+  TString branchName = AliNanoAODColumn::GetBranchName(varName);
+
+  TTree* tree = (fTree) ? fTree->GetTree() : 0;
+  if (tree && !tree->GetBranch(branchName)) return 0;
+
+  return dynamic_cast<AliNanoAODIntColumn*>(GetEvent()->FindListObject(branchName));
+}
@@ -0,0 +1,67 @@
+#ifndef AliNanoAODColumnInputHandler_H
+#define AliNanoAODColumnInputHandler_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     Input handler for the columnar NanoAOD
+//     (see AliNanoAODColumn, AliNanoAODReplicator::SetColumnar)
+//     The columns are read as any other branch of the AOD event. The
+//     columns of the standard variables are found once per file and the
+//     tracks are presented as AliNanoAODTrackView in the array "tracks"
+//     of the AOD event, i.e. AliAODEvent::GetTrack can be used as for
+//     the NanoAOD with AliNanoAODTrack. The views are constructed only
+//     when the number of tracks exceeds the one of all previous events.
+//-------------------------------------------------------------------------
+
+#include <vector>
+#include "AliAODInputHandler.h"
+#include "AliNanoAODColumn.h"
+#include "AliNanoAODTrackView.h"
+
+class TClonesArray;
+
+class AliNanoAODColumnInputHandler : public AliAODInputHandler {
+
+public:
+
+  AliNanoAODColumnInputHandler();
+  AliNanoAODColumnInputHandler(const char* name, const char* title);
+  virtual ~AliNanoAODColumnInputHandler();
+
+  using AliAODInputHandler::Init;
+  using AliAODInputHandler::Notify;
+  virtual Bool_t Init(TTree* tree, Option_t* opt);
+  virtual Bool_t Notify(const char* path);
+  virtual Bool_t BeginEvent(Long64_t entry);
+
+  Int_t                GetNumberOfTracks() const;
+  AliNanoAODTrackView* GetTrack(Int_t i) const;
+  Long64_t             GetTrackOffset() const { return (fOffset) ? fOffset->GetOffset() : 0; }
+
+  // index of a custom variable for AliNanoAODTrackView::GetCustomVar
+  Int_t GetCustomVarIndex(const char* varName);
+
+private:
+
+  void              ResolveColumns();
+  AliNanoAODColumn* FindColumn(const char* varName) const;
+  AliNanoAODIntColumn* FindIntColumn(const char* varName) const;
+
+  AliNanoAODColumn*              fColumns[AliNanoAODColumn::kNVars]; //! columns of the standard float variables in the current file
+  AliNanoAODIntColumn*           fIntColumns[AliNanoAODColumn::kNVars]; //! columns of the integer variables (id, label) in the current file
+  std::vector<TString>           fCustomVars;     //! names of the custom variables
+  std::vector<AliNanoAODColumn*> fCustomColumns;  //! columns of the custom variables in the current file
+  AliNanoAODColumnOffset*        fOffset;         //! number of tracks and offset of the event
+  AliNanoAODTrackView::Columns   fColumnData;     //! values of the current event, used by the views
+  TClonesArray*                  fTracks;         //! views of the tracks of the current event
+  Bool_t                         fResolved;       //! columns found for the current file
+
+  AliNanoAODColumnInputHandler(const AliNanoAODColumnInputHandler&);            // not implemented
+  AliNanoAODColumnInputHandler& operator=(const AliNanoAODColumnInputHandler&); // not implemented
+
+  ClassDef(AliNanoAODColumnInputHandler, 1);
+};
+
+#endif
@@ -74,6 +74,7 @@ class AliAODRecoDecay;
 #include "TCanvas.h"
 #include "AliNanoAODHeader.h"
 #include "AliNanoAODCustomSetter.h"
+#include "AliNanoAODColumn.h"
 
 using std::cout;
 using std::endl;
@@ -93,7 +94,13 @@ AliAODBranchReplicator(),
   fParticleSelected(),
   fVarList(""),
   fVarListHeader(""),
-  fCustomSetter(0){
+  fCustomSetter(0),
+  fColumnar(kFALSE),
+  fColumns(),
+  fIDColumn(0x0),
+  fLabelColumn(0x0),
+  fColumnOffset(0x0),
+  fNTracksWritten(0){
   // Default ctor. we need it to avoid instantiating a wrong mapping when reading from file 
   }
 
@@ -114,7 +121,13 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title,
   fParticleSelected(),
   fVarList(varlist),
   fVarListHeader(""),// FIXME: this should be set to a meaningful value: add an arg to the constructor
-  fCustomSetter(0)
+  fCustomSetter(0),
+  fColumnar(kFALSE),
+  fColumns(),
+  fIDColumn(0x0),
+  fLabelColumn(0x0),
+  fColumnOffset(0x0),
+  fNTracksWritten(0)
 {
   // default ctor
   AliNanoAODTrackMapping * tm =new AliNanoAODTrackMapping(fVarList);
@@ -207,7 +220,7 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
 
   //  std::cout << "MC Mode: " << fMCMode << ", Tracks " << fTracks->GetEntries() << std::endl;
   
-  if ( fMCMode>=2 && !fTracks->GetEntries() ) {
+  if ( fMCMode>=2 && !GetNumberOfReplicatedTracks() ) {
     return;
   }
   // for fMCMode==1 we only copy MC information for events where there's at least one muon track
@@ -246,12 +259,11 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
       } 
 
       // loop on (kept) tracks to find their ancestors
-      TIter nextTRACK(fTracks);
-      AliNanoAODTrack* track;
+      const Int_t nTracks = GetNumberOfReplicatedTracks();
     
-      while ( ( track = static_cast<AliNanoAODTrack*>(nextTRACK()) ) )
+      for (Int_t itrack = 0; itrack < nTracks; itrack++)
 	{
-	  Int_t label = TMath::Abs(track->GetLabel()); 
+	  Int_t label = TMath::Abs(GetReplicatedTrackLabel(itrack)); 
       
 	  while ( label >= 0 ) 
 	    {
@@ -360,14 +372,12 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
     
       // now remap the tracks...
     
-      TIter nextTrack(fTracks);
-      AliNanoAODTrack* t;
       //      std::cout << "Remapping tracks" << std::endl;
     
-      while ( ( t = dynamic_cast<AliNanoAODTrack*>(nextTrack()) ) )
+      for (Int_t itrack = 0; itrack < nTracks; itrack++)
 	{
 	  
-	  t->SetLabel(GetNewLabel(t->GetLabel()));
+	  SetReplicatedTrackLabel(itrack, GetNewLabel(GetReplicatedTrackLabel(itrack)));
 	}
     
     } // closes fMCMode == 1
@@ -395,6 +405,30 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
 
 }
 
+//_____________________________________________________________________________
+Int_t AliNanoAODReplicator::GetNumberOfReplicatedTracks() const
+{
+  // number of tracks kept in the current event
+  if (fColumnar) return fColumnOffset->GetNTracks();
+  return fTracks->GetEntriesFast();
+}
+
+//_____________________________________________________________________________
+Int_t AliNanoAODReplicator::GetReplicatedTrackLabel(Int_t i) const
+{
+  // MC label of the kept track i
+  if (fColumnar) return fLabelColumn->GetValue(i);
+  return static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(i))->GetLabel();
+}
+
+//_____________________________________________________________________________
+void AliNanoAODReplicator::SetReplicatedTrackLabel(Int_t i, Int_t label)
+{
+  // sets the MC label of the kept track i
+  if (fColumnar) fLabelColumn->SetValue(i, label);
+  else static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(i))->SetLabel(label);
+}
+
 // //_____________________________________________________________________________
 TList* AliNanoAODReplicator::GetList() const
 {
@@ -405,9 +439,36 @@ TList* AliNanoAODReplicator::GetList() const
       fList = new TList;
       fList->SetOwner(kTRUE);
 
-      fTracks = new TClonesArray("AliNanoAODTrack");      
-      fTracks->SetName("tracks"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
-      fList->Add(fTracks);    
+      if (fColumnar)
+	{
+	  // one column per variable, in the order of the mapping, then charge and label (not in the mapping)
+	  // id and label are integers, they do not fit into a float above 2^24
+	  fColumnOffset = new AliNanoAODColumnOffset;
+	  fList->Add(fColumnOffset);
+
+	  AliNanoAODTrackMapping * tm = AliNanoAODTrackMapping::GetInstance();
+	  for (Int_t ivar = 0; ivar < tm->GetSize(); ivar++) {
+	    if (AliNanoAODColumn::FindVar(tm->GetVarName(ivar)) == AliNanoAODColumn::kID) {
+	      fIDColumn = new AliNanoAODIntColumn(tm->GetVarName(ivar));
+	      fColumns.push_back(0);
+	    } else {
+	      fColumns.push_back(new AliNanoAODColumn(tm->GetVarName(ivar)));
+	    }
+	  }
+	  fColumns.push_back(new AliNanoAODColumn(AliNanoAODColumn::GetVarName(AliNanoAODColumn::kCharge)));
+	  fLabelColumn = new AliNanoAODIntColumn(AliNanoAODColumn::GetVarName(AliNanoAODColumn::kLabel));
+
+	  for (UInt_t icol = 0; icol < fColumns.size(); icol++)
+	    if (fColumns[icol]) fList->Add(fColumns[icol]);
+	  if (fIDColumn) fList->Add(fIDColumn);
+	  fList->Add(fLabelColumn);
+	}
+      else
+	{
+	  fTracks = new TClonesArray("AliNanoAODTrack");      
+	  fTracks->SetName("tracks"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
+	  fList->Add(fTracks);    
+	}
 
       fHeader = new AliNanoAODHeader(3);// TODO: to be customized
       fHeader->SetName("header"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
@@ -444,7 +505,15 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   
   
 
-  fTracks->Clear("C");			
+  if (fColumnar) {
+    for (UInt_t icol = 0; icol < fColumns.size(); icol++)
+      if (fColumns[icol]) fColumns[icol]->Clear();
+    if (fIDColumn) fIDColumn->Clear();
+    fLabelColumn->Clear();
+    fColumnOffset->Set(fNTracksWritten, 0);
+  } else {
+    fTracks->Clear("C");			
+  }
   assert(fVertices!=0x0);
   fVertices->Clear("C");
   if (fMCMode > 0){
@@ -479,10 +548,30 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
     AliAODTrack *aodtrack =(AliAODTrack*)track;// FIXME DYNAMIC CAST?
     if(fTrackCut && !fTrackCut->IsSelected(aodtrack)) continue;
 
+    if (fColumnar) {
+      // the track is built as usual (custom setter), its variables are then appended to the columns
+      AliNanoAODTrack special(aodtrack, fVarList);
+      if(fCustomSetter) fCustomSetter->SetNanoAODTrack(aodtrack, &special);
+
+      const Int_t nvars = fColumns.size() - 1;
+      for (Int_t ivar = 0; ivar < nvars; ivar++)
+	if (fColumns[ivar]) fColumns[ivar]->Add(special.GetVar(ivar));
+      fColumns[nvars]->Add(special.Charge());
+      if (fIDColumn) fIDColumn->Add(aodtrack->GetID());
+      fLabelColumn->Add(special.GetLabel());
+      ntracks++;
+      continue;
+    }
+
     AliNanoAODTrack * special = new((*fTracks)[ntracks++]) AliNanoAODTrack (aodtrack, fVarList);
     
     if(fCustomSetter) fCustomSetter->SetNanoAODTrack(aodtrack, special);
   }  
+
+  if (fColumnar) {
+    fColumnOffset->Set(fNTracksWritten, ntracks);
+    fNTracksWritten += ntracks;
+  }
   //----------------------------------------------------------
   
   TIter nextV(source.GetVertices());
@@ -501,7 +590,7 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   
   
   AliDebug(1,Form("input mu tracks=%d tracks=%d vertices=%d",
-                  input,fTracks->GetEntries(),fVertices->GetEntries())); 
+                  input,GetNumberOfReplicatedTracks(),fVertices->GetEntries())); 
   
   
   // Finally, deal with MC information, if needed
@@ -15,6 +15,7 @@
 #endif
 
 #include <iostream>
+#include <vector>
 
 /* #ifndef AliAOD3LH_H */
 /* #include "AliAOD3LH.h" */
@@ -56,6 +57,9 @@ class AliAnalysisTaskSE;
 class AliNanoAODTrack;
 class AliAODTrack;
 class AliNanoAODCustomSetter;
+class AliNanoAODColumn;
+class AliNanoAODIntColumn;
+class AliNanoAODColumnOffset;
 
 class TH1F;
 
@@ -88,6 +92,10 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   AliNanoAODCustomSetter * GetCustomSetter() { return fCustomSetter; }
   void  SetCustomSetter (AliNanoAODCustomSetter * var) { fCustomSetter = var;  }
 
+  // Columnar format: one branch per track variable instead of the "tracks" array (see AliNanoAODColumn)
+  Bool_t GetColumnar() const { return fColumnar; }
+  void   SetColumnar(Bool_t var = kTRUE) { fColumnar = var; }
+
 
  private:
 
@@ -96,6 +104,9 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void CreateLabelMap(const AliAODEvent& source);
   Int_t GetNewLabel(Int_t i);
   void FilterMC(const AliAODEvent& source);
+  Int_t GetNumberOfReplicatedTracks() const;
+  Int_t GetReplicatedTrackLabel(Int_t i) const;
+  void  SetReplicatedTrackLabel(Int_t i, Int_t label);
  
 
  private:
@@ -121,13 +132,20 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
 
   AliNanoAODCustomSetter * fCustomSetter;  // Setter class for custom variables
 
+  Bool_t fColumnar; // write the tracks in the columnar format
+  mutable std::vector<AliNanoAODColumn*> fColumns; //! columns of the float track variables (mapping order, 0 for the id), then charge
+  mutable AliNanoAODIntColumn* fIDColumn; //! column of the track id, 0 if not in the variable list
+  mutable AliNanoAODIntColumn* fLabelColumn; //! column of the MC label
+  mutable AliNanoAODColumnOffset* fColumnOffset; //! number of tracks and offset of the event
+  Long64_t fNTracksWritten; //! number of tracks written before the current event
+
  private:
 
   
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
   
-  ClassDef(AliNanoAODReplicator,1) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator,2) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
@@ -0,0 +1,53 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     View of a track in the columnar NanoAOD
+//-------------------------------------------------------------------------
+
+#include "AliLog.h"
+#include "AliNanoAODTrackView.h"
+
+ClassImp(AliNanoAODTrackView)
+
+//______________________________________________________________________________
+void AliNanoAODTrackView::VarNotAvailable(Int_t var) const
+{
+  // called for variables which are not in the file
+  if (var < 0)
+    AliFatal(Form("Custom variable %d not available in this NanoAOD", -1 - var));
+  else
+    AliFatal(Form("Variable %s not available in this NanoAOD", AliNanoAODColumn::GetVarName(var)));
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackView::Print(Option_t* /*option*/) const
+{
+  // prints the available variables of the track
+
+  printf("Track %d\n", fIndex);
+  for (Int_t var = 0; var < AliNanoAODColumn::kNVars; var++) {
+    if (!HasVar(var)) continue;
+    if (AliNanoAODColumn::IsIntVar(var))
+      printf("  %-20s %d\n", AliNanoAODColumn::GetVarName(var), GetIntVar(var));
+    else
+      printf("  %-20s %f\n", AliNanoAODColumn::GetVarName(var), GetVar(var));
+  }
+  for (UInt_t index = 0; index < fColumns->fCustom.size(); index++) {
+    if (fColumns->fCustom[index])
+      printf("  custom %-13d %f\n", index, GetCustomVar(index));
+  }
+}
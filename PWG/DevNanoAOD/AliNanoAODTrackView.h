@@ -0,0 +1,173 @@
+#ifndef AliNanoAODTrackView_H
+#define AliNanoAODTrackView_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     View of a track in the columnar NanoAOD
+//     The view does not hold any data: it points to the columns of the
+//     current event (AliNanoAODColumn) and to the index of the track in
+//     the columns. The views are created once by
+//     AliNanoAODColumnInputHandler and re-pointed in each event.
+//     The accessors are the ones of AliNanoAODTrack, the variables are
+//     found by their fixed index (AliNanoAODColumn::EVar) without lookup
+//     of a mapping. Attempts to use a variable which is not in the file
+//     produce an AliFatal.
+//-------------------------------------------------------------------------
+
+#include <vector>
+#include "AliVTrack.h"
+#include "AliAODTrack.h"
+#include "AliNanoAODColumn.h"
+
+class AliVVertex;
+class AliDetectorPID;
+class AliExternalTrackParam;
+
+class AliNanoAODTrackView : public AliVTrack {
+
+public:
+
+  // columns of the current event, filled by AliNanoAODColumnInputHandler
+  struct Columns {
+    Columns() : fCustom() { for (Int_t i = 0; i < AliNanoAODColumn::kNVars; i++) { fData[i] = 0; fIntData[i] = 0; } }
+    const Float_t * fData[AliNanoAODColumn::kNVars];    // values per float variable, 0 if the variable is not in the file
+    const Int_t *   fIntData[AliNanoAODColumn::kNVars]; // values per integer variable (AliNanoAODColumn::IsIntVar), 0 if not in the file
+    std::vector<const Float_t *> fCustom;               // values of the custom variables
+  };
+
+  using TObject::ClassName;
+
+  AliNanoAODTrackView() : AliVTrack(), fColumns(0), fIndex(0) { }
+  virtual ~AliNanoAODTrackView() { }
+
+  void  SetIndex(const Columns * columns, Int_t index) { fColumns = columns; fIndex = index; }
+  Int_t GetIndex() const { return fIndex; }
+
+  // any float variable by its fixed index
+  Double_t GetVar(Int_t var) const { if (!fColumns->fData[var]) VarNotAvailable(var); return fColumns->fData[var][fIndex]; }
+  // integer variable (id, label) by its fixed index
+  Int_t    GetIntVar(Int_t var) const { if (!fColumns->fIntData[var]) VarNotAvailable(var); return fColumns->fIntData[var][fIndex]; }
+  Bool_t   HasVar(Int_t var) const { return fColumns->fData[var] != 0 || fColumns->fIntData[var] != 0; }
+  // custom variable, see AliNanoAODColumnInputHandler::GetCustomVarIndex
+  Double_t GetCustomVar(Int_t index) const { if (!fColumns->fCustom[index]) VarNotAvailable(-1 - index); return fColumns->fCustom[index][fIndex]; }
+
+  // kinematics
+  virtual Double_t OneOverPt() const { return (Pt() != 0.) ? 1./Pt() : -999.; }
+  virtual Double_t Phi()       const { return GetVar(AliNanoAODColumn::kPhi);   }
+  virtual Double_t Theta()     const { return GetVar(AliNanoAODColumn::kTheta); }
+
+  virtual Double_t Px() const { return Pt() * TMath::Cos(Phi()); }
+  virtual Double_t Py() const { return Pt() * TMath::Sin(Phi()); }
+  virtual Double_t Pz() const { return Pt() / TMath::Tan(Theta()); }
+  virtual Double_t Pt() const { return GetVar(AliNanoAODColumn::kPt); }
+  virtual Double_t P()  const { return TMath::Sqrt(Pt()*Pt()+Pz()*Pz()); }
+  virtual Bool_t   PxPyPz(Double_t p[3]) const { p[0] = Px(); p[1] = Py(); p[2] = Pz(); return kTRUE; }
+  Bool_t GetPxPyPz(Double_t *p) const { return PxPyPz(p); }
+
+  // the production vertex is not stored in the columns
+  virtual Double_t Xv() const { AliFatal("Not Implemented"); return 0; }
+  virtual Double_t Yv() const { AliFatal("Not Implemented"); return 0; }
+  virtual Double_t Zv() const { AliFatal("Not Implemented"); return 0; }
+  virtual Bool_t   XvYvZv(Double_t x[3]) const { x[0] = Xv(); x[1] = Yv(); x[2] = Zv(); return kTRUE; }
+
+  Double_t Chi2perNDF()  const { return GetVar(AliNanoAODColumn::kChi2PerNDF); }
+  UShort_t GetTPCNcls()  const { return GetVar(AliNanoAODColumn::kTPCncls); }
+
+  virtual Double_t M() const { AliFatal("Not Implemented"); return -1; }
+  virtual Double_t E() const { AliFatal("Not Implemented"); return -1; }
+  Double_t E(Double_t m) const { return TMath::Sqrt(P()*P() + m*m); }
+  virtual Double_t Y() const { AliFatal("Not Implemented"); return  -1; }
+
+  virtual Double_t Eta() const { return -TMath::Log(TMath::Tan(0.5 * Theta())); }
+  virtual Short_t  Charge() const { return (Short_t) GetVar(AliNanoAODColumn::kCharge); }
+  virtual Double_t GetSign() const { return Charge(); }
+  virtual Bool_t   PropagateToDCA(const AliVVertex */*vtx*/, Double_t /*b*/, Double_t /*maxd*/, Double_t /*dz*/[2], Double_t /*covar*/[3]) { AliFatal("Not Implemented"); return kFALSE; }
+
+  ULong_t GetStatus() const { AliFatal("Not implemented"); return 0; }
+  Int_t   GetID() const { return GetIntVar(AliNanoAODColumn::kID); }
+  Int_t   GetLabel() const { return GetIntVar(AliNanoAODColumn::kLabel); }
+
+  Bool_t GetXYZ(Double_t *p) const {
+    p[0] = GetVar(AliNanoAODColumn::kPosX); p[1] = GetVar(AliNanoAODColumn::kPosY); p[2] = GetVar(AliNanoAODColumn::kPosZ);
+    return kFALSE; }
+  Bool_t GetXYZAt(Double_t /*x*/, Double_t /*b*/, Double_t */*r*/) const { AliFatal("Not implemented"); return kFALSE; }
+  Bool_t GetCovarianceXYZPxPyPz(Double_t /*cv*/[21]) const { AliFatal("Not implemented"); return 0; }
+
+  Double_t XAtDCA() const { return GetVar(AliNanoAODColumn::kPosDCAx); }
+  Double_t YAtDCA() const { return GetVar(AliNanoAODColumn::kPosDCAy); }
+  Double_t PxAtDCA() const { return GetVar(AliNanoAODColumn::kPDCAx); }
+  Double_t PyAtDCA() const { return GetVar(AliNanoAODColumn::kPDCAy); }
+  Double_t PzAtDCA() const { return GetVar(AliNanoAODColumn::kPDCAz); }
+  Double_t PAtDCA() const { return TMath::Sqrt(PxAtDCA()*PxAtDCA() + PyAtDCA()*PyAtDCA() + PzAtDCA()*PzAtDCA()); }
+  Bool_t   PxPyPzAtDCA(Double_t p[3]) const { p[0] = PxAtDCA(); p[1] = PyAtDCA(); p[2] = PzAtDCA(); return kTRUE; }
+
+  Double_t GetRAtAbsorberEnd() const { return GetVar(AliNanoAODColumn::kRAtAbsorberEnd); }
+
+  UChar_t  GetITSClusterMap() const { AliFatal("Not Implemented"); return 0; }
+  Float_t  GetTPCClusterInfo(Int_t /*nNeighbours=3*/, Int_t /*type=0*/, Int_t /*row0=0*/, Int_t /*row1=159*/, Int_t /*type*/=0) const { AliFatal("Not Implemented"); return 0; }
+
+  UShort_t GetTPCNclsF() const { return GetVar(AliNanoAODColumn::kTPCnclsF); }
+  UShort_t GetTPCNCrossedRows()  const { return GetVar(AliNanoAODColumn::kTPCNCrossedRows); }
+  Float_t  GetTPCFoundFraction() const { return GetTPCNCrossedRows()>0 ? float(GetTPCNcls())/GetTPCNCrossedRows() : 0; }
+
+  Double_t GetTrackPhiOnEMCal() const { return GetVar(AliNanoAODColumn::kTrackPhiOnEMCal); }
+  Double_t GetTrackEtaOnEMCal() const { return GetVar(AliNanoAODColumn::kTrackEtaOnEMCal); }
+  Double_t GetTrackPtOnEMCal() const  { return GetVar(AliNanoAODColumn::kTrackPtOnEMCal); }
+  Double_t GetTrackPOnEMCal() const { return TMath::Abs(GetTrackEtaOnEMCal()) < 1 ? GetTrackPtOnEMCal()*TMath::CosH(GetTrackEtaOnEMCal()) : -999; }
+
+  Double_t  GetITSsignal()       const { return GetVar(AliNanoAODColumn::kITSsignal); }
+  Double_t  GetTPCsignal()       const { return GetVar(AliNanoAODColumn::kTPCsignal); }
+  Double_t  GetTPCsignalTunedOnData() const { return GetVar(AliNanoAODColumn::kTPCsignalTuned); }
+  UShort_t  GetTPCsignalN()      const { return GetVar(AliNanoAODColumn::kTPCsignalN); }
+  Double_t  GetTPCmomentum()     const { return GetVar(AliNanoAODColumn::kTPCmomentum); }
+  Double_t  GetTPCTgl()          const { return GetVar(AliNanoAODColumn::kTPCTgl); }
+  Double_t  GetTOFsignal()       const { return GetVar(AliNanoAODColumn::kTOFsignal); }
+  Double_t  GetIntegratedLength() const { return GetVar(AliNanoAODColumn::kIntegratedLength); }
+  Double_t  GetTOFsignalTunedOnData() const { return GetVar(AliNanoAODColumn::kTOFsignalTuned); }
+  Double_t  GetHMPIDsignal()     const { return GetVar(AliNanoAODColumn::kHMPIDsignal); }
+  Double_t  GetHMPIDoccupancy()  const { return GetVar(AliNanoAODColumn::kHMPIDoccupancy); }
+
+  virtual void GetIntegratedTimes(Double_t */*times*/, Int_t) const { AliFatal("Not implemented"); return; }
+
+  Int_t     GetTOFBunchCrossing(Double_t /*b=0*/, Bool_t /*tpcPIDonly=kFALSE*/) const { AliFatal("Not Implemented"); return 0; }
+  UChar_t   GetTRDncls(Int_t /*layer*/)                           const { AliFatal("Not Implemented"); return 0; }
+  Double_t  GetTRDslice(Int_t /*plane*/, Int_t /*slice*/)         const { AliFatal("Not Implemented"); return 0; }
+  Double_t  GetTRDmomentum(Int_t /*plane*/, Double_t */*sp*/=0x0) const { AliFatal("Not Implemented"); return 0; }
+
+  Double_t  GetTRDsignal()         const { return GetVar(AliNanoAODColumn::kTRDsignal); }
+  Double_t  GetTRDchi2()           const { return GetVar(AliNanoAODColumn::kTRDChi2); }
+  UChar_t   GetTRDncls()           const { return GetTRDncls(-1); }
+  Int_t     GetNumberOfTRDslices() const { return GetVar(AliNanoAODColumn::kTRDnSlices); }
+
+  Int_t    PdgCode() const { return 0; }
+
+  //  needed  to inherit from VTrack, but not implemented
+  virtual void  SetDetectorPID(const AliDetectorPID */*pid*/)  { AliFatal("Not Implemented"); return; }
+  virtual const AliDetectorPID* GetDetectorPID() const { AliFatal("Not Implemented"); return 0; }
+  virtual UChar_t  GetTRDntrackletsPID() const  { AliFatal("Not Implemented"); return 0; }
+  virtual void      GetHMPIDpid(Double_t */*p*/) const  { AliFatal("Not Implemented"); return; }
+  virtual Double_t GetBz() const  { AliFatal("Not Implemented"); return 0; }
+  virtual void     GetBxByBz(Double_t [3]/*b[3]*/) const  { AliFatal("Not Implemented"); return; }
+  virtual const    AliExternalTrackParam * GetOuterParam() const { AliFatal("Not Implemented"); return 0; }
+  virtual const    AliExternalTrackParam * GetInnerParam() const { AliFatal("Not Implemented"); return 0; }
+  virtual Int_t    GetNcls(Int_t /*idet*/) const { AliFatal("Not Implemented"); return 0; }
+  virtual const Double_t *PID() const { AliFatal("Not Implemented"); return 0; }
+
+  void  Print(const Option_t *opt = "") const;
+
+private:
+
+  void VarNotAvailable(Int_t var) const; // var < 0: custom variable -1 - var
+
+  AliNanoAODTrackView(const AliNanoAODTrackView&);            // not implemented
+  AliNanoAODTrackView& operator=(const AliNanoAODTrackView&); // not implemented
+
+  const Columns * fColumns; //! columns of the current event
+  Int_t           fIndex;   //! index of the track in the columns
+
+  ClassDef(AliNanoAODTrackView, 1);
+};
+
+#endif
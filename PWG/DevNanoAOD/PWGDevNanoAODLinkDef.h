@@ -10,6 +10,11 @@
 #pragma link C++ class AliAnalysisNanoAODTrackCuts+;
 #pragma link C++ class AliAnalysisNanoAODEventCuts+;
 #pragma link C++ class AliNanoAODSimpleSetter+;         
+#pragma link C++ class AliNanoAODColumn+;
+#pragma link C++ class AliNanoAODIntColumn+;
+#pragma link C++ class AliNanoAODColumnOffset+;
+#pragma link C++ class AliNanoAODTrackView+;
+#pragma link C++ class AliNanoAODColumnInputHandler+;
 // Custom ESE classes: to be removed once the library is not in dev mode any more
 #pragma link C++ class AliESEEvtCut+;
 #pragma link C++ class AliESETrkCut+;
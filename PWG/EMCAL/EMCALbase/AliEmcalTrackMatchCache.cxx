@@ -0,0 +1,218 @@
+ /**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <algorithm>
+
+#include "AliAnalysisManager.h"
+#include "AliVEvent.h"
+#include "AliVTrack.h"
+#include "AliVCluster.h"
+
+#include "AliEmcalTrackMatchCache.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalTrackMatchCache)
+/// \endcond
+
+AliEmcalTrackMatchCache* AliEmcalTrackMatchCache::fgInstance = 0;
+
+/**
+ * Default constructor
+ */
+AliEmcalTrackMatchCache::AliEmcalTrackMatchCache() :
+  TObject(),
+  fEvent(0),
+  fEntry(-1),
+  fHypotheses(),
+  fPropagations(),
+  fPropagationTable(),
+  fResidualTable(),
+  fNFound(0),
+  fNStored(0)
+{
+}
+
+/**
+ * Destructor
+ */
+AliEmcalTrackMatchCache::~AliEmcalTrackMatchCache()
+{
+  if (fgInstance == this) fgInstance = 0;
+}
+
+/**
+ * Cache shared by all tasks of the process, created on first use.
+ * @return Pointer to the cache
+ */
+AliEmcalTrackMatchCache* AliEmcalTrackMatchCache::Instance()
+{
+  if (!fgInstance) fgInstance = new AliEmcalTrackMatchCache();
+  return fgInstance;
+}
+
+/**
+ * Clear the cache if the event differs from the one of the cached results. The event object
+ * is reused by the input handler, hence the entry of the analysis manager is compared as well.
+ * @param[in] event Current event
+ * @return kTRUE if the cache was cleared
+ */
+Bool_t AliEmcalTrackMatchCache::BeginEvent(const AliVEvent* event)
+{
+  AliAnalysisManager* mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  if (event == fEvent && entry == fEntry) return kFALSE;
+
+  Clear();
+  fEvent = event;
+  fEntry = entry;
+  return kTRUE;
+}
+
+/**
+ * Remove all propagations, the hypotheses are kept.
+ */
+void AliEmcalTrackMatchCache::Clear(Option_t*)
+{
+  fPropagations.clear();
+  fPropagationTable.clear();
+  fResidualTable.clear();
+  fEvent = 0;
+  fEntry = -1;
+}
+
+/**
+ * Index of a propagation hypothesis, the same for the same parameters.
+ * @param[in] detector Calorimeter (Detector_t)
+ * @param[in] radius Radius of the surface, 0 for propagations to a cluster
+ * @param[in] mass Mass hypothesis
+ * @param[in] step Step
+ * @param[in] variant Anything else which changes the result of the propagation
+ * @return Index of the hypothesis
+ */
+Int_t AliEmcalTrackMatchCache::GetHypothesis(Int_t detector, Double_t radius, Double_t mass, Double_t step, Int_t variant)
+{
+  for (UInt_t i = 0; i < fHypotheses.size(); i++) {
+    const Hypothesis& h = fHypotheses[i];
+    if (h.fDetector == detector && h.fRadius == radius && h.fMass == mass && h.fStep == step && h.fVariant == variant) return i;
+  }
+  Hypothesis h = {detector, radius, mass, step, variant};
+  fHypotheses.push_back(h);
+  return fHypotheses.size() - 1;
+}
+
+/**
+ * Look up a propagation to the calorimeter surface.
+ * @param[in] hypothesis Index from GetHypothesis()
+ * @param[in] track Track of the input event
+ * @param[out] param Track parameters on the surface (if not NULL and propagated)
+ * @param[out] eta Eta on the surface (if propagated)
+ * @param[out] phi Phi on the surface (if propagated)
+ * @param[out] pt Pt on the surface (if propagated)
+ * @return Status_t
+ */
+Int_t AliEmcalTrackMatchCache::FindPropagation(Int_t hypothesis, const AliVTrack* track, AliExternalTrackParam* param, Float_t& eta, Float_t& phi, Float_t& pt)
+{
+  PropagationEntry entry = {{track->GetID(), hypothesis, 0}, -1};
+  std::vector<PropagationEntry>::const_iterator it = std::lower_bound(fPropagationTable.begin(), fPropagationTable.end(), entry, LessPropagation);
+  if (it == fPropagationTable.end() || !(it->fKey == entry.fKey)) return kNotCached;
+
+  fNFound++;
+  const Propagation& p = fPropagations[it->fIndex];
+  if (!p.fOk) return kFailed;
+  eta = p.fEta;
+  phi = p.fPhi;
+  pt = p.fPt;
+  if (param) *param = p.fParam;
+  return kPropagated;
+}
+
+/**
+ * Store a propagation to the calorimeter surface. The tracks are usually stored in the order
+ * of their IDs, so the entry is mostly appended at the end of the table.
+ * @param[in] hypothesis Index from GetHypothesis()
+ * @param[in] track Track of the input event
+ * @param[in] ok kTRUE if the propagation was successful
+ * @param[in] param Track parameters on the surface (may be NULL)
+ * @param[in] eta Eta on the surface
+ * @param[in] phi Phi on the surface
+ * @param[in] pt Pt on the surface
+ */
+void AliEmcalTrackMatchCache::AddPropagation(Int_t hypothesis, const AliVTrack* track, Bool_t ok, const AliExternalTrackParam* param, Float_t eta, Float_t phi, Float_t pt)
+{
+  PropagationEntry entry = {{track->GetID(), hypothesis, 0}, (Int_t)fPropagations.size()};
+  std::vector<PropagationEntry>::iterator it = std::lower_bound(fPropagationTable.begin(), fPropagationTable.end(), entry, LessPropagation);
+  if (it != fPropagationTable.end() && it->fKey == entry.fKey) return;
+  fPropagationTable.insert(it, entry);
+
+  fNStored++;
+  Propagation p;
+  p.fOk = ok;
+  p.fEta = eta;
+  p.fPhi = phi;
+  p.fPt = pt;
+  if (param) p.fParam = *param;
+  fPropagations.push_back(p);
+}
+
+/**
+ * Look up a propagation to a cluster.
+ * @param[in] hypothesis Index from GetHypothesis()
+ * @param[in] track Track of the input event
+ * @param[in] cluster Cluster of the input event
+ * @param[out] dEta Eta residual (if propagated)
+ * @param[out] dPhi Phi residual (if propagated)
+ * @return Status_t
+ */
+Int_t AliEmcalTrackMatchCache::FindResidual(Int_t hypothesis, const AliVTrack* track, const AliVCluster* cluster, Float_t& dEta, Float_t& dPhi)
+{
+  ResidualEntry entry = {{track->GetID(), hypothesis, cluster->GetID()}, {kFALSE, 0, 0}};
+  std::vector<ResidualEntry>::const_iterator it = std::lower_bound(fResidualTable.begin(), fResidualTable.end(), entry, LessResidual);
+  if (it == fResidualTable.end() || !(it->fKey == entry.fKey)) return kNotCached;
+
+  fNFound++;
+  const Residual& r = it->fResidual;
+  if (!r.fOk) return kFailed;
+  dEta = r.fDEta;
+  dPhi = r.fDPhi;
+  return kPropagated;
+}
+
+/**
+ * Store a propagation to a cluster.
+ * @param[in] hypothesis Index from GetHypothesis()
+ * @param[in] track Track of the input event
+ * @param[in] cluster Cluster of the input event
+ * @param[in] ok kTRUE if the propagation was successful
+ * @param[in] dEta Eta residual
+ * @param[in] dPhi Phi residual
+ */
+void AliEmcalTrackMatchCache::AddResidual(Int_t hypothesis, const AliVTrack* track, const AliVCluster* cluster, Bool_t ok, Float_t dEta, Float_t dPhi)
+{
+  ResidualEntry entry = {{track->GetID(), hypothesis, cluster->GetID()}, {ok, dEta, dPhi}};
+  std::vector<ResidualEntry>::iterator it = std::lower_bound(fResidualTable.begin(), fResidualTable.end(), entry, LessResidual);
+  if (it != fResidualTable.end() && it->fKey == entry.fKey) return;
+  fResidualTable.insert(it, entry);
+
+  fNStored++;
+}
+
+/**
+ * Order of the keys: track ID, then hypothesis, then cluster ID.
+ */
+bool AliEmcalTrackMatchCache::Key::operator<(const Key& other) const
+{
+  if (fTrack != other.fTrack) return fTrack < other.fTrack;
+  if (fHypothesis != other.fHypothesis) return fHypothesis < other.fHypothesis;
+  return fCluster < other.fCluster;
+}
@@ -0,0 +1,188 @@
+#ifndef ALIEMCALTRACKMATCHCACHE_H
+#define ALIEMCALTRACKMATCHCACHE_H
+
+#include <vector>
+
+#include <TObject.h>
+
+#include "AliExternalTrackParam.h"
+
+class AliVEvent;
+class AliVTrack;
+class AliVCluster;
+
+/**
+ * @class AliEmcalTrackMatchCache
+ * @ingroup EMCALCOREFW
+ * @brief Event-scoped cache of track propagations to the calorimeters and of track-cluster residuals
+ *
+ * Several tasks in a train propagate the same tracks to the EMCal/DCal/PHOS surface and to the
+ * same clusters (e.g. AliCaloTrackMatcher for EMCal and DCal and for many cut configurations, or the
+ * EMCal correction framework in several correction tasks), each with its own loop. With this cache the
+ * first task stores the result of each propagation and the following ones read it back, so that each
+ * track is propagated at most once per propagation hypothesis in an event.
+ *
+ * A propagation hypothesis is identified by the detector, radius, mass, step and a
+ * variant number for everything else which changes the result (the starting point of the
+ * propagation, see Variant_t); GetHypothesis() returns the same index for the same parameters to all users.
+ * Results are only shared between users with identical hypotheses: AliCaloTrackMatcher starts from the
+ * inner parameters (ESD) or the stored AOD parameters with mass 0.139, the correction framework from the
+ * track through AliEMCALRecoUtils with mass 0.1396, so the two frameworks use the same service but do not
+ * reuse each other's propagations.
+ *
+ * Propagations are stored in a table sorted by track ID and hypothesis, residuals in a table sorted
+ * by track ID, hypothesis and cluster ID, so that all results of a track are adjacent. The IDs are
+ * those of the tracks and clusters of the input event (AliVTrack::GetID(), AliVCluster::GetID());
+ * tracks copied into other collections with modified parameters must not be looked up in the cache.
+ * Both failed and successful propagations are stored, each user then applies its own acceptance and
+ * matching cuts.
+ *
+ * The cache is cleared by BeginEvent() when a new event is seen, which each user calls before
+ * accessing it:
+ * ~~~{.cxx}
+ * AliEmcalTrackMatchCache* cache = AliEmcalTrackMatchCache::Instance();
+ * cache->BeginEvent(event);
+ * Int_t hyp = cache->GetHypothesis(AliEmcalTrackMatchCache::kEMCal, 440., 0.139, 20.);
+ * AliExternalTrackParam param;
+ * Float_t eta, phi, pt;
+ * Int_t status = cache->FindPropagation(hyp, track, &param, eta, phi, pt);
+ * if (status == AliEmcalTrackMatchCache::kNotCached) {
+ *   // propagate and then cache->AddPropagation(hyp, track, ok, &param, eta, phi, pt);
+ * }
+ * ~~~
+ */
+class AliEmcalTrackMatchCache : public TObject {
+ public:
+  /**
+   * @enum Detector_t
+   * @brief Calorimeter of a propagation hypothesis, same numbering as the cluster type of AliCaloTrackMatcher
+   */
+  enum Detector_t {
+    kEMCal = 1,                    ///< EMCal
+    kPHOS  = 2,                    ///< PHOS
+    kDCal  = 3                     ///< DCal
+  };
+  /**
+   * @enum Status_t
+   * @brief Result of a lookup
+   */
+  enum Status_t {
+    kNotCached = -1,               ///< not yet done in this event
+    kFailed = 0,                   ///< done, propagation failed
+    kPropagated = 1                ///< done, propagation successful
+  };
+  /**
+   * @enum Variant_t
+   * @brief Starting point of the propagation, used as variant of the hypothesis
+   */
+  enum Variant_t {
+    kVertexStart = 0,              ///< AliVTrack propagated from the primary vertex (AliEMCALRecoUtils)
+    kDCAStart = 1,                 ///< AliVTrack propagated from the DCA (AliEMCALRecoUtils)
+    kInnerParamStart = 2,          ///< inner parameters of an ESD track (AliCaloTrackMatcher)
+    kAODParamStart = 3             ///< parameters built from the position, momentum and covariance stored in an AOD track (AliCaloTrackMatcher)
+  };
+
+  AliEmcalTrackMatchCache();
+  virtual ~AliEmcalTrackMatchCache();
+
+  static AliEmcalTrackMatchCache* Instance();
+
+  Bool_t BeginEvent(const AliVEvent* event);
+  void   Clear(Option_t* option = "");
+
+  Int_t  GetHypothesis(Int_t detector, Double_t radius, Double_t mass, Double_t step, Int_t variant = 0);
+
+  // Track to the calorimeter surface
+  Int_t  FindPropagation(Int_t hypothesis, const AliVTrack* track, AliExternalTrackParam* param, Float_t& eta, Float_t& phi, Float_t& pt);
+  void   AddPropagation(Int_t hypothesis, const AliVTrack* track, Bool_t ok, const AliExternalTrackParam* param, Float_t eta, Float_t phi, Float_t pt);
+  // Track to a cluster
+  Int_t  FindResidual(Int_t hypothesis, const AliVTrack* track, const AliVCluster* cluster, Float_t& dEta, Float_t& dPhi);
+  void   AddResidual(Int_t hypothesis, const AliVTrack* track, const AliVCluster* cluster, Bool_t ok, Float_t dEta, Float_t dPhi);
+
+  Long64_t GetNFound() const  { return fNFound; }   ///< number of lookups answered from the cache since the start
+  Long64_t GetNStored() const { return fNStored; }  ///< number of propagations stored since the start
+
+ protected:
+  /**
+   * @struct Hypothesis
+   * @brief Parameters of a propagation
+   */
+  struct Hypothesis {
+    Int_t    fDetector;            ///< calorimeter
+    Double_t fRadius;              ///< radius of the surface (0 for propagations to a cluster)
+    Double_t fMass;                ///< mass hypothesis
+    Double_t fStep;                ///< step
+    Int_t    fVariant;             ///< anything else which changes the result
+  };
+  /**
+   * @struct Propagation
+   * @brief Result of a propagation to the surface
+   */
+  struct Propagation {
+    Bool_t   fOk;                  ///< propagation successful
+    Float_t  fEta;                 ///< eta on the surface
+    Float_t  fPhi;                 ///< phi on the surface
+    Float_t  fPt;                  ///< pt on the surface
+    AliExternalTrackParam fParam;  ///< track parameters on the surface
+  };
+  /**
+   * @struct Residual
+   * @brief Result of a propagation to a cluster
+   */
+  struct Residual {
+    Bool_t   fOk;                  ///< propagation successful
+    Float_t  fDEta;                ///< eta residual
+    Float_t  fDPhi;                ///< phi residual
+  };
+  /**
+   * @struct Key
+   * @brief Track ID, hypothesis and (for residuals) cluster ID, ordered in this sequence
+   */
+  struct Key {
+    Int_t    fTrack;               ///< track ID
+    Int_t    fHypothesis;          ///< hypothesis index
+    Int_t    fCluster;             ///< cluster ID, 0 for propagations to the surface
+    bool operator<(const Key& other) const;
+    bool operator==(const Key& other) const { return fTrack == other.fTrack && fHypothesis == other.fHypothesis && fCluster == other.fCluster; }
+  };
+  /**
+   * @struct PropagationEntry
+   * @brief Entry of the propagation table
+   */
+  struct PropagationEntry {
+    Key      fKey;                 ///< track and hypothesis
+    Int_t    fIndex;               ///< position in fPropagations
+  };
+  /**
+   * @struct ResidualEntry
+   * @brief Entry of the residual table
+   */
+  struct ResidualEntry {
+    Key      fKey;                 ///< track, hypothesis and cluster
+    Residual fResidual;            ///< result
+  };
+
+  static bool LessPropagation(const PropagationEntry& a, const PropagationEntry& b) { return a.fKey < b.fKey; }
+  static bool LessResidual(const ResidualEntry& a, const ResidualEntry& b)          { return a.fKey < b.fKey; }
+
+  const AliVEvent*          fEvent;              //!<! event of the cached results
+  Long64_t                  fEntry;              //!<! entry of the analysis manager of the cached results
+  std::vector<Hypothesis>   fHypotheses;         //!<! all hypotheses requested so far (kept between events)
+  std::vector<Propagation>  fPropagations;       //!<! propagations to the surface in this event, in the order stored
+  std::vector<PropagationEntry> fPropagationTable; //!<! propagations sorted by track ID and hypothesis
+  std::vector<ResidualEntry> fResidualTable;     //!<! propagations to clusters sorted by track ID, hypothesis and cluster ID
+  Long64_t                  fNFound;             //!<! lookups answered from the cache
+  Long64_t                  fNStored;            //!<! propagations stored
+
+ private:
+  AliEmcalTrackMatchCache(const AliEmcalTrackMatchCache&);            // Not implemented
+  AliEmcalTrackMatchCache& operator=(const AliEmcalTrackMatchCache&); // Not implemented
+
+  static AliEmcalTrackMatchCache* fgInstance;    //!<! instance shared by all tasks
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTrackMatchCache, 1); // Event-scoped cache of track propagations to the calorimeters
+  /// \endcond
+};
+
+#endif /* ALIEMCALTRACKMATCHCACHE_H */
@@ -17,6 +17,7 @@
 #pragma link C++ class AliEmcalParticle+;
 #pragma link C++ class AliEmcalPhysicsSelection+;
 #pragma link C++ class AliEmcalPythiaInfo+;
+#pragma link C++ class AliEmcalTrackMatchCache+;
 #pragma link C++ class AliEmcalTrackSelResultPtr+;
 #pragma link C++ class AliEmcalManagedObject+;
 #pragma link C++ class AliEmcalTrackSelection+;
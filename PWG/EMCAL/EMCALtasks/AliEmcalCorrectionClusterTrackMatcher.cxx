@@ -3,8 +3,12 @@
 
 #include "AliEmcalCorrectionClusterTrackMatcher.h"
 
+#include <algorithm>
+
 #include <TH1.h>
 #include <TList.h>
+#include <TVector2.h>
+#include <TVector3.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
@@ -13,6 +17,7 @@
 #include "AliAODCaloCluster.h"
 #include "AliVParticle.h"
 #include "AliEmcalParticle.h"
+#include "AliEmcalTrackMatchCache.h"
 #include "AliEMCALGeometry.h"
 #include "AliMCEvent.h"
 
@@ -37,6 +42,8 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fUseDCA(kTRUE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fUseGridMatching(kFALSE),
+  fUseMatchCache(kFALSE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
   fEmcalTracks(0),
@@ -45,6 +52,14 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fNEmcalClusters(0),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0),
+  fGridNEta(0),
+  fGridNPhi(0),
+  fGridEtaMin(0),
+  fGridEtaWidth(0),
+  fGridPhiWidth(0),
+  fGridCellStart(),
+  fGridClusters(),
+  fGridCandidates(),
   fMCGenerToAcceptForTrack(1),
   fNMCGenerToAccept(0)
 {
@@ -81,6 +96,8 @@ Bool_t AliEmcalCorrectionClusterTrackMatcher::Initialize()
   GetProperty("maxDist", fMaxDistance);
   GetProperty("updateClusters", fUpdateClusters);
   GetProperty("updateTracks", fUpdateTracks);
+  GetProperty("useGridMatching", fUseGridMatching);
+  GetProperty("useMatchCache", fUseMatchCache);
   fDoPropagation = fEsdMode;
   
   Bool_t enableFracEMCRecalc = kFALSE;
@@ -291,9 +308,23 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
     mass = 0.1396;
   }
 
+  // Propagations shared with the other correction tasks in this event, with the same hypothesis
+  AliEmcalTrackMatchCache* cache = 0;
+  Int_t hypothesis = -1;
+  if (fUseMatchCache) {
+    cache = AliEmcalTrackMatchCache::Instance();
+    cache->BeginEvent(fEventManager.InputEvent());
+    hypothesis = cache->GetHypothesis(AliEmcalTrackMatchCache::kEMCal, fPropDist, mass, 20, fUseDCA ? AliEmcalTrackMatchCache::kDCAStart : AliEmcalTrackMatchCache::kVertexStart);
+  }
+
   AliParticleContainer * partCont = 0;
   TIter nextPartCont(&fParticleCollArray);
   while ((partCont = static_cast<AliParticleContainer*>(nextPartCont()))) {
+    // The cache identifies the tracks of the input event by their ID, tracks of other collections are propagated here
+    AliEmcalTrackMatchCache* contCache = 0;
+    if (cache && !partCont->GetIsEmbedding() && partCont->GetArrayName() == AliEmcalContainerUtils::DetermineUseDefaultName(AliEmcalContainerUtils::kTrack, fEsdMode).c_str()) {
+      contCache = cache;
+    }
     auto partItCont = partCont->accepted_momentum();
     for (AliParticleIterableMomentumContainer::iterator partIterator = partItCont.begin(); partIterator != partItCont.end(); ++partIterator) {
       track = static_cast<AliVTrack *>(partIterator->second);
@@ -333,8 +364,22 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
           if ( !generOK ) continue;
         }
         
-        // Propagate the track
-        AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA);
+        // Propagate the track, or take the result of another task which did the same propagation in this event
+        if (contCache) {
+          Float_t etaOnEMCal = -999, phiOnEMCal = -999, ptOnEMCal = -999;
+          Int_t cached = contCache->FindPropagation(hypothesis, track, 0, etaOnEMCal, phiOnEMCal, ptOnEMCal);
+          if (cached == AliEmcalTrackMatchCache::kNotCached) {
+            Bool_t propagated = AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA);
+            contCache->AddPropagation(hypothesis, track, propagated, 0, track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), track->GetTrackPtOnEMCal());
+          }
+          else {
+            // a failed propagation leaves the default values in the track
+            track->SetTrackPhiEtaPtOnEMCal(phiOnEMCal, etaOnEMCal, ptOnEMCal);
+          }
+        }
+        else {
+          AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA);
+        }
       }
 
       // Reset properties of the track to fix TRefArray errors which occur when AddTrackMatched(obj) is called.
@@ -369,11 +414,19 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  // With the grid, only clusters in the cells around the track are compared.
+  // They are visited in increasing index, as in the loop over all clusters,
+  // so that AddMatchedObj() is called in the same order for all pairs in range.
+  const Bool_t useGrid = fUseGridMatching && fMaxDistance > 0 && fNEmcalClusters > 0;
+  if (useGrid) FillClusterGrid();
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    const Int_t nCandidates = useGrid ? FindGridCandidates(track) : fNEmcalClusters;
+    for (Int_t icandidate = 0; icandidate < nCandidates; icandidate++) {
+      const Int_t icluster = useGrid ? fGridCandidates[icandidate] : icandidate;
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
       
@@ -410,6 +463,85 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
   }
 }
 
+/**
+ * Sort the clusters into an (eta,phi) grid. The cells are at least fMaxDistance wide,
+ * hence a track can only match clusters in its own cell and the neighbouring ones.
+ * The cluster eta and phi are calculated as in GetEtaPhiDiff().
+ */
+void AliEmcalCorrectionClusterTrackMatcher::FillClusterGrid()
+{
+  const Int_t maxCells = 1000; // per axis, the cells are enlarged beyond this
+  const Double_t minWidth = fMaxDistance * (1 + 1e-6); // margin against rounding at the cell edges
+
+  std::vector<Double_t> clusEta(fNEmcalClusters);
+  std::vector<Double_t> clusPhi(fNEmcalClusters);
+  Double_t etaMin = 0, etaMax = 0;
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliVCluster* cluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster))->GetCluster();
+    Float_t pos[3] = {0};
+    cluster->GetPosition(pos);
+    TVector3 cpos(pos);
+    clusEta[icluster] = cpos.Eta();
+    clusPhi[icluster] = cpos.Phi();
+    if (icluster == 0 || clusEta[icluster] < etaMin) etaMin = clusEta[icluster];
+    if (icluster == 0 || clusEta[icluster] > etaMax) etaMax = clusEta[icluster];
+  }
+
+  fGridEtaMin = etaMin;
+  fGridEtaWidth = TMath::Max(minWidth, (etaMax - etaMin) / (maxCells - 1));
+  fGridNEta = TMath::Min(maxCells, Int_t((etaMax - etaMin) / fGridEtaWidth) + 1);
+  fGridNPhi = TMath::Max(1, TMath::Min(maxCells, Int_t(TMath::TwoPi() / minWidth)));
+  fGridPhiWidth = TMath::TwoPi() / fGridNPhi;
+
+  // Counting sort by cell, clusters keep their order within a cell
+  const Int_t nCells = fGridNEta * fGridNPhi;
+  std::vector<Int_t> cellOfCluster(fNEmcalClusters);
+  fGridCellStart.assign(nCells + 1, 0);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    Int_t ieta = TMath::Min(fGridNEta - 1, Int_t((clusEta[icluster] - fGridEtaMin) / fGridEtaWidth));
+    Int_t iphi = TMath::Min(fGridNPhi - 1, Int_t((clusPhi[icluster] + TMath::Pi()) / fGridPhiWidth));
+    if (iphi < 0) iphi = 0;
+    cellOfCluster[icluster] = ieta * fGridNPhi + iphi;
+    fGridCellStart[cellOfCluster[icluster] + 1]++;
+  }
+  for (Int_t icell = 0; icell < nCells; icell++) fGridCellStart[icell + 1] += fGridCellStart[icell];
+  fGridClusters.resize(fNEmcalClusters);
+  std::vector<Int_t> next(fGridCellStart.begin(), fGridCellStart.end() - 1);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    fGridClusters[next[cellOfCluster[icluster]]++] = icluster;
+  }
+}
+
+/**
+ * Collect in fGridCandidates, in increasing order, the clusters in the grid cells around the
+ * position of the track on the EMCal surface.
+ * @return number of candidate clusters
+ */
+Int_t AliEmcalCorrectionClusterTrackMatcher::FindGridCandidates(const AliVTrack* track)
+{
+  fGridCandidates.clear();
+
+  const Double_t veta = track->GetTrackEtaOnEMCal();
+  const Double_t vphi = TVector2::Phi_mpi_pi(track->GetTrackPhiOnEMCal());
+  const Double_t xeta = (veta - fGridEtaMin) / fGridEtaWidth;
+  if (!(xeta >= -1 && xeta < fGridNEta + 1)) return 0; // also for NaN
+  const Int_t ieta = TMath::FloorNint(xeta);
+  Int_t iphi = TMath::Min(fGridNPhi - 1, Int_t((vphi + TMath::Pi()) / fGridPhiWidth));
+  if (iphi < 0) iphi = 0;
+
+  const Int_t nPhiCells = fGridNPhi < 3 ? fGridNPhi : 3;
+  for (Int_t jeta = TMath::Max(0, ieta - 1); jeta <= TMath::Min(fGridNEta - 1, ieta + 1); jeta++) {
+    for (Int_t k = 0; k < nPhiCells; k++) {
+      Int_t jphi = fGridNPhi < 3 ? k : (iphi + k - 1 + fGridNPhi) % fGridNPhi;
+      Int_t icell = jeta * fGridNPhi + jphi;
+      fGridCandidates.insert(fGridCandidates.end(), fGridClusters.begin() + fGridCellStart[icell], fGridClusters.begin() + fGridCellStart[icell + 1]);
+    }
+  }
+  std::sort(fGridCandidates.begin(), fGridCandidates.end());
+
+  return fGridCandidates.size();
+}
+
 /**
  * Update clusters with matching info.
  */
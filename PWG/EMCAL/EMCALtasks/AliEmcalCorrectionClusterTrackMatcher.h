@@ -1,6 +1,8 @@
 #ifndef ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
+#include <vector>
+
 #include "AliEmcalCorrectionComponent.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
@@ -11,6 +13,7 @@ class TH1;
 class TClonesArray;
 
 class AliVParticle;
+class AliVTrack;
 
 /**
  * @class AliEmcalCorrectionClusterTrackMatcher
@@ -69,6 +72,8 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Int_t         GetMomBin(Double_t p) const;
   void          GenerateEmcalParticles();
   void          DoMatching();
+  void          FillClusterGrid();
+  Int_t         FindGridCandidates(const AliVTrack* track);
   void          UpdateTracks();
   void          UpdateClusters();
   Bool_t        IsTrackInEmcalAcceptance(AliVParticle* part, Double_t edges=0.9) const;
@@ -87,6 +92,8 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Bool_t        fUseDCA;                ///< Use DCA as starting point for track propagation, rather than primary vertex
   Bool_t        fUpdateTracks;          ///< update tracks with matching info
   Bool_t        fUpdateClusters;        ///< update clusters with matching info
+  Bool_t        fUseGridMatching;       ///< compare each track only to the clusters in the neighbouring cells of an (eta,phi) grid with cells of at least fMaxDistance
+  Bool_t        fUseMatchCache;         ///< share the propagations to the EMCal surface with the other track matchers of the event (AliEmcalTrackMatchCache)
   
 #if !(defined(__CINT__) || defined(__MAKECINT__))
   // Handle mapping between index and containers
@@ -102,6 +109,15 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   TH1          *fHistMatchPhiAll;       //!<!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!<!deta distribution
   TH1          *fHistMatchPhi[10][9][2]; //!<!dphi distribution
+
+  Int_t         fGridNEta;              //!<!number of eta cells of the cluster grid
+  Int_t         fGridNPhi;              //!<!number of phi cells of the cluster grid
+  Double_t      fGridEtaMin;            //!<!lower eta edge of the cluster grid
+  Double_t      fGridEtaWidth;          //!<!eta width of a grid cell
+  Double_t      fGridPhiWidth;          //!<!phi width of a grid cell
+  std::vector<Int_t> fGridCellStart;    //!<!position of the first cluster of each cell in fGridClusters (one more entry than cells)
+  std::vector<Int_t> fGridClusters;     //!<!cluster indices ordered by cell, increasing within a cell
+  std::vector<Int_t> fGridCandidates;   //!<!clusters in the cells around the current track, increasing
   
   Int_t      fNMCGenerToAccept;          ///<  Number of MC generators that should not be included in analysis
   TString    fMCGenerToAccept[5];        ///<  List with name of generators that should not be included
@@ -115,7 +131,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 4); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 6); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
@@ -18,6 +18,7 @@
 #include "AliFlowAnalysis.h"
 #include "AliFlowEventSimpleCuts.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventFlat.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // AliFlowAnalysis:
@@ -52,3 +53,12 @@ void AliFlowAnalysis::ProcessEvent(AliFlowEventSimple* event)
   if (fEventCuts) pass=fEventCuts->IsSelected(event,(TObject*)NULL);
   if (pass) Make(event);
 }
+
+//-----------------------------------------------------------------------
+void AliFlowAnalysis::Make(const AliFlowEventFlat* anEvent)
+{
+  //run Make(AliFlowEventSimple*) on the viewed event, or on the AliFlowEventSimple
+  //filled from the arrays; methods reading the arrays directly override this
+  if (!anEvent) return;
+  Make(anEvent->GetEventSimple());
+}
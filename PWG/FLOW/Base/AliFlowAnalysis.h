@@ -7,6 +7,7 @@
 #define ALIFLOWANALYSISBASE_H
 
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowEventSimpleCuts;
 class TList;
 class TDirectoryFile;
@@ -26,6 +27,7 @@ class AliFlowAnalysis : public TNamed {
    virtual void Init() {}                                       //Define output objects
    virtual void ProcessEvent(AliFlowEventSimple* /*anEvent*/);  //Main routine executed by the framework
    virtual void Make(AliFlowEventSimple* /*anEvent*/) {}        //Main routine to be implemened by user
+   virtual void Make(const AliFlowEventFlat* anEvent);          //Same for a flat event, by default on its AliFlowEventSimple
    virtual void Finish() {}                                           //Fill results
    virtual void GetOutputHistograms(TList* /* outputListHistos */) {} //Copy output objects from TList
    virtual void WriteHistograms(TDirectoryFile* /* outputFileName */) const {} //writes histograms locally (for OnTheFly)
@@ -42,9 +42,11 @@
 #include "TPaveLabel.h"
 #include "TCanvas.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventFlat.h"
 #include "AliFlowVector.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisCRC.h"
+#include "AliFlowCRCQvectorWorkspace.h"
 #include "AliLog.h"
 #include "TRandom.h"
 #include "TF1.h"
@@ -321,6 +323,7 @@ fCMETPCList(NULL),
 fCMEZDCList(NULL),
 fCRC2List(NULL),
 fCRC2nEtaBins(6),
+fQvectorWorkspace(NULL),
 fFlowSPZDCList(NULL),
 fFlowQCList(NULL),
 //fFlowQCOrdMagList(NULL),
@@ -403,6 +406,7 @@ AliFlowAnalysisCRC::~AliFlowAnalysisCRC()
   // destructor
   delete fHistList;
   delete fTempList;
+  delete fQvectorWorkspace;
   if(fCRCQVecWeightsList) delete fCRCQVecWeightsList;
   if(fCRCZDCCalibList)    delete fCRCZDCCalibList;
   if(fCRCZDC2DCutList)    delete fCRCZDC2DCutList;
@@ -1043,91 +1047,58 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
         
         // Flow SP ZDC
         Bool_t bFillDis=kTRUE;
-        for (Int_t k=0; k<fQVecPower; k++) {
-          for (Int_t h=0;h<fFlowNHarmMax;h++) {
+        fQvectorWorkspace->SetTrack(dPhi,wPhiEta);
+        Int_t ptBin = fQvectorWorkspace->FindPtBin(dPt);
+        Int_t phiBin = fQvectorWorkspace->FindPhiBin(dPhi);
+        if(fFlowQCDeltaEta>0.) {
+          
+          fQvectorWorkspace->FillPt(AliFlowCRCQvectorWorkspace::kPtAll,ptBin);
+          fQvectorWorkspace->FillPt(AliFlowCRCQvectorWorkspace::kPtCh+cw,ptBin);
+          fQvectorWorkspace->FillPhi(AliFlowCRCQvectorWorkspace::kPhiAll,phiBin);
+          fQvectorWorkspace->FillPhiEta(ITStype,fQvectorWorkspace->FindPhiEtaBin(dPhi,dEta));
+          
+          if(fabs(dEta)>fFlowQCDeltaEta/2.) {
+            Int_t keta = (dEta<0.?0:1);
+            fQvectorWorkspace->FillPt(AliFlowCRCQvectorWorkspace::kPtEG+keta,ptBin);
+            fQvectorWorkspace->FillPhi(AliFlowCRCQvectorWorkspace::kPhiEG+keta,phiBin);
+          }
+          
+        } else if(fFlowQCDeltaEta<0. && fFlowQCDeltaEta>-1.) {
+          
+          if(dEta>0.) {
+            fQvectorWorkspace->FillPt(AliFlowCRCQvectorWorkspace::kPtAll,ptBin);
+            fQvectorWorkspace->FillPhi(AliFlowCRCQvectorWorkspace::kPhiAll,phiBin);
             
-            if(fFlowQCDeltaEta>0.) {
-              
-              fPOIPtDiffQRe[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-              fPOIPtDiffQIm[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-              fPOIPtDiffMul[k][h]->Fill(dPt,pow(wPhiEta,k));
-              
-              fPOIPtDiffQReCh[cw][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-              fPOIPtDiffQImCh[cw][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-              fPOIPtDiffMulCh[cw][k][h]->Fill(dPt,pow(wPhiEta,k));
-              
-              fPOIPhiDiffQRe[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-              fPOIPhiDiffQIm[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-              fPOIPhiDiffMul[k][h]->Fill(dPhi,pow(wPhiEta,k));
-              
-              fPOIPhiEtaDiffQRe[ITStype][k][h]->Fill(dPhi,dEta,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-              fPOIPhiEtaDiffQIm[ITStype][k][h]->Fill(dPhi,dEta,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-              fPOIPhiEtaDiffMul[ITStype][k][h]->Fill(dPhi,dEta,pow(wPhiEta,k));
-              
-              if(fabs(dEta)>fFlowQCDeltaEta/2.) {
-                Int_t keta = (dEta<0.?0:1);
-                fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k));
-                fPOIPhiDiffQReEG[keta][k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPhiDiffQImEG[keta][k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPhiDiffMulEG[keta][k][h]->Fill(dPhi,pow(wPhiEta,k));
-              }
-              
-            } else if(fFlowQCDeltaEta<0. && fFlowQCDeltaEta>-1.) {
-              
-              if(dEta>0.) {
-                fPOIPtDiffQRe[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPtDiffQIm[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPtDiffMul[k][h]->Fill(dPt,pow(wPhiEta,k));
-                
-                fPOIPhiDiffQRe[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPhiDiffQIm[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPhiDiffMul[k][h]->Fill(dPhi,pow(wPhiEta,k));
-                
-                Double_t boundetagap = fabs(fFlowQCDeltaEta);
-                
-                if((dEta>0. && dEta<0.4-boundetagap/2.) || (dEta>0.4+boundetagap/2. && dEta<0.8)) {
-                  Int_t keta;
-                  if(dEta>0. && dEta<0.4-boundetagap/2.) keta = 0;
-                  else keta = 1;
-                  fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                  fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                  fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k));
-                }
-              } else {
-                bFillDis = kFALSE;
-                continue;
-              }
-              
-            } else if(fFlowQCDeltaEta<-1. && fFlowQCDeltaEta>-2.) {
-              
-              if(dEta<0.) {
-                fPOIPtDiffQRe[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPtDiffQIm[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPtDiffMul[k][h]->Fill(dPt,pow(wPhiEta,k));
-                
-                fPOIPhiDiffQRe[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPhiDiffQIm[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPhiDiffMul[k][h]->Fill(dPhi,pow(wPhiEta,k));
-                
-                Double_t boundetagap = fabs(fFlowQCDeltaEta)-1.;
-                
-                if((dEta<0. && dEta>-0.4+boundetagap/2.) || (dEta<-0.4-boundetagap/2. && dEta>-0.8)) {
-                  Int_t keta;
-                  if(dEta<0. && dEta>-0.4+boundetagap/2.) keta = 0;
-                  else keta = 1;
-                  fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                  fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                  fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k));
-                }
-              } else {
-                bFillDis = kFALSE;
-                continue;
-              }
-              
+            Double_t boundetagap = fabs(fFlowQCDeltaEta);
+            
+            if((dEta>0. && dEta<0.4-boundetagap/2.) || (dEta>0.4+boundetagap/2. && dEta<0.8)) {
+              Int_t keta;
+              if(dEta>0. && dEta<0.4-boundetagap/2.) keta = 0;
+              else keta = 1;
+              fQvectorWorkspace->FillPt(AliFlowCRCQvectorWorkspace::kPtEG+keta,ptBin);
+            }
+          } else {
+            bFillDis = kFALSE;
+          }
+          
+        } else if(fFlowQCDeltaEta<-1. && fFlowQCDeltaEta>-2.) {
+          
+          if(dEta<0.) {
+            fQvectorWorkspace->FillPt(AliFlowCRCQvectorWorkspace::kPtAll,ptBin);
+            fQvectorWorkspace->FillPhi(AliFlowCRCQvectorWorkspace::kPhiAll,phiBin);
+            
+            Double_t boundetagap = fabs(fFlowQCDeltaEta)-1.;
+            
+            if((dEta<0. && dEta>-0.4+boundetagap/2.) || (dEta<-0.4-boundetagap/2. && dEta>-0.8)) {
+              Int_t keta;
+              if(dEta<0. && dEta>-0.4+boundetagap/2.) keta = 0;
+              else keta = 1;
+              fQvectorWorkspace->FillPt(AliFlowCRCQvectorWorkspace::kPtEG+keta,ptBin);
             }
+          } else {
+            bFillDis = kFALSE;
           }
+          
         }
         
         for (Int_t h=0;h<fFlowNHarmMax;h++) {
@@ -1368,6 +1339,18 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
   
 } // end of AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
 
+//================================================================================================================
+
+void AliFlowAnalysisCRC::Make(const AliFlowEventFlat *anEvent)
+{
+  // Same as Make(AliFlowEventSimple*) for a flat event. The CRC Q-vectors use the ZDC and VZERO
+  // Q-vectors and the vertex of AliFlowEventSimple, so the viewed event (or the one filled from the arrays) is used.
+
+  if(!anEvent){return;}
+  this->Make(anEvent->GetEventSimple());
+
+} // end of void AliFlowAnalysisCRC::Make(const AliFlowEventFlat *anEvent)
+
 //=======================================================================================================================
 
 void AliFlowAnalysisCRC::Finish()
@@ -17130,52 +17113,6 @@ void AliFlowAnalysisCRC::InitializeArraysForFlowGF()
 
 void AliFlowAnalysisCRC::InitializeArraysForFlowEbE()
 {
-  for (Int_t c=0;c<fQVecPower;c++) {
-    for (Int_t h=0;h<fFlowNHarmMax;h++) {
-      fPOIPtDiffQRe[c][h] = NULL;
-      fPOIPtDiffQIm[c][h] = NULL;
-      fPOIPtDiffMul[c][h] = NULL;
-      for(Int_t k=0;k<2;k++) {
-        fPOIPtDiffQReCh[k][c][h] = NULL;
-        fPOIPtDiffQImCh[k][c][h] = NULL;
-        fPOIPtDiffMulCh[k][c][h] = NULL;
-      }
-    }
-  }
-  for(Int_t k=0;k<2;k++) {
-    for(Int_t c=0;c<fQVecPower;c++) {
-      for (Int_t h=0;h<fFlowNHarmMax;h++) {
-        fPOIPtDiffQReEG[k][c][h] = NULL;
-        fPOIPtDiffQImEG[k][c][h] = NULL;
-        fPOIPtDiffMulEG[k][c][h] = NULL;
-      }
-    }
-  }
-  for (Int_t c=0;c<fQVecPower;c++) {
-    for (Int_t h=0;h<fFlowNHarmMax;h++) {
-      fPOIPhiDiffQRe[c][h] = NULL;
-      fPOIPhiDiffQIm[c][h] = NULL;
-      fPOIPhiDiffMul[c][h] = NULL;
-    }
-  }
-  for (Int_t k=0;k<fkNITStypes;k++) {
-    for (Int_t c=0;c<fQVecPower;c++) {
-      for (Int_t h=0;h<fFlowNHarmMax;h++) {
-        fPOIPhiEtaDiffQRe[k][c][h] = NULL;
-        fPOIPhiEtaDiffQIm[k][c][h] = NULL;
-        fPOIPhiEtaDiffMul[k][c][h] = NULL;
-      }
-    }
-  }
-  for(Int_t k=0;k<2;k++) {
-    for(Int_t c=0;c<fQVecPower;c++) {
-      for (Int_t h=0;h<fFlowNHarmMax;h++) {
-        fPOIPhiDiffQReEG[k][c][h] = NULL;
-        fPOIPhiDiffQImEG[k][c][h] = NULL;
-        fPOIPhiDiffMulEG[k][c][h] = NULL;
-      }
-    }
-  }
   for (Int_t c=0;c<2;c++) {
     for (Int_t h=0;h<fFlowNHarmMax;h++) {
       fEtaDiffQRe[c][h] = NULL;
@@ -18917,9 +18854,9 @@ void AliFlowAnalysisCRC::RecenterCRCQVec()
   for(Int_t h=0;h<fCRCnHar;h++) {
     Double_t Q2Re=0., Q2Im=0., QM=0.;
     for(Int_t pt=1; pt<=fPtDiffNBins; pt++) {
-      Q2Re += fPOIPtDiffQRe[1][h]->GetBinContent(pt);
-      Q2Im += fPOIPtDiffQIm[1][h]->GetBinContent(pt);
-      QM   += fPOIPtDiffMul[1][h]->GetBinContent(pt);
+      Q2Re += fQvectorWorkspace->PtDiffQRe(1,h,pt);
+      Q2Im += fQvectorWorkspace->PtDiffQIm(1,h,pt);
+      QM   += fQvectorWorkspace->PtDiffMul(1,h,pt);
     }
     
     if(QM>0) {
@@ -20772,14 +20709,14 @@ void AliFlowAnalysisCRC::CalculateCMETPC()
   Int_t hr=0;
   
   for(Int_t pt=0; pt<fPtDiffNBins; pt++) {
-    QARe += fPOIPtDiffQReEG[0][1][hr+1]->GetBinContent(pt+1);
-    QAIm += fPOIPtDiffQImEG[0][1][hr+1]->GetBinContent(pt+1);
-    QBRe += fPOIPtDiffQReEG[1][1][hr+1]->GetBinContent(pt+1);
-    QBIm += fPOIPtDiffQImEG[1][1][hr+1]->GetBinContent(pt+1);
-    QAM0 += fPOIPtDiffMulEG[0][0][0]->GetBinContent(pt+1);
-    QAM  += fPOIPtDiffMulEG[0][1][0]->GetBinContent(pt+1);
-    QBM0 += fPOIPtDiffMulEG[1][0][0]->GetBinContent(pt+1);
-    QBM  += fPOIPtDiffMulEG[1][1][0]->GetBinContent(pt+1);
+    QARe += fQvectorWorkspace->PtDiffQReEG(0,1,hr+1,pt+1);
+    QAIm += fQvectorWorkspace->PtDiffQImEG(0,1,hr+1,pt+1);
+    QBRe += fQvectorWorkspace->PtDiffQReEG(1,1,hr+1,pt+1);
+    QBIm += fQvectorWorkspace->PtDiffQImEG(1,1,hr+1,pt+1);
+    QAM0 += fQvectorWorkspace->PtDiffMulEG(0,0,0,pt+1);
+    QAM  += fQvectorWorkspace->PtDiffMulEG(0,1,0,pt+1);
+    QBM0 += fQvectorWorkspace->PtDiffMulEG(1,0,0,pt+1);
+    QBM  += fQvectorWorkspace->PtDiffMulEG(1,1,0,pt+1);
   }
   
   Double_t IQM2EG = QAM*QBM;
@@ -20967,15 +20904,15 @@ void AliFlowAnalysisCRC::CalculateFlowSCZDC()
   for(Int_t hsc=0; hsc<2; hsc++) {
     Double_t QARe=0., QAIm=0., QBRe=0., QBIm=0., QAM0=0., QAM=0., QBM0=0., QBM=0., AvPt=0.;
     for(Int_t pt=0; pt<fPtDiffNBins; pt++) {
-      QARe += fPOIPtDiffQReEG[0][1][hsc+1]->GetBinContent(pt+1);
-      QAIm += fPOIPtDiffQImEG[0][1][hsc+1]->GetBinContent(pt+1);
-      QBRe += fPOIPtDiffQReEG[1][1][hsc+1]->GetBinContent(pt+1);
-      QBIm += fPOIPtDiffQImEG[1][1][hsc+1]->GetBinContent(pt+1);
-      QAM0 += fPOIPtDiffMulEG[0][0][0]->GetBinContent(pt+1);
-      QAM  += fPOIPtDiffMulEG[0][1][0]->GetBinContent(pt+1);
-      QBM0 += fPOIPtDiffMulEG[1][0][0]->GetBinContent(pt+1);
-      QBM  += fPOIPtDiffMulEG[1][1][0]->GetBinContent(pt+1);
-      AvPt += fPOIPtDiffMulEG[0][1][0]->GetBinCenter(pt+1)*(fPOIPtDiffMulEG[0][1][0]->GetBinContent(pt+1)+fPOIPtDiffMulEG[1][1][0]->GetBinContent(pt+1));
+      QARe += fQvectorWorkspace->PtDiffQReEG(0,1,hsc+1,pt+1);
+      QAIm += fQvectorWorkspace->PtDiffQImEG(0,1,hsc+1,pt+1);
+      QBRe += fQvectorWorkspace->PtDiffQReEG(1,1,hsc+1,pt+1);
+      QBIm += fQvectorWorkspace->PtDiffQImEG(1,1,hsc+1,pt+1);
+      QAM0 += fQvectorWorkspace->PtDiffMulEG(0,0,0,pt+1);
+      QAM  += fQvectorWorkspace->PtDiffMulEG(0,1,0,pt+1);
+      QBM0 += fQvectorWorkspace->PtDiffMulEG(1,0,0,pt+1);
+      QBM  += fQvectorWorkspace->PtDiffMulEG(1,1,0,pt+1);
+      AvPt += fQvectorWorkspace->GetPtAxis()->GetBinCenter(pt+1)*(fQvectorWorkspace->PtDiffMulEG(0,1,0,pt+1)+fQvectorWorkspace->PtDiffMulEG(1,1,0,pt+1));
     }
     Double_t IQM2EG = QAM*QBM;
     if(QAM0+QBM0>1) {
@@ -21076,13 +21013,13 @@ void AliFlowAnalysisCRC::CalculateFlowSPZDC(Double_t ZCRe, Double_t ZCIm, Double
     
     // ZDC resolution correction
     if(dCnt==0) {
-      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(1),ZARe*ZCRe,fCenWeightEbE);
-      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(2),ZAIm*ZCIm,fCenWeightEbE);
-      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(3),ZARe*ZCIm,fCenWeightEbE);
-      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(4),ZAIm*ZCRe,fCenWeightEbE);
-      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(5),ZARe*ZCRe*ZAIm*ZCIm,fCenWeightEbE);
-      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(6),ZARe*ZCRe*ZAIm*ZCIm,fCenWeightEbE);
-      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(7),ZARe*ZCRe+ZAIm*ZCIm,fCenWeightEbE);
+      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(1),ZARe*ZCRe,fCenWeightEbE);
+      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(2),ZAIm*ZCIm,fCenWeightEbE);
+      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(3),ZARe*ZCIm,fCenWeightEbE);
+      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(4),ZAIm*ZCRe,fCenWeightEbE);
+      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(5),ZARe*ZCRe*ZAIm*ZCIm,fCenWeightEbE);
+      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(6),ZARe*ZCRe*ZAIm*ZCIm,fCenWeightEbE);
+      fFlowSPZDCCorPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(7),ZARe*ZCRe+ZAIm*ZCIm,fCenWeightEbE);
     }
     
     if(hr==0) {
@@ -21382,18 +21319,18 @@ void AliFlowAnalysisCRC::CalculateFlowQC()
     QRe=0.; QIm=0.; Q2Re2=0.; Q2Im2=0.; QRe3=0.; QIm3=0.; QM0=0.; QM=0.; QM2=0.; QM3=0.; QM4=0.;
     
     for(Int_t pt=0; pt<fPtDiffNBins; pt++) {
-      QRe += fPOIPtDiffQRe[1][hr+1]->GetBinContent(pt+1);
-      QIm += fPOIPtDiffQIm[1][hr+1]->GetBinContent(pt+1);
-      Q2Re2 += fPOIPtDiffQRe[2][2*hr+3]->GetBinContent(pt+1);
-      Q2Im2 += fPOIPtDiffQIm[2][2*hr+3]->GetBinContent(pt+1);
-      QRe3 += fPOIPtDiffQRe[3][hr+1]->GetBinContent(pt+1);
-      QIm3 += fPOIPtDiffQIm[3][hr+1]->GetBinContent(pt+1);
+      QRe += fQvectorWorkspace->PtDiffQRe(1,hr+1,pt+1);
+      QIm += fQvectorWorkspace->PtDiffQIm(1,hr+1,pt+1);
+      Q2Re2 += fQvectorWorkspace->PtDiffQRe(2,2*hr+3,pt+1);
+      Q2Im2 += fQvectorWorkspace->PtDiffQIm(2,2*hr+3,pt+1);
+      QRe3 += fQvectorWorkspace->PtDiffQRe(3,hr+1,pt+1);
+      QIm3 += fQvectorWorkspace->PtDiffQIm(3,hr+1,pt+1);
       
-      QM0 += fPOIPtDiffMul[0][0]->GetBinContent(pt+1);
-      QM  += fPOIPtDiffMul[1][0]->GetBinContent(pt+1);
-      QM2 += fPOIPtDiffMul[2][0]->GetBinContent(pt+1);
-      QM3 += fPOIPtDiffMul[3][0]->GetBinContent(pt+1);
-      QM4 += fPOIPtDiffMul[4][0]->GetBinContent(pt+1);
+      QM0 += fQvectorWorkspace->PtDiffMul(0,0,pt+1);
+      QM  += fQvectorWorkspace->PtDiffMul(1,0,pt+1);
+      QM2 += fQvectorWorkspace->PtDiffMul(2,0,pt+1);
+      QM3 += fQvectorWorkspace->PtDiffMul(3,0,pt+1);
+      QM4 += fQvectorWorkspace->PtDiffMul(4,0,pt+1);
     }
     
     IQM2 = QM*QM-QM2;
@@ -21499,18 +21436,18 @@ void AliFlowAnalysisCRC::CalculateFlowQC()
     Double_t QARe0=0., QAIm0=0., QBRe0=0., QBIm0=0.;
     
     for(Int_t pt=0; pt<fPtDiffNBins; pt++) {
-      QARe += fPOIPtDiffQReEG[0][1][hr+1]->GetBinContent(pt+1);
-      QAIm += fPOIPtDiffQImEG[0][1][hr+1]->GetBinContent(pt+1);
-      QBRe += fPOIPtDiffQReEG[1][1][hr+1]->GetBinContent(pt+1);
-      QBIm += fPOIPtDiffQImEG[1][1][hr+1]->GetBinContent(pt+1);
-      QAM0 += fPOIPtDiffMulEG[0][0][0]->GetBinContent(pt+1);
-      QAM  += fPOIPtDiffMulEG[0][1][0]->GetBinContent(pt+1);
-      QBM0 += fPOIPtDiffMulEG[1][0][0]->GetBinContent(pt+1);
-      QBM  += fPOIPtDiffMulEG[1][1][0]->GetBinContent(pt+1);
-      QARe0 += fPOIPtDiffQReEG[0][0][hr+1]->GetBinContent(pt+1);
-      QAIm0 += fPOIPtDiffQImEG[0][0][hr+1]->GetBinContent(pt+1);
-      QBRe0 += fPOIPtDiffQReEG[1][0][hr+1]->GetBinContent(pt+1);
-      QBIm0 += fPOIPtDiffQImEG[1][0][hr+1]->GetBinContent(pt+1);
+      QARe += fQvectorWorkspace->PtDiffQReEG(0,1,hr+1,pt+1);
+      QAIm += fQvectorWorkspace->PtDiffQImEG(0,1,hr+1,pt+1);
+      QBRe += fQvectorWorkspace->PtDiffQReEG(1,1,hr+1,pt+1);
+      QBIm += fQvectorWorkspace->PtDiffQImEG(1,1,hr+1,pt+1);
+      QAM0 += fQvectorWorkspace->PtDiffMulEG(0,0,0,pt+1);
+      QAM  += fQvectorWorkspace->PtDiffMulEG(0,1,0,pt+1);
+      QBM0 += fQvectorWorkspace->PtDiffMulEG(1,0,0,pt+1);
+      QBM  += fQvectorWorkspace->PtDiffMulEG(1,1,0,pt+1);
+      QARe0 += fQvectorWorkspace->PtDiffQReEG(0,0,hr+1,pt+1);
+      QAIm0 += fQvectorWorkspace->PtDiffQImEG(0,0,hr+1,pt+1);
+      QBRe0 += fQvectorWorkspace->PtDiffQReEG(1,0,hr+1,pt+1);
+      QBIm0 += fQvectorWorkspace->PtDiffQImEG(1,0,hr+1,pt+1);
     }
     
     IQM2EG = QAM*QBM;
@@ -21560,30 +21497,30 @@ void AliFlowAnalysisCRC::CalculateFlowQC()
     // pT-differential: {2}, {4}, {2,EG}
     for(Int_t pt=0; pt<fPtDiffNBins; pt++) {
       
-      FillPtBin = fPOIPtDiffQRe[0][0]->GetBinCenter(pt+1);
+      FillPtBin = fQvectorWorkspace->GetPtAxis()->GetBinCenter(pt+1);
       qpRe0=0.; qpIm0=0.; qpRe2=0.; qpIm2=0.; qp2Re=0.; qp2Im=0.; qpM0=0.; qpM=0.; qpM2=0.; qpM3=0.;
       qpRe=0.; qpIm=0.; qp2Re2=0.; qp2Im2=0.; qpRe3=0.; qpIm3=0.; qpM4=0.;
       
-      qpRe0 = fPOIPtDiffQRe[0][hr+1]->GetBinContent(pt+1);
-      qpIm0 = fPOIPtDiffQIm[0][hr+1]->GetBinContent(pt+1);
-      qpRe2 = fPOIPtDiffQRe[2][hr+1]->GetBinContent(pt+1);
-      qpIm2 = fPOIPtDiffQIm[2][hr+1]->GetBinContent(pt+1);
-      qp2Re = fPOIPtDiffQRe[1][2*hr+3]->GetBinContent(pt+1);
-      qp2Im = fPOIPtDiffQIm[1][2*hr+3]->GetBinContent(pt+1);
-      
-      qpM0 = fPOIPtDiffMul[0][0]->GetBinContent(pt+1);
-      qpM  = fPOIPtDiffMul[1][0]->GetBinContent(pt+1);
-      qpM2 = fPOIPtDiffMul[2][0]->GetBinContent(pt+1);
-      qpM3 = fPOIPtDiffMul[3][0]->GetBinContent(pt+1);
-      
-      qpRe = fPOIPtDiffQRe[1][hr+1]->GetBinContent(pt+1);
-      qpIm = fPOIPtDiffQIm[1][hr+1]->GetBinContent(pt+1);
-      qp2Re2 = fPOIPtDiffQRe[2][2*hr+3]->GetBinContent(pt+1);
-      qp2Im2 = fPOIPtDiffQIm[2][2*hr+3]->GetBinContent(pt+1);
-      qpRe3 = fPOIPtDiffQRe[3][hr+1]->GetBinContent(pt+1);
-      qpIm3 = fPOIPtDiffQIm[3][hr+1]->GetBinContent(pt+1);
-      
-      qpM4 = fPOIPtDiffMul[4][0]->GetBinContent(pt+1);
+      qpRe0 = fQvectorWorkspace->PtDiffQRe(0,hr+1,pt+1);
+      qpIm0 = fQvectorWorkspace->PtDiffQIm(0,hr+1,pt+1);
+      qpRe2 = fQvectorWorkspace->PtDiffQRe(2,hr+1,pt+1);
+      qpIm2 = fQvectorWorkspace->PtDiffQIm(2,hr+1,pt+1);
+      qp2Re = fQvectorWorkspace->PtDiffQRe(1,2*hr+3,pt+1);
+      qp2Im = fQvectorWorkspace->PtDiffQIm(1,2*hr+3,pt+1);
+      
+      qpM0 = fQvectorWorkspace->PtDiffMul(0,0,pt+1);
+      qpM  = fQvectorWorkspace->PtDiffMul(1,0,pt+1);
+      qpM2 = fQvectorWorkspace->PtDiffMul(2,0,pt+1);
+      qpM3 = fQvectorWorkspace->PtDiffMul(3,0,pt+1);
+      
+      qpRe = fQvectorWorkspace->PtDiffQRe(1,hr+1,pt+1);
+      qpIm = fQvectorWorkspace->PtDiffQIm(1,hr+1,pt+1);
+      qp2Re2 = fQvectorWorkspace->PtDiffQRe(2,2*hr+3,pt+1);
+      qp2Im2 = fQvectorWorkspace->PtDiffQIm(2,2*hr+3,pt+1);
+      qpRe3 = fQvectorWorkspace->PtDiffQRe(3,hr+1,pt+1);
+      qpIm3 = fQvectorWorkspace->PtDiffQIm(3,hr+1,pt+1);
+      
+      qpM4 = fQvectorWorkspace->PtDiffMul(4,0,pt+1);
      
       if(hr==0) {
        fFlowQCSpectra->Fill(fCentralityEBE,FillPtBin,qpM*fCenWeightEbE);
@@ -21664,14 +21601,14 @@ void AliFlowAnalysisCRC::CalculateFlowQC()
       if(Q4f && dQ4f) fFlowQCCorCovPro[fCenBin][hr][4]->Fill(FillPtBin,IQC4[hr]*dQC4,WQM4*WdQM4*fCenWeightEbE);
       
       // eta-gap
-      qpARe = fPOIPtDiffQReEG[0][1][hr+1]->GetBinContent(pt+1);
-      qpAIm = fPOIPtDiffQImEG[0][1][hr+1]->GetBinContent(pt+1);
-      qpAM  = fPOIPtDiffMulEG[0][1][0]->GetBinContent(pt+1);
-      qpBRe = fPOIPtDiffQReEG[1][1][hr+1]->GetBinContent(pt+1);
-      qpBIm = fPOIPtDiffQImEG[1][1][hr+1]->GetBinContent(pt+1);
-      qpBM  = fPOIPtDiffMulEG[1][1][0]->GetBinContent(pt+1);
-      qpAM0 = fPOIPtDiffMulEG[0][0][0]->GetBinContent(pt+1);
-      qpBM0 = fPOIPtDiffMulEG[1][0][0]->GetBinContent(pt+1);
+      qpARe = fQvectorWorkspace->PtDiffQReEG(0,1,hr+1,pt+1);
+      qpAIm = fQvectorWorkspace->PtDiffQImEG(0,1,hr+1,pt+1);
+      qpAM  = fQvectorWorkspace->PtDiffMulEG(0,1,0,pt+1);
+      qpBRe = fQvectorWorkspace->PtDiffQReEG(1,1,hr+1,pt+1);
+      qpBIm = fQvectorWorkspace->PtDiffQImEG(1,1,hr+1,pt+1);
+      qpBM  = fQvectorWorkspace->PtDiffMulEG(1,1,0,pt+1);
+      qpAM0 = fQvectorWorkspace->PtDiffMulEG(0,0,0,pt+1);
+      qpBM0 = fQvectorWorkspace->PtDiffMulEG(1,0,0,pt+1);
       
       // qA QB
       dQM2EG = qpAM*QBM;
@@ -21718,22 +21655,22 @@ void AliFlowAnalysisCRC::CalculateFlowQC()
     } // end of for(Int_t pt=0; pt<fCRCnPtBin; pt++)
     
     // phi-differential: {2,EG}
-    for(Int_t pt=0; pt<fPOIPhiDiffQRe[0][0]->GetNbinsX(); pt++) {
+    for(Int_t pt=0; pt<fQvectorWorkspace->GetPhiAxis()->GetNbins(); pt++) {
      
-      Double_t FillPhiBin = fPOIPhiDiffQRe[0][0]->GetBinCenter(pt+1);
+      Double_t FillPhiBin = fQvectorWorkspace->GetPhiAxis()->GetBinCenter(pt+1);
       qpRe0=0.; qpIm0=0.; qpRe2=0.; qpIm2=0.; qp2Re=0.; qp2Im=0.; qpM0=0.; qpM=0.; qpM2=0.; qpM3=0.;
       
-      qpRe0 = fPOIPhiDiffQRe[0][hr+1]->GetBinContent(pt+1);
-      qpIm0 = fPOIPhiDiffQIm[0][hr+1]->GetBinContent(pt+1);
-      qpRe2 = fPOIPhiDiffQRe[2][hr+1]->GetBinContent(pt+1);
-      qpIm2 = fPOIPhiDiffQIm[2][hr+1]->GetBinContent(pt+1);
-      qp2Re = fPOIPhiDiffQRe[1][2*hr+3]->GetBinContent(pt+1);
-      qp2Im = fPOIPhiDiffQIm[1][2*hr+3]->GetBinContent(pt+1);
+      qpRe0 = fQvectorWorkspace->PhiDiffQRe(0,hr+1,pt+1);
+      qpIm0 = fQvectorWorkspace->PhiDiffQIm(0,hr+1,pt+1);
+      qpRe2 = fQvectorWorkspace->PhiDiffQRe(2,hr+1,pt+1);
+      qpIm2 = fQvectorWorkspace->PhiDiffQIm(2,hr+1,pt+1);
+      qp2Re = fQvectorWorkspace->PhiDiffQRe(1,2*hr+3,pt+1);
+      qp2Im = fQvectorWorkspace->PhiDiffQIm(1,2*hr+3,pt+1);
       
-      qpM0 = fPOIPhiDiffMul[0][0]->GetBinContent(pt+1);
-      qpM  = fPOIPhiDiffMul[1][0]->GetBinContent(pt+1);
-      qpM2 = fPOIPhiDiffMul[2][0]->GetBinContent(pt+1);
-      qpM3 = fPOIPhiDiffMul[3][0]->GetBinContent(pt+1);
+      qpM0 = fQvectorWorkspace->PhiDiffMul(0,0,pt+1);
+      qpM  = fQvectorWorkspace->PhiDiffMul(1,0,pt+1);
+      qpM2 = fQvectorWorkspace->PhiDiffMul(2,0,pt+1);
+      qpM3 = fQvectorWorkspace->PhiDiffMul(3,0,pt+1);
       
       dQM2 = qpM0*QM-qpM;
       WdQM2 = (WeigMul? dQM2 : 1.);
@@ -21761,9 +21698,9 @@ void AliFlowAnalysisCRC::CalculateFlowQC()
       }
       
       // eta-gap
-      Double_t qpARe0 = fPOIPhiDiffQReEG[0][0][hr+1]->GetBinContent(pt+1);
-      Double_t qpAIm0 = fPOIPhiDiffQImEG[0][0][hr+1]->GetBinContent(pt+1);
-      Double_t qpAM0 = fPOIPhiDiffMulEG[0][0][0]->GetBinContent(pt+1);
+      Double_t qpARe0 = fQvectorWorkspace->PhiDiffQReEG(0,0,hr+1,pt+1);
+      Double_t qpAIm0 = fQvectorWorkspace->PhiDiffQImEG(0,0,hr+1,pt+1);
+      Double_t qpAM0 = fQvectorWorkspace->PhiDiffMulEG(0,0,0,pt+1);
       
       dQM2EG = qpAM0*QBM;
       WdQM2EG = (WeigMul? dQM2EG : 1.);
@@ -21775,25 +21712,25 @@ void AliFlowAnalysisCRC::CalculateFlowQC()
       qpARe0=0.; qpAIm0=0.; qpAM0=0.;
       
       
-    } // end of for(Int_t pt=0; pt<fPOIPhiDiffQRe[0][0]->GetNbinsX(); pt++)
+    } // end of for(Int_t pt=0; pt<fQvectorWorkspace->GetPhiAxis()->GetNbins(); pt++)
     
     // phi-eta-differential: {2}
-    for(Int_t pb=0; pb<fPOIPhiEtaDiffQRe[0][0][0]->GetNbinsX(); pb++) {
-      for(Int_t eb=0; eb<fPOIPhiEtaDiffQRe[0][0][0]->GetNbinsY(); eb++) {
+    for(Int_t pb=0; pb<fQvectorWorkspace->GetPhiAxis()->GetNbins(); pb++) {
+      for(Int_t eb=0; eb<fQvectorWorkspace->GetEtaAxis()->GetNbins(); eb++) {
         
-        Int_t peb = fPOIPhiEtaDiffQRe[0][0][0]->GetBin(pb+1,eb+1);
-        Double_t FillPhiBin = fPOIPhiEtaDiffQRe[0][0][0]->GetXaxis()->GetBinCenter(pb+1);
-        Double_t FillEtaBin = fPOIPhiEtaDiffQRe[0][0][0]->GetYaxis()->GetBinCenter(eb+1);
+        Int_t peb = fQvectorWorkspace->GetPhiEtaBin(pb+1,eb+1);
+        Double_t FillPhiBin = fQvectorWorkspace->GetPhiAxis()->GetBinCenter(pb+1);
+        Double_t FillEtaBin = fQvectorWorkspace->GetEtaAxis()->GetBinCenter(eb+1);
         Double_t qpReAny=0., qpImAny=0., qpMAny=0., qpRe0Any=0., qpIm0Any=0., qpM0Any=0.;
         
         for (Int_t k=0;k<fkNITStypes;k++) {
-          qpRe0 = fPOIPhiEtaDiffQRe[k][0][hr+1]->GetBinContent(peb);
-          qpIm0 = fPOIPhiEtaDiffQIm[k][0][hr+1]->GetBinContent(peb);
-          qpRe = fPOIPhiEtaDiffQRe[k][1][hr+1]->GetBinContent(peb);
-          qpIm = fPOIPhiEtaDiffQIm[k][1][hr+1]->GetBinContent(peb);
-          qpM0 = fPOIPhiEtaDiffMul[k][0][0]->GetBinContent(peb);
-          qpM  = fPOIPhiEtaDiffMul[k][1][0]->GetBinContent(peb);
-          qpM2 = fPOIPhiEtaDiffMul[k][2][0]->GetBinContent(peb);
+          qpRe0 = fQvectorWorkspace->PhiEtaDiffQRe(k,0,hr+1,peb);
+          qpIm0 = fQvectorWorkspace->PhiEtaDiffQIm(k,0,hr+1,peb);
+          qpRe = fQvectorWorkspace->PhiEtaDiffQRe(k,1,hr+1,peb);
+          qpIm = fQvectorWorkspace->PhiEtaDiffQIm(k,1,hr+1,peb);
+          qpM0 = fQvectorWorkspace->PhiEtaDiffMul(k,0,0,peb);
+          qpM  = fQvectorWorkspace->PhiEtaDiffMul(k,1,0,peb);
+          qpM2 = fQvectorWorkspace->PhiEtaDiffMul(k,2,0,peb);
           
           dQM2 = qpM0*QM-qpM;
           WdQM2 = (WeigMul? dQM2 : 1.);
@@ -21829,7 +21766,7 @@ void AliFlowAnalysisCRC::CalculateFlowQC()
         }
         
       }
-    } // end of for(Int_t pb=0; pb<fPOIPhiEtaDiffQRe[0][0]->GetNbinsX(); pb++)
+    } // end of for(Int_t pb=0; pb<fQvectorWorkspace->GetPhiAxis()->GetNbins(); pb++)
     
   } // end of for(Int_t hr=0; hr<fFlowNHarm; hr++)
   
@@ -21848,15 +21785,15 @@ void AliFlowAnalysisCRC::CalculateFlowQCHighOrders()
     Double_t dImQ1n=0., dImQ2n=0., dImQ3n=0., dImQ4n=0., dImQ5n=0., dImQ6n=0.;
     
     for(Int_t pt=0; pt<fPtDiffNBins; pt++) {
-      dReQ1n += fPOIPtDiffQRe[0][hr+1]->GetBinContent(pt+1);
-      dImQ1n += fPOIPtDiffQIm[0][hr+1]->GetBinContent(pt+1);
-      dReQ2n += fPOIPtDiffQRe[0][2*hr+3]->GetBinContent(pt+1);
-      dImQ2n += fPOIPtDiffQIm[0][2*hr+3]->GetBinContent(pt+1);
-      dReQ3n += fPOIPtDiffQRe[0][3*hr+5]->GetBinContent(pt+1);
-      dImQ3n += fPOIPtDiffQIm[0][3*hr+5]->GetBinContent(pt+1);
-      dReQ4n += fPOIPtDiffQRe[0][4*hr+7]->GetBinContent(pt+1);
-      dImQ4n += fPOIPtDiffQIm[0][4*hr+7]->GetBinContent(pt+1);
-      dMult  += fPOIPtDiffMul[0][0]->GetBinContent(pt+1);
+      dReQ1n += fQvectorWorkspace->PtDiffQRe(0,hr+1,pt+1);
+      dImQ1n += fQvectorWorkspace->PtDiffQIm(0,hr+1,pt+1);
+      dReQ2n += fQvectorWorkspace->PtDiffQRe(0,2*hr+3,pt+1);
+      dImQ2n += fQvectorWorkspace->PtDiffQIm(0,2*hr+3,pt+1);
+      dReQ3n += fQvectorWorkspace->PtDiffQRe(0,3*hr+5,pt+1);
+      dImQ3n += fQvectorWorkspace->PtDiffQIm(0,3*hr+5,pt+1);
+      dReQ4n += fQvectorWorkspace->PtDiffQRe(0,4*hr+7,pt+1);
+      dImQ4n += fQvectorWorkspace->PtDiffQIm(0,4*hr+7,pt+1);
+      dMult  += fQvectorWorkspace->PtDiffMul(0,0,pt+1);
     }
     
     // Real parts of expressions involving various combinations of Q-vectors which appears
@@ -22178,35 +22115,35 @@ void AliFlowAnalysisCRC::CalculateFlowSPVZ()
     Double_t FillPtBin = 0.;
     Double_t QRe=0., QIm=0., QMraw=0., QM=0.;
     for(Int_t pt=0; pt<fPtDiffNBins; pt++) {
-      QRe += fPOIPtDiffQRe[1][hr+1]->GetBinContent(pt+1);
-      QIm += fPOIPtDiffQIm[1][hr+1]->GetBinContent(pt+1);
-      QMraw += fPOIPtDiffMul[0][0]->GetBinContent(pt+1);
-      QM  += fPOIPtDiffMul[1][0]->GetBinContent(pt+1);
+      QRe += fQvectorWorkspace->PtDiffQRe(1,hr+1,pt+1);
+      QIm += fQvectorWorkspace->PtDiffQIm(1,hr+1,pt+1);
+      QMraw += fQvectorWorkspace->PtDiffMul(0,0,pt+1);
+      QM  += fQvectorWorkspace->PtDiffMul(1,0,pt+1);
     }
     
     if(QMraw>0) {
-      FillPtBin = fPOIPtDiffQRe[0][0]->GetBinCenter(1);
+      FillPtBin = fQvectorWorkspace->GetPtAxis()->GetBinCenter(1);
       fFlowSPVZCorPro[fCenBin][hr][0]->Fill(FillPtBin,VCRe*VARe+VCIm*VAIm,fCenWeightEbE);
-      FillPtBin = fPOIPtDiffQRe[0][0]->GetBinCenter(2);
+      FillPtBin = fQvectorWorkspace->GetPtAxis()->GetBinCenter(2);
       fFlowSPVZCorPro[fCenBin][hr][0]->Fill(FillPtBin,(QRe*VCRe+QIm*VCIm)/QM,QM*fCenWeightEbE);
-      FillPtBin = fPOIPtDiffQRe[0][0]->GetBinCenter(3);
+      FillPtBin = fQvectorWorkspace->GetPtAxis()->GetBinCenter(3);
       fFlowSPVZCorPro[fCenBin][hr][0]->Fill(FillPtBin,(QRe*VARe+QIm*VAIm)/QM,QM*fCenWeightEbE);
       
-      fFlowSPVZNUAPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(1),VCRe,fCenWeightEbE);
-      fFlowSPVZNUAPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(2),VARe,fCenWeightEbE);
-      fFlowSPVZNUAPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(3),VCIm,fCenWeightEbE);
-      fFlowSPVZNUAPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(4),VAIm,fCenWeightEbE);
-      fFlowSPVZNUAPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(5),QRe/QM,QM*fCenWeightEbE);
-      fFlowSPVZNUAPro[fCenBin][hr][0]->Fill(fPOIPtDiffQRe[0][0]->GetBinCenter(6),QIm/QM,QM*fCenWeightEbE);
+      fFlowSPVZNUAPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(1),VCRe,fCenWeightEbE);
+      fFlowSPVZNUAPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(2),VARe,fCenWeightEbE);
+      fFlowSPVZNUAPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(3),VCIm,fCenWeightEbE);
+      fFlowSPVZNUAPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(4),VAIm,fCenWeightEbE);
+      fFlowSPVZNUAPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(5),QRe/QM,QM*fCenWeightEbE);
+      fFlowSPVZNUAPro[fCenBin][hr][0]->Fill(fQvectorWorkspace->GetPtAxis()->GetBinCenter(6),QIm/QM,QM*fCenWeightEbE);
     }
     
     for(Int_t pt=0; pt<fPtDiffNBins; pt++) {
       
-      FillPtBin = fPOIPtDiffQRe[0][0]->GetBinCenter(pt+1);
-      Double_t qpRe = fPOIPtDiffQRe[1][hr+1]->GetBinContent(pt+1);
-      Double_t qpIm = fPOIPtDiffQIm[1][hr+1]->GetBinContent(pt+1);
-      Double_t qpMraw = fPOIPtDiffMul[0][0]->GetBinContent(pt+1);
-      Double_t qpM  = fPOIPtDiffMul[1][0]->GetBinContent(pt+1);
+      FillPtBin = fQvectorWorkspace->GetPtAxis()->GetBinCenter(pt+1);
+      Double_t qpRe = fQvectorWorkspace->PtDiffQRe(1,hr+1,pt+1);
+      Double_t qpIm = fQvectorWorkspace->PtDiffQIm(1,hr+1,pt+1);
+      Double_t qpMraw = fQvectorWorkspace->PtDiffMul(0,0,pt+1);
+      Double_t qpM  = fQvectorWorkspace->PtDiffMul(1,0,pt+1);
       
       if(qpMraw>0) {
         // Normalize TPC Q-vector
@@ -31273,70 +31210,8 @@ void AliFlowAnalysisCRC::BookEverythingForFlowSPZDC()
 void AliFlowAnalysisCRC::BookEverythingForFlowEbE()
 {
   // EbE quantities
-  for (Int_t c=0;c<fQVecPower;c++) {
-    for (Int_t h=0;h<fFlowNHarmMax;h++) {
-      fPOIPtDiffQRe[c][h] = new TH1D(Form("fPOIPtDiffQRe[%d][%d]",c,h),Form("fPOIPtDiffQRe[%d][%d]",c,h),fPtDiffNBins,fCRCPtBins);
-      fTempList->Add(fPOIPtDiffQRe[c][h]);
-      fPOIPtDiffQIm[c][h] = new TH1D(Form("fPOIPtDiffQIm[%d][%d]",c,h),Form("fPOIPtDiffQIm[%d][%d]",c,h),fPtDiffNBins,fCRCPtBins);
-      fTempList->Add(fPOIPtDiffQIm[c][h]);
-      fPOIPtDiffMul[c][h] = new TH1D(Form("fPOIPtDiffMul[%d][%d]",c,h),Form("fPOIPtDiffMul[%d][%d]",c,h),fPtDiffNBins,fCRCPtBins);
-      fTempList->Add(fPOIPtDiffMul[c][h]);
-      for (Int_t k=0; k<2; k++) {
-        fPOIPtDiffQReCh[k][c][h] = new TH1D(Form("fPOIPtDiffQRe[%d][%d][%d]",k,c,h),Form("fPOIPtDiffQRe[%d][%d][%d]",k,c,h),fPtDiffNBins,fCRCPtBins);
-        fTempList->Add(fPOIPtDiffQReCh[k][c][h]);
-        fPOIPtDiffQImCh[k][c][h] = new TH1D(Form("fPOIPtDiffQIm[%d][%d][%d]",k,c,h),Form("fPOIPtDiffQIm[%d][%d][%d]",k,c,h),fPtDiffNBins,fCRCPtBins);
-        fTempList->Add(fPOIPtDiffQImCh[k][c][h]);
-        fPOIPtDiffMulCh[k][c][h] = new TH1D(Form("fPOIPtDiffMul[%d][%d][%d]",k,c,h),Form("fPOIPtDiffMul[%d][%d][%d]",k,c,h),fPtDiffNBins,fCRCPtBins);
-        fTempList->Add(fPOIPtDiffMulCh[k][c][h]);
-      }
-    }
-  }
-  for (Int_t k=0; k<2; k++) {
-    for (Int_t c=0;c<fQVecPower;c++) {
-      for (Int_t h=0;h<fFlowNHarmMax;h++) {
-        fPOIPtDiffQReEG[k][c][h] = new TH1D(Form("fPOIPtDiffQReEG[%d][%d][%d]",k,c,h),Form("fPOIPtDiffQReEG[%d][%d][%d]",k,c,h),fPtDiffNBins,fCRCPtBins);
-        fTempList->Add(fPOIPtDiffQReEG[k][c][h]);
-        fPOIPtDiffQImEG[k][c][h] = new TH1D(Form("fPOIPtDiffQImEG[%d][%d][%d]",k,c,h),Form("fPOIPtDiffQImEG[%d][%d][%d]",k,c,h),fPtDiffNBins,fCRCPtBins);
-        fTempList->Add(fPOIPtDiffQImEG[k][c][h]);
-        fPOIPtDiffMulEG[k][c][h] = new TH1D(Form("fPOIPtDiffMulEG[%d][%d][%d]",k,c,h),Form("fPOIPtDiffMulEG[%d][%d][%d]",k,c,h),fPtDiffNBins,fCRCPtBins);
-        fTempList->Add(fPOIPtDiffMulEG[k][c][h]);
-      }
-    }
-  }
-  for (Int_t c=0;c<fQVecPower;c++) {
-    for (Int_t h=0;h<fFlowNHarmMax;h++) {
-      fPOIPhiDiffQRe[c][h] = new TH1D(Form("fPOIPhiDiffQRe[%d][%d]",c,h),Form("fPOIPhiDiffQRe[%d][%d]",c,h),100,0.,TMath::TwoPi());
-      fTempList->Add(fPOIPhiDiffQRe[c][h]);
-      fPOIPhiDiffQIm[c][h] = new TH1D(Form("fPOIPhiDiffQIm[%d][%d]",c,h),Form("fPOIPhiDiffQIm[%d][%d]",c,h),100,0.,TMath::TwoPi());
-      fTempList->Add(fPOIPhiDiffQIm[c][h]);
-      fPOIPhiDiffMul[c][h] = new TH1D(Form("fPOIPhiDiffMul[%d][%d]",c,h),Form("fPOIPhiDiffMul[%d][%d]",c,h),100,0.,TMath::TwoPi());
-      fTempList->Add(fPOIPhiDiffMul[c][h]);
-    }
-  }
-  for (Int_t k=0;k<fkNITStypes;k++) {
-    for (Int_t c=0;c<fQVecPower;c++) {
-      for (Int_t h=0;h<fFlowNHarmMax;h++) {
-        fPOIPhiEtaDiffQRe[k][c][h] = new TH2D(Form("fPOIPhiEtaDiffQRe[%d][%d][%d]",k,c,h),Form("fPOIPhiEtaDiffQRe[%d][%d][%d]",k,c,h),100,0.,TMath::TwoPi(),32,-0.8,0.8);
-        fTempList->Add(fPOIPhiEtaDiffQRe[k][c][h]);
-        fPOIPhiEtaDiffQIm[k][c][h] = new TH2D(Form("fPOIPhiEtaDiffQIm[%d][%d][%d]",k,c,h),Form("fPOIPhiEtaDiffQIm[%d][%d][%d]",k,c,h),100,0.,TMath::TwoPi(),32,-0.8,0.8);
-        fTempList->Add(fPOIPhiEtaDiffQIm[k][c][h]);
-        fPOIPhiEtaDiffMul[k][c][h] = new TH2D(Form("fPOIPhiEtaDiffMul[%d][%d][%d]",k,c,h),Form("fPOIPhiEtaDiffMul[%d][%d][%d]",k,c,h),100,0.,TMath::TwoPi(),32,-0.8,0.8);
-        fTempList->Add(fPOIPhiEtaDiffMul[k][c][h]);
-      }
-    }
-  }
-  for (Int_t k=0; k<2; k++) {
-    for (Int_t c=0;c<fQVecPower;c++) {
-      for (Int_t h=0;h<fFlowNHarmMax;h++) {
-        fPOIPhiDiffQReEG[k][c][h] = new TH1D(Form("fPOIPhiDiffQReEG[%d][%d][%d]",k,c,h),Form("fPOIPhiDiffQReEG[%d][%d][%d]",k,c,h),100,0.,TMath::TwoPi());
-        fTempList->Add(fPOIPhiDiffQReEG[k][c][h]);
-        fPOIPhiDiffQImEG[k][c][h] = new TH1D(Form("fPOIPhiDiffQImEG[%d][%d][%d]",k,c,h),Form("fPOIPhiDiffQImEG[%d][%d][%d]",k,c,h),100,0.,TMath::TwoPi());
-        fTempList->Add(fPOIPhiDiffQImEG[k][c][h]);
-        fPOIPhiDiffMulEG[k][c][h] = new TH1D(Form("fPOIPhiDiffMulEG[%d][%d][%d]",k,c,h),Form("fPOIPhiDiffMulEG[%d][%d][%d]",k,c,h),100,0.,TMath::TwoPi());
-        fTempList->Add(fPOIPhiDiffMulEG[k][c][h]);
-      }
-    }
-  }
+  // POI Q-vectors vs pt, phi and (phi,eta), [power][harmonic] per bin
+  fQvectorWorkspace = new AliFlowCRCQvectorWorkspace(fQVecPower,fFlowNHarmMax,fPtDiffNBins,fCRCPtBins,100,32,-0.8,0.8,fkNITStypes);
   for (Int_t c=0;c<2;c++) {
     for (Int_t h=0;h<fFlowNHarmMax;h++) {
       fEtaDiffQRe[c][h] = new TH1D(Form("fEtaDiffQRe[%d][%d]",c,h),Form("fEtaDiffQRe[%d][%d]",c,h),fkEtaDiffMaxNBins,fCRCEtaMin,fCRCEtaMax);
@@ -33090,52 +32965,7 @@ void AliFlowAnalysisCRC::ResetEventByEventQuantities()
     }
   }
   // FlowSPZDC
-  for(Int_t c=0;c<fQVecPower;c++) {
-    for (Int_t h=0;h<fFlowNHarmMax;h++) {
-      if(fPOIPtDiffQRe[c][h]) fPOIPtDiffQRe[c][h]->Reset();
-      if(fPOIPtDiffQIm[c][h]) fPOIPtDiffQIm[c][h]->Reset();
-      if(fPOIPtDiffMul[c][h]) fPOIPtDiffMul[c][h]->Reset();
-      for(Int_t k=0;k<2;k++) {
-        if(fPOIPtDiffQReCh[k][c][h]) fPOIPtDiffQReCh[k][c][h]->Reset();
-        if(fPOIPtDiffQImCh[k][c][h]) fPOIPtDiffQImCh[k][c][h]->Reset();
-        if(fPOIPtDiffMulCh[k][c][h]) fPOIPtDiffMulCh[k][c][h]->Reset();
-      }
-    }
-  }
-  for(Int_t k=0;k<2;k++) {
-    for(Int_t c=0;c<fQVecPower;c++) {
-      for (Int_t h=0;h<fFlowNHarmMax;h++) {
-        if(fPOIPtDiffQReEG[k][c][h]) fPOIPtDiffQReEG[k][c][h]->Reset();
-        if(fPOIPtDiffQImEG[k][c][h]) fPOIPtDiffQImEG[k][c][h]->Reset();
-        if(fPOIPtDiffMulEG[k][c][h]) fPOIPtDiffMulEG[k][c][h]->Reset();
-      }
-    }
-  }
-  for(Int_t c=0;c<fQVecPower;c++) {
-    for (Int_t h=0;h<fFlowNHarmMax;h++) {
-      if(fPOIPhiDiffQRe[c][h]) fPOIPhiDiffQRe[c][h]->Reset();
-      if(fPOIPhiDiffQIm[c][h]) fPOIPhiDiffQIm[c][h]->Reset();
-      if(fPOIPhiDiffMul[c][h]) fPOIPhiDiffMul[c][h]->Reset();
-    }
-  }
-  for (Int_t k=0;k<fkNITStypes;k++) {
-    for(Int_t c=0;c<fQVecPower;c++) {
-      for (Int_t h=0;h<fFlowNHarmMax;h++) {
-        if(fPOIPhiEtaDiffQRe[k][c][h]) fPOIPhiEtaDiffQRe[k][c][h]->Reset();
-        if(fPOIPhiEtaDiffQIm[k][c][h]) fPOIPhiEtaDiffQIm[k][c][h]->Reset();
-        if(fPOIPhiEtaDiffMul[k][c][h]) fPOIPhiEtaDiffMul[k][c][h]->Reset();
-      }
-    }
-  }
-  for(Int_t k=0;k<2;k++) {
-    for(Int_t c=0;c<fQVecPower;c++) {
-      for (Int_t h=0;h<fFlowNHarmMax;h++) {
-        if(fPOIPhiDiffQReEG[k][c][h]) fPOIPhiDiffQReEG[k][c][h]->Reset();
-        if(fPOIPhiDiffQImEG[k][c][h]) fPOIPhiDiffQImEG[k][c][h]->Reset();
-        if(fPOIPhiDiffMulEG[k][c][h]) fPOIPhiDiffMulEG[k][c][h]->Reset();
-      }
-    }
-  }
+  if(fQvectorWorkspace) fQvectorWorkspace->Clear();
   for (Int_t c=0;c<2;c++) {
     for (Int_t h=0;h<fFlowNHarmMax;h++) {
       if(fEtaDiffQRe[c][h]) fEtaDiffQRe[c][h]->Reset();
@@ -23,6 +23,7 @@
 // aliroot includes
 #include "AliFlowCommonConstants.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventFlat.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowCommonHist.h"
 #include "AliFlowCommonHistResults.h"
@@ -76,6 +77,13 @@ void AliFlowAnalysisTemplate::Make(AliFlowEventSimple* anEvent)
   printf("Numer of POIs %i", anEvent->NumberOfTracks());
 }
 //_____________________________________________________________________________
+void AliFlowAnalysisTemplate::Make(const AliFlowEventFlat *anEvent)
+{
+  // core method for a flat event, run on AliFlowEventFlat::GetEventSimple()
+  if (!anEvent) return;
+  this->Make(anEvent->GetEventSimple());
+}
+//_____________________________________________________________________________
 void AliFlowAnalysisTemplate::GetOutputHistograms(TList *outputListHistos)
 {
     //get pointers to all output histograms (called before Finish())
@@ -18,6 +18,7 @@ class TDirectoryFile;
 // forward declarations ALIROOT
 class AliFlowTrackSimple;
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
 
@@ -31,6 +32,7 @@ class AliFlowAnalysisTemplate {
         virtual  ~AliFlowAnalysisTemplate();
         void Init();
         void Make(AliFlowEventSimple* anEvent);
+        void Make(const AliFlowEventFlat *anEvent);
         void GetOutputHistograms(TList *outputListHistos);
         void Finish();
         void WriteHistograms(TDirectoryFile *outputFileName) const;
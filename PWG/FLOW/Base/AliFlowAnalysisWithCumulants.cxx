@@ -43,6 +43,7 @@
 #include "AliFlowCommonHist.h"
 #include "AliFlowCommonHistResults.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventFlat.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisWithCumulants.h"
 #include "AliFlowVector.h"
@@ -212,6 +213,18 @@ void AliFlowAnalysisWithCumulants::Make(AliFlowEventSimple* anEvent)
 
 //================================================================================================================
 
+void AliFlowAnalysisWithCumulants::Make(const AliFlowEventFlat *anEvent)
+{
+ // Same as Make(AliFlowEventSimple*) for a flat event. The generating functions are built from the
+ // tracks of AliFlowEventSimple, taken from AliFlowEventFlat::GetEventSimple() (no copy for a viewed event).
+
+ if(!anEvent){return;}
+ this->Make(anEvent->GetEventSimple());
+
+} // end of void AliFlowAnalysisWithCumulants::Make(const AliFlowEventFlat *anEvent)
+
+//================================================================================================================
+
 void AliFlowAnalysisWithCumulants::Finish()
 {
  // Calculate the final results.
@@ -30,6 +30,7 @@ class TProfile3D;
 class TDirectoryFile;
 
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowTrackSimple;
 class AliFlowCommonConstants; 
 class AliFlowCommonHist;
@@ -60,6 +61,7 @@ class AliFlowAnalysisWithCumulants{
     virtual void BookEverythingForCalculationVsMultiplicity(); 
   // 2.) Method Make() and methods called within Make():
   virtual void Make(AliFlowEventSimple* anEvent);
+  virtual void Make(const AliFlowEventFlat *anEvent);
      virtual void CheckPointersUsedInMake(); 
      virtual void FillGeneratingFunctionForReferenceFlow(AliFlowEventSimple *anEvent);
      virtual void FillQvectorComponents(AliFlowEventSimple *anEvent);    
@@ -38,6 +38,7 @@
 #include "TParticle.h"
 #include "TProfile.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventFlat.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisWithFittingQDistribution.h"
 
@@ -273,6 +274,18 @@ void AliFlowAnalysisWithFittingQDistribution::Make(AliFlowEventSimple* anEvent)
 
 //================================================================================================================
 
+void AliFlowAnalysisWithFittingQDistribution::Make(const AliFlowEventFlat *anEvent)
+{
+ // Same as Make(AliFlowEventSimple*) for a flat event. The q-distribution uses AliFlowEventSimple::GetQ(),
+ // hence the event from AliFlowEventFlat::GetEventSimple() is used.
+
+ if(!anEvent){return;}
+ this->Make(anEvent->GetEventSimple());
+
+} // end of void AliFlowAnalysisWithFittingQDistribution::Make(const AliFlowEventFlat *anEvent)
+
+//================================================================================================================
+
 void AliFlowAnalysisWithFittingQDistribution::Finish(Bool_t doFit)
 {
  // Calculate the final results.
@@ -32,6 +32,7 @@ class TProfile;
 class TF1;
 
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowTrackSimple;
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
@@ -55,6 +56,7 @@ class AliFlowAnalysisWithFittingQDistribution{
    virtual void AccessFittingParameters();
   // 2.) method Make() and methods called within Make(): 
   virtual void Make(AliFlowEventSimple* anEvent);
+  virtual void Make(const AliFlowEventFlat *anEvent);
    virtual void CheckPointersUsedInMake();
   // 3.) method Finish() and methods called within Finish(): 
   virtual void Finish(Bool_t doFit = kTRUE);
@@ -36,6 +36,7 @@ $Log$
 #include "AliFlowLYZConstants.h"    //needed as include
 #include "AliFlowCommonConstants.h" //needed as include
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventFlat.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowCommonHist.h"
 #include "AliFlowCommonHistResults.h"
@@ -323,6 +324,15 @@ void AliFlowAnalysisWithLYZEventPlane::Make(AliFlowEventSimple* anEvent, AliFlow
     //    cout<<"@@@@@ "<<fEventNumber<<" events processed"<<endl;
   }
 }
+ 
+//-----------------------------------------------------------------------
+ 
+void AliFlowAnalysisWithLYZEventPlane::Make(const AliFlowEventFlat *anEvent, AliFlowLYZEventPlane* aLYZEP) {
+  // Same for a flat event: the event plane of AliFlowLYZEventPlane is calculated from an
+  // AliFlowEventSimple, taken from AliFlowEventFlat::GetEventSimple()
+  if (!anEvent) return;
+  this->Make(anEvent->GetEventSimple(), aLYZEP);
+}
 
   //--------------------------------------------------------------------    
 void AliFlowAnalysisWithLYZEventPlane::GetOutputHistograms(TList *outputListHistos){
@@ -12,6 +12,7 @@
 #define ALIFLOWANALYSISWITHLYZEVENTPLANE_H
 
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
 class AliFlowLYZEventPlane;
@@ -30,6 +31,7 @@ class AliFlowAnalysisWithLYZEventPlane {
   
   virtual void   Init();
   virtual void   Make(AliFlowEventSimple* fEvent, AliFlowLYZEventPlane* fLYZEP);
+  virtual void   Make(const AliFlowEventFlat *anEvent, AliFlowLYZEventPlane* fLYZEP);
   virtual void   GetOutputHistograms(TList *outputListHistos); //get pointers to all output histograms (called before Finish()) 
   virtual void   Finish();
   void           WriteHistograms(TString* outputFileName);
@@ -43,6 +43,7 @@
 #include "AliFlowCommonHist.h"
 #include "AliFlowCommonHistResults.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventFlat.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowVector.h"
 
@@ -380,6 +381,16 @@ Bool_t AliFlowAnalysisWithLeeYangZeros::Make(AliFlowEventSimple* anEvent)
      
   return kTRUE; 
 }
+ 
+//-----------------------------------------------------------------------
+ 
+Bool_t AliFlowAnalysisWithLeeYangZeros::Make(const AliFlowEventFlat *anEvent)
+{
+  //make method for a flat event: the generating functions use AliFlowEventSimple::GetQ(),
+  //so the event from AliFlowEventFlat::GetEventSimple() is used
+  if (!anEvent) return kFALSE;
+  return this->Make(anEvent->GetEventSimple());
+}
 
    //-----------------------------------------------------------------------     
 void AliFlowAnalysisWithLeeYangZeros::GetOutputHistograms(TList *outputListHistos) {
@@ -25,6 +25,7 @@ class TVector2;
  
 class AliFlowVector;
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowLYZHist1; 
 class AliFlowLYZHist2;
 class AliFlowCommonHist;
@@ -39,6 +40,7 @@ class AliFlowAnalysisWithLeeYangZeros {
  
    Bool_t    Init();                                          //defines variables and histograms
    Bool_t    Make(AliFlowEventSimple* anEvent);               //calculates variables and fills histograms
+   Bool_t    Make(const AliFlowEventFlat *anEvent);           //same for a flat event (AliFlowEventFlat)
    void      GetOutputHistograms(TList *outputListHistos);    //get pointers to all output histograms (called before Finish()) 
    Bool_t    Finish();                                        //saves histograms
    void      WriteHistograms(TString* outputFileName);        //writes histograms locally
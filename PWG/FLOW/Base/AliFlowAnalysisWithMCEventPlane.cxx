@@ -31,6 +31,7 @@
 
 #include "AliFlowCommonConstants.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventFlat.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowCommonHist.h"
 #include "AliFlowCommonHistResults.h"
@@ -303,6 +304,15 @@ void AliFlowAnalysisWithMCEventPlane::Make(AliFlowEventSimple* anEvent) {
     if(fEvaluateMixedHarmonics) EvaluateMixedHarmonics(anEvent);
   }    
 }
+ 
+//-----------------------------------------------------------------------
+ 
+void AliFlowAnalysisWithMCEventPlane::Make(const AliFlowEventFlat *anEvent) {
+  //Calculate v2 from the MC reaction plane for a flat event,
+  //using AliFlowEventFlat::GetEventSimple() for the event plane resolution from GetQ()
+  if (!anEvent) return;
+  this->Make(anEvent->GetEventSimple());
+}
   //--------------------------------------------------------------------    
 
 void AliFlowAnalysisWithMCEventPlane::GetOutputHistograms(TList *outputListHistos) {
@@ -15,6 +15,7 @@ class TDirectoryFile;
 
 class AliFlowTrackSimple;
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
 
@@ -42,6 +43,7 @@ class AliFlowAnalysisWithMCEventPlane {
    void      WriteHistograms(TDirectoryFile *outputFileName);
    void      Init();                                       //defines variables and histograms
    void      Make(AliFlowEventSimple* anEvent);            //calculates variables and fills histograms
+   void      Make(const AliFlowEventFlat *anEvent);        //same for a flat event (AliFlowEventFlat)
    void      GetOutputHistograms(TList *outputListHistos); //get pointers to all output histograms (called before Finish()) 
    void      Finish();                                     //saves histograms
    
@@ -42,6 +42,7 @@
 #include "TProfile2D.h"
 
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventFlat.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisWithMixedHarmonics.h"
 
@@ -438,6 +439,18 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
 
 //================================================================================================================
 
+void AliFlowAnalysisWithMixedHarmonics::Make(const AliFlowEventFlat *anEvent)
+{
+ // Same as Make(AliFlowEventSimple*) for a flat event. The multi-particle correlators are built from
+ // the tracks of AliFlowEventSimple, taken from AliFlowEventFlat::GetEventSimple().
+
+ if(!anEvent){return;}
+ this->Make(anEvent->GetEventSimple());
+
+} // end of void AliFlowAnalysisWithMixedHarmonics::Make(const AliFlowEventFlat *anEvent)
+
+//================================================================================================================
+
 void AliFlowAnalysisWithMixedHarmonics::Finish()
 {
  // Calculate the final results.
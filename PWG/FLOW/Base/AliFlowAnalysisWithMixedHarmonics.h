@@ -32,6 +32,7 @@ class TProfile;
 class TProfile2D;
 
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowCommonConstants;
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
@@ -63,6 +64,7 @@ class AliFlowAnalysisWithMixedHarmonics
   
   // 2.) Method Make() and methods called within Make():
   virtual void Make(AliFlowEventSimple *anEvent);
+  virtual void Make(const AliFlowEventFlat *anEvent);
   virtual void CheckPointersUsedInMake();
   virtual void Calculate3pCorrelator();
   virtual void Calculate5pCorrelator();
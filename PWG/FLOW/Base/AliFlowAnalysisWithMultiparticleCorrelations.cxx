@@ -24,6 +24,7 @@
 #define AliFlowAnalysisWithMultiparticleCorrelations_cxx
 
 #include "AliFlowAnalysisWithMultiparticleCorrelations.h"
+#include "AliFlowCorrelatorEngine.h"
 
 using std::endl;
 using std::cout;
@@ -80,6 +81,8 @@ AliFlowAnalysisWithMultiparticleCorrelations::AliFlowAnalysisWithMultiparticleCo
  fCalculateOnlyForSC(kFALSE),
  fCalculateOnlyCos(kFALSE),
  fCalculateOnlySin(kFALSE),
+ fUseCorrelatorEngine(kFALSE),
+ fCorrelatorEngine(NULL),
  // 4.) Event-by-event cumulants:
  fEbECumulantsList(NULL),
  fEbECumulantsFlagsPro(NULL),
@@ -169,6 +172,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleC
  // Destructor.
  
  delete fHistList;
+ delete fCorrelatorEngine;
 
 } // end of AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleCorrelations()
 
@@ -182,6 +186,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::Init()
  // b) Cross-check the initial settings before starting this adventure;
  // c) Book all objects;
  // d) Set all flags;
+ // e) Prepare the evaluation of all booked correlations in one go;
  // *) Trick to avoid name clashes, part 2. 
 
  // a) Trick to avoid name clashes, part 1: 
@@ -209,6 +214,9 @@ void AliFlowAnalysisWithMultiparticleCorrelations::Init()
  // d) Set all flags:
  // ... 
 
+ // e) Prepare the evaluation of all booked correlations in one go:
+ if(fUseCorrelatorEngine){this->BookEverythingForCorrelatorEngine();}
+
  // *) Trick to avoid name clashes, part 2:
  TH1::AddDirectory(oldHistAddStatus);
 
@@ -305,6 +313,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::Make(AliFlowEventSimple *anEv
  
  // e) Fill Q-vector components:
  if(fCalculateQvector||fCalculateDiffQvectors){this->FillQvector(anEvent);}
+ if(fCalculateQvector && fCorrelatorEngine){fCorrelatorEngine->Evaluate(&fQvector[0][0],49,9);}
 
  // f) Calculate multi-particle correlations from Q-vector components:
  if(fCalculateCorrelations){this->CalculateCorrelations(anEvent);}
@@ -334,6 +343,18 @@ void AliFlowAnalysisWithMultiparticleCorrelations::Make(AliFlowEventSimple *anEv
 
 } // end of AliFlowAnalysisWithMultiparticleCorrelations::Make(AliFlowEventSimple *anEvent)
 
+//================================================================================================================
+
+void AliFlowAnalysisWithMultiparticleCorrelations::Make(const AliFlowEventFlat *anEvent)
+{
+ // Same as Make(AliFlowEventSimple*) for a flat event. The Q-vectors and the control histograms are
+ // filled from the tracks of AliFlowEventSimple, taken from AliFlowEventFlat::GetEventSimple().
+
+ if(!anEvent){return;}
+ this->Make(anEvent->GetEventSimple());
+
+} // end of void AliFlowAnalysisWithMultiparticleCorrelations::Make(const AliFlowEventFlat *anEvent)
+
 //=======================================================================================================================
 
 void AliFlowAnalysisWithMultiparticleCorrelations::Finish()
@@ -751,10 +772,20 @@ void AliFlowAnalysisWithMultiparticleCorrelations::CalculateCorrelations(AliFlow
    else{continue;}
    for(Int_t b=1;b<=nBins;b++)
    {
-    TString sBinLabel = fCorrelationsPro[cs][co]->GetXaxis()->GetBinLabel(b);
-    if(sBinLabel.EqualTo("")){break;} 
-    Double_t num = CastStringToCorrelation(sBinLabel.Data(),kTRUE);
-    Double_t den = CastStringToCorrelation(sBinLabel.Data(),kFALSE);
+    Double_t num = 0., den = 0.;
+    if(fCorrelatorEngine && fCorrelationsEntries[cs][co].GetSize() == nBins)
+    {
+     Int_t e = fCorrelationsEntries[cs][co][b-1];
+     if(e<0){break;}
+     num = fCorrelatorEngine->GetNumerator(e);
+     den = fCorrelatorEngine->GetDenominator(e);
+    } else
+      {
+       TString sBinLabel = fCorrelationsPro[cs][co]->GetXaxis()->GetBinLabel(b);
+       if(sBinLabel.EqualTo("")){break;} 
+       num = CastStringToCorrelation(sBinLabel.Data(),kTRUE);
+       den = CastStringToCorrelation(sBinLabel.Data(),kFALSE);
+      }
     Double_t weight = den; // TBI: add support for other options for the weight eventually
     if(den>0.) 
     {
@@ -943,34 +974,9 @@ Double_t AliFlowAnalysisWithMultiparticleCorrelations::CastStringToCorrelation(c
 
  TString sMethodName = "AliFlowAnalysisWithMultiparticleCorrelations::CastStringToCorrelation(const char *string, Bool_t numerator)"; 
 
- if(!(TString(string).BeginsWith("Cos") || TString(string).BeginsWith("Sin")))
- {
-  cout<<Form("And the fatal string is... '%s'. Congratulations!!",string)<<endl; 
-  Fatal(sMethodName.Data(),"!(TString(string).BeginsWith(...");
- }
-
  Bool_t bRealPart = kTRUE;
- if(TString(string).BeginsWith("Sin")){bRealPart = kFALSE;}
-
  Int_t n[8] = {0,0,0,0,0,0,0,0}; // harmonics, supporting up to 8p correlations
- UInt_t whichCorr = 0;   
- for(Int_t t=0;t<=TString(string).Length();t++)
- {
-  if(TString(string[t]).EqualTo(",") || TString(string[t]).EqualTo(")")) // TBI this is just ugly
-  {
-   n[whichCorr] = string[t-1] - '0';
-   if(TString(string[t-2]).EqualTo("-")){n[whichCorr] = -1*n[whichCorr];}
-   if(!(TString(string[t-2]).EqualTo("-") 
-      || TString(string[t-2]).EqualTo(",")
-      || TString(string[t-2]).EqualTo("("))) // TBI relax this eventually to allow two-digits harmonics
-   { 
-    cout<<Form("And the fatal string is... '%s'. Congratulations!!",string)<<endl; 
-    Fatal(sMethodName.Data(),"!(TString(string[t-2]).EqualTo(...");
-   }
-   whichCorr++;
-   if(whichCorr>=9){Fatal(sMethodName.Data(),"whichCorr>=9");} // not supporting corr. beyond 8p 
-  } // if(TString(string[t]).EqualTo(",") || TString(string[t]).EqualTo(")")) // TBI this is just ugly
- } // for(UInt_t t=0;t<=TString(string).Length();t++)
+ Int_t whichCorr = this->CastStringToHarmonics(string,n,bRealPart);
 
  switch(whichCorr)
  {
@@ -1033,6 +1039,48 @@ Double_t AliFlowAnalysisWithMultiparticleCorrelations::CastStringToCorrelation(c
 
 //=======================================================================================================================
 
+Int_t AliFlowAnalysisWithMultiparticleCorrelations::CastStringToHarmonics(const char *string, Int_t *n, Bool_t &bRealPart)
+{
+ // Cast string of the generic form Cos/Sin(-n_1,-n_2,...,n_{k-1},n_k) in the harmonics n_1,...,n_k. 
+ // Returns the number of harmonics k, bRealPart is set to kFALSE for Sin. 
+
+ TString sMethodName = "AliFlowAnalysisWithMultiparticleCorrelations::CastStringToHarmonics(const char *string, Int_t *n, Bool_t &bRealPart)"; 
+
+ if(!(TString(string).BeginsWith("Cos") || TString(string).BeginsWith("Sin")))
+ {
+  cout<<Form("And the fatal string is... '%s'. Congratulations!!",string)<<endl; 
+  Fatal(sMethodName.Data(),"!(TString(string).BeginsWith(...");
+ }
+
+ bRealPart = kTRUE;
+ if(TString(string).BeginsWith("Sin")){bRealPart = kFALSE;}
+
+ for(Int_t h=0;h<8;h++){n[h] = 0;} // harmonics, supporting up to 8p correlations
+ Int_t whichCorr = 0;   
+ for(Int_t t=0;t<=TString(string).Length();t++)
+ {
+  if(TString(string[t]).EqualTo(",") || TString(string[t]).EqualTo(")")) // TBI this is just ugly
+  {
+   n[whichCorr] = string[t-1] - '0';
+   if(TString(string[t-2]).EqualTo("-")){n[whichCorr] = -1*n[whichCorr];}
+   if(!(TString(string[t-2]).EqualTo("-") 
+      || TString(string[t-2]).EqualTo(",")
+      || TString(string[t-2]).EqualTo("("))) // TBI relax this eventually to allow two-digits harmonics
+   { 
+    cout<<Form("And the fatal string is... '%s'. Congratulations!!",string)<<endl; 
+    Fatal(sMethodName.Data(),"!(TString(string[t-2]).EqualTo(...");
+   }
+   whichCorr++;
+   if(whichCorr>=9){Fatal(sMethodName.Data(),"whichCorr>=9");} // not supporting corr. beyond 8p 
+  } // if(TString(string[t]).EqualTo(",") || TString(string[t]).EqualTo(")")) // TBI this is just ugly
+ } // for(UInt_t t=0;t<=TString(string).Length();t++)
+
+ return whichCorr;
+
+} // Int_t AliFlowAnalysisWithMultiparticleCorrelations::CastStringToHarmonics(const char *string, Int_t *n, Bool_t &bRealPart)
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithMultiparticleCorrelations::CalculateProductsOfCorrelations(AliFlowEventSimple *anEvent, TProfile2D *profile2D)
 {
  // Calculate products of multi-particle correlations (needed for error propagation).
@@ -1041,6 +1089,12 @@ void AliFlowAnalysisWithMultiparticleCorrelations::CalculateProductsOfCorrelatio
  if(!anEvent){Fatal(sMethodName.Data(),"Sorry, 'anEvent' is on holidays.");} 
  if(!profile2D){Fatal(sMethodName.Data(),"Sorry, 'profile2D' is on holidays.");} 
 
+ // Entries of the bin labels in fCorrelatorEngine, if used:
+ TArrayI *entries = NULL;
+ if(fCorrelatorEngine && profile2D == fProductsQCPro){entries = fProductsQCEntries;}
+ else if(fCorrelatorEngine && profile2D == fProductsSCPro){entries = fProductsSCEntries;}
+ if(entries && entries[0].GetSize() != profile2D->GetXaxis()->GetNbins()){entries = NULL;} // booked after Init()
+
  Int_t nBins = profile2D->GetXaxis()->GetNbins();
  for(Int_t bx=2;bx<=nBins;bx++)
  {
@@ -1048,11 +1102,21 @@ void AliFlowAnalysisWithMultiparticleCorrelations::CalculateProductsOfCorrelatio
   {
    const char *binLabelX = profile2D->GetXaxis()->GetBinLabel(bx);
    const char *binLabelY = profile2D->GetYaxis()->GetBinLabel(by);
-   Double_t numX = this->CastStringToCorrelation(binLabelX,kTRUE); // numerator
-   Double_t denX = this->CastStringToCorrelation(binLabelX,kFALSE); // denominator
+   Double_t numX = 0., denX = 0., numY = 0., denY = 0.;
+   if(entries)
+   {
+    numX = fCorrelatorEngine->GetNumerator(entries[0][bx-1]); // numerator
+    denX = fCorrelatorEngine->GetDenominator(entries[0][bx-1]); // denominator
+    numY = fCorrelatorEngine->GetNumerator(entries[1][by-1]); // numerator
+    denY = fCorrelatorEngine->GetDenominator(entries[1][by-1]); // denominator
+   } else
+     {
+      numX = this->CastStringToCorrelation(binLabelX,kTRUE); // numerator
+      denX = this->CastStringToCorrelation(binLabelX,kFALSE); // denominator
+      numY = this->CastStringToCorrelation(binLabelY,kTRUE); // numerator
+      denY = this->CastStringToCorrelation(binLabelY,kFALSE); // denominator
+     }
    Double_t wX = denX; // weight TBI add support for other options
-   Double_t numY = this->CastStringToCorrelation(binLabelY,kTRUE); // numerator
-   Double_t denY = this->CastStringToCorrelation(binLabelY,kFALSE); // denominator
    Double_t wY = denY; // weight TBI add support for other options
    if(TMath::Abs(denX) > 0. && TMath::Abs(denY) > 0.)
    {
@@ -3111,6 +3175,71 @@ void AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForEtaGaps()
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForCorrelatorEngine()
+{
+ // Book AliFlowCorrelatorEngine with all correlations in the bin labels of the booked profiles, so that 
+ // for each event they are all calculated in one go, sharing the common sub-terms of the recursion.
+
+ // a) Book the engine;
+ // b) Correlations;
+ // c) Products needed for QC error propagation;
+ // d) Products needed for SC error propagation.
+
+ TString sMethodName = "AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForCorrelatorEngine()";
+
+ // a) Book the engine:
+ delete fCorrelatorEngine;
+ fCorrelatorEngine = new AliFlowCorrelatorEngine(fMaxHarmonic*fMaxCorrelator,fMaxCorrelator);
+
+ Int_t n[8] = {0,0,0,0,0,0,0,0}; // harmonics
+ Bool_t bRealPart = kTRUE;
+
+ // b) Correlations:
+ for(Int_t cs=0;cs<2;cs++) // cos/sin 
+ {
+  for(Int_t co=0;co<8;co++) // correlator order (TBI hardwired 8) 
+  {
+   if(!fCorrelationsPro[cs][co]){continue;}
+   Int_t nBins = fCorrelationsPro[cs][co]->GetNbinsX();
+   fCorrelationsEntries[cs][co].Set(nBins);
+   fCorrelationsEntries[cs][co].Reset(-1);
+   for(Int_t b=1;b<=nBins;b++)
+   {
+    TString sBinLabel = fCorrelationsPro[cs][co]->GetXaxis()->GetBinLabel(b);
+    if(sBinLabel.EqualTo("")){break;} 
+    Int_t whichCorr = this->CastStringToHarmonics(sBinLabel.Data(),n,bRealPart);
+    fCorrelationsEntries[cs][co][b-1] = fCorrelatorEngine->AddEntry(whichCorr,n,bRealPart);
+    if(fCorrelationsEntries[cs][co][b-1]<0){Fatal(sMethodName.Data(),"Cannot book '%s'",sBinLabel.Data());}
+   } // for(Int_t b=1;b<=nBins;b++)
+  } // for(Int_t co=0;co<8;co++) // correlator order (TBI hardwired 8) 
+ } // for(Int_t cs=0;cs<2;cs++) // cos/sin 
+
+ // c) Products needed for QC error propagation:
+ // d) Products needed for SC error propagation:
+ TProfile2D *products[2] = {fProductsQCPro,fProductsSCPro};
+ TArrayI *entries[2] = {fProductsQCEntries,fProductsSCEntries};
+ for(Int_t p=0;p<2;p++) // [QC,SC]
+ {
+  if(!products[p]){continue;}
+  for(Int_t xy=0;xy<2;xy++) // [x,y]
+  {
+   TAxis *axis = (0==xy ? products[p]->GetXaxis() : products[p]->GetYaxis());
+   entries[p][xy].Set(axis->GetNbins());
+   for(Int_t b=1;b<=axis->GetNbins();b++)
+   {
+    Int_t whichCorr = this->CastStringToHarmonics(axis->GetBinLabel(b),n,bRealPart);
+    entries[p][xy][b-1] = fCorrelatorEngine->AddEntry(whichCorr,n,bRealPart);
+    if(entries[p][xy][b-1]<0){Fatal(sMethodName.Data(),"Cannot book '%s'",axis->GetBinLabel(b));}
+   } // for(Int_t b=1;b<=axis->GetNbins();b++)
+  } // for(Int_t xy=0;xy<2;xy++) // [x,y]
+ } // for(Int_t p=0;p<2;p++) // [QC,SC]
+
+ cout<<Form("AliFlowCorrelatorEngine: %d booked correlators from %d shared sub-terms.",fCorrelatorEngine->GetNCorrelators(),fCorrelatorEngine->GetNNodes())<<endl;
+
+} // void AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForCorrelatorEngine()
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForEbECumulants()
 {
  // Book all the stuff for event-by-event cumulants.
@@ -31,6 +31,9 @@
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
 
+class AliFlowEventFlat;
+class AliFlowCorrelatorEngine;
+
 class AliFlowAnalysisWithMultiparticleCorrelations{
  public:
   AliFlowAnalysisWithMultiparticleCorrelations();
@@ -72,9 +75,11 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
    virtual void BookEverythingForDiffCorrelations();
    virtual void BookEverythingForSymmetryPlanes();
    virtual void BookEverythingForEtaGaps();
+   virtual void BookEverythingForCorrelatorEngine();
    
   // 2.) Method Make() and methods called in it:
   virtual void Make(AliFlowEventSimple *anEvent);
+  virtual void Make(const AliFlowEventFlat *anEvent);
    virtual Bool_t CrossCheckInternalFlags(AliFlowEventSimple *anEvent);
    virtual void CrossCheckPointersUsedInMake(); 
    virtual void DetermineRandomIndices(AliFlowEventSimple *anEvent);
@@ -168,6 +173,8 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   TProfile* GetCorrelationsFlagsPro() const {return this->fCorrelationsFlagsPro;}; 
   void SetCalculateCorrelations(Bool_t cc) {this->fCalculateCorrelations = cc;};
   Bool_t GetCalculateCorrelations() const {return this->fCalculateCorrelations;};
+  void SetUseCorrelatorEngine(Bool_t uce) {this->fUseCorrelatorEngine = uce;};
+  Bool_t GetUseCorrelatorEngine() const {return this->fUseCorrelatorEngine;};
   void SetCalculateIsotropic(Bool_t ci) {this->fCalculateIsotropic = ci;};
   Bool_t GetCalculateIsotropic() const {return this->fCalculateIsotropic;};
   void SetCalculateSame(Bool_t cs) {this->fCalculateSame = cs;};
@@ -313,6 +320,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   virtual TComplex FourDiff(Int_t n1, Int_t n2, Int_t n3, Int_t n4);
   virtual Double_t Weight(const Double_t &value, const char *type, const char *variable); // value, [RP,POI], [phi,pt,eta]
   virtual Double_t CastStringToCorrelation(const char *string, Bool_t numerator);
+  virtual Int_t CastStringToHarmonics(const char *string, Int_t *n, Bool_t &bRealPart);
   virtual Double_t Covariance(const char *x, const char *y, TProfile2D *profile2D, Bool_t bUnbiasedEstimator = kFALSE);
   virtual TComplex Recursion(Int_t n, Int_t* harmonic, Int_t mult = 1, Int_t skip = 0); // Credits: Kristjan Gulbrandsen (gulbrand@nbi.dk) 
   virtual void CalculateProductsOfCorrelations(AliFlowEventSimple *anEvent, TProfile2D *profile2D);
@@ -403,6 +411,11 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t fCalculateOnlyForSC;         // calculate only correlations needed for 'standard candles'
   Bool_t fCalculateOnlyCos;           // calculate only 'cos' correlations
   Bool_t fCalculateOnlySin;           // calculate only 'sin' correlations
+  Bool_t fUseCorrelatorEngine;        // calculate all booked correlations at once from shared sub-terms, see AliFlowCorrelatorEngine
+  AliFlowCorrelatorEngine *fCorrelatorEngine; //! all booked correlations, in the form of shared sub-terms
+  TArrayI fCorrelationsEntries[2][8]; //! entry in fCorrelatorEngine for each bin of fCorrelationsPro[2][8], -1 for empty labels
+  TArrayI fProductsQCEntries[2];      //! entry in fCorrelatorEngine for each bin of fProductsQCPro [x,y]
+  TArrayI fProductsSCEntries[2];      //! entry in fCorrelatorEngine for each bin of fProductsSCPro [x,y]
 
   // 4.) Event-by-event cumulants:
   TList *fEbECumulantsList;         // list to hold all e-b-e cumulants objects
@@ -476,7 +489,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Int_t fHighestHarmonicEtaGaps;      // 2-p correlations with eta gaps will be calculated for harmonics [fLowestHarmonicEtaGaps,fHighestHarmonicEtaGaps]
   TProfile *fEtaGapsPro[6];           // [harmonic] different eta gaps are different bins
 
-  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,6);
+  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,7);
 
 };
 
@@ -38,6 +38,7 @@
 #include "TProfile.h"
 
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventFlat.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisWithNestedLoops.h"
 
@@ -184,6 +185,17 @@ void AliFlowAnalysisWithNestedLoops::Make(AliFlowEventSimple* anEvent)
 
 //================================================================================================================
 
+void AliFlowAnalysisWithNestedLoops::Make(const AliFlowEventFlat *anEvent)
+{
+ // Same as Make(AliFlowEventSimple*) for a flat event, with the event from AliFlowEventFlat::GetEventSimple().
+
+ if(!anEvent){return;}
+ this->Make(anEvent->GetEventSimple());
+
+} // end of void AliFlowAnalysisWithNestedLoops::Make(const AliFlowEventFlat *anEvent)
+
+//================================================================================================================
+
 void AliFlowAnalysisWithNestedLoops::Finish()
 {
  // Calculate the final results.
@@ -24,6 +24,7 @@ class TH1D;
 class TProfile;
 
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowCommonConstants;
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
@@ -50,6 +51,7 @@ class AliFlowAnalysisWithNestedLoops
     virtual void StoreHarmonic();        
   // 2.) Method Make() and methods called within Make():
   virtual void Make(AliFlowEventSimple *anEvent);
+  virtual void Make(const AliFlowEventFlat *anEvent);
     virtual void CheckPointersUsedInMake();
     virtual void EvaluateNestedLoopsForRAD(AliFlowEventSimple *anEvent);
     virtual void EvaluateNestedLoopsForMH(AliFlowEventSimple *anEvent);
@@ -43,6 +43,9 @@
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisWithQCumulants.h"
+#include "AliFlowQvectorKernel.h"
+#include "AliFlowResampling.h"
+#include "AliFlowEventFlat.h"
 #include "TArrayD.h"
 #include "TRandom.h"
 #include "TF1.h"
@@ -134,9 +137,11 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fUse2DHistograms(kFALSE),
  fFillProfilesVsMUsingWeights(kTRUE),
  fUseQvectorTerms(kFALSE),
+ fUseQvectorKernel(kFALSE),
  fReQ(NULL),
  fImQ(NULL),
  fSpk(NULL),
+ fQvectorKernel(NULL),
  fIntFlowCorrelationsEBE(NULL),
  fIntFlowEventWeightsForCorrelationsEBE(NULL),
  fIntFlowCorrelationsAllEBE(NULL),
@@ -234,7 +239,11 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fnSubsamples(10),
  fRandom(NULL),
  fBootstrapCorrelations(NULL),
- fBootstrapCumulants(NULL)
+ fBootstrapCumulants(NULL),
+ fResamplingList(NULL),
+ fUseResampling(kFALSE),
+ fnResamplingThreads(0),
+ fResampling(NULL)
  {
   // constructor  
   
@@ -271,6 +280,7 @@ AliFlowAnalysisWithQCumulants::~AliFlowAnalysisWithQCumulants()
  // destructor
  
  delete fHistList;
+ delete fQvectorKernel;
 
 } // end of AliFlowAnalysisWithQCumulants::~AliFlowAnalysisWithQCumulants()
 
@@ -376,7 +386,8 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  if(fStoreControlHistograms){this->FillControlHistograms(anEvent);}                                                              
                                                                                                                                                                                                                                                                                         
  // d) Loop over data and calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k}:
- Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
+ if(fUseQvectorKernel){this->FillQvectorsWithKernel(anEvent);} // same quantities, the loop below is then skipped
+ Int_t nPrim = fUseQvectorKernel ? 0 : anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
  AliFlowTrackSimple *aftsTrack = NULL;
  Int_t n = fHarmonic; // shortcut for the harmonic 
  for(Int_t i=0;i<nPrim;i++) 
@@ -548,6 +559,83 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     }
  } // end of for(Int_t i=0;i<nPrim;i++) 
 
+ // e) to j) Final expressions for S_{p,k} and s_{p,k}, correlations and their distributions:
+ this->CalculateEventByEventCorrelations();
+
+ // k) Store phi distribution for one event to illustrate flow: 
+ if(fStorePhiDistributionForOneEvent){this->StorePhiDistributionForOneEvent(anEvent);}
+   
+ // l) Cross-check with nested loops correlators for reference flow:
+ if(fEvaluateIntFlowNestedLoops){this->EvaluateIntFlowNestedLoops(anEvent);} 
+
+ // m) Cross-check with nested loops correlators for differential flow:
+ if(fEvaluateDiffFlowNestedLoops){this->EvaluateDiffFlowNestedLoops(anEvent);} 
+ 
+ // n) Reset all event-by-event quantities (very important !!!!):
+ this->ResetEventByEventQuantities();
+ 
+} // end of AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
+
+//================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::Make(const AliFlowEventFlat *anEvent)
+{
+ // Same as Make(AliFlowEventSimple*), for an event kept in contiguous arrays. The Q-vectors are always calculated
+ // with AliFlowQvectorKernel and the common control histograms (whose pt and eta spectra are used in Finish())
+ // are filled from the arrays. The phi distribution for one event and the cross-checks with nested loops read
+ // an AliFlowEventSimple: the viewed event (AliFlowEventFlat::View()), or for events built with
+ // AliFlowEventFlat::AddTrack() the one filled from the arrays (AliFlowEventFlat::GetEventSimple()).
+
+ // a) Check all pointers used in this method;
+ // b) Event-level quantities;
+ // c) Fill the common control histograms and call the method to fill fAvMultiplicity;
+ // d) Calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k};
+ // e) to j) Final expressions for S_{p,k} and s_{p,k}, correlations and their distributions;
+ // k) Store phi distribution for one event to illustrate flow;
+ // l) Cross-check with nested loops correlators for reference flow;
+ // m) Cross-check with nested loops correlators for differential flow;
+ // n) Reset all event-by-event quantities (very important !!!!). 
+
+ // a) Check all pointers used in this method:
+ this->CheckPointersUsedInMake();
+
+ // b) Event-level quantities:
+ fNumberOfRPsEBE = anEvent->GetNumberOfRPs(); // number of RPs (i.e. number of reference particles)
+ if(fExactNoRPs > 0 && fNumberOfRPsEBE<fExactNoRPs){return;}
+ fNumberOfPOIsEBE = anEvent->GetNumberOfPOIs(); // number of POIs (i.e. number of particles of interest)
+ fReferenceMultiplicityEBE = anEvent->GetReferenceMultiplicity(); // reference multiplicity for current event
+
+ // c) Fill the common control histograms and call the method to fill fAvMultiplicity:
+ this->FillCommonControlHistograms(anEvent);
+ this->FillAverageMultiplicities((Int_t)(fNumberOfRPsEBE)); 
+ if(fStoreControlHistograms){this->FillControlHistograms(anEvent);}
+
+ // d) Calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k}:
+ this->FillQvectorsWithKernel(anEvent);
+
+ // e) to j) Final expressions for S_{p,k} and s_{p,k}, correlations and their distributions:
+ this->CalculateEventByEventCorrelations();
+
+ // k) Store phi distribution for one event to illustrate flow: 
+ if(fStorePhiDistributionForOneEvent){this->StorePhiDistributionForOneEvent(anEvent->GetEventSimple());}
+
+ // l) Cross-check with nested loops correlators for reference flow:
+ if(fEvaluateIntFlowNestedLoops){this->EvaluateIntFlowNestedLoops(anEvent->GetEventSimple());} 
+
+ // m) Cross-check with nested loops correlators for differential flow:
+ if(fEvaluateDiffFlowNestedLoops){this->EvaluateDiffFlowNestedLoops(anEvent->GetEventSimple());} 
+
+ // n) Reset all event-by-event quantities (very important !!!!):
+ this->ResetEventByEventQuantities();
+
+} // end of AliFlowAnalysisWithQCumulants::Make(const AliFlowEventFlat *anEvent)
+
+//================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::CalculateEventByEventCorrelations()
+{
+ // Called in Make() once Q_{n,k}, S_{p,k} and s_{p,k} are filled for this event.
+
  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
  for(Int_t p=0;p<8;p++)
  {
@@ -684,19 +772,7 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  // j) Distributions of correlations:
  if(fStoreDistributions){this->StoreDistributionsOfCorrelations();}
  
- // k) Store phi distribution for one event to illustrate flow: 
- if(fStorePhiDistributionForOneEvent){this->StorePhiDistributionForOneEvent(anEvent);}
-   
- // l) Cross-check with nested loops correlators for reference flow:
- if(fEvaluateIntFlowNestedLoops){this->EvaluateIntFlowNestedLoops(anEvent);} 
-
- // m) Cross-check with nested loops correlators for differential flow:
- if(fEvaluateDiffFlowNestedLoops){this->EvaluateDiffFlowNestedLoops(anEvent);} 
- 
- // n) Reset all event-by-event quantities (very important !!!!):
- this->ResetEventByEventQuantities();
- 
-} // end of AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
+} // end of void AliFlowAnalysisWithQCumulants::CalculateEventByEventCorrelations()
 
 //=======================================================================================================================
 
@@ -763,6 +839,8 @@ void AliFlowAnalysisWithQCumulants::Finish()
  fUseBootstrap = (Bool_t)fBootstrapFlags->GetBinContent(1); 
  fUseBootstrapVsM = (Bool_t)fBootstrapFlags->GetBinContent(2); 
  fnSubsamples = (Int_t)fBootstrapFlags->GetBinContent(3); 
+ fUseResampling = (Bool_t)fBootstrapFlags->GetBinContent(4); 
+ fnResamplingThreads = (Int_t)fBootstrapFlags->GetBinContent(5); 
 
  // d) Calculate reference cumulants (not corrected for detector effects):
  this->FinalizeCorrelationsIntFlow();
@@ -886,6 +964,9 @@ void AliFlowAnalysisWithQCumulants::Finish()
  // j) Calculate cumulants for bootstrap:
  if(fUseBootstrap||fUseBootstrapVsM){this->CalculateCumulantsForBootstrap();} 
 
+ // k) Calculate jackknife and bootstrap errors from subsamples:
+ if(fUseResampling){this->CalculateErrorsWithResampling();} 
+
 } // end of AliFlowAnalysisWithQCumulants::Finish()
 
 //=======================================================================================================================
@@ -2775,12 +2856,13 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForBootstrap()
  // a) Book profile to hold all flags for bootstrap;
  // b) Book local random generator;
  // c) Book all bootstrap objects;
- // d) Book all bootstrap objects 'vs M'.
+ // d) Book all bootstrap objects 'vs M';
+ // e) Book all objects for resampling.
 
  // a) Book profile to hold all flags for bootstrap;
  TString bootstrapFlagsName = "fBootstrapFlags";
  bootstrapFlagsName += fAnalysisLabel->Data();
- fBootstrapFlags = new TProfile(bootstrapFlagsName.Data(),"Flags for bootstrap",3,0,3);
+ fBootstrapFlags = new TProfile(bootstrapFlagsName.Data(),"Flags for bootstrap",5,0,5);
  fBootstrapFlags->SetTickLength(-0.01,"Y");
  fBootstrapFlags->SetMarkerStyle(25);
  fBootstrapFlags->SetLabelSize(0.04);
@@ -2789,10 +2871,12 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForBootstrap()
  fBootstrapFlags->GetXaxis()->SetBinLabel(1,"fUseBootstrap");
  fBootstrapFlags->GetXaxis()->SetBinLabel(2,"fUseBootstrapVsM");
  fBootstrapFlags->GetXaxis()->SetBinLabel(3,"fnSubsamples");
+ fBootstrapFlags->GetXaxis()->SetBinLabel(4,"fUseResampling");
+ fBootstrapFlags->GetXaxis()->SetBinLabel(5,"fnResamplingThreads");
  fBootstrapList->Add(fBootstrapFlags);
 
  // b) Book local random generator:
- if(fUseBootstrap||fUseBootstrapVsM)
+ if(fUseBootstrap||fUseBootstrapVsM||fUseResampling)
  { 
   fRandom = new TRandom3(0); // if uiSeed is 0, the seed is determined uniquely in space and time via TUUID
  }
@@ -2880,6 +2964,41 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForBootstrap()
   } // end of for(Int_t co=0;co<4;co++) // correlation index 
  } // end of if(fUseBootstrapVsM)
 
+ // e) Book all objects for resampling:
+ if(fUseResampling)
+ {
+  // ....
+  TString resamplingName = "fResampling";
+  resamplingName += fAnalysisLabel->Data();
+  fResampling = new AliFlowResampling(resamplingName.Data(),1+fnBinsMult,4,fnSubsamples); // bin 0 => all events; bins 1, 2, ... => multiplicity
+  fResamplingList->Add(fResampling);
+  // ....
+  TString methodFlag[2] = {"jackknife","bootstrap"};
+  TString flowFlag[4] = {"v{2,QC}","v{4,QC}","v{6,QC}","v{8,QC}"};
+  for(Int_t m=0;m<2;m++) // resampling method
+  {
+   fResamplingCumulants[m] = new TH1D(Form("fResamplingCumulants%s, %s",fAnalysisLabel->Data(),methodFlag[m].Data()),
+                                      Form("Q-cumulants, %s errors",methodFlag[m].Data()),4,0.,4.);
+   fResamplingCumulants[m]->SetStats(kFALSE);
+   fResamplingFlow[m] = new TH1D(Form("fResamplingFlow%s, %s",fAnalysisLabel->Data(),methodFlag[m].Data()),
+                                 Form("Reference flow, %s errors",methodFlag[m].Data()),4,0.,4.);
+   fResamplingFlow[m]->SetStats(kFALSE);
+   for(Int_t co=0;co<4;co++) // cumulant order
+   {
+    fResamplingCumulants[m]->GetXaxis()->SetBinLabel(co+1,cumulantFlag[co].Data());
+    fResamplingFlow[m]->GetXaxis()->SetBinLabel(co+1,flowFlag[co].Data());
+    fResamplingCumulantsVsM[m][co] = new TH1D(Form("fResamplingCumulantsVsM%s, %s, %s",fAnalysisLabel->Data(),cumulantFlag[co].Data(),methodFlag[m].Data()),
+                                              Form("%s vs M, %s errors",cumulantFlag[co].Data(),methodFlag[m].Data()),
+                                              fnBinsMult,fMinMult,fMaxMult);
+    fResamplingCumulantsVsM[m][co]->SetStats(kFALSE);
+    fResamplingCumulantsVsM[m][co]->GetXaxis()->SetTitle(sMultiplicity.Data());
+   } // end of for(Int_t co=0;co<4;co++) // cumulant order
+   fResamplingList->Add(fResamplingCumulants[m]);
+   fResamplingList->Add(fResamplingFlow[m]);
+   for(Int_t co=0;co<4;co++){fResamplingList->Add(fResamplingCumulantsVsM[m][co]);}
+  } // end of for(Int_t m=0;m<2;m++) // resampling method
+ } // end of if(fUseResampling)
+
 } // end of void AliFlowAnalysisWithQCumulants::BookEverythingForBootstrap()
 
 //=======================================================================================================================
@@ -3626,6 +3745,15 @@ void AliFlowAnalysisWithQCumulants::InitializeArraysForBootstrap()
   fBootstrapCorrelationsVsM[ci] = NULL;    
   fBootstrapCumulantsVsM[ci] = NULL;
  }
+ for(Int_t m=0;m<2;m++) // resampling method
+ {
+  fResamplingCumulants[m] = NULL;
+  fResamplingFlow[m] = NULL;
+  for(Int_t co=0;co<4;co++)
+  {
+   fResamplingCumulantsVsM[m][co] = NULL;
+  }
+ }
 
 } // end of void AliFlowAnalysisWithQCumulants::InitializeArraysForBootstrap()
 
@@ -4913,9 +5041,10 @@ void AliFlowAnalysisWithQCumulants::CalculateIntFlowCorrelations()
  } // end of if(fUseQvectorTerms)
 
  // Bootstrap:
- if(fUseBootstrap||fUseBootstrapVsM)
+ if(fUseBootstrap||fUseBootstrapVsM||fUseResampling)
  {
-  Double_t nSampleNo = 1.*fRandom->Integer(fnSubsamples) + 0.5;
+  Int_t nSubsample = fRandom->Integer(fnSubsamples);
+  Double_t nSampleNo = 1.*nSubsample + 0.5;
   if(fUseBootstrap)
   {
    fBootstrapCorrelations->Fill(0.5,nSampleNo,two1n1n,mWeight2p); 
@@ -4930,7 +5059,15 @@ void AliFlowAnalysisWithQCumulants::CalculateIntFlowCorrelations()
    fBootstrapCorrelationsVsM[2]->Fill(dMultiplicityBin,nSampleNo,six1n1n1n1n1n1n,mWeight6p); 
    fBootstrapCorrelationsVsM[3]->Fill(dMultiplicityBin,nSampleNo,eight1n1n1n1n1n1n1n1n,mWeight8p); 
   } // end of if(fUseBootstrapVsM) 
- } // end of if(fUseBootstrap||fUseBootstrapVsM)
+  if(fUseResampling)
+  {
+   Double_t dCorrelations[4] = {two1n1n,four1n1n1n1n,six1n1n1n1n1n1n,eight1n1n1n1n1n1n1n1n};
+   Double_t dWeights[4] = {mWeight2p,mWeight4p,mWeight6p,mWeight8p};
+   fResampling->Fill(nSubsample,0,dCorrelations,dWeights);
+   Int_t nMultBin = (Int_t)((dMultiplicityBin-fMinMult)/((fMaxMult-fMinMult)/fnBinsMult)); // as TAxis::FindBin(), outside of range not filled
+   if(dMultiplicityBin>=fMinMult && nMultBin<fnBinsMult){fResampling->Fill(nSubsample,1+nMultBin,dCorrelations,dWeights);}
+  } // end of if(fUseResampling)
+ } // end of if(fUseBootstrap||fUseBootstrapVsM||fUseResampling)
 
  return;
 
@@ -14837,6 +14974,39 @@ void AliFlowAnalysisWithQCumulants::CalculateCumulantsForBootstrap()
 
 //================================================================================================================================ 
 
+void AliFlowAnalysisWithQCumulants::CalculateErrorsWithResampling()
+{
+ // Evaluate jackknife and bootstrap errors of Q-cumulants and reference flow from the subsample sums
+ // in fResampling (in parallel over multiplicity bins) and store them in fResamplingCumulants, ...
+
+ if(!fResampling)
+ {
+  cout<<"WARNING: fResampling is NULL in AFAWQC::CEWR() !!!!"<<endl;
+  return;
+ }
+
+ fResampling->Evaluate(fnResamplingThreads);
+
+ for(Int_t m=0;m<2;m++) // resampling method
+ {
+  for(Int_t co=0;co<4;co++) // cumulant order
+  {
+   fResamplingCumulants[m]->SetBinContent(co+1,fResampling->GetCumulant(0,co));
+   fResamplingCumulants[m]->SetBinError(co+1,fResampling->GetCumulantError(0,co,m));
+   fResamplingFlow[m]->SetBinContent(co+1,fResampling->GetFlow(0,co));
+   fResamplingFlow[m]->SetBinError(co+1,fResampling->GetFlowError(0,co,m));
+   for(Int_t b=1;b<=fnBinsMult;b++)
+   {
+    fResamplingCumulantsVsM[m][co]->SetBinContent(b,fResampling->GetCumulant(b,co));
+    fResamplingCumulantsVsM[m][co]->SetBinError(b,fResampling->GetCumulantError(b,co,m));
+   }
+  } // end of for(Int_t co=0;co<4;co++) // cumulant order
+ } // end of for(Int_t m=0;m<2;m++) // resampling method
+
+} // end of void AliFlowAnalysisWithQCumulants::CalculateErrorsWithResampling()
+
+//================================================================================================================================ 
+
 void AliFlowAnalysisWithQCumulants::CalculateReferenceFlow()
 {
  // a) Calculate the final results for reference flow estimates from Q-cumulants;
@@ -16054,6 +16224,11 @@ void AliFlowAnalysisWithQCumulants::BookAndNestAllLists()
  fBootstrapResultsList->SetName("Results");
  fBootstrapResultsList->SetOwner(kTRUE);
  if(fUseBootstrap||fUseBootstrapVsM){fBootstrapList->Add(fBootstrapResultsList);}
+ //  List holding objects for resampling:
+ fResamplingList = new TList();
+ fResamplingList->SetName("Resampling");
+ fResamplingList->SetOwner(kTRUE);
+ if(fUseResampling){fBootstrapList->Add(fResamplingList);}
 
 } // end of void AliFlowAnalysisWithQCumulants::BookAndNestAllLists()
 
@@ -18092,6 +18267,8 @@ void AliFlowAnalysisWithQCumulants::StoreBootstrapFlags()
  fBootstrapFlags->Fill(0.5,(Int_t)fUseBootstrap);
  fBootstrapFlags->Fill(1.5,(Int_t)fUseBootstrapVsM);
  fBootstrapFlags->Fill(2.5,(Int_t)fnSubsamples);
+ fBootstrapFlags->Fill(3.5,(Int_t)fUseResampling);
+ fBootstrapFlags->Fill(4.5,(Int_t)fnResamplingThreads);
 
 } // end of void AliFlowAnalysisWithQCumulants::StoreBootstrapFlags()
 
@@ -20618,7 +20795,8 @@ void AliFlowAnalysisWithQCumulants::GetPointersForBootstrap()
  // b) Get pointer to TProfile fBootstrapFlags holding all flags for bootstrap histograms;
  // c) Get pointers to all other lists;
  // d) Get pointers to remaining bootstrap profiles and histograms;
- // e) Get pointers to remaining bootstrap profiles and histograms 'vs M'.
+ // e) Get pointers to remaining bootstrap profiles and histograms 'vs M';
+ // f) Get pointers to all objects for resampling.
 
  // a) Get pointer to base list for bootstrap histograms:
  TList *bootstrapList = dynamic_cast<TList*>(fHistList->FindObject("Bootstrap"));
@@ -20642,6 +20820,8 @@ void AliFlowAnalysisWithQCumulants::GetPointersForBootstrap()
   fUseBootstrap = (Bool_t)fBootstrapFlags->GetBinContent(1); 
   fUseBootstrapVsM = (Bool_t)fBootstrapFlags->GetBinContent(2); 
   fnSubsamples = (Int_t)fBootstrapFlags->GetBinContent(3); 
+  fUseResampling = (Bool_t)fBootstrapFlags->GetBinContent(4); 
+  fnResamplingThreads = (Int_t)fBootstrapFlags->GetBinContent(5); 
  } else 
    {
     cout<<"WARNING: bootstrapFlags is NULL in AFAWQC::GPFMHH() !!!!"<<endl;
@@ -20736,6 +20916,60 @@ void AliFlowAnalysisWithQCumulants::GetPointersForBootstrap()
   } // end of for(Int_t co=0;co<4;co++)
  } // end of if(fUseBootstrapVsM)
 
+ // f) Get pointers to all objects for resampling:
+ if(fUseResampling)
+ {
+  TList *resamplingList = dynamic_cast<TList*>(fBootstrapList->FindObject("Resampling"));
+  if(resamplingList)
+  {
+   this->SetResamplingList(resamplingList);
+  } else
+    {
+     cout<<"WARNING: resamplingList is NULL in AFAWQC::GPFB() !!!!"<<endl;
+     exit(0);
+    }
+  TString resamplingName = "fResampling";
+  resamplingName += fAnalysisLabel->Data();
+  AliFlowResampling *pResampling = dynamic_cast<AliFlowResampling*>(fResamplingList->FindObject(resamplingName.Data()));
+  if(pResampling)
+  {
+   this->SetResampling(pResampling);
+  } else
+    {
+     cout<<"WARNING: pResampling is NULL in AFAWQC::GPFB() !!!!"<<endl;
+     exit(0);
+    }
+  TString methodFlag[2] = {"jackknife","bootstrap"};
+  for(Int_t m=0;m<2;m++) // resampling method
+  {
+   TH1D *pResamplingCumulants = dynamic_cast<TH1D*>(fResamplingList->FindObject(Form("fResamplingCumulants%s, %s",fAnalysisLabel->Data(),methodFlag[m].Data())));
+   TH1D *pResamplingFlow = dynamic_cast<TH1D*>(fResamplingList->FindObject(Form("fResamplingFlow%s, %s",fAnalysisLabel->Data(),methodFlag[m].Data())));
+   if(pResamplingCumulants && pResamplingFlow)
+   {
+    this->SetResamplingCumulants(pResamplingCumulants,m);
+    this->SetResamplingFlow(pResamplingFlow,m);
+   } else
+     {
+      cout<<"WARNING: pResamplingCumulants or pResamplingFlow is NULL in AFAWQC::GPFB() !!!!"<<endl;
+      cout<<"m = "<<m<<endl;
+      exit(0);
+     }
+   for(Int_t co=0;co<4;co++) // cumulant order
+   {
+    TH1D *pResamplingCumulantsVsM = dynamic_cast<TH1D*>(fResamplingList->FindObject(Form("fResamplingCumulantsVsM%s, %s, %s",fAnalysisLabel->Data(),cumulantFlag[co].Data(),methodFlag[m].Data())));
+    if(pResamplingCumulantsVsM)
+    {
+     this->SetResamplingCumulantsVsM(pResamplingCumulantsVsM,m,co);
+    } else
+      {
+       cout<<"WARNING: pResamplingCumulantsVsM is NULL in AFAWQC::GPFB() !!!!"<<endl;
+       cout<<"m = "<<m<<", co = "<<co<<endl;
+       exit(0);
+      }
+   } // end of for(Int_t co=0;co<4;co++) // cumulant order
+  } // end of for(Int_t m=0;m<2;m++) // resampling method
+ } // end of if(fUseResampling)
+
 } // end of void AliFlowAnalysisWithQCumulants::GetPointersForBootstrap()
 
 //=======================================================================================================================
@@ -20986,6 +21220,40 @@ void AliFlowAnalysisWithQCumulants::FillControlHistograms(AliFlowEventSimple *an
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithQCumulants::FillCommonControlHistograms(const AliFlowEventFlat *anEvent)
+{
+ // Fill common control histograms from a flat event.
+ 
+ Int_t nRP = anEvent->GetNumberOfRPs(); // number of Reference Particles 
+ fCommonHists->FillControlHistograms(anEvent); 
+ if(fFillMultipleControlHistograms)
+ {
+  if(nRP>1 && fCommonHists2nd){fCommonHists2nd->FillControlHistograms(anEvent);}
+  if(nRP>3 && fCommonHists4th){fCommonHists4th->FillControlHistograms(anEvent);}
+  if(nRP>5 && fCommonHists6th){fCommonHists6th->FillControlHistograms(anEvent);}
+  if(nRP>7 && fCommonHists8th){fCommonHists8th->FillControlHistograms(anEvent);}
+ } // end of if(fFillMultipleControlHistograms)
+ 
+} // end of void AliFlowAnalysisWithQCumulants::FillCommonControlHistograms(const AliFlowEventFlat *anEvent)
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::FillControlHistograms(const AliFlowEventFlat *anEvent)
+{
+ // Fill control histograms from a flat event.
+ 
+ Int_t nRPs = anEvent->GetNumberOfRPs(); // number of Reference Particles
+ Int_t nPOIs = anEvent->GetNumberOfPOIs(); // number of Particles Of Interest
+ Int_t nRefMult = anEvent->GetReferenceMultiplicity(); // reference multiplicity for current event
+
+ fCorrelationNoRPsVsRefMult->Fill(nRPs,nRefMult);
+ fCorrelationNoPOIsVsRefMult->Fill(nPOIs,nRefMult);
+ fCorrelationNoRPsVsNoPOIs->Fill(nRPs,nPOIs);
+ 
+} // end of void AliFlowAnalysisWithQCumulants::FillControlHistograms(const AliFlowEventFlat *anEvent)
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithQCumulants::ResetEventByEventQuantities()
 {
  // Reset all event by event quantities.
@@ -21084,6 +21352,128 @@ void AliFlowAnalysisWithQCumulants::ResetEventByEventQuantities()
 
 } // end of void AliFlowAnalysisWithQCumulants::ResetEventByEventQuantities();
 
+//================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::FillQvectorsWithKernel(AliFlowEventSimple *anEvent)
+{
+ // Calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k} with AliFlowQvectorKernel. These are the same quantities 
+ // as in the loop over data in Make(), calculated from contiguous arrays of all RPs and POIs in the event.
+
+ // a) Collect RPs and POIs together with their particle weights;
+ // b) Calculate Re[Q_{m*n,k}], Im[Q_{m*n,k}] and S_{p,k};
+ // c) Calculate r_{m*n,k}, p_{m*n,k}, q_{m*n,k} and s_{p,k} vs pt, eta and (pt,eta).
+ 
+ if(!fQvectorKernel){fQvectorKernel = new AliFlowQvectorKernel();}
+ fQvectorKernel->Clear();
+
+ // a) Collect RPs and POIs together with their particle weights:
+ Int_t nPrim = anEvent->NumberOfTracks(); // nPrim = total number of primary tracks
+ Int_t nCounterNoRPs = 0; // needed only for shuffling
+ for(Int_t i=0;i<nPrim;i++) 
+ { 
+  if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
+  AliFlowTrackSimple *aftsTrack = anEvent->GetTrack(i);
+  if(!aftsTrack)
+  {
+   printf("\n WARNING (QC): No particle (i.e. aftsTrack is a NULL pointer in AFAWQC::FillQvectorsWithKernel())!!!!\n\n");
+   continue;
+  }
+  Bool_t bRP = aftsTrack->InRPSelection();
+  Bool_t bPOI = aftsTrack->InPOISelection();
+  if(!(bRP || bPOI)){continue;} // safety measure: consider only tracks which are RPs or POIs
+  Double_t dPhi = aftsTrack->Phi();
+  Double_t dPt  = aftsTrack->Pt();
+  Double_t dEta = aftsTrack->Eta();
+  Double_t dWeight = 1.; // product of all particle weights
+  if(bRP) // particle weights are used only for RPs (and for POIs which are also RPs)
+  {
+   nCounterNoRPs++;
+   dWeight = this->ParticleWeight(dPhi,dPt,dEta,aftsTrack->Weight());
+  } // end of if(bRP)
+  fQvectorKernel->AddTrack(dPhi,dPt,dEta,dWeight,bRP,bPOI);
+ } // end of for(Int_t i=0;i<nPrim;i++) 
+
+ // b) Calculate Re[Q_{m*n,k}], Im[Q_{m*n,k}] and S_{p,k} (Remark: final calculation of S_{p,k} follows in Make()):
+ fQvectorKernel->Calculate(fHarmonic);
+ fQvectorKernel->AddQvector(fReQ,fImQ,fSpk);
+
+ // c) Calculate r_{m*n,k}, p_{m*n,k}, q_{m*n,k} and s_{p,k} vs pt, eta and (pt,eta):
+ if(fCalculateDiffFlow){fQvectorKernel->FillDiffQvector1D(fReRPQ1dEBE,fImRPQ1dEBE,fs1dEBE,1+(Int_t)fCalculateDiffFlowVsEta);}
+ if(fCalculate2DDiffFlow){fQvectorKernel->FillDiffQvector2D(fReRPQ2dEBE,fImRPQ2dEBE,fs2dEBE);}
+
+} // end of void AliFlowAnalysisWithQCumulants::FillQvectorsWithKernel(AliFlowEventSimple *anEvent)
+
+//================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::FillQvectorsWithKernel(const AliFlowEventFlat *anEvent)
+{
+ // As FillQvectorsWithKernel(AliFlowEventSimple*), reading the tracks from the arrays of a flat event.
+
+ if(!fQvectorKernel){fQvectorKernel = new AliFlowQvectorKernel();}
+ fQvectorKernel->Clear();
+
+ // a) Collect RPs and POIs together with their particle weights:
+ Int_t nPrim = anEvent->NumberOfTracks(); // nPrim = total number of primary tracks
+ Int_t nCounterNoRPs = 0; // needed only for shuffling
+ for(Int_t i=0;i<nPrim;i++) 
+ { 
+  if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
+  Bool_t bRP = anEvent->InRPSelection(i);
+  Bool_t bPOI = anEvent->InPOISelection(i);
+  if(!(bRP || bPOI)){continue;} // safety measure: consider only tracks which are RPs or POIs
+  Double_t dPhi = anEvent->Phi(i);
+  Double_t dPt  = anEvent->Pt(i);
+  Double_t dEta = anEvent->Eta(i);
+  Double_t dWeight = 1.; // product of all particle weights
+  if(bRP) // particle weights are used only for RPs (and for POIs which are also RPs)
+  {
+   nCounterNoRPs++;
+   dWeight = this->ParticleWeight(dPhi,dPt,dEta,anEvent->Weight(i));
+  } // end of if(bRP)
+  fQvectorKernel->AddTrack(dPhi,dPt,dEta,dWeight,bRP,bPOI);
+ } // end of for(Int_t i=0;i<nPrim;i++) 
+
+ // b) Calculate Re[Q_{m*n,k}], Im[Q_{m*n,k}] and S_{p,k} (Remark: final calculation of S_{p,k} follows in Make()):
+ fQvectorKernel->Calculate(fHarmonic);
+ fQvectorKernel->AddQvector(fReQ,fImQ,fSpk);
+
+ // c) Calculate r_{m*n,k}, p_{m*n,k}, q_{m*n,k} and s_{p,k} vs pt, eta and (pt,eta):
+ if(fCalculateDiffFlow){fQvectorKernel->FillDiffQvector1D(fReRPQ1dEBE,fImRPQ1dEBE,fs1dEBE,1+(Int_t)fCalculateDiffFlowVsEta);}
+ if(fCalculate2DDiffFlow){fQvectorKernel->FillDiffQvector2D(fReRPQ2dEBE,fImRPQ2dEBE,fs2dEBE);}
+
+} // end of void AliFlowAnalysisWithQCumulants::FillQvectorsWithKernel(const AliFlowEventFlat *anEvent)
+
+//================================================================================================================
+
+Double_t AliFlowAnalysisWithQCumulants::ParticleWeight(Double_t dPhi, Double_t dPt, Double_t dEta, Double_t dTrackWeight) const
+{
+ // Product of phi, pt, eta and track weights of an RP, for the weights in use (as in the loop over data in Make()).
+
+ Double_t wPhi = 1.; // phi weight
+ Double_t wPt  = 1.; // pt weight
+ Double_t wEta = 1.; // eta weight
+ Double_t wTrack = 1.; // track weight
+ if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi weight for this particle:
+ {
+  wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
+ }
+ if(fUsePtWeights && fPtWeights && fnBinsPt) // determine pt weight for this particle:
+ {
+  wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
+ }              
+ if(fUseEtaWeights && fEtaWeights && fEtaBinWidth) // determine eta weight for this particle: 
+ {
+  wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
+ }      
+ if(fUseTrackWeights) // access track weight:
+ {
+  wTrack = dTrackWeight; 
+ }
+
+ return wPhi*wPt*wEta*wTrack;
+
+} // end of Double_t AliFlowAnalysisWithQCumulants::ParticleWeight(Double_t dPhi, Double_t dPt, Double_t dEta, Double_t dTrackWeight) const
+
 //=======================================================================================================================
 
 void AliFlowAnalysisWithQCumulants::CalculateDiffFlowCorrectionsForNUASinTerms(TString type, TString ptOrEta)
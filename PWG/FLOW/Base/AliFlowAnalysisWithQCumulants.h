@@ -30,7 +30,10 @@ class TProfile2D;
 class TDirectoryFile;
 
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowVector;
+class AliFlowQvectorKernel;
+class AliFlowResampling;
 
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
@@ -76,12 +79,19 @@ class AliFlowAnalysisWithQCumulants{
     virtual void StoreBootstrapFlags();
   // 2.) method Make() and methods called within Make():
   virtual void Make(AliFlowEventSimple *anEvent);
+  virtual void Make(const AliFlowEventFlat *anEvent);
     // 2a.) Common:
     virtual void CheckPointersUsedInMake();     
     virtual void FillAverageMultiplicities(Int_t nRP);
     virtual void FillCommonControlHistograms(AliFlowEventSimple *anEvent);
     virtual void FillControlHistograms(AliFlowEventSimple *anEvent);
+    virtual void FillCommonControlHistograms(const AliFlowEventFlat *anEvent);
+    virtual void FillControlHistograms(const AliFlowEventFlat *anEvent);
     virtual void ResetEventByEventQuantities();
+    virtual void FillQvectorsWithKernel(AliFlowEventSimple *anEvent);
+    virtual void FillQvectorsWithKernel(const AliFlowEventFlat *anEvent);
+    virtual Double_t ParticleWeight(Double_t dPhi, Double_t dPt, Double_t dEta, Double_t dTrackWeight) const;
+    virtual void CalculateEventByEventCorrelations();
     // 2b.) Reference flow:
     virtual void CalculateIntFlowCorrelations(); 
     virtual void CalculateIntFlowCorrelationsUsingParticleWeights();
@@ -167,6 +177,7 @@ class AliFlowAnalysisWithQCumulants{
     virtual void CalculateCumulantsMixedHarmonics(); 
     // 3f.) Bootstrap:
     virtual void CalculateCumulantsForBootstrap();
+    virtual void CalculateErrorsWithResampling();
     
   // 4.)  method GetOutputHistograms() and methods called within GetOutputHistograms(): 
   virtual void GetOutputHistograms(TList *outputListHistos);
@@ -287,6 +298,8 @@ class AliFlowAnalysisWithQCumulants{
   Bool_t GetFillProfilesVsMUsingWeights() const {return this->fFillProfilesVsMUsingWeights;};
   void SetUseQvectorTerms(Bool_t const uqvt){this->fUseQvectorTerms = uqvt;if(uqvt){this->fStoreControlHistograms = kTRUE;}};
   Bool_t GetUseQvectorTerms() const {return this->fUseQvectorTerms;};
+  void SetUseQvectorKernel(Bool_t const uqvk){this->fUseQvectorKernel = uqvk;};
+  Bool_t GetUseQvectorKernel() const {return this->fUseQvectorKernel;};
 
   // Reference flow profiles:
   void SetAvMultiplicity(TProfile* const avMultiplicity) {this->fAvMultiplicity = avMultiplicity;};
@@ -549,6 +562,19 @@ class AliFlowAnalysisWithQCumulants{
   TH2D* GetBootstrapCumulants() const {return this->fBootstrapCumulants;}; 
   void SetBootstrapCumulantsVsM(TH2D* const bcpVsM, Int_t const qvti) {this->fBootstrapCumulantsVsM[qvti] = bcpVsM;};
   TH2D* GetBootstrapCumulantsVsM(Int_t qvti) const {return this->fBootstrapCumulantsVsM[qvti];};
+  void SetResamplingList(TList* const rl) {this->fResamplingList = rl;};
+  void SetUseResampling(Bool_t const ur) {this->fUseResampling = ur;};
+  Bool_t GetUseResampling() const {return this->fUseResampling;};
+  void SetnResamplingThreads(Int_t const nrt) {this->fnResamplingThreads = nrt;};
+  Int_t GetnResamplingThreads() const {return this->fnResamplingThreads;};
+  void SetResampling(AliFlowResampling* const r) {this->fResampling = r;};
+  AliFlowResampling* GetResampling() const {return this->fResampling;};
+  void SetResamplingCumulants(TH1D* const rc, Int_t const m) {this->fResamplingCumulants[m] = rc;};
+  TH1D* GetResamplingCumulants(Int_t m) const {return this->fResamplingCumulants[m];};
+  void SetResamplingFlow(TH1D* const rf, Int_t const m) {this->fResamplingFlow[m] = rf;};
+  TH1D* GetResamplingFlow(Int_t m) const {return this->fResamplingFlow[m];};
+  void SetResamplingCumulantsVsM(TH1D* const rcVsM, Int_t const m, Int_t const co) {this->fResamplingCumulantsVsM[m][co] = rcVsM;};
+  TH1D* GetResamplingCumulantsVsM(Int_t m, Int_t co) const {return this->fResamplingCumulantsVsM[m][co];};
 
  private:
   
@@ -627,11 +653,13 @@ class AliFlowAnalysisWithQCumulants{
   Bool_t fUse2DHistograms; // use TH2D instead of TProfile to improve numerical stability in reference flow calculation 
   Bool_t fFillProfilesVsMUsingWeights; // if the width of multiplicity bin is 1, weights are not needed  
   Bool_t fUseQvectorTerms; // use TH2D with separate Q-vector terms instead of TProfile to improve numerical stability in reference flow calculation 
+  Bool_t fUseQvectorKernel; // calculate e-b-e Q-vectors with AliFlowQvectorKernel from contiguous arrays of all tracks
 
   //  3c.) event-by-event quantities:
   TMatrixD *fReQ; //! fReQ[m][k] = sum_{i=1}^{M} w_{i}^{k} cos(m*phi_{i})
   TMatrixD *fImQ; //! fImQ[m][k] = sum_{i=1}^{M} w_{i}^{k} sin(m*phi_{i})
   TMatrixD *fSpk; //! fSM[p][k] = (sum_{i=1}^{M} w_{i}^{k})^{p+1}
+  AliFlowQvectorKernel *fQvectorKernel; //! calculates fReQ, fImQ, fSpk and differential e-b-e Q-vectors when fUseQvectorKernel
   TH1D *fIntFlowCorrelationsEBE; // 1st bin: <2>, 2nd bin: <4>, 3rd bin: <6>, 4th bin: <8>
   TH1D *fIntFlowEventWeightsForCorrelationsEBE; // 1st bin: eW_<2>, 2nd bin: eW_<4>, 3rd bin: eW_<6>, 4th bin: eW_<8>
   TH1D *fIntFlowCorrelationsAllEBE; // to be improved (add comment)
@@ -846,8 +874,16 @@ class AliFlowAnalysisWithQCumulants{
   //  11d) histograms:  
   TH2D *fBootstrapCumulants; // x-axis => QC{2}, QC{4}, QC{6}, QC{8}; y-axis => subsample # 
   TH2D *fBootstrapCumulantsVsM[4]; // index => QC{2}, QC{4}, QC{6}, QC{8}; x-axis => multiplicity; y-axis => subsample # 
+  //  11e) resampling (subsample sums only, jackknife and bootstrap errors evaluated in Finish()):
+  TList *fResamplingList; // list to hold all objects for resampling
+  Bool_t fUseResampling; // fill AliFlowResampling and get jackknife and bootstrap errors of QC{2,4,6,8} and vs M
+  Int_t fnResamplingThreads; // threads used by AliFlowResampling::Evaluate(), 0 = one per core
+  AliFlowResampling *fResampling; // sums of <2>, <4>, <6>, <8> per subsample, [0] = all events, [1,...] = multiplicity bins
+  TH1D *fResamplingCumulants[2]; // [0=jackknife,1=bootstrap] QC{2}, QC{4}, QC{6}, QC{8} with resampling errors
+  TH1D *fResamplingFlow[2]; // [0=jackknife,1=bootstrap] v{2}, v{4}, v{6}, v{8} with resampling errors
+  TH1D *fResamplingCumulantsVsM[2][4]; // [0=jackknife,1=bootstrap][QC{2}, QC{4}, QC{6}, QC{8}] vs multiplicity
 
-  ClassDef(AliFlowAnalysisWithQCumulants, 4);
+  ClassDef(AliFlowAnalysisWithQCumulants, 6);
 
 };
 
@@ -27,6 +27,7 @@
 
 #include "AliFlowCommonConstants.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventFlat.h"
 #include "AliFlowVector.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowCommonHist.h"
@@ -480,6 +481,14 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
 
 }
 
+//-----------------------------------------------------------------------
+void AliFlowAnalysisWithScalarProduct::Make(const AliFlowEventFlat *anEvent) {
+  // Scalar Product method for a flat event: the subevent Q-vectors come from
+  // AliFlowEventSimple::Get2Qsub(), hence AliFlowEventFlat::GetEventSimple() is used
+  if (!anEvent) return;
+  this->Make(anEvent->GetEventSimple());
+}
+
 //--------------------------------------------------------------------  
 void AliFlowAnalysisWithScalarProduct::GetOutputHistograms(TList *outputListHistos){
   //get pointers to all output histograms (called before Finish())
@@ -9,6 +9,7 @@
 
 class AliFlowTrackSimple;
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
 
@@ -37,6 +38,7 @@ class AliFlowAnalysisWithScalarProduct : public AliFlowAnalysis {
  
    void Init();                                       //Define output objects
    void Make(AliFlowEventSimple* anEvent);            //Main routine
+   void Make(const AliFlowEventFlat *anEvent);        //same for a flat event (AliFlowEventFlat)
    void GetOutputHistograms(TList *outputListHistos); //Copy output objects from TList
    void Finish();                                     //Fill results
    void WriteHistograms(TDirectoryFile *outputFileName) const; //writes histograms locally (for OnTheFly)
@@ -27,6 +27,7 @@
 
 #include "AliFlowCommonConstants.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowEventFlat.h"
 #include "AliFlowVector.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowCommonHist.h"
@@ -456,6 +457,14 @@ void AliFlowAnalysisWithSimpleSP::Make(AliFlowEventSimple* anEvent) {
 
 }
 
+//-----------------------------------------------------------------------
+void AliFlowAnalysisWithSimpleSP::Make(const AliFlowEventFlat *anEvent) {
+    // Scalar Product method for a flat event: the subevent Q-vectors come from
+    // AliFlowEventSimple::Get2Qsub(), hence AliFlowEventFlat::GetEventSimple() is used
+    if (!anEvent) return;
+    this->Make(anEvent->GetEventSimple());
+}
+
 //--------------------------------------------------------------------  
 void AliFlowAnalysisWithSimpleSP::GetOutputHistograms(TList *outputListHistos){
     //get pointers to all output histograms (called before Finish())
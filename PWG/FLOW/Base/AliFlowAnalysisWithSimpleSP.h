@@ -9,6 +9,7 @@
 
 class AliFlowTrackSimple;
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
 
@@ -35,6 +36,7 @@ class AliFlowAnalysisWithSimpleSP : public AliFlowAnalysis {
 
         void Init();                                       //Define output objects
         void Make(AliFlowEventSimple* anEvent);            //Main routine
+        void Make(const AliFlowEventFlat *anEvent);        //same for a flat event (AliFlowEventFlat)
         void GetOutputHistograms(TList *outputListHistos); //Copy output objects from TList
         void Finish(Bool_t A = kFALSE);                                     //Fill results
         void WriteHistograms(TDirectoryFile *outputFileName) const; //writes histograms locally (for OnTheFly)
@@ -0,0 +1,150 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+ /*************************************
+ * event-by-event POI Q-vectors in pt, *
+ * phi and (phi,eta) bins, for         *
+ * AliFlowAnalysisCRC                  *
+ *************************************/
+
+// AliFlowAnalysisCRC used to keep the POI Q-vectors of each event in temporary
+// histograms, one per set of particles, power of the weight and harmonic: about
+// 1.3k Fill() calls per track and, before each event, Reset() of ~1.8k TH1D and
+// ~3.4k TH2D (phi,eta) histograms of 102x34 bins, ~100 MB which were mostly
+// empty. Here cos, sin and w^p are calculated once per track, and the bin is
+// looked up once per set of particles; all sums of this bin are contiguous.
+// Only the bins hit in the event get a slot, and only those are zeroed for the
+// next event. The sums are added in the same order as by TH1::Fill(), hence the
+// bin contents are identical to the ones of the histograms.
+
+#include "AliFlowCRCQvectorWorkspace.h"
+
+#include "TMath.h"
+
+//================================================================================================================
+
+AliFlowCRCQvectorWorkspace::AliFlowCRCQvectorWorkspace(Int_t nPowers, Int_t nHarmonics, Int_t nPtBins, const Double_t *ptBins,
+                                                       Int_t nPhiBins, Int_t nEtaBins, Double_t etaMin, Double_t etaMax, Int_t nITStypes):
+ fNPowers(nPowers),
+ fNHarmonics(nHarmonics),
+ fNTerms(nPowers*nHarmonics),
+ fNSums(2*nPowers*nHarmonics+nPowers),
+ fPtAxis(nPtBins,ptBins),
+ fPhiAxis(nPhiBins,0.,TMath::TwoPi()),
+ fEtaAxis(nEtaBins,etaMin,etaMax),
+ fPtSums(kNPtSets),
+ fPhiSums(kNPhiSets),
+ fPhiEtaSums(nITStypes),
+ fCos(nHarmonics,0.),
+ fSin(nHarmonics,0.),
+ fWpow(nPowers,0.)
+ {
+  // Constructor.
+
+  for(Int_t s=0;s<kNPtSets;s++){Book(fPtSums[s],nPtBins+2);}
+  for(Int_t s=0;s<kNPhiSets;s++){Book(fPhiSums[s],nPhiBins+2);}
+  for(Int_t t=0;t<nITStypes;t++){Book(fPhiEtaSums[t],(nPhiBins+2)*(nEtaBins+2));}
+
+ } // AliFlowCRCQvectorWorkspace::AliFlowCRCQvectorWorkspace(...)
+
+//================================================================================================================
+
+AliFlowCRCQvectorWorkspace::~AliFlowCRCQvectorWorkspace()
+{
+ // Destructor.
+
+} // AliFlowCRCQvectorWorkspace::~AliFlowCRCQvectorWorkspace()
+
+//================================================================================================================
+
+void AliFlowCRCQvectorWorkspace::Book(Sums &sums, Int_t nCells)
+{
+ // All bins empty.
+
+ sums.fSlotOfBin.assign(nCells,-1);
+ sums.fBinOfSlot.clear();
+ sums.fSums.clear();
+
+} // void AliFlowCRCQvectorWorkspace::Book(Sums &sums, Int_t nCells)
+
+//================================================================================================================
+
+void AliFlowCRCQvectorWorkspace::Clear()
+{
+ // Start a new event (the capacity of all slots is kept).
+
+ for(UInt_t s=0;s<fPtSums.size();s++){Clear(fPtSums[s]);}
+ for(UInt_t s=0;s<fPhiSums.size();s++){Clear(fPhiSums[s]);}
+ for(UInt_t t=0;t<fPhiEtaSums.size();t++){Clear(fPhiEtaSums[t]);}
+
+} // void AliFlowCRCQvectorWorkspace::Clear()
+
+//================================================================================================================
+
+void AliFlowCRCQvectorWorkspace::Clear(Sums &sums)
+{
+ // Release the slots of the bins hit in the last event.
+
+ for(UInt_t i=0;i<sums.fBinOfSlot.size();i++){sums.fSlotOfBin[sums.fBinOfSlot[i]] = -1;}
+ sums.fBinOfSlot.clear();
+ sums.fSums.clear();
+
+} // void AliFlowCRCQvectorWorkspace::Clear(Sums &sums)
+
+//================================================================================================================
+
+void AliFlowCRCQvectorWorkspace::SetTrack(Double_t phi, Double_t w)
+{
+ // Same expressions as used before for each Fill(): pow(w,p)*TMath::Cos((h+1.)*phi), ...
+
+ for(Int_t h=0;h<fNHarmonics;h++)
+ {
+  fCos[h] = TMath::Cos((h+1.)*phi);
+  fSin[h] = TMath::Sin((h+1.)*phi);
+ }
+ for(Int_t p=0;p<fNPowers;p++){fWpow[p] = pow(w,p);}
+
+} // void AliFlowCRCQvectorWorkspace::SetTrack(Double_t phi, Double_t w)
+
+//================================================================================================================
+
+void AliFlowCRCQvectorWorkspace::Fill(Sums &sums, Int_t bin)
+{
+ // Add the current track to the sums of its bin.
+
+ Int_t slot = sums.fSlotOfBin[bin];
+ if(slot<0)
+ {
+  slot = sums.fBinOfSlot.size();
+  sums.fSlotOfBin[bin] = slot;
+  sums.fBinOfSlot.push_back(bin);
+  sums.fSums.resize(sums.fSums.size()+fNSums,0.);
+ }
+
+ Double_t *re = &sums.fSums[slot*fNSums];
+ Double_t *im = re+fNTerms;
+ Double_t *mul = im+fNTerms;
+ for(Int_t p=0;p<fNPowers;p++)
+ {
+  Double_t wp = fWpow[p];
+  for(Int_t h=0;h<fNHarmonics;h++)
+  {
+   re[p*fNHarmonics+h] += wp*fCos[h];
+   im[p*fNHarmonics+h] += wp*fSin[h];
+  }
+  mul[p] += wp;
+ }
+
+} // void AliFlowCRCQvectorWorkspace::Fill(Sums &sums, Int_t bin)
@@ -0,0 +1,102 @@
+/*
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.
+ * See cxx source for full Copyright notice
+ * $Id$
+ */
+
+ /*************************************
+ * event-by-event POI Q-vectors in pt, *
+ * phi and (phi,eta) bins, for         *
+ * AliFlowAnalysisCRC                  *
+ *************************************/
+
+#ifndef ALIFLOWCRCQVECTORWORKSPACE_H
+#define ALIFLOWCRCQVECTORWORKSPACE_H
+
+#include <vector>
+
+#include "TAxis.h"
+
+class AliFlowCRCQvectorWorkspace{
+ public:
+  AliFlowCRCQvectorWorkspace(Int_t nPowers, Int_t nHarmonics, Int_t nPtBins, const Double_t *ptBins,
+                             Int_t nPhiBins, Int_t nEtaBins, Double_t etaMin, Double_t etaMax, Int_t nITStypes);
+  virtual ~AliFlowCRCQvectorWorkspace();
+
+  // Sets of particles:
+  enum EPtSet {kPtAll = 0, kPtCh = 1, kPtEG = 3, kNPtSets = 5};  // all POIs, [charge], [eta-gap side]
+  enum EPhiSet {kPhiAll = 0, kPhiEG = 1, kNPhiSets = 3};         // all POIs, [eta-gap side]
+
+  // For each event:
+  void Clear(); // start a new event, zeroes only the bins filled in the previous one
+  void SetTrack(Double_t phi, Double_t w); // cos and sin of (h+1)*phi and w^p for the next fills
+  void FillPt(Int_t set, Int_t bin) {Fill(fPtSums[set],bin);};
+  void FillPhi(Int_t set, Int_t bin) {Fill(fPhiSums[set],bin);};
+  void FillPhiEta(Int_t type, Int_t bin) {Fill(fPhiEtaSums[type],bin);};
+
+  // Binning, bin numbers as in TH1/TH2 (0 = underflow):
+  const TAxis* GetPtAxis() const {return &fPtAxis;};
+  const TAxis* GetPhiAxis() const {return &fPhiAxis;};
+  const TAxis* GetEtaAxis() const {return &fEtaAxis;};
+  Int_t FindPtBin(Double_t pt) const {return fPtAxis.FindFixBin(pt);};
+  Int_t FindPhiBin(Double_t phi) const {return fPhiAxis.FindFixBin(phi);};
+  Int_t GetPhiEtaBin(Int_t phiBin, Int_t etaBin) const {return phiBin+(fPhiAxis.GetNbins()+2)*etaBin;};
+  Int_t FindPhiEtaBin(Double_t phi, Double_t eta) const {return GetPhiEtaBin(fPhiAxis.FindFixBin(phi),fEtaAxis.FindFixBin(eta));};
+
+  // Sum of w^p cos((h+1)*phi), w^p sin((h+1)*phi) and w^p in one bin, same indices as the former
+  // per-event histograms fPOIPtDiffQRe[p][h], fPOIPtDiffQReCh[c][p][h], ... of AliFlowAnalysisCRC:
+  Double_t PtDiffQRe(Int_t p, Int_t h, Int_t bin) const {return QRe(fPtSums[kPtAll],p,h,bin);};
+  Double_t PtDiffQIm(Int_t p, Int_t h, Int_t bin) const {return QIm(fPtSums[kPtAll],p,h,bin);};
+  Double_t PtDiffMul(Int_t p, Int_t /*h*/, Int_t bin) const {return Mul(fPtSums[kPtAll],p,bin);};
+  Double_t PtDiffQReCh(Int_t c, Int_t p, Int_t h, Int_t bin) const {return QRe(fPtSums[kPtCh+c],p,h,bin);};
+  Double_t PtDiffQImCh(Int_t c, Int_t p, Int_t h, Int_t bin) const {return QIm(fPtSums[kPtCh+c],p,h,bin);};
+  Double_t PtDiffMulCh(Int_t c, Int_t p, Int_t /*h*/, Int_t bin) const {return Mul(fPtSums[kPtCh+c],p,bin);};
+  Double_t PtDiffQReEG(Int_t e, Int_t p, Int_t h, Int_t bin) const {return QRe(fPtSums[kPtEG+e],p,h,bin);};
+  Double_t PtDiffQImEG(Int_t e, Int_t p, Int_t h, Int_t bin) const {return QIm(fPtSums[kPtEG+e],p,h,bin);};
+  Double_t PtDiffMulEG(Int_t e, Int_t p, Int_t /*h*/, Int_t bin) const {return Mul(fPtSums[kPtEG+e],p,bin);};
+  Double_t PhiDiffQRe(Int_t p, Int_t h, Int_t bin) const {return QRe(fPhiSums[kPhiAll],p,h,bin);};
+  Double_t PhiDiffQIm(Int_t p, Int_t h, Int_t bin) const {return QIm(fPhiSums[kPhiAll],p,h,bin);};
+  Double_t PhiDiffMul(Int_t p, Int_t /*h*/, Int_t bin) const {return Mul(fPhiSums[kPhiAll],p,bin);};
+  Double_t PhiDiffQReEG(Int_t e, Int_t p, Int_t h, Int_t bin) const {return QRe(fPhiSums[kPhiEG+e],p,h,bin);};
+  Double_t PhiDiffQImEG(Int_t e, Int_t p, Int_t h, Int_t bin) const {return QIm(fPhiSums[kPhiEG+e],p,h,bin);};
+  Double_t PhiDiffMulEG(Int_t e, Int_t p, Int_t /*h*/, Int_t bin) const {return Mul(fPhiSums[kPhiEG+e],p,bin);};
+  Double_t PhiEtaDiffQRe(Int_t t, Int_t p, Int_t h, Int_t bin) const {return QRe(fPhiEtaSums[t],p,h,bin);};
+  Double_t PhiEtaDiffQIm(Int_t t, Int_t p, Int_t h, Int_t bin) const {return QIm(fPhiEtaSums[t],p,h,bin);};
+  Double_t PhiEtaDiffMul(Int_t t, Int_t p, Int_t /*h*/, Int_t bin) const {return Mul(fPhiEtaSums[t],p,bin);};
+
+ private:
+  AliFlowCRCQvectorWorkspace(const AliFlowCRCQvectorWorkspace& other);
+  AliFlowCRCQvectorWorkspace& operator=(const AliFlowCRCQvectorWorkspace& other);
+
+  // Sums of one set of particles: the bins hit in this event get a slot, each slot
+  // holds Re[p][h], Im[p][h] and Mul[p] of its bin.
+  struct Sums {
+   std::vector<Int_t> fSlotOfBin; // slot of each bin (incl. under- and overflow), -1 if not hit
+   std::vector<Int_t> fBinOfSlot; // bin of each slot
+   std::vector<Double_t> fSums;   // fNSums sums per slot
+  };
+
+  void Book(Sums &sums, Int_t nCells);
+  void Fill(Sums &sums, Int_t bin);
+  void Clear(Sums &sums);
+  Double_t QRe(const Sums &sums, Int_t p, Int_t h, Int_t bin) const {Int_t s = sums.fSlotOfBin[bin]; return s<0 ? 0. : sums.fSums[s*fNSums+p*fNHarmonics+h];};
+  Double_t QIm(const Sums &sums, Int_t p, Int_t h, Int_t bin) const {Int_t s = sums.fSlotOfBin[bin]; return s<0 ? 0. : sums.fSums[s*fNSums+fNTerms+p*fNHarmonics+h];};
+  Double_t Mul(const Sums &sums, Int_t p, Int_t bin) const {Int_t s = sums.fSlotOfBin[bin]; return s<0 ? 0. : sums.fSums[s*fNSums+2*fNTerms+p];};
+
+  Int_t fNPowers;    // powers of the particle weight, p = 0,...,fNPowers-1
+  Int_t fNHarmonics; // harmonics, h+1 = 1,...,fNHarmonics
+  Int_t fNTerms;     // fNPowers*fNHarmonics
+  Int_t fNSums;      // sums per slot, 2*fNTerms+fNPowers
+  TAxis fPtAxis;     // pt binning
+  TAxis fPhiAxis;    // phi binning
+  TAxis fEtaAxis;    // eta binning of the (phi,eta) bins
+  std::vector<Sums> fPtSums;     // [EPtSet]
+  std::vector<Sums> fPhiSums;    // [EPhiSet]
+  std::vector<Sums> fPhiEtaSums; // [ITS type]
+  // Current track:
+  std::vector<Double_t> fCos;  // cos((h+1)*phi)
+  std::vector<Double_t> fSin;  // sin((h+1)*phi)
+  std::vector<Double_t> fWpow; // w^p
+};
+
+#endif
@@ -18,6 +18,7 @@
 #include "AliFlowCommonHist.h"
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowEventFlat.h"
 
 #include "TString.h" 
 #include "TProfile.h"
@@ -717,6 +718,98 @@ Bool_t AliFlowCommonHist::FillControlHistograms(AliFlowEventSimple* anEvent,TLis
 
 //----------------------------------------------------------------------- 
 
+Bool_t AliFlowCommonHist::FillControlHistograms(const AliFlowEventFlat* anEvent)
+{
+  //Fills the control histograms from a flat event, as
+  //FillControlHistograms(AliFlowEventSimple*) without particle weights
+  if (!anEvent){
+    cout<<"##### FillControlHistograms: FlowEvent pointer null"<<endl;
+    return kFALSE;
+  }
+
+  Double_t dQX = 0., dQY = 0., dSumW = 0.;       //Q-vector of the RPs
+  Double_t dQXSub[2] = {0.,0.}, dQYSub[2] = {0.,0.}; //Q-vectors of the subevents
+  Double_t dMultRP = 0.;
+  Double_t dMultPOI = 0.;
+
+  Int_t iNumberOfTracks = anEvent->NumberOfTracks();
+  for (Int_t i=0;i<iNumberOfTracks;i++) {
+    Double_t dW = anEvent->Weight(i);
+    Double_t dPt = anEvent->Pt(i);
+    Double_t dPhi = anEvent->Phi(i);
+    Double_t dEta = anEvent->Eta(i);
+
+    if (anEvent->InRPSelection(i)){
+      Double_t dCos = TMath::Cos(fHarmonicInt*dPhi);
+      Double_t dSin = TMath::Sin(fHarmonicInt*dPhi);
+      dQX += dW*dCos;
+      dQY += dW*dSin;
+      dSumW += dW;
+      for (Int_t s=0;s<2;s++) {
+        if (!anEvent->InSubevent(i,s)) continue;
+        dQXSub[s] += dW*dCos;
+        dQYSub[s] += dW*dSin;
+      }
+    }
+
+    if (dPhi<0.) dPhi+=2*TMath::Pi();
+
+    if (anEvent->InRPSelection(i)){
+      fHistPtRP->Fill(dPt,dW);
+      fHistPhiRP->Fill(dPhi,dW);
+      fHistEtaRP->Fill(dEta,dW);
+      if(!fBookOnlyBasic){fHistPhiEtaRP->Fill(dEta,dPhi,dW);}
+      if(!fBookOnlyBasic){fHistWeightvsPhi->Fill(dPhi,dW);}
+      dMultRP += dW;
+      if(!fBookOnlyBasic && anEvent->InSubevent(i,0)){
+        fHistPtSub0->Fill(dPt,dW);
+        fHistPhiSub0->Fill(dPhi,dW);
+        fHistEtaSub0->Fill(dEta,dW);
+      }
+      if(!fBookOnlyBasic && anEvent->InSubevent(i,1)){
+        fHistPtSub1->Fill(dPt,dW);
+        fHistPhiSub1->Fill(dPhi,dW);
+        fHistEtaSub1->Fill(dEta,dW);
+      }
+    }
+    if (anEvent->InPOISelection(i)){
+      fHistPtPOI->Fill(dPt,dW);
+      fHistPhiPOI->Fill(dPhi,dW);
+      fHistEtaPOI->Fill(dEta,dW);
+      if(!fBookOnlyBasic){fHistPhiEtaPOI->Fill(dEta,dPhi,dW);}
+      fHistProMeanPtperBin->Fill(dPt,dPt,dW);
+      fHistMassPOI->Fill(anEvent->Mass(i),dPt,dW);
+      dMultPOI += dW;
+    }
+  } //loop over tracks
+
+  if(!fBookOnlyBasic){
+    //Q-vector weighted by the multiplicity, as in AliFlowEventSimple::GetQ() and Get2Qsub()
+    AliFlowVector vQ;
+    if (dSumW!=0.) vQ.Set(dQX/dSumW,dQY/dSumW);
+    fHistQ->Fill(vQ.Mod());
+    fHistAngleQ->Fill(vQ.Phi()/float(fHarmonicInt));
+    AliFlowVector vQa(dQXSub[0],dQYSub[0]);
+    AliFlowVector vQb(dQXSub[1],dQYSub[1]);
+    fHistAngleQSub0->Fill(vQa.Phi()/float(fHarmonicInt));
+    fHistAngleQSub1->Fill(vQb.Phi()/float(fHarmonicInt));
+  }
+
+  fHistMultRP->Fill(dMultRP);
+  fHistMultPOI->Fill(dMultPOI);
+  if(!fBookOnlyBasic){fHistMultPOIvsRP->Fill(dMultRP,dMultPOI);}
+
+  //<reference multiplicity> versus # of RPs:
+  fRefMultVsNoOfRPs->Fill(dMultRP+0.5,anEvent->GetReferenceMultiplicity(),1.);
+
+  //reference multiplicity:
+  fHistRefMult->Fill(anEvent->GetReferenceMultiplicity());
+
+  return kTRUE;
+}
+
+//----------------------------------------------------------------------- 
+
 Double_t AliFlowCommonHist::GetEntriesInPtBinRP(Int_t aBin)
 {
   //get entries in bin aBin from fHistPtRP
@@ -12,6 +12,7 @@
 
              
 class AliFlowEventSimple;
+class AliFlowEventFlat;
 class AliFlowTrackSimple;
 class TH1F;
 class TH2F;
@@ -39,6 +40,7 @@ class AliFlowCommonHist: public TNamed {
  
   //fill method
   Bool_t FillControlHistograms(AliFlowEventSimple* anEvent,TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
+  Bool_t FillControlHistograms(const AliFlowEventFlat* anEvent); // same without particle weights, from the arrays of a flat event
   
   //getters
   Double_t GetEntriesInPtBinRP(Int_t iBin);   //gets entries from fHistPtRP
@@ -0,0 +1,258 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+ /************************************
+ * generic multi-particle correlators *
+ * evaluated from a table of shared   *
+ * sub-terms                          *
+ ************************************/
+
+// The generic correlators of AliFlowAnalysisWithMultiparticleCorrelations are
+// obtained with the recursion of K. Gulbrandsen, which re-evaluates the same
+// sub-terms many times for each correlator, and again for every correlator
+// requested in the same event. Here the recursion is unrolled once, before the
+// first event, for all requested correlators: each distinct call
+// Recursion(n,harmonic,mult,skip) becomes one node, shared by all correlators
+// which need it. For each event the nodes are then evaluated once, in order,
+// from a flat table of Q-vector components, giving exactly the same result as
+// AliFlowAnalysisWithMultiparticleCorrelations::Recursion.
+
+#include "AliFlowCorrelatorEngine.h"
+
+#include "TMath.h"
+#include "Riostream.h"
+
+using std::cout;
+using std::endl;
+
+//================================================================================================================
+
+AliFlowCorrelatorEngine::AliFlowCorrelatorEngine(Int_t maxHarmonic, Int_t maxPower):
+ fMaxHarmonic(maxHarmonic),
+ fMaxPower(maxPower),
+ fNodes(),
+ fTerms(),
+ fCorrelators(),
+ fEntryNum(),
+ fEntryDen(),
+ fEntryRe(),
+ fNodeIndex(),
+ fCorrelatorIndex(),
+ fQRe((2*maxHarmonic+1)*(maxPower+1),0.),
+ fQIm((2*maxHarmonic+1)*(maxPower+1),0.),
+ fRe(),
+ fIm()
+ {
+  // Constructor.
+
+ } // AliFlowCorrelatorEngine::AliFlowCorrelatorEngine(Int_t maxHarmonic, Int_t maxPower)
+
+//================================================================================================================
+
+AliFlowCorrelatorEngine::~AliFlowCorrelatorEngine()
+{
+ // Destructor.
+
+} // AliFlowCorrelatorEngine::~AliFlowCorrelatorEngine()
+
+//================================================================================================================
+
+void AliFlowCorrelatorEngine::Clear()
+{
+ // Remove all correlators.
+
+ fNodes.clear();
+ fTerms.clear();
+ fCorrelators.clear();
+ fEntryNum.clear();
+ fEntryDen.clear();
+ fEntryRe.clear();
+ fNodeIndex.clear();
+ fCorrelatorIndex.clear();
+ fRe.clear();
+ fIm.clear();
+
+} // void AliFlowCorrelatorEngine::Clear()
+
+//================================================================================================================
+
+Int_t AliFlowCorrelatorEngine::AddCorrelator(Int_t n, const Int_t *harmonic)
+{
+ // Add the generic n-particle correlator <exp[i(h1*phi1+...+hn*phin)]> and return its index.
+ // Requesting the same harmonics again returns the same index.
+
+ if(n<1 || n>fMaxPower)
+ {
+  cout<<Form("AliFlowCorrelatorEngine::AddCorrelator(): n = %d is not supported.",n)<<endl;
+  return -1;
+ }
+ Int_t sum = 0;
+ for(Int_t i=0;i<n;i++){sum += TMath::Abs(harmonic[i]);}
+ if(sum>fMaxHarmonic)
+ {
+  cout<<Form("AliFlowCorrelatorEngine::AddCorrelator(): sum of |harmonics| = %d is beyond %d.",sum,fMaxHarmonic)<<endl;
+  return -1;
+ }
+
+ std::vector<Int_t> key(harmonic,harmonic+n);
+ std::map<std::vector<Int_t>,Int_t>::const_iterator it = fCorrelatorIndex.find(key);
+ if(it!=fCorrelatorIndex.end()){return it->second;}
+
+ Int_t h[8] = {0}; // Recursion() permutes the harmonics in place
+ for(Int_t i=0;i<n;i++){h[i] = harmonic[i];}
+ fCorrelators.push_back(BuildNode(n,h,1,0));
+ fRe.resize(fNodes.size(),0.);
+ fIm.resize(fNodes.size(),0.);
+
+ Int_t c = fCorrelators.size()-1;
+ fCorrelatorIndex[key] = c;
+ return c;
+
+} // Int_t AliFlowCorrelatorEngine::AddCorrelator(Int_t n, const Int_t *harmonic)
+
+//================================================================================================================
+
+Int_t AliFlowCorrelatorEngine::AddEntry(Int_t n, const Int_t *harmonic, Bool_t bRealPart)
+{
+ // Add a booked correlation: its numerator is Re or Im of the correlator, its denominator
+ // (a.k.a. weight 'number of combinations') is Re of the correlator with all harmonics set to zero.
+
+ Int_t zero[8] = {0};
+ Int_t num = AddCorrelator(n,harmonic);
+ Int_t den = AddCorrelator(n,zero);
+ if(num<0 || den<0){return -1;}
+
+ fEntryNum.push_back(num);
+ fEntryDen.push_back(den);
+ fEntryRe.push_back(bRealPart);
+ return fEntryNum.size()-1;
+
+} // Int_t AliFlowCorrelatorEngine::AddEntry(Int_t n, const Int_t *harmonic, Bool_t bRealPart)
+
+//================================================================================================================
+
+Int_t AliFlowCorrelatorEngine::BuildNode(Int_t n, Int_t *harmonic, Int_t mult, Int_t skip)
+{
+ // Unroll one call of AliFlowAnalysisWithMultiparticleCorrelations::Recursion(n,harmonic,mult,skip),
+ // following exactly its permutations of the harmonics. Returns the index of the node.
+
+ std::vector<Int_t> key(harmonic,harmonic+n);
+ key.push_back(n); key.push_back(mult); key.push_back(skip);
+ std::map<std::vector<Int_t>,Int_t>::const_iterator it = fNodeIndex.find(key);
+ if(it!=fNodeIndex.end()){return it->second;}
+
+ Node node;
+ Int_t nm1 = n-1;
+ node.fQ = QIndex(harmonic[nm1],mult);
+ node.fProduct = -1;
+ node.fFirstTerm = 0;
+ node.fNTerms = 0;
+ node.fMult = mult;
+
+ std::vector<Int_t> terms;
+ if(nm1 > 0)
+ {
+  node.fProduct = BuildNode(nm1,harmonic,1,0);
+  if(nm1 != skip)
+  {
+   Int_t multp1 = mult+1;
+   Int_t nm2 = n-2;
+   Int_t counter1 = 0;
+   Int_t hhold = harmonic[counter1];
+   harmonic[counter1] = harmonic[nm2];
+   harmonic[nm2] = hhold + harmonic[nm1];
+   terms.push_back(BuildNode(nm1,harmonic,multp1,nm2));
+   Int_t counter2 = n-3;
+   while(counter2 >= skip)
+   {
+    harmonic[nm2] = harmonic[counter1];
+    harmonic[counter1] = hhold;
+    ++counter1;
+    hhold = harmonic[counter1];
+    harmonic[counter1] = harmonic[nm2];
+    harmonic[nm2] = hhold + harmonic[nm1];
+    terms.push_back(BuildNode(nm1,harmonic,multp1,counter2));
+    --counter2;
+   }
+   harmonic[nm2] = harmonic[counter1];
+   harmonic[counter1] = hhold;
+  } // if(nm1 != skip)
+ } // if(nm1 > 0)
+
+ node.fFirstTerm = fTerms.size();
+ node.fNTerms = terms.size();
+ fTerms.insert(fTerms.end(),terms.begin(),terms.end());
+ fNodes.push_back(node);
+
+ Int_t index = fNodes.size()-1;
+ fNodeIndex[key] = index;
+ return index;
+
+} // Int_t AliFlowCorrelatorEngine::BuildNode(Int_t n, Int_t *harmonic, Int_t mult, Int_t skip)
+
+//================================================================================================================
+
+void AliFlowCorrelatorEngine::Evaluate(const TComplex *qvector, Int_t nHarmonics, Int_t nPowers)
+{
+ // Evaluate all nodes for the current event. 'qvector' holds Q(h,p) at [h*nPowers+p] for h >= 0;
+ // Q(-h,p) is taken as Q(h,p)^*.
+
+ // a) Fill the flat Q-vector table:
+ Int_t nh = TMath::Min(nHarmonics,fMaxHarmonic+1);
+ Int_t np = TMath::Min(nPowers,fMaxPower+1);
+ for(Int_t h=0;h<nh;h++)
+ {
+  for(Int_t p=0;p<np;p++)
+  {
+   const TComplex &q = qvector[h*nPowers+p];
+   fQRe[QIndex(h,p)] = q.Re();
+   fQIm[QIndex(h,p)] = q.Im();
+   fQRe[QIndex(-h,p)] = q.Re();
+   fQIm[QIndex(-h,p)] = -q.Im();
+  }
+ }
+
+ // b) Evaluate the nodes, each after the ones it uses:
+ const Double_t *qRe = &fQRe[0];
+ const Double_t *qIm = &fQIm[0];
+ Int_t nNodes = fNodes.size();
+ for(Int_t i=0;i<nNodes;i++)
+ {
+  const Node &node = fNodes[i];
+  Double_t re = qRe[node.fQ];
+  Double_t im = qIm[node.fQ];
+  if(node.fProduct>=0)
+  {
+   Double_t pRe = fRe[node.fProduct], pIm = fIm[node.fProduct];
+   Double_t tmp = re*pRe-im*pIm;
+   im = re*pIm+im*pRe;
+   re = tmp;
+  }
+  if(node.fNTerms>0)
+  {
+   Double_t sRe = 0., sIm = 0.;
+   for(Int_t t=node.fFirstTerm;t<node.fFirstTerm+node.fNTerms;t++)
+   {
+    sRe += fRe[fTerms[t]];
+    sIm += fIm[fTerms[t]];
+   }
+   re -= node.fMult*sRe;
+   im -= node.fMult*sIm;
+  }
+  fRe[i] = re;
+  fIm[i] = im;
+ } // for(Int_t i=0;i<nNodes;i++)
+
+} // void AliFlowCorrelatorEngine::Evaluate(const TComplex *qvector, Int_t nHarmonics, Int_t nPowers)
@@ -0,0 +1,73 @@
+/*
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.
+ * See cxx source for full Copyright notice
+ * $Id$
+ */
+
+ /************************************
+ * generic multi-particle correlators *
+ * evaluated from a table of shared   *
+ * sub-terms                          *
+ ************************************/
+
+#ifndef ALIFLOWCORRELATORENGINE_H
+#define ALIFLOWCORRELATORENGINE_H
+
+#include <map>
+#include <vector>
+
+#include "TComplex.h"
+
+class AliFlowCorrelatorEngine{
+ public:
+  AliFlowCorrelatorEngine(Int_t maxHarmonic = 48, Int_t maxPower = 8);
+  virtual ~AliFlowCorrelatorEngine();
+
+  // Setup (before the first event):
+  Int_t AddCorrelator(Int_t n, const Int_t *harmonic); // returns the index of the correlator
+  Int_t AddEntry(Int_t n, const Int_t *harmonic, Bool_t bRealPart); // numerator Re/Im and denominator of a booked correlation
+  void Clear();
+
+  // For each event:
+  void Evaluate(const TComplex *qvector, Int_t nHarmonics, Int_t nPowers); // Q-vector as [harmonic][power], harmonic >= 0
+  TComplex GetCorrelator(Int_t c) const {Int_t i = fCorrelators[c]; return TComplex(fRe[i],fIm[i]);};
+  Double_t GetNumerator(Int_t e) const {Int_t i = fCorrelators[fEntryNum[e]]; return fEntryRe[e] ? fRe[i] : fIm[i];};
+  Double_t GetDenominator(Int_t e) const {return fRe[fCorrelators[fEntryDen[e]]];};
+
+  Int_t GetNCorrelators() const {return fCorrelators.size();};
+  Int_t GetNEntries() const {return fEntryNum.size();};
+  Int_t GetNNodes() const {return fNodes.size();};
+
+ private:
+  AliFlowCorrelatorEngine(const AliFlowCorrelatorEngine& other);
+  AliFlowCorrelatorEngine& operator=(const AliFlowCorrelatorEngine& other);
+
+  // One sub-term of the recursion: Q(h,p)*product - mult*sum(terms), see AliFlowAnalysisWithMultiparticleCorrelations::Recursion
+  struct Node {
+   Int_t fQ;          // index of Q(h,p) in the Q-vector table
+   Int_t fProduct;    // node multiplied with Q(h,p), -1 for a single Q(h,p)
+   Int_t fFirstTerm;  // first subtracted node in fTerms
+   Int_t fNTerms;     // number of subtracted nodes
+   Double_t fMult;    // factor of the subtracted nodes
+  };
+
+  Int_t BuildNode(Int_t n, Int_t *harmonic, Int_t mult, Int_t skip);
+  Int_t QIndex(Int_t h, Int_t p) const {return (h+fMaxHarmonic)*(fMaxPower+1)+p;};
+
+  Int_t fMaxHarmonic; // largest |harmonic| in the Q-vector table
+  Int_t fMaxPower;    // largest weight power in the Q-vector table
+  std::vector<Node> fNodes;      // all sub-terms, each after the ones it uses
+  std::vector<Int_t> fTerms;     // subtracted nodes of all sub-terms
+  std::vector<Int_t> fCorrelators; // node of each correlator
+  std::vector<Int_t> fEntryNum;  // numerator correlator of each entry
+  std::vector<Int_t> fEntryDen;  // denominator correlator of each entry
+  std::vector<Bool_t> fEntryRe;  // real or imaginary part of the numerator
+  std::map<std::vector<Int_t>,Int_t> fNodeIndex;       // (n,mult,skip,harmonics) -> node
+  std::map<std::vector<Int_t>,Int_t> fCorrelatorIndex; // harmonics -> correlator
+  std::vector<Double_t> fQRe;    // Q-vector table, real parts [harmonic+fMaxHarmonic][power]
+  std::vector<Double_t> fQIm;    // Q-vector table, imaginary parts
+  std::vector<Double_t> fRe;     // value of each node, real part
+  std::vector<Double_t> fIm;     // value of each node, imaginary part
+};
+
+#endif
@@ -0,0 +1,197 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/*****************************************************************
+  AliFlowEventFlat: flat, reusable representation of a flow
+  event, with the tracks in contiguous arrays and the RP/POI
+  and subevent selections as bit masks
+
+  AliFlowEventSimple keeps each track as a separate TObject,
+  accessed through TBits. Here one object is kept for the whole
+  analysis and refilled for each event with AddTrack(); the
+  arrays only grow, so after the first events no allocation is
+  done any more. An existing AliFlowEventSimple is adapted with
+  View(), which copies nothing: the accessors then read the
+  tracks of the viewed event (in the order of GetTrack(), i.e.
+  shuffled if requested), and the arrays stay empty.
+
+  The flow methods which read AliFlowEventSimple internally
+  (e.g. through GetQ()) get it from GetEventSimple(): the viewed
+  event, or for events built with AddTrack() an AliFlowEventSimple
+  filled once per event from the arrays, reusing its tracks.
+*****************************************************************/
+
+#include "AliFlowEventFlat.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowTrackSimple.h"
+#include "TBits.h"
+#include "TMath.h"
+
+ClassImp(AliFlowEventFlat)
+
+//-----------------------------------------------------------------------
+
+AliFlowEventFlat::AliFlowEventFlat():
+  fPhi(),
+  fEta(),
+  fPt(),
+  fWeight(),
+  fCharge(),
+  fMass(),
+  fPOItypes(),
+  fSubevents(),
+  fReferenceMultiplicity(0),
+  fMCReactionPlaneAngle(0.),
+  fCentrality(-1.),
+  fSource(NULL),
+  fEventSimple(NULL),
+  fEventSimpleFilled(kFALSE)
+{
+  //constructor
+  for(Int_t i=0;i<kMaxPOItypes;i++) fNumberOfPOIs[i]=0;
+}
+
+//-----------------------------------------------------------------------
+
+AliFlowEventFlat::~AliFlowEventFlat()
+{
+  //destructor
+  delete fEventSimple;
+}
+
+//-----------------------------------------------------------------------
+
+void AliFlowEventFlat::Clear()
+{
+  //start a new event, the capacity of the arrays is kept
+  fPhi.clear();
+  fEta.clear();
+  fPt.clear();
+  fWeight.clear();
+  fCharge.clear();
+  fMass.clear();
+  fPOItypes.clear();
+  fSubevents.clear();
+  for(Int_t i=0;i<kMaxPOItypes;i++) fNumberOfPOIs[i]=0;
+  fReferenceMultiplicity=0;
+  fMCReactionPlaneAngle=0.;
+  fCentrality=-1.;
+  fSource=NULL;
+  fEventSimpleFilled=kFALSE;
+}
+
+//-----------------------------------------------------------------------
+
+void AliFlowEventFlat::AddTrack(Double_t phi, Double_t eta, Double_t pt, Double_t weight, Int_t charge, UInt_t poiTypes, UInt_t subevents, Double_t mass)
+{
+  //add a track, the number of RPs and POIs is incremented for each bit set in poiTypes
+  fPhi.push_back(phi);
+  fEta.push_back(eta);
+  fPt.push_back(pt);
+  fWeight.push_back(weight);
+  fCharge.push_back(charge);
+  fMass.push_back(mass);
+  fPOItypes.push_back(poiTypes);
+  fSubevents.push_back(subevents);
+  fEventSimpleFilled=kFALSE;
+  for(Int_t i=0;i<kMaxPOItypes;i++)
+  {
+    if(poiTypes & (1u<<i)) fNumberOfPOIs[i]++;
+  }
+}
+
+//-----------------------------------------------------------------------
+
+void AliFlowEventFlat::View(AliFlowEventSimple *anEvent)
+{
+  //view anEvent: the tracks and event-level numbers are read from it, nothing is copied;
+  //anEvent must stay valid and unchanged while this event is used
+  Clear();
+  fSource=anEvent;
+}
+
+//-----------------------------------------------------------------------
+
+UInt_t AliFlowEventFlat::POItypes(Int_t i) const
+{
+  //RP/POI selections of track i as bit mask
+  if(!fSource) return fPOItypes[i];
+  UInt_t poiTypes=0;
+  const TBits *bits = fSource->GetTrack(i)->GetPOItype();
+  Int_t nBits = TMath::Min((Int_t)bits->GetNbits(),(Int_t)kMaxPOItypes);
+  for(Int_t b=0;b<nBits;b++)
+  {
+    if(bits->TestBitNumber(b)) poiTypes |= (1u<<b);
+  }
+  return poiTypes;
+}
+
+//-----------------------------------------------------------------------
+
+UInt_t AliFlowEventFlat::Subevents(Int_t i) const
+{
+  //subevents of track i as bit mask
+  if(!fSource) return fSubevents[i];
+  UInt_t subevents=0;
+  for(Int_t s=0;s<2;s++) // AliFlowEventSimple has two subevents
+  {
+    if(fSource->GetTrack(i)->InSubevent(s)) subevents |= (1u<<s);
+  }
+  return subevents;
+}
+
+//-----------------------------------------------------------------------
+
+AliFlowEventSimple* AliFlowEventFlat::GetEventSimple() const
+{
+  //the viewed event, or an AliFlowEventSimple filled from the arrays for the flow methods
+  //which read one; its tracks are filled once per event and reused between events
+  if(fSource) return fSource;
+  if(!fEventSimple) fEventSimple = new AliFlowEventSimple(TMath::Max((Int_t)fPhi.size(),10));
+
+  if(!fEventSimpleFilled)
+  {
+    fEventSimple->ClearFast();
+    Int_t nTracks = fPhi.size();
+    for(Int_t i=0;i<nTracks;i++)
+    {
+      AliFlowTrackSimple *pTrack = fEventSimple->MakeNewTrack();
+      pTrack->Clear();
+      pTrack->SetPhi(fPhi[i]);
+      pTrack->SetEta(fEta[i]);
+      pTrack->SetPt(fPt[i]);
+      pTrack->SetWeight(fWeight[i]);
+      pTrack->SetCharge(fCharge[i]);
+      pTrack->SetMass(fMass[i]);
+      for(Int_t b=0;b<kMaxPOItypes;b++)
+      {
+        if(fPOItypes[i] & (1u<<b)) pTrack->SetPOItype(b);
+        if(fSubevents[i] & (1u<<b)) pTrack->SetForSubevent(b);
+      }
+      fEventSimple->AddTrack(pTrack);
+    }
+    fEventSimpleFilled=kTRUE;
+  }
+
+  //event-level numbers, also when set after the tracks
+  for(Int_t i=0;i<kMaxPOItypes;i++)
+  {
+    if(i<2 || fNumberOfPOIs[i]>0) fEventSimple->SetNumberOfPOIs(fNumberOfPOIs[i],i);
+  }
+  fEventSimple->SetReferenceMultiplicity(fReferenceMultiplicity);
+  fEventSimple->SetMCReactionPlaneAngle(fMCReactionPlaneAngle);
+  fEventSimple->SetCentrality(fCentrality);
+  return fEventSimple;
+}
@@ -0,0 +1,90 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+/*****************************************************************
+  AliFlowEventFlat: flat, reusable representation of a flow
+  event, with the tracks in contiguous arrays and the RP/POI
+  and subevent selections as bit masks, or a view of an
+  AliFlowEventSimple without copying its tracks
+*****************************************************************/
+
+#ifndef ALIFLOWEVENTFLAT_H
+#define ALIFLOWEVENTFLAT_H
+
+#include <vector>
+
+#include "Rtypes.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowTrackSimple.h"
+
+class AliFlowEventFlat{
+
+ public:
+
+  enum {kMaxPOItypes = 32, kMaxSubevents = 32}; // bits in the selection masks
+
+  AliFlowEventFlat();
+  virtual ~AliFlowEventFlat();
+
+  // Building the event (the capacity of all arrays is kept between events):
+  void Clear();
+  void View(AliFlowEventSimple *anEvent); // view of anEvent, the tracks are read from it and not copied
+  void AddTrack(Double_t phi, Double_t eta, Double_t pt, Double_t weight, Int_t charge, UInt_t poiTypes, UInt_t subevents = 0, Double_t mass = -1.);
+
+  // Tracks (from the viewed event, or from the arrays filled with AddTrack()):
+  Int_t NumberOfTracks() const {return fSource ? fSource->NumberOfTracks() : (Int_t)fPhi.size();};
+  Double_t Phi(Int_t i) const {return fSource ? fSource->GetTrack(i)->Phi() : fPhi[i];};
+  Double_t Eta(Int_t i) const {return fSource ? fSource->GetTrack(i)->Eta() : fEta[i];};
+  Double_t Pt(Int_t i) const {return fSource ? fSource->GetTrack(i)->Pt() : fPt[i];};
+  Double_t Weight(Int_t i) const {return fSource ? fSource->GetTrack(i)->Weight() : fWeight[i];};
+  Int_t Charge(Int_t i) const {return fSource ? fSource->GetTrack(i)->Charge() : fCharge[i];};
+  Double_t Mass(Int_t i) const {return fSource ? fSource->GetTrack(i)->Mass() : fMass[i];};
+  UInt_t POItypes(Int_t i) const; // bit AliFlowTrackSimple::kRP, kPOI, kPOI1, ...
+  UInt_t Subevents(Int_t i) const;
+  Bool_t InRPSelection(Int_t i) const {return fSource ? fSource->GetTrack(i)->InRPSelection() : (fPOItypes[i] & (1u<<0));};
+  Bool_t InPOISelection(Int_t i, Int_t poiType=1) const {return fSource ? fSource->GetTrack(i)->InPOISelection(poiType) : (fPOItypes[i] & (1u<<poiType));};
+  Bool_t InSubevent(Int_t i, Int_t s) const {return fSource ? fSource->GetTrack(i)->InSubevent(s) : (fSubevents[i] & (1u<<s));};
+  // contiguous arrays, NULL for a view:
+  const Double_t* GetPhi() const {return (fSource || fPhi.empty()) ? NULL : &fPhi[0];};
+  const Double_t* GetEta() const {return (fSource || fEta.empty()) ? NULL : &fEta[0];};
+  const Double_t* GetPt() const {return (fSource || fPt.empty()) ? NULL : &fPt[0];};
+  const Double_t* GetWeight() const {return (fSource || fWeight.empty()) ? NULL : &fWeight[0];};
+
+  // Event (the setters apply to events built with AddTrack()):
+  Int_t GetNumberOfRPs() const {return GetNumberOfPOIs(0);};
+  Int_t GetNumberOfPOIs(Int_t poiType=1) const {return fSource ? fSource->GetNumberOfPOIs(poiType) : ((poiType>=0 && poiType<kMaxPOItypes) ? fNumberOfPOIs[poiType] : 0);};
+  void SetNumberOfPOIs(Int_t n, Int_t poiType=1) {if(poiType>=0 && poiType<kMaxPOItypes){fNumberOfPOIs[poiType] = n;}};
+  Int_t GetReferenceMultiplicity() const {return fSource ? fSource->GetReferenceMultiplicity() : fReferenceMultiplicity;};
+  void SetReferenceMultiplicity(Int_t m) {fReferenceMultiplicity = m;};
+  Double_t GetMCReactionPlaneAngle() const {return fSource ? fSource->GetMCReactionPlaneAngle() : fMCReactionPlaneAngle;};
+  void SetMCReactionPlaneAngle(Double_t psi) {fMCReactionPlaneAngle = psi;};
+  Double_t GetCentrality() const {return fSource ? fSource->GetCentrality() : fCentrality;};
+  void SetCentrality(Double_t c) {fCentrality = c;};
+  AliFlowEventSimple* GetSource() const {return fSource;}; // viewed event, NULL if built with AddTrack()
+  AliFlowEventSimple* GetEventSimple() const; // viewed event, or an AliFlowEventSimple filled from the arrays
+
+ private:
+  AliFlowEventFlat(const AliFlowEventFlat& anEvent);
+  AliFlowEventFlat& operator=(const AliFlowEventFlat& anEvent);
+
+  std::vector<Double_t> fPhi;       // azimuthal angle
+  std::vector<Double_t> fEta;       // pseudorapidity
+  std::vector<Double_t> fPt;        // transverse momentum
+  std::vector<Double_t> fWeight;    // track weight
+  std::vector<Int_t>    fCharge;    // charge
+  std::vector<Double_t> fMass;      // mass (-1 if unknown)
+  std::vector<UInt_t>   fPOItypes;  // bit i set if the track passed the selection of POI type i (0 = RP)
+  std::vector<UInt_t>   fSubevents; // bit i set if the track belongs to subevent i
+  Int_t fNumberOfPOIs[kMaxPOItypes]; // number of tracks of each POI type (0 = RP)
+  Int_t fReferenceMultiplicity;      // reference multiplicity
+  Double_t fMCReactionPlaneAngle;    // reaction plane angle from the MC truth
+  Double_t fCentrality;              // centrality
+  AliFlowEventSimple *fSource;       //! viewed event, not owned
+  mutable AliFlowEventSimple *fEventSimple; //! AliFlowEventSimple filled from the arrays for methods reading one (owned)
+  mutable Bool_t fEventSimpleFilled; //! fEventSimple holds the current arrays
+
+  ClassDef(AliFlowEventFlat,1)
+};
+
+#endif
@@ -0,0 +1,345 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+ /***************************************
+ * Q-vector components of one event from *
+ * contiguous arrays of tracks, for      *
+ * AliFlowAnalysisWithQCumulants         *
+ ***************************************/
+
+// AliFlowAnalysisWithQCumulants::Make() calculates for each track cos and sin of
+// all multiples of the harmonic and all powers of the particle weight, and fills
+// the differential Q-vectors into one TProfile bin per multiple and power. Here
+// the tracks of the event are first collected in contiguous arrays; cos and sin
+// of (m+1)*n*phi are then obtained for all tracks at once from the ones of n*phi
+// with the recurrence for complex powers, and w^k by repeated multiplication.
+// The integrated Q-vector is a sum over these arrays, the differential ones are
+// summed per pt, eta or (pt,eta) bin and written to the profiles once per event,
+// with the same bin contents, bin entries and sums of squares as obtained with
+// TProfile::Fill(x,value,1.).
+
+#include "AliFlowQvectorKernel.h"
+
+#include "TMath.h"
+#include "TMatrixD.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+
+//================================================================================================================
+
+AliFlowQvectorKernel::AliFlowQvectorKernel():
+ fPhi(),
+ fPt(),
+ fEta(),
+ fW(),
+ fRP(),
+ fType(),
+ fCos(),
+ fSin(),
+ fWpow()
+ {
+  // Constructor.
+
+  for(Int_t m=0;m<kNm;m++){for(Int_t k=0;k<kNk;k++){fReQ[m][k] = 0.; fImQ[m][k] = 0.;}}
+  for(Int_t k=0;k<kNk;k++){fS[k] = 0.;}
+
+ } // AliFlowQvectorKernel::AliFlowQvectorKernel()
+
+//================================================================================================================
+
+AliFlowQvectorKernel::~AliFlowQvectorKernel()
+{
+ // Destructor.
+
+} // AliFlowQvectorKernel::~AliFlowQvectorKernel()
+
+//================================================================================================================
+
+void AliFlowQvectorKernel::Clear()
+{
+ // Start a new event (the capacity of all arrays is kept).
+
+ fPhi.clear();
+ fPt.clear();
+ fEta.clear();
+ fW.clear();
+ fRP.clear();
+ fType.clear();
+ for(Int_t t=0;t<3;t++)
+ {
+  for(Int_t pe=0;pe<2;pe++){ClearDiff(fDiff1D[t][pe]);}
+  ClearDiff(fDiff2D[t]);
+ }
+
+} // void AliFlowQvectorKernel::Clear()
+
+//================================================================================================================
+
+void AliFlowQvectorKernel::ClearDiff(DiffSums &sums)
+{
+ // Release the slots of the bins hit in the last event.
+
+ for(UInt_t i=0;i<sums.fBinOfSlot.size();i++){sums.fSlotOfBin[sums.fBinOfSlot[i]] = -1;}
+ sums.fBinOfSlot.clear();
+ sums.fEntries.clear();
+ sums.fSums.clear();
+
+} // void AliFlowQvectorKernel::ClearDiff(DiffSums &sums)
+
+//================================================================================================================
+
+void AliFlowQvectorKernel::AddTrack(Double_t phi, Double_t pt, Double_t eta, Double_t w, Bool_t bRP, Bool_t bPOI)
+{
+ // Add a RP and/or POI. For POIs which are not RPs, w shall be 1.
+
+ fPhi.push_back(phi);
+ fPt.push_back(pt);
+ fEta.push_back(eta);
+ fW.push_back(w);
+ fRP.push_back(bRP ? 1. : 0.);
+ fType.push_back((bRP ? 1 : 0) | (bPOI ? 2 : 0));
+
+} // void AliFlowQvectorKernel::AddTrack(Double_t phi, Double_t pt, Double_t eta, Double_t w, Bool_t bRP, Bool_t bPOI)
+
+//================================================================================================================
+
+void AliFlowQvectorKernel::Calculate(Int_t n)
+{
+ // Calculate the per-track terms and the integrated Q-vector for harmonic n.
+
+ // a) Per-track terms;
+ // b) Integrated Q-vector.
+
+ for(Int_t m=0;m<kNm;m++){for(Int_t k=0;k<kNk;k++){fReQ[m][k] = 0.; fImQ[m][k] = 0.;}}
+ for(Int_t k=0;k<kNk;k++){fS[k] = 0.;}
+ Int_t nTracks = fPhi.size();
+ if(0==nTracks){return;}
+
+ // a) Per-track terms:
+ fCos.resize(kNm*nTracks);
+ fSin.resize(kNm*nTracks);
+ fWpow.resize(kNk*nTracks);
+ const Double_t *phi = &fPhi[0];
+ const Double_t *w = &fW[0];
+ const Double_t *rp = &fRP[0];
+ Double_t *c1 = &fCos[0];
+ Double_t *s1 = &fSin[0];
+ for(Int_t j=0;j<nTracks;j++)
+ {
+  c1[j] = TMath::Cos(n*phi[j]);
+  s1[j] = TMath::Sin(n*phi[j]);
+ }
+ for(Int_t m=1;m<kNm;m++) // exp(i(m+1)n*phi) = exp(i*m*n*phi)*exp(i*n*phi)
+ {
+  const Double_t *c0 = c1+(m-1)*nTracks;
+  const Double_t *s0 = s1+(m-1)*nTracks;
+  Double_t *cm = c1+m*nTracks;
+  Double_t *sm = s1+m*nTracks;
+  for(Int_t j=0;j<nTracks;j++)
+  {
+   cm[j] = c0[j]*c1[j]-s0[j]*s1[j];
+   sm[j] = s0[j]*c1[j]+c0[j]*s1[j];
+  }
+ }
+ Double_t *w0 = &fWpow[0];
+ for(Int_t j=0;j<nTracks;j++){w0[j] = 1.;}
+ for(Int_t k=1;k<kNk;k++)
+ {
+  const Double_t *wkm1 = w0+(k-1)*nTracks;
+  Double_t *wk = w0+k*nTracks;
+  for(Int_t j=0;j<nTracks;j++){wk[j] = wkm1[j]*w[j];}
+ }
+
+ // b) Integrated Q-vector (RPs only):
+ for(Int_t k=0;k<kNk;k++)
+ {
+  const Double_t *wk = w0+k*nTracks;
+  Double_t s = 0.;
+  for(Int_t j=0;j<nTracks;j++){s += rp[j]*wk[j];}
+  fS[k] = s;
+  for(Int_t m=0;m<kNm;m++)
+  {
+   const Double_t *cm = c1+m*nTracks;
+   const Double_t *sm = s1+m*nTracks;
+   Double_t re = 0., im = 0.;
+   for(Int_t j=0;j<nTracks;j++)
+   {
+    Double_t a = rp[j]*wk[j];
+    re += a*cm[j];
+    im += a*sm[j];
+   }
+   fReQ[m][k] = re;
+   fImQ[m][k] = im;
+  } // for(Int_t m=0;m<kNm;m++)
+ } // for(Int_t k=0;k<kNk;k++)
+
+} // void AliFlowQvectorKernel::Calculate(Int_t n)
+
+//================================================================================================================
+
+void AliFlowQvectorKernel::AddQvector(TMatrixD *reQ, TMatrixD *imQ, TMatrixD *spk) const
+{
+ // Add the integrated Q-vector of this event to Re[Q_{m*n,k}], Im[Q_{m*n,k}] and S_{p,k} (before the power p+1).
+
+ for(Int_t m=0;m<kNm;m++)
+ {
+  for(Int_t k=0;k<kNk;k++)
+  {
+   (*reQ)(m,k) += fReQ[m][k];
+   (*imQ)(m,k) += fImQ[m][k];
+  }
+ }
+ for(Int_t p=0;p<spk->GetNrows();p++)
+ {
+  for(Int_t k=0;k<kNk;k++){(*spk)(p,k) += fS[k];}
+ }
+
+} // void AliFlowQvectorKernel::AddQvector(TMatrixD *reQ, TMatrixD *imQ, TMatrixD *spk) const
+
+//================================================================================================================
+
+void AliFlowQvectorKernel::AccumulateDiff(DiffSums &sums, Int_t nCells, Int_t bin, Int_t j, Bool_t bS)
+{
+ // Add track j to the sums of its bin: w^k cos((m+1)*n*phi), w^k sin((m+1)*n*phi) and, if bS, w^k.
+
+ if((Int_t)sums.fSlotOfBin.size() < nCells){sums.fSlotOfBin.resize(nCells,-1);}
+ Int_t slot = sums.fSlotOfBin[bin];
+ if(slot<0)
+ {
+  slot = sums.fBinOfSlot.size();
+  sums.fSlotOfBin[bin] = slot;
+  sums.fBinOfSlot.push_back(bin);
+  sums.fEntries.push_back(0.);
+  sums.fSums.resize(sums.fSums.size()+2*kNSums,0.);
+ }
+ sums.fEntries[slot] += 1.;
+
+ Int_t nTracks = fPhi.size();
+ Double_t *sum = &sums.fSums[2*kNSums*slot];
+ Double_t *sum2 = sum+kNSums;
+ for(Int_t m=0;m<kNmDiff;m++)
+ {
+  Double_t c = fCos[m*nTracks+j];
+  Double_t s = fSin[m*nTracks+j];
+  for(Int_t k=0;k<kNk;k++)
+  {
+   Double_t re = fWpow[k*nTracks+j]*c;
+   Double_t im = fWpow[k*nTracks+j]*s;
+   sum[kReSum+m*kNk+k] += re;
+   sum2[kReSum+m*kNk+k] += re*re;
+   sum[kImSum+m*kNk+k] += im;
+   sum2[kImSum+m*kNk+k] += im*im;
+  }
+ }
+ if(!bS){return;}
+ for(Int_t k=0;k<kNk;k++)
+ {
+  Double_t wk = fWpow[k*nTracks+j];
+  sum[kSSum+k] += wk;
+  sum2[kSSum+k] += wk*wk;
+ }
+
+} // void AliFlowQvectorKernel::AccumulateDiff(DiffSums &sums, Int_t nCells, Int_t bin, Int_t j, Bool_t bS)
+
+//================================================================================================================
+
+template <class P> static void SetProfileBin(P *profile, Int_t bin, Double_t sum, Double_t sum2, Double_t entries)
+{
+ // Set one bin of an (empty) profile as if filled 'entries' times with weight 1.
+
+ profile->SetBinContent(bin,sum); // for profiles the bin content is the sum of weighted values
+ profile->SetBinEntries(bin,entries);
+ profile->GetSumw2()->SetAt(sum2,bin);
+ if(profile->GetBinSumw2()->GetSize()){profile->GetBinSumw2()->SetAt(entries,bin);}
+
+} // template <class P> static void SetProfileBin(P *profile, Int_t bin, Double_t sum, Double_t sum2, Double_t entries)
+
+//================================================================================================================
+
+template <class P> void AliFlowQvectorKernel::FlushDiff(DiffSums &sums, P *re[4][9], P *im[4][9], P *s[9])
+{
+ // Write the sums of all bins hit in this event to the profiles.
+
+ for(UInt_t slot=0;slot<sums.fBinOfSlot.size();slot++)
+ {
+  Int_t bin = sums.fBinOfSlot[slot];
+  Double_t entries = sums.fEntries[slot];
+  const Double_t *sum = &sums.fSums[2*kNSums*slot];
+  const Double_t *sum2 = sum+kNSums;
+  for(Int_t m=0;m<kNmDiff;m++)
+  {
+   for(Int_t k=0;k<kNk;k++)
+   {
+    SetProfileBin(re[m][k],bin,sum[kReSum+m*kNk+k],sum2[kReSum+m*kNk+k],entries);
+    SetProfileBin(im[m][k],bin,sum[kImSum+m*kNk+k],sum2[kImSum+m*kNk+k],entries);
+   }
+  }
+  if(!s){continue;}
+  for(Int_t k=0;k<kNk;k++){SetProfileBin(s[k],bin,sum[kSSum+k],sum2[kSSum+k],entries);}
+ } // for(UInt_t slot=0;slot<sums.fBinOfSlot.size();slot++)
+
+} // template <class P> void AliFlowQvectorKernel::FlushDiff(DiffSums &sums, P *re[4][9], P *im[4][9], P *s[9])
+
+//================================================================================================================
+
+void AliFlowQvectorKernel::FillDiffQvector1D(TProfile *re[3][2][4][9], TProfile *im[3][2][4][9], TProfile *s[3][2][9], Int_t nPtEta)
+{
+ // Fill the e-b-e profiles for r_{m*n,k}, p_{m*n,k}, q_{m*n,k} and s_{p,k} vs pt (and eta) of AliFlowAnalysisWithQCumulants,
+ // which shall be empty. As in AliFlowAnalysisWithQCumulants::Make(), s_{p,k} is not filled for POIs.
+
+ Int_t nTracks = fPhi.size();
+ for(Int_t pe=0;pe<nPtEta;pe++) // pt or eta
+ {
+  TAxis *axis = re[0][pe][0][0]->GetXaxis();
+  Int_t nCells = re[0][pe][0][0]->GetNcells();
+  const std::vector<Double_t> &x = (0==pe ? fPt : fEta);
+  for(Int_t j=0;j<nTracks;j++)
+  {
+   Int_t bin = axis->FindBin(x[j]);
+   if(fType[j] & 1) // RP
+   {
+    AccumulateDiff(fDiff1D[0][pe],nCells,bin,j,kTRUE);
+    if(fType[j] & 2){AccumulateDiff(fDiff1D[2][pe],nCells,bin,j,kTRUE);} // RP && POI
+   }
+   if(fType[j] & 2){AccumulateDiff(fDiff1D[1][pe],nCells,bin,j,kFALSE);} // POI
+  }
+  for(Int_t t=0;t<3;t++){FlushDiff(fDiff1D[t][pe],re[t][pe],im[t][pe],(1==t ? NULL : s[t][pe]));}
+ } // for(Int_t pe=0;pe<nPtEta;pe++) // pt or eta
+
+} // void AliFlowQvectorKernel::FillDiffQvector1D(TProfile *re[3][2][4][9], TProfile *im[3][2][4][9], TProfile *s[3][2][9], Int_t nPtEta)
+
+//================================================================================================================
+
+void AliFlowQvectorKernel::FillDiffQvector2D(TProfile2D *re[3][4][9], TProfile2D *im[3][4][9], TProfile2D *s[3][9])
+{
+ // Fill the e-b-e profiles for r_{m*n,k}, p_{m*n,k}, q_{m*n,k} and s_{p,k} vs (pt,eta) of AliFlowAnalysisWithQCumulants,
+ // which shall be empty. As in AliFlowAnalysisWithQCumulants::Make(), s_{p,k} is not filled for POIs.
+
+ Int_t nTracks = fPhi.size();
+ TProfile2D *profile = re[0][0][0];
+ Int_t nCells = profile->GetNcells();
+ for(Int_t j=0;j<nTracks;j++)
+ {
+  Int_t bin = profile->GetBin(profile->GetXaxis()->FindBin(fPt[j]),profile->GetYaxis()->FindBin(fEta[j]));
+  if(fType[j] & 1) // RP
+  {
+   AccumulateDiff(fDiff2D[0],nCells,bin,j,kTRUE);
+   if(fType[j] & 2){AccumulateDiff(fDiff2D[2],nCells,bin,j,kTRUE);} // RP && POI
+  }
+  if(fType[j] & 2){AccumulateDiff(fDiff2D[1],nCells,bin,j,kFALSE);} // POI
+ }
+ for(Int_t t=0;t<3;t++){FlushDiff(fDiff2D[t],re[t],im[t],(1==t ? NULL : s[t]));}
+
+} // void AliFlowQvectorKernel::FillDiffQvector2D(TProfile2D *re[3][4][9], TProfile2D *im[3][4][9], TProfile2D *s[3][9])
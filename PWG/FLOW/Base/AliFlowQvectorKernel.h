@@ -0,0 +1,79 @@
+/*
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.
+ * See cxx source for full Copyright notice
+ * $Id$
+ */
+
+ /***************************************
+ * Q-vector components of one event from *
+ * contiguous arrays of tracks, for      *
+ * AliFlowAnalysisWithQCumulants         *
+ ***************************************/
+
+#ifndef ALIFLOWQVECTORKERNEL_H
+#define ALIFLOWQVECTORKERNEL_H
+
+#include <vector>
+
+#include "Rtypes.h"
+
+class TProfile;
+class TProfile2D;
+class TMatrixD;
+
+class AliFlowQvectorKernel{
+ public:
+  AliFlowQvectorKernel();
+  virtual ~AliFlowQvectorKernel();
+
+  // For each event:
+  void Clear(); // start a new event
+  void AddTrack(Double_t phi, Double_t pt, Double_t eta, Double_t w, Bool_t bRP, Bool_t bPOI); // w = product of all particle weights
+  void Calculate(Int_t n); // cos and sin of m*n*phi (m = 1,...,12) and w^k (k = 0,...,8) for all tracks
+  void AddQvector(TMatrixD *reQ, TMatrixD *imQ, TMatrixD *spk) const; // Q_{m*n,k} and S_{p,k} before taking the power p+1
+  void FillDiffQvector1D(TProfile *re[3][2][4][9], TProfile *im[3][2][4][9], TProfile *s[3][2][9], Int_t nPtEta);
+  void FillDiffQvector2D(TProfile2D *re[3][4][9], TProfile2D *im[3][4][9], TProfile2D *s[3][9]);
+
+  Int_t GetNTracks() const {return fPhi.size();};
+
+  enum {kNm = 12, kNmDiff = 4, kNk = 9}; // multiples of harmonic, for differential flow, powers of particle weight
+
+ private:
+  AliFlowQvectorKernel(const AliFlowQvectorKernel& other);
+  AliFlowQvectorKernel& operator=(const AliFlowQvectorKernel& other);
+
+  // Per-bin sums of one type of particles [0=RP,1=POI,2=RP&&POI] in pt, eta or (pt,eta) bins:
+  // the bins hit in this event get a slot, each slot holds all sums for this bin.
+  enum {kReSum = 0, kImSum = kNmDiff*kNk, kSSum = 2*kNmDiff*kNk, kNSums = 2*kNmDiff*kNk+kNk}; // sums in a slot, followed by their squares
+  struct DiffSums {
+   std::vector<Int_t> fSlotOfBin;  // slot of each global bin, -1 if not hit
+   std::vector<Int_t> fBinOfSlot;  // global bin of each slot
+   std::vector<Double_t> fEntries; // number of particles in each slot
+   std::vector<Double_t> fSums;    // per slot kNSums sums, followed by the kNSums sums of squares
+  };
+
+  void AccumulateDiff(DiffSums &sums, Int_t nCells, Int_t bin, Int_t j, Bool_t bS);
+  template <class P> void FlushDiff(DiffSums &sums, P *re[4][9], P *im[4][9], P *s[9]); // P = TProfile or TProfile2D
+  static void ClearDiff(DiffSums &sums);
+
+  // Tracks, in the order they were added:
+  std::vector<Double_t> fPhi; // azimuthal angle
+  std::vector<Double_t> fPt;  // transverse momentum
+  std::vector<Double_t> fEta; // pseudorapidity
+  std::vector<Double_t> fW;   // particle weight
+  std::vector<Double_t> fRP;  // 1 for RPs, 0 otherwise
+  std::vector<Char_t> fType;  // bit 0: RP, bit 1: POI
+  // Per-track terms, [m or k][track]:
+  std::vector<Double_t> fCos;  // cos((m+1)*n*phi)
+  std::vector<Double_t> fSin;  // sin((m+1)*n*phi)
+  std::vector<Double_t> fWpow; // w^k
+  // Integrated Q-vector:
+  Double_t fReQ[kNm][kNk]; // sum over RPs of w^k cos((m+1)*n*phi)
+  Double_t fImQ[kNm][kNk]; // sum over RPs of w^k sin((m+1)*n*phi)
+  Double_t fS[kNk];        // sum over RPs of w^k
+  // Differential Q-vectors:
+  DiffSums fDiff1D[3][2]; // [0=RP,1=POI,2=RP&&POI][0=pt,1=eta]
+  DiffSums fDiff2D[3];    // [0=RP,1=POI,2=RP&&POI]
+};
+
+#endif
@@ -0,0 +1,338 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+ /**************************************
+ * subsample sums of multi-particle     *
+ * correlators and bootstrap/jackknife  *
+ * errors of the cumulants and flow     *
+ **************************************/
+
+// Each event is put in one of fNSubsamples random subsamples; per bin, subsample
+// and order only the sum of the event weights and of the weighted correlators are
+// kept, i.e. 2*nBins*nSubsamples*nOrders numbers instead of one profile per
+// subsample. Both sums are additive, hence Merge() just adds them, and Evaluate()
+// can be called again on the merged object.
+//
+// Evaluate() calculates in each bin the cumulants and flow of the full sample and
+// their errors from
+//  - jackknife: the spread of the results with one subsample left out,
+//  - bootstrap: the spread of the results of fNReplicas samples of fNSubsamples
+//    subsamples drawn with replacement; the draws depend only on fSeed and are the
+//    same in all bins, so the result does not depend on the number of threads.
+// The bins are distributed over the threads; each bin is written by one thread only.
+
+#include "AliFlowResampling.h"
+
+#include <thread>
+#include <vector>
+
+#include "TCollection.h"
+#include "TMath.h"
+#include "TRandom3.h"
+
+#include <Riostream.h>
+
+using std::cout;
+using std::endl;
+
+ClassImp(AliFlowResampling)
+
+//================================================================================================================
+
+AliFlowResampling::AliFlowResampling():
+ TNamed(),
+ fNBins(0),
+ fNOrders(0),
+ fNSubsamples(0),
+ fNReplicas(0),
+ fSeed(0),
+ fSumW(),
+ fSumWX(),
+ fCumulant(),
+ fCumulantError(),
+ fFlow(),
+ fFlowError(),
+ fCounts()
+ {
+  // Default constructor (for ROOT I/O).
+
+ } // AliFlowResampling::AliFlowResampling()
+
+//================================================================================================================
+
+AliFlowResampling::AliFlowResampling(const char *name, Int_t nBins, Int_t nOrders, Int_t nSubsamples, Int_t nReplicas, UInt_t seed):
+ TNamed(name,"Subsample sums of correlators for bootstrap and jackknife errors"),
+ fNBins(nBins),
+ fNOrders(TMath::Min(nOrders,(Int_t)kMaxOrders)),
+ fNSubsamples(nSubsamples),
+ fNReplicas(nReplicas),
+ fSeed(seed),
+ fSumW(nBins*nSubsamples*TMath::Min(nOrders,(Int_t)kMaxOrders)),
+ fSumWX(nBins*nSubsamples*TMath::Min(nOrders,(Int_t)kMaxOrders)),
+ fCumulant(nBins*TMath::Min(nOrders,(Int_t)kMaxOrders)),
+ fCumulantError(kNMethods*nBins*TMath::Min(nOrders,(Int_t)kMaxOrders)),
+ fFlow(nBins*TMath::Min(nOrders,(Int_t)kMaxOrders)),
+ fFlowError(kNMethods*nBins*TMath::Min(nOrders,(Int_t)kMaxOrders)),
+ fCounts()
+ {
+  // Constructor.
+
+ } // AliFlowResampling::AliFlowResampling(...)
+
+//================================================================================================================
+
+AliFlowResampling::~AliFlowResampling()
+{
+ // Destructor.
+
+} // AliFlowResampling::~AliFlowResampling()
+
+//================================================================================================================
+
+void AliFlowResampling::Fill(Int_t subsample, Int_t bin, const Double_t *correlators, const Double_t *weights)
+{
+ // Add the correlators of one event, orders with zero weight are not filled.
+
+ if(bin<0 || bin>=fNBins || subsample<0 || subsample>=fNSubsamples){return;}
+
+ Int_t offset = (bin*fNSubsamples+subsample)*fNOrders;
+ for(Int_t o=0;o<fNOrders;o++)
+ {
+  if(!(weights[o]>0.)){continue;}
+  fSumW[offset+o] += weights[o];
+  fSumWX[offset+o] += weights[o]*correlators[o];
+ }
+
+} // void AliFlowResampling::Fill(Int_t subsample, Int_t bin, const Double_t *correlators, const Double_t *weights)
+
+//================================================================================================================
+
+void AliFlowResampling::Clear(Option_t * /*option*/)
+{
+ // Remove all entries and results.
+
+ fSumW.Reset();
+ fSumWX.Reset();
+ fCumulant.Reset();
+ fCumulantError.Reset();
+ fFlow.Reset();
+ fFlowError.Reset();
+
+} // void AliFlowResampling::Clear(Option_t *option)
+
+//================================================================================================================
+
+Long64_t AliFlowResampling::Merge(TCollection *list)
+{
+ // Add the sums of all objects in list, the results have to be evaluated again.
+
+ if(!list){return 0;}
+ if(list->IsEmpty()){return (Long64_t)fSumW.GetSum();}
+
+ TIter next(list);
+ TObject *obj = NULL;
+ while((obj = next()))
+ {
+  AliFlowResampling *other = dynamic_cast<AliFlowResampling*>(obj);
+  if(!other){continue;}
+  if(other->fNBins!=fNBins || other->fNOrders!=fNOrders || other->fNSubsamples!=fNSubsamples)
+  {
+   cout<<"WARNING: "<<other->GetName()<<" has different binning, not merged in AFR::Merge() !!!!"<<endl;
+   continue;
+  }
+  for(Int_t i=0;i<fSumW.GetSize();i++)
+  {
+   fSumW[i] += other->fSumW[i];
+   fSumWX[i] += other->fSumWX[i];
+  }
+ } // end of while((obj = next()))
+
+ return (Long64_t)fSumW.GetSum();
+
+} // Long64_t AliFlowResampling::Merge(TCollection *list)
+
+//================================================================================================================
+
+void AliFlowResampling::Evaluate(Int_t nThreads)
+{
+ // a) Draw the bootstrap replicas;
+ // b) Evaluate the bins in parallel.
+
+ if(fNBins<=0 || fNOrders<=0 || fNSubsamples<=0){return;}
+
+ // a) Draw the bootstrap replicas:
+ fCounts.Set(fNReplicas*fNSubsamples);
+ fCounts.Reset();
+ TRandom3 random(fSeed);
+ for(Int_t r=0;r<fNReplicas;r++)
+ {
+  for(Int_t s=0;s<fNSubsamples;s++)
+  {
+   fCounts[r*fNSubsamples+random.Integer(fNSubsamples)]++;
+  }
+ }
+
+ // b) Evaluate the bins in parallel:
+ if(nThreads<=0){nThreads = std::thread::hardware_concurrency();}
+ nThreads = TMath::Max(1,TMath::Min(nThreads,fNBins));
+ if(nThreads==1)
+ {
+  for(Int_t b=0;b<fNBins;b++){EvaluateBin(b);}
+  return;
+ }
+ std::vector<std::thread> workers;
+ for(Int_t t=0;t<nThreads;t++)
+ {
+  workers.push_back(std::thread([this, t, nThreads]() {for(Int_t b=t;b<fNBins;b+=nThreads){EvaluateBin(b);}}));
+ }
+ for(UInt_t t=0;t<workers.size();t++){workers[t].join();}
+
+} // void AliFlowResampling::Evaluate(Int_t nThreads)
+
+//================================================================================================================
+
+void AliFlowResampling::CorrelatorsOf(Int_t bin, const Int_t *counts, Int_t leftOut, Double_t *correlators, Bool_t *filled) const
+{
+ // Average correlators of the subsamples, each taken counts[s] times (once if counts is NULL),
+ // without subsample leftOut (if >= 0).
+
+ Double_t sumW[kMaxOrders] = {0.};
+ Double_t sumWX[kMaxOrders] = {0.};
+ for(Int_t s=0;s<fNSubsamples;s++)
+ {
+  if(s==leftOut){continue;}
+  Double_t n = counts ? counts[s] : 1.;
+  if(n==0.){continue;}
+  Int_t offset = (bin*fNSubsamples+s)*fNOrders;
+  for(Int_t o=0;o<fNOrders;o++)
+  {
+   sumW[o] += n*fSumW[offset+o];
+   sumWX[o] += n*fSumWX[offset+o];
+  }
+ }
+ for(Int_t o=0;o<fNOrders;o++)
+ {
+  filled[o] = sumW[o]>0.;
+  correlators[o] = filled[o] ? sumWX[o]/sumW[o] : 0.;
+ }
+
+} // void AliFlowResampling::CorrelatorsOf(...) const
+
+//================================================================================================================
+
+void AliFlowResampling::EvaluateBin(Int_t bin)
+{
+ // a) Full sample;
+ // b) Jackknife;
+ // c) Bootstrap.
+
+ Double_t correlators[kMaxOrders] = {0.};
+ Double_t cumulants[kMaxOrders] = {0.};
+ Bool_t filled[kMaxOrders] = {kFALSE};
+
+ // a) Full sample:
+ CorrelatorsOf(bin,NULL,-1,correlators,filled);
+ CalculateCumulants(correlators,fNOrders,cumulants);
+ for(Int_t o=0;o<fNOrders;o++)
+ {
+  Double_t flow = 0.;
+  CalculateFlow(cumulants[o],o,flow);
+  fCumulant[Index(bin,o)] = cumulants[o];
+  fFlow[Index(bin,o)] = flow;
+ }
+
+ // b) Jackknife and c) bootstrap, running sums of the results and of their squares:
+ for(Int_t m=0;m<kNMethods;m++)
+ {
+  Int_t nSamples = (m==kJackknife) ? fNSubsamples : fNReplicas;
+  Double_t nCumulant[kMaxOrders] = {0.}, sumCumulant[kMaxOrders] = {0.}, sumCumulant2[kMaxOrders] = {0.};
+  Double_t nFlow[kMaxOrders] = {0.}, sumFlow[kMaxOrders] = {0.}, sumFlow2[kMaxOrders] = {0.};
+  for(Int_t i=0;i<nSamples;i++)
+  {
+   if(m==kJackknife){CorrelatorsOf(bin,NULL,i,correlators,filled);}
+   else{CorrelatorsOf(bin,fCounts.GetArray()+i*fNSubsamples,-1,correlators,filled);}
+   CalculateCumulants(correlators,fNOrders,cumulants);
+   for(Int_t o=0;o<fNOrders;o++)
+   {
+    if(!filled[o]){continue;}
+    nCumulant[o] += 1.;
+    sumCumulant[o] += cumulants[o];
+    sumCumulant2[o] += cumulants[o]*cumulants[o];
+    Double_t flow = 0.;
+    if(!CalculateFlow(cumulants[o],o,flow)){continue;}
+    nFlow[o] += 1.;
+    sumFlow[o] += flow;
+    sumFlow2[o] += flow*flow;
+   }
+  } // end of for(Int_t i=0;i<nSamples;i++)
+  for(Int_t o=0;o<fNOrders;o++)
+  {
+   // jackknife: sqrt((n-1)/n*sum(x_i-<x>)^2), bootstrap: sqrt(sum(x_i-<x>)^2/(n-1))
+   Double_t errorCumulant = 0., errorFlow = 0.;
+   if(nCumulant[o]>1.)
+   {
+    Double_t ss = TMath::Max(0.,sumCumulant2[o]-sumCumulant[o]*sumCumulant[o]/nCumulant[o]);
+    errorCumulant = (m==kJackknife) ? TMath::Sqrt((nCumulant[o]-1.)/nCumulant[o]*ss) : TMath::Sqrt(ss/(nCumulant[o]-1.));
+   }
+   if(nFlow[o]>1.)
+   {
+    Double_t ss = TMath::Max(0.,sumFlow2[o]-sumFlow[o]*sumFlow[o]/nFlow[o]);
+    errorFlow = (m==kJackknife) ? TMath::Sqrt((nFlow[o]-1.)/nFlow[o]*ss) : TMath::Sqrt(ss/(nFlow[o]-1.));
+   }
+   fCumulantError[m*fNBins*fNOrders+Index(bin,o)] = errorCumulant;
+   fFlowError[m*fNBins*fNOrders+Index(bin,o)] = errorFlow;
+  }
+ } // end of for(Int_t m=0;m<kNMethods;m++)
+
+} // void AliFlowResampling::EvaluateBin(Int_t bin)
+
+//================================================================================================================
+
+void AliFlowResampling::CalculateCumulants(const Double_t *correlators, Int_t nOrders, Double_t *cumulants)
+{
+ // QC{2}, QC{4}, QC{6} and QC{8} as in AliFlowAnalysisWithQCumulants::CalculateCumulantsForBootstrap().
+
+ Double_t two = nOrders>0 ? correlators[0] : 0.;
+ Double_t four = nOrders>1 ? correlators[1] : 0.;
+ Double_t six = nOrders>2 ? correlators[2] : 0.;
+ Double_t eight = nOrders>3 ? correlators[3] : 0.;
+ Double_t qc[kMaxOrders] = {0.};
+ if(TMath::Abs(two) > 0.){qc[0] = two;}
+ if(TMath::Abs(four) > 0.){qc[1] = four-2.*pow(two,2.);}
+ if(TMath::Abs(six) > 0.){qc[2] = six-9.*two*four+12.*pow(two,3.);}
+ if(TMath::Abs(eight) > 0.){qc[3] = eight-16.*two*six-18.*pow(four,2.)+144.*pow(two,2.)*four-144.*pow(two,4.);}
+ for(Int_t o=0;o<nOrders && o<kMaxOrders;o++){cumulants[o] = qc[o];}
+
+} // void AliFlowResampling::CalculateCumulants(const Double_t *correlators, Int_t nOrders, Double_t *cumulants)
+
+//================================================================================================================
+
+Bool_t AliFlowResampling::CalculateFlow(Double_t cumulant, Int_t order, Double_t &flow)
+{
+ // v{2}, v{4}, v{6} and v{8} as in AliFlowAnalysisWithQCumulants::CalculateReferenceFlow(), kFALSE for the wrong sign.
+
+ flow = 0.;
+ switch(order)
+ {
+  case 0: if(cumulant>0.){flow = pow(cumulant,0.5);} break;
+  case 1: if(cumulant<0.){flow = pow(-1.*cumulant,1./4.);} break;
+  case 2: if(cumulant>0.){flow = pow((1./4.)*cumulant,1./6.);} break;
+  case 3: if(cumulant<0.){flow = pow((-1./33.)*cumulant,1./8.);} break;
+  default: break;
+ }
+
+ return flow>0.;
+
+} // Bool_t AliFlowResampling::CalculateFlow(Double_t cumulant, Int_t order, Double_t &flow)
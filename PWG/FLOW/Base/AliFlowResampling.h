@@ -0,0 +1,78 @@
+/*
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.
+ * See cxx source for full Copyright notice
+ * $Id$
+ */
+
+ /**************************************
+ * subsample sums of multi-particle     *
+ * correlators and bootstrap/jackknife  *
+ * errors of the cumulants and flow     *
+ **************************************/
+
+#ifndef ALIFLOWRESAMPLING_H
+#define ALIFLOWRESAMPLING_H
+
+#include "TNamed.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
+
+class TCollection;
+
+class AliFlowResampling: public TNamed{
+ public:
+  AliFlowResampling();
+  AliFlowResampling(const char *name, Int_t nBins, Int_t nOrders, Int_t nSubsamples, Int_t nReplicas = 1000, UInt_t seed = 12345);
+  virtual ~AliFlowResampling();
+
+  enum EMethod {kJackknife = 0, kBootstrap = 1, kNMethods = 2};
+  enum {kMaxOrders = 4}; // <2>, <4>, <6> and <8>
+
+  // For each event:
+  void Fill(Int_t subsample, Int_t bin, const Double_t *correlators, const Double_t *weights); // [order], order = 0 for <2>, ...
+
+  // At terminate or after merging:
+  void Evaluate(Int_t nThreads = 0); // 0 = one thread per core
+  virtual Long64_t Merge(TCollection *list);
+  virtual void Clear(Option_t *option = "");
+
+  // Results of the last Evaluate(), the value is the one of the full sample:
+  Double_t GetCumulant(Int_t bin, Int_t order) const {return fCumulant[Index(bin,order)];};
+  Double_t GetCumulantError(Int_t bin, Int_t order, Int_t method) const {return fCumulantError[method*fNBins*fNOrders+Index(bin,order)];};
+  Double_t GetFlow(Int_t bin, Int_t order) const {return fFlow[Index(bin,order)];};
+  Double_t GetFlowError(Int_t bin, Int_t order, Int_t method) const {return fFlowError[method*fNBins*fNOrders+Index(bin,order)];};
+
+  Int_t GetNBins() const {return fNBins;};
+  Int_t GetNOrders() const {return fNOrders;};
+  Int_t GetNSubsamples() const {return fNSubsamples;};
+  Int_t GetNReplicas() const {return fNReplicas;};
+
+  // Cumulants QC{2}, ..., QC{2*(nOrders)} from <2>, ..., <2*(nOrders)> and the flow estimates from them:
+  static void CalculateCumulants(const Double_t *correlators, Int_t nOrders, Double_t *cumulants);
+  static Bool_t CalculateFlow(Double_t cumulant, Int_t order, Double_t &flow);
+
+ private:
+  AliFlowResampling(const AliFlowResampling& other);
+  AliFlowResampling& operator=(const AliFlowResampling& other);
+
+  Int_t Index(Int_t bin, Int_t order) const {return bin*fNOrders+order;};
+  void EvaluateBin(Int_t bin);
+  void CorrelatorsOf(Int_t bin, const Int_t *counts, Int_t leftOut, Double_t *correlators, Bool_t *filled) const;
+
+  Int_t fNBins;       // bins (e.g. 0 = integrated, 1, 2, ... = multiplicity bins)
+  Int_t fNOrders;     // correlators per bin
+  Int_t fNSubsamples; // subsamples the events are distributed over
+  Int_t fNReplicas;   // bootstrap replicas
+  UInt_t fSeed;       // seed of the bootstrap replicas, same replicas for all bins
+  TArrayD fSumW;      // [bin][subsample][order] sum of event weights
+  TArrayD fSumWX;     // [bin][subsample][order] sum of event weight times correlator
+  TArrayD fCumulant;      // [bin][order] cumulant of the full sample
+  TArrayD fCumulantError; // [method][bin][order]
+  TArrayD fFlow;          // [bin][order] flow from the cumulant of the full sample, 0 for wrong sign
+  TArrayD fFlowError;     // [method][bin][order]
+  TArrayI fCounts; //! [replica][subsample] number of times a subsample is drawn in a bootstrap replica
+
+  ClassDef(AliFlowResampling,1);
+};
+
+#endif
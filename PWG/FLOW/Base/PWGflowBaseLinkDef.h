@@ -10,6 +10,7 @@
 #pragma link C++ class AliFlowVector+;
 #pragma link C++ class AliFlowTrackSimple+;
 #pragma link C++ class AliFlowEventSimple+;
+#pragma link C++ class AliFlowEventFlat+;
 
 #pragma link C++ class AliStarTrack+;
 #pragma link C++ class AliStarEvent+;
@@ -25,6 +26,7 @@
 
 #pragma link C++ class AliFlowCommonHist+;
 #pragma link C++ class AliFlowCommonHistResults+;
+#pragma link C++ class AliFlowResampling+;
 #pragma link C++ class AliFlowLYZHist1+;
 #pragma link C++ class AliFlowLYZHist2+;
 
@@ -67,6 +67,7 @@ AliAnalysisTaskMultiparticleCorrelations::AliAnalysisTaskMultiparticleCorrelatio
  fCalculateOnlyForSC(kFALSE),
  fCalculateOnlyCos(kFALSE),
  fCalculateOnlySin(kFALSE),
+ fUseCorrelatorEngine(kFALSE),
  fCalculateEbECumulants(kFALSE),
  fCrossCheckWithNestedLoops(kFALSE),
  fCrossCheckDiffWithNestedLoops(kFALSE),
@@ -199,6 +200,7 @@ AliAnalysisTaskMultiparticleCorrelations::AliAnalysisTaskMultiparticleCorrelatio
  fCalculateOnlyForSC(kFALSE),
  fCalculateOnlyCos(kFALSE),
  fCalculateOnlySin(kFALSE),
+ fUseCorrelatorEngine(kFALSE),
  fCalculateEbECumulants(kFALSE),
  fCrossCheckWithNestedLoops(kFALSE),
  fCrossCheckDiffWithNestedLoops(kFALSE),
@@ -323,6 +325,7 @@ void AliAnalysisTaskMultiparticleCorrelations::UserCreateOutputObjects()
  fMPC->SetCalculateOnlyForSC(fCalculateOnlyForSC);
  fMPC->SetCalculateOnlyCos(fCalculateOnlyCos);
  fMPC->SetCalculateOnlySin(fCalculateOnlySin);
+ fMPC->SetUseCorrelatorEngine(fUseCorrelatorEngine);
  fMPC->SetCalculateEbECumulants(fCalculateEbECumulants);
  fMPC->SetCrossCheckWithNestedLoops(fCrossCheckWithNestedLoops);
  fMPC->SetCrossCheckDiffWithNestedLoops(fCrossCheckDiffWithNestedLoops);
@@ -105,6 +105,8 @@ class AliAnalysisTaskMultiparticleCorrelations : public AliAnalysisTaskSE{
   Bool_t GetCalculateOnlyCos() const {return this->fCalculateOnlyCos;};
   void SetCalculateOnlySin(Bool_t cos) {this->fCalculateOnlySin = cos;};
   Bool_t GetCalculateOnlySin() const {return this->fCalculateOnlySin;};
+  void SetUseCorrelatorEngine(Bool_t uce) {this->fUseCorrelatorEngine = uce;};
+  Bool_t GetUseCorrelatorEngine() const {return this->fUseCorrelatorEngine;};
 
   // Event-by-event cumulants:
   void SetCalculateEbECumulants(Bool_t cebec) {this->fCalculateEbECumulants = cebec;};
@@ -216,6 +218,7 @@ class AliAnalysisTaskMultiparticleCorrelations : public AliAnalysisTaskSE{
   Bool_t fCalculateOnlyForSC;         // calculate only correlations needed for 'standard candles'
   Bool_t fCalculateOnlyCos;           // calculate only 'cos' correlations
   Bool_t fCalculateOnlySin;           // calculate only 'sin' correlations
+  Bool_t fUseCorrelatorEngine;        // calculate all booked correlations at once from shared sub-terms
 
   // Event-by-event cumulants:
   Bool_t fCalculateEbECumulants; // calculate and store event-by-event cumulants
@@ -249,7 +252,7 @@ class AliAnalysisTaskMultiparticleCorrelations : public AliAnalysisTaskSE{
   // Eta gaps:
   Bool_t fCalculateEtaGaps; // calculate correlations with eta gaps
 
-  ClassDef(AliAnalysisTaskMultiparticleCorrelations,6);
+  ClassDef(AliAnalysisTaskMultiparticleCorrelations,7);
 
 };
 
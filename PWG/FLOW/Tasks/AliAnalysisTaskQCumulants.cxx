@@ -70,6 +70,7 @@ AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(const char *name, Bool_t us
  fUse2DHistograms(kFALSE),
  fFillProfilesVsMUsingWeights(kTRUE),
  fUseQvectorTerms(kFALSE),
+ fUseQvectorKernel(kFALSE),
  fnBinsMult(10000),
  fMinMult(0.),  
  fMaxMult(10000.), 
@@ -84,7 +85,9 @@ AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(const char *name, Bool_t us
  fnBinsForCorrelations(10000),
  fUseBootstrap(kFALSE),
  fUseBootstrapVsM(kFALSE),
- fnSubsamples(10)
+ fnSubsamples(10),
+ fUseResampling(kFALSE),
+ fnResamplingThreads(0)
 {
  // constructor
  AliDebug(2,"AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(const char *name, Bool_t useParticleWeights)");
@@ -168,6 +171,7 @@ AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants():
  fUse2DHistograms(kFALSE),
  fFillProfilesVsMUsingWeights(kTRUE),
  fUseQvectorTerms(kFALSE),
+ fUseQvectorKernel(kFALSE),
  fnBinsMult(0),
  fMinMult(0.),  
  fMaxMult(0.), 
@@ -182,7 +186,9 @@ AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants():
  fnBinsForCorrelations(0), 
  fUseBootstrap(kFALSE),
  fUseBootstrapVsM(kFALSE),
- fnSubsamples(10)
+ fnSubsamples(10),
+ fUseResampling(kFALSE),
+ fnResamplingThreads(0)
 
 {
  // Dummy constructor
@@ -283,6 +289,7 @@ void AliAnalysisTaskQCumulants::UserCreateOutputObjects()
  fQC->SetUse2DHistograms(fUse2DHistograms);
  fQC->SetFillProfilesVsMUsingWeights(fFillProfilesVsMUsingWeights);
  fQC->SetUseQvectorTerms(fUseQvectorTerms);
+ fQC->SetUseQvectorKernel(fUseQvectorKernel);
 
  // Store phi distribution for one event to illustrate flow:
  fQC->SetStorePhiDistributionForOneEvent(fStorePhiDistributionForOneEvent);
@@ -316,6 +323,8 @@ void AliAnalysisTaskQCumulants::UserCreateOutputObjects()
  fQC->SetUseBootstrap(fUseBootstrap);
  fQC->SetUseBootstrapVsM(fUseBootstrapVsM);
  fQC->SetnSubsamples(fnSubsamples);
+ fQC->SetUseResampling(fUseResampling);
+ fQC->SetnResamplingThreads(fnResamplingThreads);
 
  fQC->Init();
  
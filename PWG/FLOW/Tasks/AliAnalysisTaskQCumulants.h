@@ -87,6 +87,8 @@ class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
   Bool_t GetFillProfilesVsMUsingWeights() const {return this->fFillProfilesVsMUsingWeights;};
   void SetUseQvectorTerms(Bool_t const uqvt){this->fUseQvectorTerms = uqvt;if(uqvt){this->fStoreControlHistograms = kTRUE;}};
   Bool_t GetUseQvectorTerms() const {return this->fUseQvectorTerms;};
+  void SetUseQvectorKernel(Bool_t const uqvk){this->fUseQvectorKernel = uqvk;};
+  Bool_t GetUseQvectorKernel() const {return this->fUseQvectorKernel;};
  
   // Multiparticle correlations vs multiplicity:
   void SetnBinsMult(Int_t const nbm) {this->fnBinsMult = nbm;};
@@ -132,6 +134,10 @@ class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
   Bool_t GetUseBootstrapVsM() const {return this->fUseBootstrapVsM;};
   void SetnSubsamples(Int_t const ns) {this->fnSubsamples = ns;};
   Int_t GetnSubsamples() const {return this->fnSubsamples;};
+  void SetUseResampling(Bool_t const ur) {this->fUseResampling = ur;};
+  Bool_t GetUseResampling() const {return this->fUseResampling;};
+  void SetnResamplingThreads(Int_t const nrt) {this->fnResamplingThreads = nrt;};
+  Int_t GetnResamplingThreads() const {return this->fnResamplingThreads;};
 
  private:
   AliAnalysisTaskQCumulants(const AliAnalysisTaskQCumulants& aatqc);
@@ -165,6 +171,7 @@ class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
   Bool_t fUse2DHistograms;               // use TH2D instead of TProfile to improve numerical stability in reference flow calculation   
   Bool_t fFillProfilesVsMUsingWeights;   // if the width of multiplicity bin is 1, weights are not needed   
   Bool_t fUseQvectorTerms; // use TH2D with separate Q-vector terms instead of TProfile to improve numerical stability in reference flow calculation    
+  Bool_t fUseQvectorKernel; // calculate e-b-e Q-vectors from contiguous arrays of all tracks (AliFlowQvectorKernel)
   // Multiparticle correlations vs multiplicity:
   Int_t fnBinsMult;                   // number of multiplicity bins for flow analysis versus multiplicity  
   Double_t fMinMult;                  // minimal multiplicity for flow analysis versus multiplicity  
@@ -191,8 +198,10 @@ class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
   Bool_t fUseBootstrap; // use bootstrap to estimate statistical spread
   Bool_t fUseBootstrapVsM; // use bootstrap to estimate statistical spread for results vs M
   Int_t fnSubsamples; // number of subsamples (SS), by default 10
+  Bool_t fUseResampling; // jackknife and bootstrap errors from subsample sums (AliFlowResampling)
+  Int_t fnResamplingThreads; // threads for evaluating the resampling errors, 0 = one per core
   
-  ClassDef(AliAnalysisTaskQCumulants, 2); 
+  ClassDef(AliAnalysisTaskQCumulants, 4); 
 };
 
 //================================================================================================================
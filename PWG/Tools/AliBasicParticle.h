@@ -51,7 +51,10 @@ class AliBasicParticle : public AliVParticle
     virtual Bool_t IsEqual(const TObject* obj) const { return (obj->GetUniqueID() == GetUniqueID()); }
     virtual Bool_t IsInSameEvent(const AliBasicParticle* obj) const { return (obj->GetEventIndex() == GetEventIndex()); }
 
+    virtual void SetEta(Double_t eta) { fEta = eta; }
     virtual void SetPhi(Double_t phi) { fPhi = phi; }
+    virtual void SetPt(Double_t pt) { fpT = pt; }
+    virtual void SetCharge(Short_t charge) { fCharge = charge; }
     virtual void SetEventIndex(Long64_t val) { fEventIndex = val; }
 
   private:
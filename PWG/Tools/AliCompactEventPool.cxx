@@ -0,0 +1,616 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// compact event pool for event mixing
+//
+// Usage (the same as for AliEventPoolManager, but the tracks given to UpdatePool are copied):
+//
+//   AliCompactEventPoolManager* mgr = AliCompactEventPoolManager::Attach("poolTPC", "filterBit=768", 0, 5000, nCentralityBins, centralityBins, nZvtxBins, zvtxBins);
+//   mgr->SetTargetValues(5000, 0.1, 5);
+//   ...
+//   AliCompactEventPool* pool = mgr->GetEventPool(centrality, zVtx);
+//   if (pool->IsReady())
+//     for (Int_t jMix=0; jMix<pool->GetCurrentNEvents(); jMix++)
+//       FillCorrelations(tracks, pool->GetEvent(jMix));
+//   pool->UpdatePool(tracks);
+//   ...
+//   mgr->Detach(); // instead of delete
+//
+// Events added with UpdatePool are only visible from the next entry of the analysis manager on. Like this, several tasks
+// can use the same manager in one train: all of them mix with the same events, the event is stored by the first task
+// which calls UpdatePool, for the other tasks UpdatePool does nothing. Without analysis manager the events are added immediately.
+
+#include <algorithm>
+#include <cstring>
+
+#include "AliCompactEventPool.h"
+
+#include "TString.h"
+
+#include "AliBasicParticle.h"
+#include "AliVParticle.h"
+#include "AliAnalysisManager.h"
+#include "AliLog.h"
+
+ClassImp(AliCompactEventPool)
+ClassImp(AliCompactEventPoolManager)
+
+std::vector<AliCompactEventPoolManager*> AliCompactEventPoolManager::fgShared;
+
+//____________________________________________________________________
+AliCompactEventPool::AliCompactEventPool() :
+  TObject(),
+  fManager(0),
+  fMaxEvents(0),
+  fTargetTrackDepth(0),
+  fTargetFraction(1),
+  fMinNEvents(0),
+  fPtMin(-9999.),
+  fPtMax(9999.),
+  fEvents(),
+  fFirst(0),
+  fNEvents(0),
+  fNTracks(0),
+  fPending(),
+  fHasPending(kFALSE),
+  fPendingEntry(-1)
+{
+  // default constructor
+}
+
+//____________________________________________________________________
+AliCompactEventPool::AliCompactEventPool(Int_t maxEvents, Int_t targetTrackDepth, Double_t ptMin, Double_t ptMax, AliCompactEventPoolManager* manager) :
+  TObject(),
+  fManager(manager),
+  fMaxEvents(maxEvents),
+  fTargetTrackDepth(targetTrackDepth),
+  fTargetFraction(1),
+  fMinNEvents(0),
+  fPtMin(ptMin),
+  fPtMax(ptMax),
+  fEvents(),
+  fFirst(0),
+  fNEvents(0),
+  fNTracks(0),
+  fPending(),
+  fHasPending(kFALSE),
+  fPendingEntry(-1)
+{
+  // constructor
+  // at most <maxEvents> events are kept, and only as many as needed to have <targetTrackDepth> tracks (if > 0)
+}
+
+//____________________________________________________________________
+void AliCompactEventPool::SetTargetValues(Int_t trackDepth, Double_t fraction, Int_t minNEvents)
+{
+  // the pool keeps the most recent events which are needed to have <trackDepth> tracks
+  // it is ready for mixing when it has <fraction> * <trackDepth> tracks or <minNEvents> events
+
+  fTargetTrackDepth = trackDepth;
+  fTargetFraction = fraction;
+  fMinNEvents = minNEvents;
+}
+
+//____________________________________________________________________
+Bool_t AliCompactEventPool::IsReady() const
+{
+  // pool can be used for mixing, see SetTargetValues
+
+  if (fNEvents == 0)
+    return kFALSE;
+
+  return (fNTracks >= fTargetFraction * fTargetTrackDepth || fNEvents >= fMinNEvents);
+}
+
+//____________________________________________________________________
+TObjArray* AliCompactEventPool::GetEvent(Int_t i)
+{
+  // returns event i (0 = oldest) as array of AliBasicParticles
+  // the array and the particles belong to the manager, they are overwritten by the next call of GetEvent of any pool of the manager
+
+  if (!fManager)
+  {
+    AliError("GetEvent needs a pool created by AliCompactEventPoolManager");
+    return 0;
+  }
+
+  const Event& event = fEvents[Slot(i)];
+  Int_t n = event.fTracks.size();
+  TObjArray* array = fManager->GetParticleArray(n);
+
+  for (Int_t j=0; j<n; j++)
+  {
+    const Track& track = event.fTracks[j];
+    AliBasicParticle* particle = (AliBasicParticle*) array->UncheckedAt(j);
+    particle->SetEta(track.fEta);
+    particle->SetPhi(track.fPhi);
+    particle->SetPt(track.fPt);
+    particle->SetCharge(track.fCharge);
+    particle->SetUniqueID(track.fUniqueID);
+    particle->SetEventIndex(event.fEventIndex);
+  }
+
+  return array;
+}
+
+//____________________________________________________________________
+Int_t AliCompactEventPool::GetEventTracks(Int_t i, const Track*& tracks) const
+{
+  // sets <tracks> to the tracks of event i (0 = oldest), returns the number of tracks
+
+  const Event& event = fEvents[Slot(i)];
+  tracks = (event.fTracks.size() > 0) ? &event.fTracks[0] : 0;
+  return event.fTracks.size();
+}
+
+//____________________________________________________________________
+Bool_t AliCompactEventPool::UpdatePool(TObjArray* tracks, Bool_t rapidity)
+{
+  // adds the tracks of the current event within the pt range of the pool
+  // in contrast to AliEventPool the tracks are copied, <tracks> is not owned by the pool
+  //
+  // the event becomes visible in the next entry of the analysis manager (see AliCompactEventPoolManager)
+  // returns kFALSE if the event has already been added in this entry (by another user of the manager)
+
+  Long64_t entry = (fManager) ? fManager->GetEntry() : -1;
+
+  if (fHasPending)
+  {
+    if (entry >= 0 && fPendingEntry == entry)
+      return kFALSE;
+    Commit();
+  }
+
+  fPending.fTracks.clear();
+  fPending.fEventIndex = 0;
+
+  Bool_t cutPt = (fPtMax - fPtMin > 0);
+
+  for (Int_t i=0; i<tracks->GetEntriesFast(); i++)
+  {
+    AliVParticle* particle = (AliVParticle*) tracks->UncheckedAt(i);
+
+    Double_t pt = particle->Pt();
+    if (cutPt && (pt < fPtMin || pt >= fPtMax))
+      continue;
+
+    AliBasicParticle* particleBasic = dynamic_cast<AliBasicParticle*> (particle);
+    if (particleBasic && fPending.fTracks.size() == 0)
+      fPending.fEventIndex = particleBasic->GetEventIndex();
+
+    Track track;
+    track.fEta = (rapidity && !particleBasic) ? particle->Y() : particle->Eta();
+    track.fPhi = particle->Phi();
+    track.fPt = pt;
+    track.fCharge = particle->Charge();
+    track.fUniqueID = particle->GetUniqueID();
+    fPending.fTracks.push_back(track);
+  }
+
+  fHasPending = kTRUE;
+  fPendingEntry = entry;
+
+  if (entry < 0)
+    Commit();
+  else
+    fManager->AddPending(this);
+
+  return kTRUE;
+}
+
+//____________________________________________________________________
+void AliCompactEventPool::Commit()
+{
+  // moves the pending event into the ring buffer and removes the oldest events which are not needed any more
+
+  if (!fHasPending)
+    return;
+  fHasPending = kFALSE;
+
+  Int_t slot = 0;
+  if (fNEvents < (Int_t) fEvents.size())
+  {
+    // free slot
+    slot = Slot(fNEvents);
+  }
+  else if (fMaxEvents <= 0 || (Int_t) fEvents.size() < fMaxEvents)
+  {
+    // ring buffer is full but can grow: new slot after the most recent event
+    fEvents.insert(fEvents.begin() + fFirst, Event());
+    slot = fFirst;
+    fFirst = (fFirst + 1) % fEvents.size();
+  }
+  else
+  {
+    // replace the oldest event
+    slot = fFirst;
+    fNTracks -= fEvents[slot].fTracks.size();
+    fFirst = (fFirst + 1) % fEvents.size();
+    fNEvents--;
+  }
+
+  // the slot gets the pending tracks, the pending event reuses the memory of the slot
+  fEvents[slot].fTracks.swap(fPending.fTracks);
+  fEvents[slot].fEventIndex = fPending.fEventIndex;
+  fPending.fTracks.clear();
+  fNEvents++;
+  fNTracks += fEvents[slot].fTracks.size();
+
+  // keep only the most recent events needed to have fTargetTrackDepth tracks
+  while (fTargetTrackDepth > 0 && fNEvents > 1 && fNTracks - (Int_t) fEvents[fFirst].fTracks.size() >= fTargetTrackDepth)
+  {
+    fNTracks -= fEvents[fFirst].fTracks.size();
+    fEvents[fFirst].fTracks.clear();
+    fFirst = (fFirst + 1) % fEvents.size();
+    fNEvents--;
+  }
+}
+
+//____________________________________________________________________
+void AliCompactEventPool::Clear(Option_t*)
+{
+  // removes all events and frees the memory
+
+  std::vector<Event>().swap(fEvents);
+  std::vector<Track>().swap(fPending.fTracks);
+  fFirst = 0;
+  fNEvents = 0;
+  fNTracks = 0;
+  fHasPending = kFALSE;
+  fPendingEntry = -1;
+}
+
+//____________________________________________________________________
+ULong64_t AliCompactEventPool::GetMemory() const
+{
+  // memory allocated by the pool (including reserved but unused memory)
+
+  ULong64_t memory = sizeof(*this) + fEvents.capacity() * sizeof(Event) + fPending.fTracks.capacity() * sizeof(Track);
+  for (UInt_t i=0; i<fEvents.size(); i++)
+    memory += fEvents[i].fTracks.capacity() * sizeof(Track);
+  return memory;
+}
+
+//____________________________________________________________________
+AliCompactEventPoolManager::AliCompactEventPoolManager() :
+  TNamed(),
+  fMaxEvents(0),
+  fTargetTrackDepth(0),
+  fTargetFraction(1),
+  fMinNEvents(0),
+  fMultBins(),
+  fZvtxBins(),
+  fPsiBins(),
+  fPtBins(),
+  fTrackSelection(),
+  fPools(),
+  fPendingPools(),
+  fEntry(-1),
+  fNUsers(1),
+  fParticleArray(),
+  fParticles()
+{
+  // default constructor
+}
+
+//____________________________________________________________________
+AliCompactEventPoolManager::AliCompactEventPoolManager(const char* name, Int_t maxEvents, Int_t targetTrackDepth, Int_t nMultBins, const Double_t* multBins, Int_t nZvtxBins, const Double_t* zvtxBins, Int_t nPsiBins, const Double_t* psiBins, Int_t nPtBins, const Double_t* ptBins) :
+  TNamed(name, name),
+  fMaxEvents(maxEvents),
+  fTargetTrackDepth(targetTrackDepth),
+  fTargetFraction(1),
+  fMinNEvents(0),
+  fMultBins(),
+  fZvtxBins(),
+  fPsiBins(),
+  fPtBins(),
+  fTrackSelection(),
+  fPools(),
+  fPendingPools(),
+  fEntry(-1),
+  fNUsers(1),
+  fParticleArray(),
+  fParticles()
+{
+  // constructor
+  // the binning arguments are the number of bins and the array of nBins+1 bin edges
+  // without psi or pt binning (nBins = 0) one bin covering everything is used
+
+  if (nMultBins <= 0 || !multBins || nZvtxBins <= 0 || !zvtxBins)
+    AliFatal("Multiplicity and z vertex binning needed");
+
+  SetBins(fMultBins, nMultBins, multBins);
+  SetBins(fZvtxBins, nZvtxBins, zvtxBins);
+  SetBins(fPsiBins, nPsiBins, psiBins);
+  SetBins(fPtBins, nPtBins, ptBins);
+
+  fPools.resize(GetNumberOfMultBins() * GetNumberOfZVtxBins() * GetNumberOfPsiBins() * GetNumberOfPtBins(), 0);
+}
+
+//____________________________________________________________________
+AliCompactEventPoolManager::~AliCompactEventPoolManager()
+{
+  // destructor
+
+  for (UInt_t i=0; i<fPools.size(); i++)
+    delete fPools[i];
+  for (UInt_t i=0; i<fParticles.size(); i++)
+    delete fParticles[i];
+
+  std::vector<AliCompactEventPoolManager*>::iterator it = std::find(fgShared.begin(), fgShared.end(), this);
+  if (it != fgShared.end())
+    fgShared.erase(it);
+}
+
+//____________________________________________________________________
+AliCompactEventPoolManager* AliCompactEventPoolManager::Attach(const char* name, const char* trackSelection, Int_t maxEvents, Int_t targetTrackDepth, Int_t nMultBins, const Double_t* multBins, Int_t nZvtxBins, const Double_t* zvtxBins, Int_t nPsiBins, const Double_t* psiBins, Int_t nPtBins, const Double_t* ptBins)
+{
+  // returns the shared manager with the name <name>, which is created if it does not exist yet
+  // all users must use the same binning and must store the same tracks, i.e. give the same <trackSelection> (a description
+  // of the track cuts and the track type, compared as string). Call Detach() instead of deleting the manager.
+
+  for (UInt_t i=0; i<fgShared.size(); i++)
+  {
+    AliCompactEventPoolManager* mgr = fgShared[i];
+    if (strcmp(mgr->GetName(), name) != 0)
+      continue;
+
+    if (!mgr->SameBinning(nMultBins, multBins, nZvtxBins, zvtxBins, nPsiBins, psiBins, nPtBins, ptBins))
+      AliFatalGeneral("AliCompactEventPoolManager", Form("Shared event pool %s requested with different binning", name));
+    if (mgr->fTrackSelection != trackSelection)
+      AliFatalGeneral("AliCompactEventPoolManager", Form("Shared event pool %s requested with different track selection: \"%s\" instead of \"%s\"", name, trackSelection, mgr->fTrackSelection.Data()));
+    if (mgr->fMaxEvents != maxEvents || mgr->fTargetTrackDepth != targetTrackDepth)
+      AliWarningGeneral("AliCompactEventPoolManager", Form("Shared event pool %s requested with different depth, using the one of the first user", name));
+
+    mgr->fNUsers++;
+    return mgr;
+  }
+
+  AliCompactEventPoolManager* mgr = new AliCompactEventPoolManager(name, maxEvents, targetTrackDepth, nMultBins, multBins, nZvtxBins, zvtxBins, nPsiBins, psiBins, nPtBins, ptBins);
+  mgr->fTrackSelection = trackSelection;
+  fgShared.push_back(mgr);
+  return mgr;
+}
+
+//____________________________________________________________________
+void AliCompactEventPoolManager::Detach()
+{
+  // a user does not need the manager any more, it is deleted after the last user
+
+  fNUsers--;
+  if (fNUsers <= 0)
+    delete this;
+}
+
+//____________________________________________________________________
+void AliCompactEventPoolManager::SetTargetValues(Int_t trackDepth, Double_t fraction, Int_t minNEvents)
+{
+  // see AliCompactEventPool::SetTargetValues, applied to all pools
+
+  fTargetTrackDepth = trackDepth;
+  fTargetFraction = fraction;
+  fMinNEvents = minNEvents;
+
+  for (UInt_t i=0; i<fPools.size(); i++)
+    if (fPools[i])
+      fPools[i]->SetTargetValues(trackDepth, fraction, minNEvents);
+}
+
+//____________________________________________________________________
+void AliCompactEventPoolManager::Sync()
+{
+  // when a new entry is processed, the events added in the previous entry are moved into the pools
+
+  AliAnalysisManager* mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = (mgr) ? mgr->GetCurrentEntry() : -1;
+  if (entry == fEntry)
+    return;
+
+  fEntry = entry;
+  for (UInt_t i=0; i<fPendingPools.size(); i++)
+    fPendingPools[i]->Commit();
+  fPendingPools.clear();
+}
+
+//____________________________________________________________________
+AliCompactEventPool* AliCompactEventPoolManager::GetEventPool(Double_t mult, Double_t zvtx, Double_t psi, Int_t iPt)
+{
+  // returns the pool for the given event and pt bin, 0 if outside of the binning
+
+  Sync();
+
+  Int_t iMult = FindBin(fMultBins, mult);
+  Int_t iZvtx = FindBin(fZvtxBins, zvtx);
+  Int_t iPsi = FindBin(fPsiBins, psi);
+  if (iMult < 0 || iZvtx < 0 || iPsi < 0 || iPt < 0 || iPt >= GetNumberOfPtBins())
+    return 0;
+
+  Int_t index = ((iMult * GetNumberOfZVtxBins() + iZvtx) * GetNumberOfPsiBins() + iPsi) * GetNumberOfPtBins() + iPt;
+  if (!fPools[index])
+  {
+    fPools[index] = new AliCompactEventPool(fMaxEvents, fTargetTrackDepth, fPtBins[iPt], fPtBins[iPt+1], this);
+    fPools[index]->SetTargetValues(fTargetTrackDepth, fTargetFraction, fMinNEvents);
+  }
+
+  return fPools[index];
+}
+
+//____________________________________________________________________
+void AliCompactEventPoolManager::ClearPools()
+{
+  // removes all events
+
+  for (UInt_t i=0; i<fPools.size(); i++)
+    if (fPools[i])
+      fPools[i]->Clear();
+  fPendingPools.clear();
+}
+
+//____________________________________________________________________
+ULong64_t AliCompactEventPoolManager::GetMemory() const
+{
+  // memory allocated by the pools
+
+  ULong64_t memory = 0;
+  for (UInt_t i=0; i<fPools.size(); i++)
+    if (fPools[i])
+      memory += fPools[i]->GetMemory();
+  return memory;
+}
+
+//____________________________________________________________________
+ULong64_t AliCompactEventPoolManager::GetUsedMemory() const
+{
+  // memory used by the stored tracks
+
+  ULong64_t memory = 0;
+  for (UInt_t i=0; i<fPools.size(); i++)
+    if (fPools[i])
+      memory += fPools[i]->GetUsedMemory();
+  return memory;
+}
+
+//____________________________________________________________________
+Long64_t AliCompactEventPoolManager::GetNEvents() const
+{
+  // number of events in all pools
+
+  Long64_t n = 0;
+  for (UInt_t i=0; i<fPools.size(); i++)
+    if (fPools[i])
+      n += fPools[i]->GetCurrentNEvents();
+  return n;
+}
+
+//____________________________________________________________________
+Long64_t AliCompactEventPoolManager::GetNTracks() const
+{
+  // number of tracks in all pools
+
+  Long64_t n = 0;
+  for (UInt_t i=0; i<fPools.size(); i++)
+    if (fPools[i])
+      n += fPools[i]->NTracksInPool();
+  return n;
+}
+
+//____________________________________________________________________
+void AliCompactEventPoolManager::Print(Option_t* option) const
+{
+  // prints the memory and fill level of the pools
+  // with option "pools" one line per used pool is printed
+
+  Int_t nUsed = 0;
+  Int_t nReady = 0;
+  for (UInt_t i=0; i<fPools.size(); i++)
+  {
+    if (!fPools[i])
+      continue;
+    nUsed++;
+    if (fPools[i]->IsReady())
+      nReady++;
+  }
+
+  if (fTrackSelection.Length() > 0)
+    Printf("%s: track selection %s", GetName(), fTrackSelection.Data());
+  Printf("%s: %d users, %d of %d pools used, %d ready, %lld events, %lld tracks, memory %.1f MB (%.1f MB used by tracks)", GetName(), fNUsers, nUsed, (Int_t) fPools.size(), nReady, GetNEvents(), GetNTracks(), GetMemory() / 1048576., GetUsedMemory() / 1048576.);
+
+  if (!TString(option).Contains("pools"))
+    return;
+
+  for (UInt_t i=0; i<fPools.size(); i++)
+  {
+    AliCompactEventPool* pool = fPools[i];
+    if (!pool)
+      continue;
+
+    Int_t iPt = i % GetNumberOfPtBins();
+    Int_t iPsi = (i / GetNumberOfPtBins()) % GetNumberOfPsiBins();
+    Int_t iZvtx = (i / GetNumberOfPtBins() / GetNumberOfPsiBins()) % GetNumberOfZVtxBins();
+    Int_t iMult = i / GetNumberOfPtBins() / GetNumberOfPsiBins() / GetNumberOfZVtxBins();
+
+    Printf("  mult %.1f-%.1f zvtx %.1f-%.1f psi %.2f-%.2f pt %.2f-%.2f: %d events, %d tracks, %s, memory %.1f kB",
+	   fMultBins[iMult], fMultBins[iMult+1], fZvtxBins[iZvtx], fZvtxBins[iZvtx+1], fPsiBins[iPsi], fPsiBins[iPsi+1], fPtBins[iPt], fPtBins[iPt+1],
+	   pool->GetCurrentNEvents(), pool->NTracksInPool(), (pool->IsReady()) ? "ready" : "not ready", pool->GetMemory() / 1024.);
+  }
+}
+
+//____________________________________________________________________
+TObjArray* AliCompactEventPoolManager::GetParticleArray(Int_t n)
+{
+  // returns the array of <n> AliBasicParticles used by AliCompactEventPool::GetEvent
+
+  while ((Int_t) fParticles.size() < n)
+  {
+    AliBasicParticle* particle = new AliBasicParticle;
+    fParticleArray.AddAtAndExpand(particle, fParticles.size());
+    fParticles.push_back(particle);
+  }
+
+  for (Int_t i=0; i<n; i++)
+    fParticleArray.AddAt(fParticles[i], i);
+  fParticleArray.SetLast(n - 1);
+
+  return &fParticleArray;
+}
+
+//____________________________________________________________________
+Int_t AliCompactEventPoolManager::FindBin(const std::vector<Double_t>& bins, Double_t value) const
+{
+  // bin containing <value>, -1 if outside
+
+  if (!(value >= bins.front() && value < bins.back()))
+    return -1;
+
+  return std::upper_bound(bins.begin(), bins.end(), value) - bins.begin() - 1;
+}
+
+//____________________________________________________________________
+Bool_t AliCompactEventPoolManager::SameBinning(Int_t nMultBins, const Double_t* multBins, Int_t nZvtxBins, const Double_t* zvtxBins, Int_t nPsiBins, const Double_t* psiBins, Int_t nPtBins, const Double_t* ptBins) const
+{
+  // compares the binning with the given one
+
+  std::vector<Double_t> bins;
+
+  SetBins(bins, nMultBins, multBins);
+  if (bins != fMultBins)
+    return kFALSE;
+  SetBins(bins, nZvtxBins, zvtxBins);
+  if (bins != fZvtxBins)
+    return kFALSE;
+  SetBins(bins, nPsiBins, psiBins);
+  if (bins != fPsiBins)
+    return kFALSE;
+  SetBins(bins, nPtBins, ptBins);
+  if (bins != fPtBins)
+    return kFALSE;
+
+  return kTRUE;
+}
+
+//____________________________________________________________________
+void AliCompactEventPoolManager::SetBins(std::vector<Double_t>& target, Int_t n, const Double_t* bins)
+{
+  // sets the bin edges, without bins one bin as for AliEventPoolManager
+
+  if (n <= 0 || !bins)
+  {
+    target.assign(2, -9999.);
+    target[1] = 9999.;
+    return;
+  }
+
+  target.assign(bins, bins + n + 1);
+}
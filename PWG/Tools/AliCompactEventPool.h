@@ -0,0 +1,169 @@
+#ifndef AliCompactEventPool_H
+#define AliCompactEventPool_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+// compact event pool for event mixing
+//
+// AliCompactEventPoolManager / AliCompactEventPool can be used instead of AliEventPoolManager / AliEventPool:
+// the tracks are not stored as cloned AliBasicParticle objects but as packed records (eta, phi, pt, charge, unique id),
+// the events of a pool bin are kept in a ring buffer whose memory is reused. A manager can be shared by several tasks
+// in a train (see AliCompactEventPoolManager::Attach), each event is then stored only once.
+
+#include <vector>
+#include "TNamed.h"
+#include "TObjArray.h"
+
+class AliBasicParticle;
+class AliCompactEventPoolManager;
+
+class AliCompactEventPool : public TObject
+{
+ public:
+  // packed track record
+  struct Track
+  {
+    Float_t fEta;       // eta (or rapidity)
+    Float_t fPhi;       // phi
+    Float_t fPt;        // pt
+    Short_t fCharge;    // charge
+    UInt_t  fUniqueID;  // unique id of the original track
+  };
+
+  AliCompactEventPool();
+  AliCompactEventPool(Int_t maxEvents, Int_t targetTrackDepth, Double_t ptMin, Double_t ptMax, AliCompactEventPoolManager* manager = 0);
+  virtual ~AliCompactEventPool() { }
+
+  void SetTargetValues(Int_t trackDepth, Double_t fraction, Int_t minNEvents);
+
+  Bool_t IsReady() const;
+  Int_t GetCurrentNEvents() const { return fNEvents; }
+  Int_t NTracksInPool() const { return fNTracks; }
+  Double_t GetPtMin() const { return fPtMin; }
+  Double_t GetPtMax() const { return fPtMax; }
+  Bool_t GetLockFlag() const { return kFALSE; }
+
+  // event i (0 = oldest) as AliBasicParticles. The array and the particles belong to the manager and are reused by the next call
+  TObjArray* GetEvent(Int_t i);
+  // event i (0 = oldest) as packed records, returns the number of tracks
+  Int_t GetEventTracks(Int_t i, const Track*& tracks) const;
+  Long64_t GetEventIndex(Int_t i) const { return fEvents[Slot(i)].fEventIndex; }
+
+  // copies the tracks within the pt range of this pool; the tracks remain owned by the caller
+  // with rapidity, Y() is stored instead of Eta() for tracks which are not AliBasicParticles (which are already reduced)
+  // returns kFALSE if the event has already been added by another user of the pool
+  Bool_t UpdatePool(TObjArray* tracks, Bool_t rapidity = kFALSE);
+
+  void Clear(Option_t* option = "");
+
+  ULong64_t GetMemory() const;
+  ULong64_t GetUsedMemory() const { return fNTracks * sizeof(Track); }
+
+ protected:
+  // one stored event, the track vector keeps its capacity when the slot is reused
+  struct Event
+  {
+    Event() : fTracks(), fEventIndex(0) { }
+    std::vector<Track> fTracks;  // tracks
+    Long64_t fEventIndex;        // event index of the first track if the tracks are AliBasicParticles, otherwise 0
+  };
+
+  Int_t Slot(Int_t i) const { return (fFirst + i) % fEvents.size(); }
+  void Commit();
+
+  AliCompactEventPoolManager* fManager; //! manager providing the arrays for GetEvent
+  Int_t fMaxEvents;          // maximum number of events
+  Int_t fTargetTrackDepth;   // number of tracks to keep
+  Double_t fTargetFraction;  // pool is ready when fTargetFraction * fTargetTrackDepth tracks are stored...
+  Int_t fMinNEvents;         // ...or at least fMinNEvents events
+  Double_t fPtMin;           // pt range of the stored tracks
+  Double_t fPtMax;           // pt range of the stored tracks
+
+  std::vector<Event> fEvents; //! ring buffer of events
+  Int_t fFirst;              //! slot of the oldest event
+  Int_t fNEvents;            //! number of events
+  Int_t fNTracks;            //! number of tracks in all events
+  Event fPending;            //! event added in the current entry, moved to the ring buffer in the next entry
+  Bool_t fHasPending;        //! fPending is set
+  Long64_t fPendingEntry;    //! entry of fPending
+
+ private:
+  friend class AliCompactEventPoolManager;
+
+  AliCompactEventPool(const AliCompactEventPool&);
+  AliCompactEventPool& operator=(const AliCompactEventPool&);
+
+  ClassDef(AliCompactEventPool, 1) // compact event pool for event mixing
+};
+
+class AliCompactEventPoolManager : public TNamed
+{
+ public:
+  AliCompactEventPoolManager();
+  AliCompactEventPoolManager(const char* name, Int_t maxEvents, Int_t targetTrackDepth, Int_t nMultBins, const Double_t* multBins, Int_t nZvtxBins, const Double_t* zvtxBins, Int_t nPsiBins = 0, const Double_t* psiBins = 0, Int_t nPtBins = 0, const Double_t* ptBins = 0);
+  virtual ~AliCompactEventPoolManager();
+
+  // manager with this name shared by all tasks of the process, created with the given arguments on first use
+  // the users must store the same tracks: <trackSelection> describes the track cuts and the track type of the user,
+  // it must be the same for all users
+  static AliCompactEventPoolManager* Attach(const char* name, const char* trackSelection, Int_t maxEvents, Int_t targetTrackDepth, Int_t nMultBins, const Double_t* multBins, Int_t nZvtxBins, const Double_t* zvtxBins, Int_t nPsiBins = 0, const Double_t* psiBins = 0, Int_t nPtBins = 0, const Double_t* ptBins = 0);
+  void Detach();
+
+  void SetTargetValues(Int_t trackDepth, Double_t fraction, Int_t minNEvents);
+
+  AliCompactEventPool* GetEventPool(Double_t mult, Double_t zvtx, Double_t psi = 0, Int_t iPt = 0);
+
+  Int_t GetNumberOfMultBins() const { return fMultBins.size() - 1; }
+  Int_t GetNumberOfZVtxBins() const { return fZvtxBins.size() - 1; }
+  Int_t GetNumberOfPsiBins() const  { return fPsiBins.size() - 1; }
+  Int_t GetNumberOfPtBins() const   { return fPtBins.size() - 1; }
+  Int_t GetNUsers() const           { return fNUsers; }
+  const char* GetTrackSelection() const { return fTrackSelection; }
+
+  void ClearPools();
+
+  ULong64_t GetMemory() const;
+  ULong64_t GetUsedMemory() const;
+  Long64_t GetNEvents() const;
+  Long64_t GetNTracks() const;
+  virtual void Print(Option_t* option = "") const;
+
+  // for AliCompactEventPool
+  Long64_t GetEntry() const { return fEntry; }
+  void AddPending(AliCompactEventPool* pool) { fPendingPools.push_back(pool); }
+  TObjArray* GetParticleArray(Int_t n);
+
+ protected:
+  void Sync();
+  Int_t FindBin(const std::vector<Double_t>& bins, Double_t value) const;
+  Bool_t SameBinning(Int_t nMultBins, const Double_t* multBins, Int_t nZvtxBins, const Double_t* zvtxBins, Int_t nPsiBins, const Double_t* psiBins, Int_t nPtBins, const Double_t* ptBins) const;
+  static void SetBins(std::vector<Double_t>& target, Int_t n, const Double_t* bins);
+
+  Int_t fMaxEvents;                 // maximum number of events per pool
+  Int_t fTargetTrackDepth;          // number of tracks to keep per pool
+  Double_t fTargetFraction;         // see AliCompactEventPool::SetTargetValues
+  Int_t fMinNEvents;                // see AliCompactEventPool::SetTargetValues
+  std::vector<Double_t> fMultBins;  // multiplicity (centrality) bin edges
+  std::vector<Double_t> fZvtxBins;  // z vertex bin edges
+  std::vector<Double_t> fPsiBins;   // event plane bin edges
+  std::vector<Double_t> fPtBins;    // pt bin edges (the tracks are split into one pool per bin)
+  TString fTrackSelection;          // track selection of the users of a shared manager (see Attach)
+
+  std::vector<AliCompactEventPool*> fPools; //! pools, created on first use
+  std::vector<AliCompactEventPool*> fPendingPools; //! pools with an event added in the current entry
+  Long64_t fEntry;                  //! current entry of the analysis manager
+  Int_t fNUsers;                    //! number of users (see Attach)
+  TObjArray fParticleArray;         //! array returned by AliCompactEventPool::GetEvent
+  std::vector<AliBasicParticle*> fParticles; //! particles in fParticleArray
+
+  static std::vector<AliCompactEventPoolManager*> fgShared; //! shared managers
+
+ private:
+  AliCompactEventPoolManager(const AliCompactEventPoolManager&);
+  AliCompactEventPoolManager& operator=(const AliCompactEventPoolManager&);
+
+  ClassDef(AliCompactEventPoolManager, 2) // manager of compact event pools for event mixing
+};
+
+#endif
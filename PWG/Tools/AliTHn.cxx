@@ -39,6 +39,7 @@
 #include "TArrayD.h"
 #include "THnSparse.h"
 #include "TMath.h"
+#include <thread>
 
 templateClassImp(AliTHnT)
 
@@ -53,7 +54,10 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fShards(),
+  fAxisUniform(),
+  fBatchBins()
 {
   // Constructor
 }
@@ -69,7 +73,10 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fShards(),
+  fAxisUniform(),
+  fBatchBins()
 {
   // Constructor
 
@@ -106,7 +113,10 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fShards(),
+  fAxisUniform(),
+  fBatchBins()
 {
   //
   // AliTHnT copy constructor
@@ -129,6 +139,9 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   
   DeleteContainers();
   
+  for (UInt_t i=0; i<fShards.size(); i++)
+    delete fShards[i];
+  
   delete[] fValues;
   delete[] fSumw2;
   delete[] axisCache;
@@ -239,6 +252,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
   if (!list)
     return 0;
   
+  MergeShards();
+
   if (list->IsEmpty())
     return 1;
   
@@ -254,6 +269,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
     if (entry == 0) 
       continue;
 
+    entry->MergeShards();
+
     for (Int_t i=0; i<fNSteps; i++)
     {
       if (entry->fValues[i])
@@ -282,57 +299,96 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
 }
 
 template <class TemplateArray, typename TemplateType>
-void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+void AliTHnT<TemplateArray, TemplateType>::InitAxisCache()
 {
-  // fills an entry
+  // fills the axis cache and the cache of the last used bins
 
-  // fill axis cache
-  if (!axisCache)
+  if (axisCache)
+    return;
+
+  axisCache = new TAxis*[fNVars];
+  fNbinsCache = new Int_t[fNVars];
+  for (Int_t i=0; i<fNVars; i++)
   {
-    axisCache = new TAxis*[fNVars];
-    fNbinsCache = new Int_t[fNVars];
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      axisCache[i] = GetAxis(i, 0);
-      fNbinsCache[i] = axisCache[i]->GetNbins();
-    }
-    
-    fLastVars = new Double_t[fNVars];
-    fLastBins = new Int_t[fNVars];
+    axisCache[i] = GetAxis(i, 0);
+    fNbinsCache[i] = axisCache[i]->GetNbins();
+  }
+  
+  fLastVars = new Double_t[fNVars];
+  fLastBins = new Int_t[fNVars];
+  
+  // initial values (underflow) to prevent checking for 0 in FindGlobalBin
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    fLastVars[i] = axisCache[i]->GetXmin() - 1;
+    fLastBins[i] = 0;
+  }
+  
+  // check for equidistant bins (also when set with variable bin limits as done by AliCFContainer::SetBinLimits)
+  fAxisUniform.assign(fNVars, kTRUE);
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    const TArrayD* xbins = axisCache[i]->GetXbins();
+    if (xbins->GetSize() == 0)
+      continue;
     
-    // initial values to prevent checking for 0 below
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      fLastBins[i] = axisCache[i]->FindBin(var[i]);
-      fLastVars[i] = var[i];
-    }
+    Double_t width = (axisCache[i]->GetXmax() - axisCache[i]->GetXmin()) / fNbinsCache[i];
+    for (Int_t j=1; j<=fNbinsCache[i]; j++)
+      if (TMath::Abs(xbins->At(j) - xbins->At(j-1) - width) > 1e-6 * width)
+      {
+        fAxisUniform[i] = kFALSE;
+        break;
+      }
   }
+}
+
+template <class TemplateArray, typename TemplateType>
+Long64_t AliTHnT<TemplateArray, TemplateType>::FindGlobalBin(const Double_t* var, Double_t* lastVars, Int_t* lastBins) const
+{
+  // calculates the global bin index for the values <var> using the bin cache <lastVars>, <lastBins>
+  // returns -1 for entries in under/overflow bins
+  // only const functions of the axis are used, so that this can be called concurrently with different caches
   
-  // calculate global bin index
   Long64_t bin = 0;
   for (Int_t i=0; i<fNVars; i++)
   {
     bin *= fNbinsCache[i];
     
     Int_t tmpBin = 0;
-    if (fLastVars[i] == var[i])
-      tmpBin = fLastBins[i];
+    if (lastVars[i] == var[i])
+      tmpBin = lastBins[i];
     else
     {
-      tmpBin = axisCache[i]->FindBin(var[i]);
-      fLastBins[i] = tmpBin;
-      fLastVars[i] = var[i];
+      tmpBin = axisCache[i]->FindFixBin(var[i]);
+      lastBins[i] = tmpBin;
+      lastVars[i] = var[i];
     }
     //Printf("%d", tmpBin);
 
     // under/overflow not supported
     if (tmpBin < 1 || tmpBin > fNbinsCache[i])
-      return;
+      return -1;
     
     // bins start from 0 here
     bin += tmpBin - 1;
 //     Printf("%lld", bin);
   }
+  
+  return bin;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry
+
+  // fill axis cache
+  InitAxisCache();
+  
+  // calculate global bin index
+  Long64_t bin = FindGlobalBin(var, fLastVars, fLastBins);
+  if (bin < 0)
+    return;
 
   if (!fValues[istep])
   {
@@ -360,6 +416,123 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 //   AliCFContainer::Fill(var, istep, weight);
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillBatch(const Double_t *vars, Int_t n, Int_t istep, const Double_t *weights, const Double_t *weights2)
+{
+  // fills <n> entries
+  // <vars> is stored column-wise: vars[i * n + j] is variable i of entry j
+  // <weights> contains the weight per entry, if 0 all weights are 1
+  // <weights2> (only used together with <weights>) contains the sum of the squared weights per entry, if one entry
+  // stands for several entries in the same bin. Such an entry counts as filled with weight 1 if weights2 == weights,
+  // i.e. if all the entries it stands for have weight 1. If 0, the square of <weights> is used.
+  //
+  // the global bin indices are calculated axis by axis for the whole batch in loops without branches
+  // (which the compiler can vectorize): arithmetically for axes with equidistant bins, otherwise by a binary search
+  // with a fixed number of steps. The result is identical to calling Fill for each entry.
+  
+  if (n <= 0)
+    return;
+  
+  InitAxisCache();
+  
+  if (fBatchBins.size() < (UInt_t) n)
+    fBatchBins.resize(n);
+  Long64_t* bins = &fBatchBins[0];
+  
+  for (Int_t j=0; j<n; j++)
+    bins[j] = 0;
+  
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    const Double_t* x = vars + (Long64_t) i * n;
+    const Int_t nBins = fNbinsCache[i];
+    const Double_t xMin = axisCache[i]->GetXmin();
+    const Double_t xMax = axisCache[i]->GetXmax();
+    const TArrayD* xbins = axisCache[i]->GetXbins();
+    const Double_t* edges = (xbins->GetSize() > 0) ? xbins->GetArray() : 0;
+    
+    if (fAxisUniform[i])
+    {
+      for (Int_t j=0; j<n; j++)
+      {
+        // same expression as in TAxis::FindFixBin for fixed bins
+        Double_t pos = nBins * (x[j] - xMin) / (xMax - xMin);
+        // clamp to a valid bin (also for NaN), entries outside the axis range are rejected by <valid>
+        pos = (pos >= 0) ? pos : 0;
+        pos = (pos < nBins - 1) ? pos : nBins - 1;
+        Int_t bin = (Int_t) pos;
+        // with variable bin limits correct for rounding differences with respect to the bin edges
+        if (edges)
+        {
+          bin -= (x[j] < edges[bin]);
+          bin += (x[j] >= edges[bin+1]);
+        }
+        Bool_t valid = (x[j] >= xMin) && (x[j] < xMax) && (bins[j] >= 0);
+        bins[j] = (valid) ? bins[j] * nBins + bin : -1;
+      }
+    }
+    else
+    {
+      for (Int_t j=0; j<n; j++)
+      {
+        // find the last edge <= x
+        Int_t base = 0;
+        Int_t len = nBins + 1;
+        while (len > 1)
+        {
+          Int_t half = len / 2;
+          base += (edges[base + half] <= x[j]) ? half : 0;
+          len -= half;
+        }
+        Bool_t valid = (x[j] >= xMin) && (x[j] < xMax) && (bins[j] >= 0);
+        bins[j] = (valid) ? bins[j] * nBins + base : -1;
+      }
+    }
+  }
+  
+  // scatter into the data containers, following the conventions of Fill
+  Bool_t anyFilled = kFALSE;
+  Bool_t weighted = kFALSE;
+  for (Int_t j=0; j<n; j++)
+  {
+    if (bins[j] < 0)
+      continue;
+    anyFilled = kTRUE;
+    if (weights && ((weights2) ? weights2[j] != weights[j] : weights[j] != 1))
+      weighted = kTRUE;
+  }
+  
+  if (!anyFilled)
+    return;
+  
+  if (!fValues[istep])
+  {
+    fValues[istep] = new TemplateArray(fNBins);
+    AliInfo(Form("Created values container for step %d", istep));
+  }
+  
+  // entries before the first entry with weight != 1 are also added to fSumw2 below
+  if (weighted && !fSumw2[istep])
+  {
+    fSumw2[istep] = new TemplateArray(*fValues[istep]);
+    AliInfo(Form("Created sumw2 container for step %d", istep));
+  }
+  
+  TemplateType* values = fValues[istep]->GetArray();
+  TemplateType* sumw2 = (fSumw2[istep]) ? fSumw2[istep]->GetArray() : 0;
+  
+  for (Int_t j=0; j<n; j++)
+  {
+    if (bins[j] < 0)
+      continue;
+    
+    Double_t weight = (weights) ? weights[j] : 1;
+    values[bins[j]] += weight;
+    if (sumw2)
+      sumw2[bins[j]] += (weights && weights2) ? weights2[j] : weight * weight;
+  }
+}
+
 template <class TemplateArray, typename TemplateType>
 Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Int_t* binIdx)
 {
@@ -448,6 +621,7 @@ void AliTHnT<TemplateArray, TemplateType>::FillParent()
 {
   // fills the information stored in the buffer in this class into the baseclass containers
   
+  MergeShards();
   FillContainer(this);
 }
 
@@ -531,5 +705,227 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
   }
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetShards(Int_t nShards, Bool_t sparse)
+{
+  // enables sharded filling with <nShards> fill buffers, to be filled with FillShard
+  // dense shards hold a full copy of the container per filled step, sparse shards only the filled bins
+  // must be called before the worker threads start filling
+  
+  MergeShards();
+  for (UInt_t i=0; i<fShards.size(); i++)
+    delete fShards[i];
+  fShards.clear();
+  
+  InitAxisCache();
+  
+  for (Int_t i=0; i<nShards; i++)
+  {
+    Shard* shard = new Shard(fNSteps, fNBins, fNVars, sparse);
+    for (Int_t j=0; j<fNVars; j++)
+    {
+      shard->fLastVars[j] = fLastVars[j];
+      shard->fLastBins[j] = fLastBins[j];
+    }
+    fShards.push_back(shard);
+  }
+  
+  AliInfo(Form("Created %d %s fill shards", nShards, (sparse) ? "sparse" : "dense"));
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillShard(Int_t shard, const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry into the fill buffer <shard>
+  // can be called concurrently as long as each thread uses a different shard
+  
+  Shard* target = fShards[shard];
+  
+  Long64_t bin = FindGlobalBin(var, target->fLastVars, target->fLastBins);
+  if (bin < 0)
+    return;
+  
+  target->Add(istep, bin, weight);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::MergeShards()
+{
+  // reduces the fill buffers into fValues/fSumw2
+  // the shards are merged pairwise in a tree (in parallel per level), so that the summation order is fixed
+  
+  Int_t nShards = fShards.size();
+  if (nShards == 0)
+    return;
+  
+  for (Int_t stride = 1; stride < nShards; stride *= 2)
+  {
+    std::vector<std::thread> workers;
+    for (Int_t i=0; i+stride<nShards; i+=2*stride)
+    {
+      Shard* target = fShards[i];
+      Shard* source = fShards[i+stride];
+      workers.push_back(std::thread([target, source]() { target->Add(*source); source->Reset(); }));
+    }
+    for (UInt_t i=0; i<workers.size(); i++)
+      workers[i].join();
+  }
+  
+  fShards[0]->AddTo(fValues, fSumw2);
+  fShards[0]->Reset();
+}
+
+template <class TemplateArray, typename TemplateType>
+AliTHnT<TemplateArray, TemplateType>::Shard::Shard(Int_t nSteps, Long64_t nBins, Int_t nVars, Bool_t sparse) :
+  fLastVars(new Double_t[nVars]),
+  fLastBins(new Int_t[nVars]),
+  fNSteps(nSteps),
+  fNBins(nBins),
+  fSparse(sparse),
+  fWeighted(nSteps, kFALSE),
+  fDenseValues(sparse ? 0 : nSteps),
+  fDenseSumw2(sparse ? 0 : nSteps),
+  fSparseBins(sparse ? nSteps : 0)
+{
+  // Constructor
+}
+
+template <class TemplateArray, typename TemplateType>
+AliTHnT<TemplateArray, TemplateType>::Shard::~Shard()
+{
+  // Destructor
+  
+  delete[] fLastVars;
+  delete[] fLastBins;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Shard::Add(Int_t step, Long64_t bin, Double_t weight)
+{
+  // adds an entry to the global bin <bin>
+  
+  if (weight != 1)
+    fWeighted[step] = kTRUE;
+  
+  if (fSparse)
+  {
+    std::pair<TemplateType, TemplateType>& entry = fSparseBins[step][bin];
+    entry.first += weight;
+    entry.second += weight * weight;
+    return;
+  }
+  
+  std::vector<TemplateType>& values = fDenseValues[step];
+  if (values.empty())
+    values.resize(fNBins, 0);
+  
+  // as in AliTHnT::Fill: sumw2 is only created when weight != 1, initialized with the already filled entries
+  std::vector<TemplateType>& sumw2 = fDenseSumw2[step];
+  if (fWeighted[step] && sumw2.empty())
+    sumw2 = values;
+  
+  values[bin] += weight;
+  if (!sumw2.empty())
+    sumw2[bin] += weight * weight;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Shard::Add(const Shard& other)
+{
+  // adds the content of <other> (which has to have the same storage mode)
+  
+  for (Int_t step=0; step<fNSteps; step++)
+  {
+    if (fSparse)
+    {
+      for (auto& entry : other.fSparseBins[step])
+      {
+        std::pair<TemplateType, TemplateType>& target = fSparseBins[step][entry.first];
+        target.first += entry.second.first;
+        target.second += entry.second.second;
+      }
+      fWeighted[step] = fWeighted[step] || other.fWeighted[step];
+      continue;
+    }
+    
+    const std::vector<TemplateType>& otherValues = other.fDenseValues[step];
+    if (otherValues.empty())
+      continue;
+    
+    std::vector<TemplateType>& values = fDenseValues[step];
+    if (values.empty())
+      values.resize(fNBins, 0);
+    
+    // sumw2 of a step without weights is identical to its values
+    std::vector<TemplateType>& sumw2 = fDenseSumw2[step];
+    if (other.fWeighted[step] && sumw2.empty())
+      sumw2 = values;
+    fWeighted[step] = fWeighted[step] || other.fWeighted[step];
+    
+    const std::vector<TemplateType>& otherSumw2 = (other.fDenseSumw2[step].empty()) ? otherValues : other.fDenseSumw2[step];
+    for (Long64_t l = 0; l<fNBins; l++)
+      values[l] += otherValues[l];
+    if (!sumw2.empty())
+      for (Long64_t l = 0; l<fNBins; l++)
+        sumw2[l] += otherSumw2[l];
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Shard::AddTo(TemplateArray** values, TemplateArray** sumw2) const
+{
+  // adds the content of this shard to the data containers <values>, <sumw2> following the conventions of AliTHnT::Fill
+  
+  for (Int_t step=0; step<fNSteps; step++)
+  {
+    if ((fSparse && fSparseBins[step].empty()) || (!fSparse && fDenseValues[step].empty()))
+      continue;
+    
+    if (!values[step])
+      values[step] = new TemplateArray(fNBins);
+    if (fWeighted[step] && !sumw2[step])
+      sumw2[step] = new TemplateArray(*values[step]);
+    
+    TemplateType* targetValues = values[step]->GetArray();
+    TemplateType* targetSumw2 = (sumw2[step]) ? sumw2[step]->GetArray() : 0;
+    
+    if (fSparse)
+    {
+      for (auto& entry : fSparseBins[step])
+      {
+        targetValues[entry.first] += entry.second.first;
+        if (targetSumw2)
+          targetSumw2[entry.first] += entry.second.second;
+      }
+      continue;
+    }
+    
+    const std::vector<TemplateType>& sourceSumw2 = (fDenseSumw2[step].empty()) ? fDenseValues[step] : fDenseSumw2[step];
+    for (Long64_t l = 0; l<fNBins; l++)
+      targetValues[l] += fDenseValues[step][l];
+    if (targetSumw2)
+      for (Long64_t l = 0; l<fNBins; l++)
+        targetSumw2[l] += sourceSumw2[l];
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Shard::Reset()
+{
+  // clears the content, dense arrays are released
+  
+  for (Int_t step=0; step<fNSteps; step++)
+  {
+    fWeighted[step] = kFALSE;
+    if (fSparse)
+      fSparseBins[step].clear();
+    else
+    {
+      std::vector<TemplateType>().swap(fDenseValues[step]);
+      std::vector<TemplateType>().swap(fDenseSumw2[step]);
+    }
+  }
+}
+
 template class AliTHnT<TArrayF, Float_t>;
 template class AliTHnT<TArrayD, Double_t>;
@@ -10,6 +10,9 @@
 // As AliTHn derives from AliCFContainer, you can just replace your current AliCFContainer object by AliTHn
 // Once you have the merged output, call FillParent() and you can use AliCFContainer as usual
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "TObject.h"
 #include "TString.h"
 #include "AliCFContainer.h"
@@ -26,6 +29,7 @@ public:
   AliTHnBase(const Char_t* name, const Char_t* title,const Int_t nSelStep, const Int_t nVarIn, const Int_t* nBinIn) : AliCFContainer(name, title, nSelStep, nVarIn, nBinIn) { }
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) = 0;
+  virtual void FillBatch(const Double_t *vars, Int_t n, Int_t istep, const Double_t *weights=0, const Double_t *weights2=0) = 0;
   virtual void FillParent() = 0;
   virtual void FillContainer(AliCFContainer* cont) = 0;
 
@@ -48,6 +52,9 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  // fills <n> entries at once, <vars> is stored column-wise (vars[ivar * n + ientry]), <weights> can be 0 (weight 1)
+  // <weights2> can give the contribution to sumw2 per entry, for entries which stand for several entries in the same bin
+  virtual void FillBatch(const Double_t *vars, Int_t n, Int_t istep, const Double_t *weights=0, const Double_t *weights2=0);
   virtual void FillParent();
   virtual void FillContainer(AliCFContainer* cont);
   
@@ -63,9 +70,46 @@ class AliTHnT : public AliTHnBase
 
   virtual Long64_t Merge(TCollection* list);
   
+  // sharded filling: each thread fills its own shard (identified by the shard index, e.g. the worker id)
+  // shards are reduced into fValues/fSumw2 by MergeShards which is also called in FillParent and Merge
+  void SetShards(Int_t nShards, Bool_t sparse = kFALSE);
+  Int_t GetNShards() const { return fShards.size(); }
+  void FillShard(Int_t shard, const Double_t *var, Int_t istep, Double_t weight=1.);
+  void MergeShards();
+  
 protected:
+  // private fill buffer of one thread, either dense (arrays of fNBins) or sparse (hash map of filled bins)
+  class Shard
+  {
+   public:
+    Shard(Int_t nSteps, Long64_t nBins, Int_t nVars, Bool_t sparse);
+    ~Shard();
+    
+    void Add(Int_t step, Long64_t bin, Double_t weight);
+    void Add(const Shard& other);
+    void AddTo(TemplateArray** values, TemplateArray** sumw2) const;
+    void Reset();
+    
+    Double_t* fLastVars;  // caching of last used bins per shard
+    Int_t* fLastBins;     // caching of last used bins per shard
+    
+   private:
+    Shard(const Shard&);
+    Shard& operator=(const Shard&);
+    
+    Int_t fNSteps;
+    Long64_t fNBins;
+    Bool_t fSparse;
+    std::vector<Bool_t> fWeighted;                                              // weight != 1 used in step
+    std::vector<std::vector<TemplateType> > fDenseValues;                       // dense storage per step
+    std::vector<std::vector<TemplateType> > fDenseSumw2;                        // dense storage per step, created when weighted
+    std::vector<std::unordered_map<Long64_t, std::pair<TemplateType, TemplateType> > > fSparseBins; // sparse storage per step (value, sumw2)
+  };
+  
   void Init();
+  void InitAxisCache();
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
+  Long64_t FindGlobalBin(const Double_t* var, Double_t* lastVars, Int_t* lastBins) const;
   
   Long64_t fNBins;   // number of total bins
   Int_t    fNVars;   // number of variables
@@ -77,6 +121,9 @@ protected:
   Int_t* fNbinsCache; //! cache Nbins per axis
   Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
   Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
+  std::vector<Shard*> fShards; //! per-thread fill buffers in sharded mode
+  std::vector<Bool_t> fAxisUniform; //! axis has equidistant bins (bin index can be calculated arithmetically)
+  std::vector<Long64_t> fBatchBins; //! global bin indices of the current batch in FillBatch
   
   ClassDef(AliTHnT, 5) // THn like container
 };
@@ -6,6 +6,8 @@
 
 #pragma link C++ class AliAnalysisHelperJetTasks+;
 #pragma link C++ class AliBasicParticle+;
+#pragma link C++ class AliCompactEventPool+;
+#pragma link C++ class AliCompactEventPoolManager+;
 #pragma link C++ class AliFigure+;
 #pragma link C++ class AliCanvas+;
 #pragma link C++ class AliHelperPID+;
@@ -37,4 +39,5 @@
 #pragma link C++ function TestTHistManager::TestRunBuildGrouped();
 #pragma link C++ function TestTHistManager::TestRunFillSimple();
 #pragma link C++ function TestTHistManager::TestRunFillGrouped();
+#pragma link C++ function TestTHistManager::TestRunFillHandle();
 #endif
@@ -409,17 +409,8 @@ void THistManager::SetObject(TObject * const o, const char *group) {
 }
 
 void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+	TH1 *hist = FindHistogram<TH1>(name, "THistManager::FillTH1");
+	if(!hist) return;
 	TString optionstring(opt);
 	if(optionstring.Contains("w")){
 	  // use bin width as weight
@@ -432,17 +423,8 @@ void THistManager::FillTH1(const char *name, double x, double weight, Option_t *
 }
 
 void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
+  TH1 *hist = FindHistogram<TH1>(name, "THistManager::FillTH1");
+  if(!hist) return;
 	TString optionstring(opt);
 	if(optionstring.Contains("w")){
 	  // use bin width as weight
@@ -456,17 +438,8 @@ void THistManager::FillTH1(const char *name, const char *label, double weight, O
 }
 
 void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+	TH2 *hist = FindHistogram<TH2>(name, "THistManager::FillTH2");
+	if(!hist) return;
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -481,17 +454,8 @@ void THistManager::FillTH2(const char *name, double x, double y, double weight,
 }
 
 void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+	TH2 *hist = FindHistogram<TH2>(name, "THistManager::FillTH2");
+	if(!hist) return;
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -506,17 +470,8 @@ void THistManager::FillTH2(const char *name, double *point, double weight, Optio
 }
 
 void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
+  TH2 *hist = FindHistogram<TH2>(name, "THistManager::FillTH2");
+  if(!hist) return;
   TString optstring(opt);
   Double_t myweight = optstring.Contains("w") ? 1. : weight;
   if(optstring.Contains("wx")){
@@ -531,17 +486,8 @@ void THistManager::FillTH2(const char *name, const char *labelX, const char *lab
 }
 
 void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+	TH3 *hist = FindHistogram<TH3>(name, "THistManager::FillTH3");
+	if(!hist) return;
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -560,17 +506,8 @@ void THistManager::FillTH3(const char* name, double x, double y, double z, doubl
 }
 
 void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+	TH3 *hist = FindHistogram<TH3>(name, "THistManager::FillTH3");
+	if(!hist) return;
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -589,17 +526,8 @@ void THistManager::FillTH3(const char* name, const double* point, double weight,
 }
 
 void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTHnSparse", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	THnSparseD *hist = dynamic_cast<THnSparseD *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+	THnSparseD *hist = FindHistogram<THnSparseD>(name, "THistManager::FillTHnSparse");
+	if(!hist) return;
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
@@ -615,16 +543,30 @@ void THistManager::FillTHnSparse(const char *name, const double *x, double weigh
 }
 
 void THistManager::FillProfile(const char* name, double x, double y, double weight){
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent)
-		Fatal("THistManager::FillTProfile", "Parent group %s does not exist", dirname.Data());
-  TProfile *hist = dynamic_cast<TProfile *>(parent->FindObject(hname));
-  if(!hist)
-		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+  TProfile *hist = FindHistogram<TProfile>(name, "THistManager::FillTProfile");
+  if(!hist) return;
   hist->Fill(x, y, weight);
 }
 
+void THistManager::FillN(const Handle<TH1> &hist, const double *x, const double *w, int n){
+  hist->FillN(n, x, w);
+}
+
+void THistManager::FillN(const Handle<TH2> &hist, const double *x, const double *y, const double *w, int n){
+  hist->FillN(n, x, y, w);
+}
+
+void THistManager::FillN(const Handle<TProfile> &hist, const double *x, const double *y, const double *w, int n){
+  hist->FillN(n, x, y, w);
+}
+
+void THistManager::FillN(const Handle<THnSparse> &hist, const double *x, const double *w, int n){
+  Int_t ndim = hist->GetNdimensions();
+  for(int ientry = 0; ientry < n; ientry++){
+    hist->Fill(x + ientry * ndim, w ? w[ientry] : 1.);
+  }
+}
+
 TObject *THistManager::FindObject(const char *name) const {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
@@ -1030,6 +972,68 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandleHistograms(){
+    THistManager testmgr("testmgr");
+
+    testmgr.CreateTH1("Group1/Test1", "Test handle fill 1D", 1, 0., 1.);
+    testmgr.CreateTH2("Test2", "Test handle fill 2D", 1, 0., 1., 1, 0., 1.);
+    testmgr.CreateTH3("Test3", "Test handle fill 3D", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[4] = {1,1,1,1}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1.};
+    testmgr.CreateTHnSparse("TestN", "Test handle fill THnSparse", 4, nbins, min, max);
+    testmgr.CreateTProfile("Group2/Subgroup1/TestProfile", "Test handle fill profile", 1, 0., 1.);
+
+    THistManager::Handle<TH1> h1 = testmgr.GetHandle<TH1>("Group1/Test1");
+    THistManager::Handle<TH2> h2 = testmgr.GetHandle<TH2>("Test2");
+    THistManager::Handle<TH3> h3 = testmgr.GetHandle<TH3>("Test3");
+    THistManager::Handle<THnSparse> hN = testmgr.GetHandle<THnSparse>("TestN");
+    THistManager::Handle<TProfile> hProf = testmgr.GetHandle<TProfile>("Group2/Subgroup1/TestProfile");
+    if(!(h1.IsValid() && h2.IsValid() && h3.IsValid() && hN.IsValid() && hProf.IsValid())){
+      std::cout << "Handles not resolved" << std::endl;
+      return 1;
+    }
+
+    double point[4] = {0.5, 0.5, 0.5, 0.5};
+    for(int i = 0; i < 100; i++){
+      h1.Fill(0.5);
+      h2.Fill(0.5, 0.5);
+      h3.Fill(0.5, 0.5, 0.5);
+      hN.Fill(point);
+      hProf.Fill(0.5, 1.);
+    }
+
+    std::vector<double> xvals(400, 0.5), yvals(100, 1.), weights(100, 1.);
+    THistManager::FillN(h1, xvals.data(), weights.data(), 100);
+    THistManager::FillN(h2, xvals.data(), xvals.data(), nullptr, 100);
+    THistManager::FillN(hN, xvals.data(), nullptr, 100);
+    THistManager::FillN(hProf, xvals.data(), yvals.data(), weights.data(), 100);
+    for(int i = 0; i < 100; i++) h3.Fill(0.5, 0.5, 0.5);
+
+    // Evaluate test
+    bool success(true);
+    if(TMath::Abs(h1->GetBinContent(1) - 200) > DBL_EPSILON){
+      std::cout << "Group1/Test1: Value mismatch: expected 200, found " << h1->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h2->GetBinContent(1,1) - 200) > DBL_EPSILON){
+      std::cout << "Test2: Value mismatch: expected 200, found " << h2->GetBinContent(1,1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h3->GetBinContent(1,1,1) - 200) > DBL_EPSILON){
+      std::cout << "Test3: Value mismatch: expected 200, found " << h3->GetBinContent(1,1,1) << std::endl;
+      success = false;
+    }
+    int index[4] = {1,1,1,1};
+    if(TMath::Abs(hN->GetBinContent(index) - 200) > DBL_EPSILON){
+      std::cout << "TestN: Value mismatch: expected 200, found " << hN->GetBinContent(index) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(hProf->GetBinContent(1) - 1) > DBL_EPSILON){
+      std::cout << "Group2/Subgroup1/TestProfile: Value mismatch: expected 1, found " << hProf->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1054,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handle" << std::endl;
+    testresult += testsuite.TestFillHandleHistograms();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1080,9 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandle(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandleHistograms();
+  }
 }
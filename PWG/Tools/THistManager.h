@@ -95,6 +95,20 @@ class TProfile;
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
  * the weight is calculated for all directions at the same time.
+ *
+ * ## Filling via handles
+ *
+ * Each call to a Fill method using the histogram name needs to look up
+ * the histogram in the (grouped) container. For histograms filled per track
+ * or per cluster the histogram can instead be resolved once into a typed
+ * @ref THistManager::Handle, which fills the histogram directly. Arrays
+ * of entries can be filled at once using the FillN functions:
+ *
+ * ~~~{.cxx}
+ * auto hpt = mgr.GetHandle<TH1>("hPt");
+ * hpt.Fill(pt);
+ * THistManager::FillN(hpt, ptvalues, nullptr, npt);
+ * ~~~
  */
 class THistManager : public TNamed {
 public:
@@ -229,6 +243,55 @@ public:
     iterator();
   };
 
+  /**
+   * @class Handle
+   * @brief Typed reference to a histogram inside the histogram manager
+   * @ingroup Histmanager
+   *
+   * Handles are resolved once, typically in UserCreateOutputObjects,
+   * via THistManager::GetHandle, and can then be used in the event loop
+   * to fill the histogram without any lookup by name:
+   *
+   * ~~~{.cxx}
+   * // UserCreateOutputObjects
+   * fHandlePt = fHistos->GetHandle<TH1>("hPt");
+   * // UserExec
+   * fHandlePt.Fill(track->Pt());
+   * ~~~
+   *
+   * The handle does not own the histogram, ownership stays with the
+   * histogram manager. Options of the string-based Fill functions
+   * (i.e. bin width correction) are not applied when filling via the
+   * handle.
+   */
+  template<class T>
+  class Handle {
+  public:
+    Handle(): fHist(nullptr) {}
+    explicit Handle(T *hist): fHist(hist) {}
+    ~Handle() {}
+
+    /**
+     * @brief Fill the underlying histogram.
+     *
+     * Arguments are forwarded to the Fill function
+     * of the histogram type.
+     */
+    template<typename... Args>
+    void Fill(Args... args) const { fHist->Fill(args...); }
+
+    /**
+     * @brief Check whether the handle is connected to a histogram
+     * @return True if a histogram is connected
+     */
+    bool IsValid() const { return fHist != nullptr; }
+    T *Get() const { return fHist; }
+    T *operator->() const { return fHist; }
+
+  private:
+    T *fHist;                       ///< Underlying histogram (not owned)
+  };
+
   /**
    * @brief Default constructor.
    *
@@ -634,6 +697,56 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Resolve a histogram into a typed handle.
+   *
+   * The histogram name also contains the parent group(s)
+   * according to the common group notation. The lookup is done
+   * only once, the handle can be used for filling afterwards.
+   * @param[in] name Name of the histogram
+   * @return Handle connected to the histogram
+   */
+  template<class T>
+  Handle<T> GetHandle(const char *name) const { return Handle<T>(FindHistogram<T>(name, "THistManager::GetHandle")); }
+
+  /**
+   * @brief Fill n entries into a 1D histogram via its handle
+   * @param[in] hist Handle of the histogram
+   * @param[in] x Array of x-coordinates
+   * @param[in] w Array of weights (nullptr for unit weights)
+   * @param[in] n Number of entries
+   */
+  static void FillN(const Handle<TH1> &hist, const double *x, const double *w, int n);
+
+  /**
+   * @brief Fill n entries into a 2D histogram via its handle
+   * @param[in] hist Handle of the histogram
+   * @param[in] x Array of x-coordinates
+   * @param[in] y Array of y-coordinates
+   * @param[in] w Array of weights (nullptr for unit weights)
+   * @param[in] n Number of entries
+   */
+  static void FillN(const Handle<TH2> &hist, const double *x, const double *y, const double *w, int n);
+
+  /**
+   * @brief Fill n entries into a profile histogram via its handle
+   * @param[in] hist Handle of the profile histogram
+   * @param[in] x Array of x-coordinates
+   * @param[in] y Array of y-coordinates
+   * @param[in] w Array of weights (nullptr for unit weights)
+   * @param[in] n Number of entries
+   */
+  static void FillN(const Handle<TProfile> &hist, const double *x, const double *y, const double *w, int n);
+
+  /**
+   * @brief Fill n entries into a THnSparse via its handle
+   * @param[in] hist Handle of the histogram
+   * @param[in] x Coordinates of the entries, ndim consecutive values per entry
+   * @param[in] w Array of weights (nullptr for unit weights)
+   * @param[in] n Number of entries
+   */
+  static void FillN(const Handle<THnSparse> &hist, const double *x, const double *w, int n);
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -705,6 +818,18 @@ private:
 	 */
 	THashList *FindGroup(const char *dirname) const;
 
+	/**
+	 * @brief Find histogram of a given type.
+	 *
+	 * Name is using common notation. Fails with Fatal in case
+	 * either the parent group or the histogram is not found.
+	 * @param[in] name Path of the histogram
+	 * @param[in] caller Name of the calling function (for error messages)
+	 * @return Histogram (NULL if not found)
+	 */
+	template<class T>
+	T *FindHistogram(const char *name, const char *caller) const;
+
 	/**
 	 * @brief Extracting the basename from a given histogram path.
 	 * @param[in] path histogram path
@@ -727,6 +852,22 @@ private:
   /// \endcond
 };
 
+template<class T>
+T *THistManager::FindHistogram(const char *name, const char *caller) const {
+  TString dirname(basename(name)), hname(histname(name));
+  THashList *parent(FindGroup(dirname));
+  if(!parent){
+    Fatal(caller, "Parent group %s does not exist", dirname.Data());
+    return nullptr;
+  }
+  T *hist = dynamic_cast<T *>(parent->FindObject(hname));
+  if(!hist){
+    Fatal(caller, "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+    return nullptr;
+  }
+  return hist;
+}
+
 THistManager::iterator THistManager::begin() const {
   return iterator(this, 0, iterator::kTHMIforward);
 }
@@ -845,6 +986,21 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether histograms are filled properly via handles
+   * Relies on: TestBuildSimpleHistograms, TestBuildGroupedHistograms
+   *
+   * Resolving handles for histograms of all types (TH1 and TProfile in groups),
+   * filling them 100 times for bin 1 via the handle, and in addition 100 times
+   * via FillN
+   *
+   * Test passed:
+   * - All handles are valid
+   * - All Histograms have the expected value (200 for histograms, 1 for profile)
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandleHistograms();
 };
 
 /**
@@ -882,5 +1038,12 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandle();
+
 }
 #endif
@@ -22,10 +22,15 @@
 //
 // Author: Jan Fiete Grosse-Oetringhaus, Sara Vallero
 
+#include <algorithm>
+#include <vector>
+
 #include "AliUEHistograms.h"
 
 #include "AliCFContainer.h"
+#include "AliTHn.h"
 #include "AliBasicParticle.h"
+#include "AliCFParticle.h"
 #include "AliVParticle.h"
 #include "AliAODTrack.h"
 
@@ -76,6 +81,7 @@ AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const
   fPtOrder(kTRUE),
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
+  fBlockedPairLoop(kFALSE),
   fRunNumber(0),
   fMergeCount(1)
 {
@@ -247,6 +253,7 @@ AliUEHistograms::AliUEHistograms(const AliUEHistograms &c) :
   fPtOrder(kTRUE),
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
+  fBlockedPairLoop(kFALSE),
   fRunNumber(0),
   fMergeCount(1)
 {
@@ -686,6 +693,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
     }
     
+    // in the blocked mode the pairs are filled by FillPairsBlocked and the loop below only fills the trigger particles
+    // the cuts on conversions and resonances are only implemented in the loop below
+    AliTHnBase* blockedTarget = 0;
+    if (fBlockedPairLoop && fCutConversionsV <= 0 && fCutResonancesV <= 0)
+      blockedTarget = dynamic_cast<AliTHnBase*> (fNumberDensityPhi->GetTrackHist(AliUEHist::kToward));
+    if (blockedTarget)
+      FillPairsBlocked(blockedTarget, centrality, zVtx, step, particles, mixed, eta.GetArray(), weight, twoTrackEfficiencyCut, bSign, twoTrackEfficiencyCutValue, applyEfficiency, triggerWeighting, kResonanceDaughterFlag);
+    Int_t jMaxPairs = (blockedTarget) ? 0 : jMax;
+    
     for (Int_t i=0; i<particles->GetEntriesFast(); i++)
     {
       AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
@@ -713,7 +729,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  continue;
 	}
 	
-      for (Int_t j=0; j<jMax; j++)
+      for (Int_t j=0; j<jMaxPairs; j++)
       {
         if (!mixed && i == j)
           continue;
@@ -1001,6 +1017,283 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   FillEvent(centrality, step);
 }
   
+//____________________________________________________________________
+void AliUEHistograms::FillPairsBlocked(AliTHnBase* target, Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed, const Float_t* eta, Float_t weight, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue, Bool_t applyEfficiency, TH1* triggerWeighting, UInt_t resonanceDaughterFlag)
+{
+  // fills the pairs of FillCorrelations into <target>
+  // the result is identical to the pair loop in FillCorrelations, the cuts on conversions and resonances are not implemented here
+  //
+  // the kinematics of the trigger and associated particles are read once into arrays instead of calling the virtual
+  // functions for each pair. For each trigger particle the pair selection and the filled variables are calculated
+  // for blocks of associated particles in loops without branches (which the compiler can vectorize). Only the pairs
+  // which are close in eta are checked for the two-track efficiency cut in a scalar loop. The accepted pairs are
+  // collected column-wise and filled with AliTHnBase::FillBatch in the order of the pair loop, so that also the
+  // weighted sums are the same.
+  //
+  // eta contains the eta of the associated particles, see FillCorrelations for the other arguments
+  
+  const Int_t kBlock = 256;   // associated particles per block
+  const Int_t kBatch = 4096;  // pairs per call of FillBatch
+  const Int_t kNVars = 6;
+  
+  TObjArray* input = (mixed) ? mixed : particles;
+  Int_t jMax = input->GetEntriesFast();
+  if (jMax == 0)
+    return;
+  
+  Bool_t fillpT = (weight < 0);
+  Bool_t sameEvent = (mixed == 0);
+  Bool_t checkEventIndex = fCheckEventNumberInCorrelation;
+  
+  // associated particles
+  std::vector<Double_t> pt(jMax);
+  std::vector<Double_t> phi(jMax);
+  std::vector<Short_t> charge(jMax);
+  std::vector<UInt_t> uniqueID(jMax);
+  std::vector<Long64_t> eventIndex(jMax, 0);
+  std::vector<Char_t> flagged(jMax, 0);
+  std::vector<Double_t> weightAssoc(jMax);
+  std::vector<Double_t> bendingMin((twoTrackEfficiencyCut) ? jMax : 0);
+  std::vector<Double_t> bendingMax((twoTrackEfficiencyCut) ? jMax : 0);
+  
+  for (Int_t j=0; j<jMax; j++)
+  {
+    AliVParticle* particle = (AliVParticle*) input->UncheckedAt(j);
+    
+    pt[j] = particle->Pt();
+    phi[j] = particle->Phi();
+    charge[j] = particle->Charge();
+    uniqueID[j] = particle->GetUniqueID();
+    
+    if (fRejectResonanceDaughters > 0)
+      flagged[j] = particle->TestBit(resonanceDaughterFlag);
+    
+    if (checkEventIndex)
+    {
+      AliBasicParticle* particleBasic = dynamic_cast<AliBasicParticle*>(particle);
+      if (!particleBasic)
+        AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
+      else
+        eventIndex[j] = particleBasic->GetEventIndex();
+    }
+    
+    // weight and efficiency of the associated particle, in the same order and precision as in FillCorrelations
+    Float_t pairWeight = (fillpT) ? (Float_t) pt[j] : weight;
+    Double_t useWeight = pairWeight;
+    if (applyEfficiency && fEfficiencyCorrectionAssociated)
+    {
+      Int_t effVars[4];
+      effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(eta[j]);
+      effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(pt[j]);
+      effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(centrality);
+      effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin(zVtx);
+      useWeight *= fEfficiencyCorrectionAssociated->GetBinContent(effVars);
+    }
+    weightAssoc[j] = useWeight;
+    
+    if (twoTrackEfficiencyCut)
+    {
+      bendingMin[j] = GetDPhiStarBending(pt[j], charge[j], fTwoTrackCutMinRadius, bSign);
+      bendingMax[j] = GetDPhiStarBending(pt[j], charge[j], 2.5, bSign);
+    }
+  }
+  
+  // accepted pairs, stored column-wise (kBatch entries per variable)
+  std::vector<Double_t> vars(kNVars * kBatch);
+  std::vector<Double_t> weights(kBatch);
+  Int_t nPairs = 0;
+  
+  Char_t accept[kBlock];
+  Char_t closeInEta[kBlock];
+  Float_t deta[kBlock];
+  Double_t dphi[kBlock];
+  Double_t pairWeight[kBlock];
+  
+  const Double_t kCloseDEta = twoTrackEfficiencyCutValue * 2.5 * 3;
+  const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
+  const Double_t kDPhiMax = 1.5 * TMath::Pi();
+  const Double_t kDPhiMin = -0.5 * TMath::Pi();
+  
+  for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+  {
+    AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
+    
+    // same trigger selection as in FillCorrelations
+    Float_t triggerEta = triggerParticle->Eta();
+    
+    if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
+      continue;
+    if (fOnlyOneEtaSide != 0 && fOnlyOneEtaSide * triggerEta < 0)
+      continue;
+    if (fTriggerSelectCharge != 0 && triggerParticle->Charge() * fTriggerSelectCharge < 0)
+      continue;
+    if (fRejectResonanceDaughters > 0 && triggerParticle->TestBit(resonanceDaughterFlag))
+      continue;
+    
+    Double_t triggerPt = triggerParticle->Pt();
+    Double_t triggerPhi = triggerParticle->Phi();
+    Short_t triggerCharge = triggerParticle->Charge();
+    UInt_t triggerUniqueID = triggerParticle->GetUniqueID();
+    
+    Long64_t triggerEventIndex = 0;
+    if (checkEventIndex)
+    {
+      AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
+      if (!triggerParticleBasic)
+        AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
+      else
+        triggerEventIndex = triggerParticleBasic->GetEventIndex();
+    }
+    
+    // IsEqual of AliBasicParticle and AliCFParticle compares the unique IDs, for other classes it is called for each pair
+    Bool_t compareUniqueID = !sameEvent && !checkEventIndex && (triggerParticle->IsA() == AliBasicParticle::Class() || triggerParticle->IsA() == AliCFParticle::Class());
+    Bool_t callIsEqual = !sameEvent && !checkEventIndex && !compareUniqueID;
+    
+    // factors of the weight which only depend on the trigger particle, 1 if not used (which is exact)
+    Double_t triggerEfficiency = 1;
+    if (applyEfficiency && fEfficiencyCorrectionTriggers)
+    {
+      Int_t effVars[4];
+      effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
+      effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(triggerPt);
+      effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(centrality);
+      effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(zVtx);
+      triggerEfficiency = fEfficiencyCorrectionTriggers->GetBinContent(effVars);
+    }
+    Double_t triggerWeight = 1;
+    if (fWeightPerEvent)
+      triggerWeight = triggerWeighting->GetBinContent(triggerWeighting->GetXaxis()->FindBin(triggerPt));
+    
+    Double_t triggerBendingMin = 0;
+    Double_t triggerBendingMax = 0;
+    if (twoTrackEfficiencyCut)
+    {
+      triggerBendingMin = GetDPhiStarBending(triggerPt, triggerCharge, fTwoTrackCutMinRadius, bSign);
+      triggerBendingMax = GetDPhiStarBending(triggerPt, triggerCharge, 2.5, bSign);
+    }
+    
+    for (Int_t j0=0; j0<jMax; j0+=kBlock)
+    {
+      Int_t n = TMath::Min(kBlock, jMax - j0);
+      
+      // pair selection and variables without branches
+      for (Int_t k=0; k<n; k++)
+      {
+        Int_t j = j0 + k;
+        Int_t chargeProduct = charge[j] * triggerCharge;
+        
+        Bool_t ok = !sameEvent | (i != j);
+        ok &= !checkEventIndex | (eventIndex[j] != triggerEventIndex);
+        ok &= !compareUniqueID | (uniqueID[j] != triggerUniqueID);
+        ok &= !fPtOrder | !(pt[j] >= triggerPt);
+        ok &= !(charge[j] * fAssociatedSelectCharge < 0);
+        ok &= (fSelectCharge != 1) | !(chargeProduct > 0);
+        ok &= (fSelectCharge != 2) | !(chargeProduct < 0);
+        ok &= !fEtaOrdering | !(((triggerEta < 0) & (eta[j] < triggerEta)) | ((triggerEta > 0) & (eta[j] > triggerEta)));
+        ok &= !flagged[j];
+        
+        deta[k] = triggerEta - eta[j];
+        
+        Double_t d = triggerPhi - phi[j];
+        d = (d > kDPhiMax) ? d - TMath::TwoPi() : d;
+        d = (d < kDPhiMin) ? d + TMath::TwoPi() : d;
+        dphi[k] = d;
+        
+        pairWeight[k] = weightAssoc[j] * triggerEfficiency / triggerWeight;
+        
+        accept[k] = ok;
+        closeInEta[k] = ok & twoTrackEfficiencyCut & (TMath::Abs(deta[k]) < kCloseDEta);
+      }
+      
+      if (callIsEqual)
+      {
+        for (Int_t k=0; k<n; k++)
+          if (accept[k] && triggerParticle->IsEqual(input->UncheckedAt(j0 + k)))
+            accept[k] = closeInEta[k] = 0;
+      }
+      
+      // two-track efficiency cut as in FillCorrelations
+      if (twoTrackEfficiencyCut)
+      {
+        for (Int_t k=0; k<n; k++)
+        {
+          if (!closeInEta[k])
+            continue;
+          
+          Int_t j = j0 + k;
+          
+          Float_t phi1 = triggerPhi;
+          Float_t pt1 = triggerPt;
+          Float_t charge1 = triggerCharge;
+          
+          Float_t phi2 = phi[j];
+          Float_t pt2 = pt[j];
+          Float_t charge2 = charge[j];
+          
+          Float_t dphistar1 = GetDPhiStar(phi1 - phi2, triggerBendingMin, bendingMin[j]);
+          Float_t dphistar2 = GetDPhiStar(phi1 - phi2, triggerBendingMax, bendingMax[j]);
+          
+          if (!(TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0))
+            continue;
+          
+          Float_t dphistarminabs = 1e5;
+          Float_t dphistarmin = 1e5;
+          for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
+          {
+            Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
+            Float_t dphistarabs = TMath::Abs(dphistar);
+            
+            if (dphistarabs < dphistarminabs)
+            {
+              dphistarmin = dphistar;
+              dphistarminabs = dphistarabs;
+            }
+          }
+          
+          fTwoTrackDistancePt[0]->Fill(deta[k], dphistarmin, TMath::Abs(pt1 - pt2));
+          
+          if (dphistarminabs < twoTrackEfficiencyCutValue && TMath::Abs(deta[k]) < twoTrackEfficiencyCutValue)
+          {
+            accept[k] = 0;
+            continue;
+          }
+          
+          fTwoTrackDistancePt[1]->Fill(deta[k], dphistarmin, TMath::Abs(pt1 - pt2));
+        }
+      }
+      
+      // collect the accepted pairs in the order of the pair loop
+      for (Int_t k=0; k<n; k++)
+      {
+        if (!accept[k])
+          continue;
+        
+        vars[0 * kBatch + nPairs] = deta[k];
+        vars[1 * kBatch + nPairs] = pt[j0 + k];
+        vars[2 * kBatch + nPairs] = triggerPt;
+        vars[3 * kBatch + nPairs] = centrality;
+        vars[4 * kBatch + nPairs] = dphi[k];
+        vars[5 * kBatch + nPairs] = zVtx;
+        weights[nPairs] = pairWeight[k];
+        
+        if (++nPairs == kBatch)
+        {
+          target->FillBatch(&vars[0], nPairs, step, &weights[0]);
+          nPairs = 0;
+        }
+      }
+    }
+  }
+  
+  if (nPairs > 0)
+  {
+    // FillBatch expects the variables of the <nPairs> entries next to each other
+    for (Int_t v=1; v<kNVars; v++)
+      std::copy(vars.begin() + v * kBatch, vars.begin() + v * kBatch + nPairs, vars.begin() + v * nPairs);
+    target->FillBatch(&vars[0], nPairs, step, &weights[0]);
+  }
+}
+  
 //____________________________________________________________________
 void AliUEHistograms::FillTrackingEfficiency(TObjArray* mc, TObjArray* recoPrim, TObjArray* recoAll, TObjArray* recoPrimPID, TObjArray* recoAllPID, TObjArray* fake, Int_t particleType, Double_t centrality, Double_t zVtx)
 {
@@ -1281,6 +1574,7 @@ void AliUEHistograms::Copy(TObject& c) const
   target.fPtOrder = fPtOrder;
   target.fTwoTrackCutMinRadius = fTwoTrackCutMinRadius;
   target.fCheckEventNumberInCorrelation = fCheckEventNumberInCorrelation;
+  target.fBlockedPairLoop = fBlockedPairLoop;
 }
 
 //____________________________________________________________________
@@ -14,10 +14,12 @@
 #include "THn.h" // in cxx file causes .../THn.h:257: error: conflicting declaration ‘typedef class THnT<float> THnF’
 
 class AliVParticle;
+class AliTHnBase;
 
 class TList;
 class TSeqCollection;
 class TObjArray;
+class TH1;
 class TH1F;
 class TH2F;
 class TH3F;
@@ -96,6 +98,7 @@ class AliUEHistograms : public TNamed
   void SetTwoTrackCutMinRadius(Float_t min) { fTwoTrackCutMinRadius = min; }
 
   void SetCheckEventNumberInCorrelation(Bool_t val) { fCheckEventNumberInCorrelation = val; }
+  void SetBlockedPairLoop(Bool_t flag) { fBlockedPairLoop = flag; }
   void ExtendTrackingEfficiency(Bool_t verbose = kFALSE);
   void Reset();
 
@@ -113,6 +116,9 @@ protected:
   inline Float_t GetInvMassSquared(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetInvMassSquaredCheap(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign);
+  inline Float_t GetDPhiStar(Float_t dphi, Double_t bending1, Double_t bending2);
+  inline Double_t GetDPhiStarBending(Float_t pt, Float_t charge, Float_t radius, Float_t bSign);
+  void FillPairsBlocked(AliTHnBase* target, Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed, const Float_t* eta, Float_t weight, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue, Bool_t applyEfficiency, TH1* triggerWeighting, UInt_t resonanceDaughterFlag);
   
   static const Int_t fgkUEHists; // number of histograms
 
@@ -158,12 +164,13 @@ protected:
   Float_t fTwoTrackCutMinRadius; // min radius for TTR cut
 
   Bool_t fCheckEventNumberInCorrelation; // do not correlate two particles from the same event (only works for AliBasicParticles)
+  Bool_t fBlockedPairLoop;       // fill the pairs in FillCorrelations with FillPairsBlocked (same result, faster for large multiplicities)
 
   Long64_t fRunNumber;           // run number that has been processed
   
   Int_t fMergeCount;		// counts how many objects have been merged together
   
-  ClassDef(AliUEHistograms, 31)  // underlying event histogram container
+  ClassDef(AliUEHistograms, 32)  // underlying event histogram container
 };
 
 Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign)
@@ -172,7 +179,25 @@ Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1,
   // calculates dphistar
   //
   
-  Float_t dphistar = phi1 - phi2 - charge1 * bSign * TMath::ASin(0.075 * radius / pt1) + charge2 * bSign * TMath::ASin(0.075 * radius / pt2);
+  return GetDPhiStar(phi1 - phi2, GetDPhiStarBending(pt1, charge1, radius, bSign), GetDPhiStarBending(pt2, charge2, radius, bSign));
+}
+
+Double_t AliUEHistograms::GetDPhiStarBending(Float_t pt, Float_t charge, Float_t radius, Float_t bSign)
+{
+  //
+  // calculates the bending of a track up to <radius> entering dphistar
+  //
+  
+  return charge * bSign * TMath::ASin(0.075 * radius / pt);
+}
+
+Float_t AliUEHistograms::GetDPhiStar(Float_t dphi, Double_t bending1, Double_t bending2)
+{
+  //
+  // calculates dphistar from dphi and the bending of both tracks (see GetDPhiStarBending)
+  //
+  
+  Float_t dphistar = dphi - bending1 + bending2;
   
   static const Double_t kPi = TMath::Pi();
   
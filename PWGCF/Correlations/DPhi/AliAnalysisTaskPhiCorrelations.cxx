@@ -26,6 +26,7 @@
 #include <TH3F.h>
 #include <TRandom.h>
 #include <TParameter.h>
+#include <TFormula.h>
 
 #include "AliAnalysisTaskPhiCorrelations.h"
 #include "AliAnalyseLeadingTrackUE.h"
@@ -55,6 +56,7 @@
 #include "AliGenHepMCEventHeader.h"
 
 #include "AliEventPoolManager.h"
+#include "AliCompactEventPool.h"
 #include "AliBasicParticle.h"
 #include "AliVHeader.h"
 
@@ -129,6 +131,7 @@ fInputHandler(0x0),
 fMcEvent(0x0),
 fMcHandler(0x0),
 fPoolMgr(0x0),
+fCompactPoolMgr(0x0),
 // histogram settings
 fListOfHistos(0x0), 
 // event QA
@@ -193,7 +196,10 @@ fCustomParticlesA(""),
 fCustomParticlesB(""),
 fEventPoolOutputList(),
 fUsePtBinnedEventPool(0),
-fCheckEventNumberInMixedEvent(kFALSE)
+fCheckEventNumberInMixedEvent(kFALSE),
+fBlockedPairLoop(kFALSE),
+fUseCompactEventPool(kFALSE),
+fCompactEventPoolName()
 {
   // Default constructor
   // Define input and output slots here
@@ -209,6 +215,9 @@ AliAnalysisTaskPhiCorrelations::~AliAnalysisTaskPhiCorrelations()
   
   if (fListOfHistos  && !AliAnalysisManager::GetAnalysisManager()->IsProofMode()) 
     delete fListOfHistos;
+  
+  if (fCompactPoolMgr)
+    fCompactPoolMgr->Detach();
 }
 
 //____________________________________________________________________
@@ -343,6 +352,9 @@ void  AliAnalysisTaskPhiCorrelations::CreateOutputObjects()
   fHistos->SetTwoTrackCutMinRadius(fTwoTrackCutMinRadius);
   fHistosMixed->SetTwoTrackCutMinRadius(fTwoTrackCutMinRadius);
   
+  fHistos->SetBlockedPairLoop(fBlockedPairLoop);
+  fHistosMixed->SetBlockedPairLoop(fBlockedPairLoop);
+  
   if (fEfficiencyCorrectionTriggers)
    {
     fHistos->SetEfficiencyCorrectionTriggers(fEfficiencyCorrectionTriggers);
@@ -454,6 +466,17 @@ void  AliAnalysisTaskPhiCorrelations::CreateOutputObjects()
     fPoolMgr->SetTargetValues(fMixingTracks, 0.1, 5);
   }
 
+  // compact event pool for the reconstructed tracks, stores the tracks as packed records and can be shared between tasks
+  // the number of events is not limited (0), like for AliEventPoolManager the depth is given by fMixingTracks only
+  if (fUseCompactEventPool && !fCompactPoolMgr)
+  {
+    if (fCompactEventPoolName.Length() > 0)
+      fCompactPoolMgr = AliCompactEventPoolManager::Attach(fCompactEventPoolName, GetMixingTrackSelection(), 0, fMixingTracks, nCentralityBins, centralityBins, nZvtxBins, zvtxbin, nPsiBins, psibins, nPtBins, ptbins);
+    else
+      fCompactPoolMgr = new AliCompactEventPoolManager(GetName(), 0, fMixingTracks, nCentralityBins, centralityBins, nZvtxBins, zvtxbin, nPsiBins, psibins, nPtBins, ptbins);
+    fCompactPoolMgr->SetTargetValues(fMixingTracks, 0.1, 5);
+  }
+
   // Check binning of pool manager (basic dimensional check for the time being)
   if( (fPoolMgr->GetNumberOfMultBins() != nCentralityBins) || (fPoolMgr->GetNumberOfZVtxBins() != nZvtxBins) || (fPoolMgr->GetNumberOfPtBins() != nPtBins) )
     AliFatal("Binning of given pool manager not compatible with binning of correlation task!");
@@ -1271,7 +1294,42 @@ void  AliAnalysisTaskPhiCorrelations::AnalyseDataMode()
   TObjArray* tracksClone = CloneAndReduceTrackList(tracks);
   delete tracks;
   
-  if (fFillMixed)
+  if (fFillMixed && fCompactPoolMgr)
+  {
+    // event mixing with the compact event pool, as below
+    // the pool copies the tracks within its pt range itself, the events are shared with other tasks using the same pool
+    for(Int_t iPool=0; iPool<fCompactPoolMgr->GetNumberOfPtBins(); iPool++)
+    {
+      AliCompactEventPool* pool = fCompactPoolMgr->GetEventPool(centrality, zVtx, 0., iPool);
+      
+      if (!pool)
+        AliFatal(Form("No pool found for centrality = %f, zVtx = %f", centrality, zVtx));
+      
+      if (pool->IsReady()) 
+      {
+        Int_t nMix = pool->GetCurrentNEvents();
+        
+        ((TH1F*) fListOfHistos->FindObject("eventStat"))->Fill(2);
+        ((TH1F*) fListOfHistos->FindObject("eventStat"))->Fill(3, nMix);
+        ((TH2F*) fListOfHistos->FindObject("mixedDist"))->Fill(centrality, pool->NTracksInPool());
+        ((TH2F*) fListOfHistos->FindObject("mixedDist2"))->Fill(centrality, nMix);
+      
+        for (Int_t jMix=0; jMix<nMix; jMix++) 
+        {
+          TObjArray* bgTracks = pool->GetEvent(jMix);
+        
+          if (!fSkipStep6)
+            fHistosMixed->FillCorrelations(centrality, zVtx, AliUEHist::kCFStepReconstructed, tracksClone, bgTracks, 1.0 / nMix, (jMix == 0), kFALSE, 0, 0.02, kTRUE);
+
+          if (fTwoTrackEfficiencyCut > 0)
+            fHistosMixed->FillCorrelations(centrality, zVtx, AliUEHist::kCFStepBiasStudy, tracksClone, bgTracks, 1.0 / nMix, (jMix == 0), kTRUE, bSign, fTwoTrackEfficiencyCut, kTRUE);
+        }
+      }
+      
+      pool->UpdatePool((tracksCorrelate) ? tracksCorrelate : tracksClone, fFillCorrelationsRapidity);
+    }
+  }
+  else if (fFillMixed)
   {
     // event mixing
     
@@ -2081,9 +2139,28 @@ void AliAnalysisTaskPhiCorrelations::AddEventPoolsToOutput(Double_t minCent, Dou
   fEventPoolOutputList.push_back(binVec);
 }
 
+//____________________________________________________________________
+TString AliAnalysisTaskPhiCorrelations::GetMixingTrackSelection() const
+{
+  // describes the selection of the tracks stored in the event pool, tasks sharing a compact event pool must have the same
+
+  return Form("filterBit=%u trackStatus=%u eta=%g-%g oneEtaSide=%d ptMin=%g chargedHadrons=%d sharedClusters=%g crossedRows=%d foundFraction=%g dcaXY=%s "
+	      "phiEvPl=%g-%g speciesTrigger=%d speciesAssociated=%d triggersFrom=%d associatedFrom=%d customA=%s customB=%s rapidity=%d",
+	      fFilterBit, fTrackStatus, fTrackEtaCutMin, fTrackEtaCut, fOnlyOneEtaSide, fPtMin, fUseChargeHadrons, fSharedClusterCut, fCrossedRowsCut, fFoundFractionCut,
+	      (fDCAXYCut) ? fDCAXYCut->GetExpFormula().Data() : "none",
+	      fTrackPhiCutEvPlMin, fTrackPhiCutEvPlMax, fParticleSpeciesTrigger, fParticleSpeciesAssociated, fTriggersFromDetector, fAssociatedFromDetector,
+	      fCustomParticlesA.Data(), fCustomParticlesB.Data(), fFillCorrelationsRapidity);
+}
+
 //____________________________________________________________________
 void AliAnalysisTaskPhiCorrelations::FinishTaskOutput()
 {
   // Clear unnecessary pools before saving
   fPoolMgr->ClearPools();
+  
+  if (fCompactPoolMgr)
+  {
+    fCompactPoolMgr->Print();
+    fCompactPoolMgr->ClearPools();
+  }
 }
@@ -42,6 +42,7 @@ class AliUEHistograms;
 class TH1;
 class TObjArray;
 class AliEventPoolManager;
+class AliCompactEventPoolManager;
 class AliESDEvent;
 class AliHelperPID;
 class AliAnalysisUtils;
@@ -171,8 +172,12 @@ public:
   // ##### External event pool configuration
   void SetExternalEventPoolManager(AliEventPoolManager* mgr) {fPoolMgr = mgr;}
   AliEventPoolManager* GetEventPoolManager() {return fPoolMgr;}
+  // use AliCompactEventPoolManager for the mixing of the reconstructed tracks; with <sharedName> the pool is shared with other tasks using the same name (which must store the same tracks, checked with GetMixingTrackSelection)
+  void SetUseCompactEventPool(Bool_t flag = kTRUE, const char* sharedName = "") { fUseCompactEventPool = flag; fCompactEventPoolName = sharedName; }
+  AliCompactEventPoolManager* GetCompactEventPoolManager() { return fCompactPoolMgr; }
   void SetUsePtBinnedEventPool(Bool_t val) {fUsePtBinnedEventPool = val;}
   void SetCheckEventNumberInMixedEvent(Bool_t val) {fCheckEventNumberInMixedEvent = val;}
+  void SetBlockedPairLoop(Bool_t flag) { fBlockedPairLoop = flag; }
 
   // Set which pools will be saved
   void AddEventPoolsToOutput(Double_t minCent, Double_t maxCent,  Double_t minZvtx, Double_t maxZvtx, Double_t minPt, Double_t maxPt);
@@ -181,6 +186,7 @@ private:
   AliAnalysisTaskPhiCorrelations(const  AliAnalysisTaskPhiCorrelations &det);
   AliAnalysisTaskPhiCorrelations&   operator=(const  AliAnalysisTaskPhiCorrelations &det);
   void            AddSettingsTree();                                  // add list of settings to output list
+  TString         GetMixingTrackSelection() const;                    // selection of the tracks in the event pool (see SetUseCompactEventPool)
   // Analysis methods
   void            AnalyseCorrectionMode();                            // main algorithm to get correction maps
   void            AnalyseDataMode();                                  // main algorithm to get raw distributions
@@ -238,6 +244,7 @@ private:
   AliMCEvent*              fMcEvent;         //! MC event
   AliInputEventHandler*    fMcHandler;       //! MCEventHandler
   AliEventPoolManager*     fPoolMgr;         // event pool manager
+  AliCompactEventPoolManager* fCompactPoolMgr; //! compact event pool manager (see SetUseCompactEventPool)
 
   // Histogram settings
   TList*              fListOfHistos;    //  Output list of containers
@@ -316,8 +323,11 @@ private:
   vector<vector<Double_t> >   fEventPoolOutputList; // vector representing a list of pools (given by value range) that will be saved
   Bool_t                      fUsePtBinnedEventPool; // uses event pool in pt bins
   Bool_t                      fCheckEventNumberInMixedEvent; // check event number before correlation in mixed event
+  Bool_t                      fBlockedPairLoop; // fill the pairs with the blocked pair loop of AliUEHistograms (same result, faster)
+  Bool_t                      fUseCompactEventPool; // use AliCompactEventPoolManager instead of AliEventPoolManager for the reconstructed tracks
+  TString                     fCompactEventPoolName; // name of the shared compact event pool (not shared if empty)
 
-  ClassDef(AliAnalysisTaskPhiCorrelations, 62); // Analysis task for delta phi correlations
+  ClassDef(AliAnalysisTaskPhiCorrelations, 64); // Analysis task for delta phi correlations
 };
 
 #endif
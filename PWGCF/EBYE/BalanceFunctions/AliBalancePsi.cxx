@@ -20,6 +20,9 @@
 //-----------------------------------------------------------------
 
 
+#include <algorithm>
+#include <unordered_map>
+
 //ROOT
 #include <Riostream.h>
 #include <TCanvas.h>
@@ -89,7 +92,14 @@ AliBalancePsi::AliBalancePsi() :
   fVertexBinning(kFALSE),
   fCustomBinning(""),
   fBinningString(""),
-  fEventClass("EventPlane"){
+  fEventClass("EventPlane"),
+  fPreBinnedPairs(kFALSE),
+  fPreBinStatus(0),
+  fPreBinEtaWidth(0),
+  fPreBinEtaOffset(0),
+  fPreBinPhiWidth(0),
+  fPreBinPhiOffset(0),
+  fPreBinNPhi(0){
   // Default constructor
 }
 
@@ -133,7 +143,14 @@ AliBalancePsi::AliBalancePsi(const AliBalancePsi& balance):
   fVertexBinning(balance.fVertexBinning),
   fCustomBinning(balance.fCustomBinning),
   fBinningString(balance.fBinningString),
-  fEventClass("EventPlane"){
+  fEventClass("EventPlane"),
+  fPreBinnedPairs(balance.fPreBinnedPairs),
+  fPreBinStatus(0),
+  fPreBinEtaWidth(0),
+  fPreBinEtaOffset(0),
+  fPreBinPhiWidth(0),
+  fPreBinPhiOffset(0),
+  fPreBinNPhi(0){
   //copy constructor
 }
 
@@ -465,6 +482,12 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
   Double_t gWidthForLambda = 0.006;
   Double_t nSigmaRejection = 3.0;
 
+  // fast mode: the pairs are filled after the 1st particle loop from cells of (eta, phi, pT)
+  Bool_t preBinned = fPreBinnedPairs && InitPreBinning();
+  vector<Double_t> firstVariable0;
+  if(preBinned)
+    firstVariable0.resize(iMax);
+
   // 1st particle loop
   for (Int_t i = 0; i < iMax; i++) {
     //AliVParticle* firstParticle = (AliVParticle*) particles->At(i);
@@ -511,6 +534,11 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     //fill single particle histograms
     if(charge1 > 0)      fHistP->Fill(trackVariablesSingle,0,firstCorrection); //==========================correction
     else if(charge1 < 0) fHistN->Fill(trackVariablesSingle,0,firstCorrection);  //==========================correction
+
+    if(preBinned) {
+      firstVariable0[i] = trackVariablesSingle[0];
+      continue;
+    }
     
     // 2nd particle loop
     for(Int_t j = 0; j < jMax; j++) {   
@@ -699,8 +727,288 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
       }
     }//end of 2nd particle loop
   }//end of 1st particle loop
+
+  if(preBinned)
+    FillPairsPreBinned(particles,(particlesMixed != 0),firstVariable0,secondEta,secondPhi,secondPt,secondCharge,secondCorrection,vertexZ);
 }  
 
+//____________________________________________________________________//
+Bool_t AliBalancePsi::InitPreBinning() {
+  // Checks whether the pairs can be filled from cells (see FillPairsPreBinned) and defines the cells.
+  // The cells have the width of the delta eta and delta phi bins. The trigger cells are shifted with
+  // respect to the associated cells, such that the differences of the cell centers are at the centers
+  // of the delta eta and delta phi bins. The pair differences are not: a pair of two cells can belong
+  // to the neighbouring delta eta or delta phi bin of the cell center difference.
+
+  // pair cuts need the single pairs
+  if(fResonancesCut || fHBTCut || fConversionCut || fQCut)
+    return kFALSE;
+
+  if(fPreBinStatus == 0) {
+    fPreBinStatus = -1;
+
+    // equidistant delta eta and delta phi bins, delta phi bins dividing 2 pi
+    const TAxis *axes[2] = {fHistPN->GetAxis(1,0), fHistPN->GetAxis(2,0)};
+    Double_t width[2];
+    for(Int_t iAxis = 0; iAxis < 2; iAxis++) {
+      width[iAxis] = (axes[iAxis]->GetXmax() - axes[iAxis]->GetXmin()) / axes[iAxis]->GetNbins();
+      for(Int_t iBin = 1; iBin <= axes[iAxis]->GetNbins(); iBin++) {
+	if(TMath::Abs(axes[iAxis]->GetBinWidth(iBin) - width[iAxis]) > 1e-4 * width[iAxis]) {
+	  AliWarning(Form("Bins of axis %s not equidistant --> pairs are filled one by one",axes[iAxis]->GetTitle()));
+	  return kFALSE;
+	}
+      }
+    }
+    Int_t nPhi = TMath::Nint(TMath::TwoPi() / width[1]);
+    if(TMath::Abs(nPhi * width[1] - TMath::TwoPi()) > 1e-4 * width[1]) {
+      AliWarning("Delta phi bins do not divide 2 pi --> pairs are filled one by one");
+      return kFALSE;
+    }
+
+    // with momentum ordering the pT bins of trigger and associated particles have to be the same
+    if(fMomentumOrdering) {
+      const TAxis *axisPtTrigger = fHistPN->GetAxis(3,0);
+      const TAxis *axisPtAssociated = fHistPN->GetAxis(4,0);
+      Bool_t samePtBins = (axisPtTrigger->GetNbins() == axisPtAssociated->GetNbins());
+      for(Int_t iBin = 1; samePtBins && iBin <= axisPtTrigger->GetNbins() + 1; iBin++)
+	samePtBins = (axisPtTrigger->GetBinLowEdge(iBin) == axisPtAssociated->GetBinLowEdge(iBin));
+      if(!samePtBins) {
+	AliWarning("Momentum ordering with different trigger and associated pT bins --> pairs are filled one by one");
+	return kFALSE;
+      }
+    }
+
+    fPreBinEtaWidth  = width[0];
+    fPreBinEtaOffset = axes[0]->GetXmin() + 0.5 * width[0];
+    fPreBinNPhi      = nPhi;
+    fPreBinPhiWidth  = TMath::TwoPi() / nPhi;
+    fPreBinPhiOffset = axes[1]->GetXmin() + 0.5 * width[1];
+    fPreBinStatus    = 1;
+    AliInfo(Form("Pairs filled from cells with delta eta = %f, delta phi = %f",fPreBinEtaWidth,fPreBinPhiWidth));
+  }
+
+  return (fPreBinStatus == 1);
+}
+
+namespace {
+  // particles with the same charge in one (eta, phi, pT) cell
+  struct AliBalancePsiCell {
+    Double_t fVariable0; // first variable of the pair histograms (trigger cells)
+    Double_t fEta;       // center of the cell
+    Double_t fPhi;       // center of the cell
+    Double_t fPt;        // center of the pT bin
+    Double_t fW;         // sum of the corrections
+    Double_t fW2;        // sum of the squared corrections
+    Int_t    fPtBin;     // pT bin
+    Short_t  fCharge;    // charge
+  };
+
+  // pairs of cells, stored column-wise for AliTHn::FillBatch
+  class AliBalancePsiPairBuffer {
+  public:
+    AliBalancePsiPairBuffer() :
+      fTarget(0), fN(0), fVars(kTrackVariablesPair * kSize), fWeights(kSize), fWeights2(kSize) {}
+
+    void Add(const AliBalancePsiCell &trigger, const AliBalancePsiCell &associated,
+	     Double_t vertexZ, Double_t weight, Double_t weight2) {
+      Double_t dphi = trigger.fPhi - associated.fPhi;
+      if (dphi > TMath::Pi()) // delta phi between -pi/2 and 3pi/2 as in CalculateBalance
+	dphi -= 2.*TMath::Pi();
+      if (dphi <  - TMath::Pi()) 
+	dphi += 2.*TMath::Pi();
+      if (dphi <  - TMath::Pi()/2.) 
+	dphi += 2.*TMath::Pi();
+
+      fVars[0 * kSize + fN] = trigger.fVariable0;
+      fVars[1 * kSize + fN] = trigger.fEta - associated.fEta;
+      fVars[2 * kSize + fN] = dphi;
+      fVars[3 * kSize + fN] = trigger.fPt;
+      fVars[4 * kSize + fN] = associated.fPt;
+      fVars[5 * kSize + fN] = vertexZ;
+      fWeights[fN] = weight;
+      fWeights2[fN] = weight2;
+      if (++fN == kSize)
+	Flush();
+    }
+
+    void Flush() {
+      if (fN == 0)
+	return;
+      // FillBatch expects the variables of the <fN> entries next to each other
+      if (fN < kSize)
+	for (Int_t i = 1; i < kTrackVariablesPair; i++)
+	  std::copy(fVars.begin() + i * kSize, fVars.begin() + i * kSize + fN, fVars.begin() + i * fN);
+      fTarget->FillBatch(&fVars[0], fN, 0, &fWeights[0], &fWeights2[0]);
+      fN = 0;
+    }
+
+    AliTHn *fTarget;   // histogram to be filled
+
+  private:
+    enum { kSize = 4096 }; // pairs per call of FillBatch
+
+    Int_t fN;                    // number of stored pairs
+    vector<Double_t> fVars;      // variables, kSize entries per variable
+    vector<Double_t> fWeights;   // weights
+    vector<Double_t> fWeights2;  // sums of the squared weights
+  };
+}
+
+//____________________________________________________________________//
+void AliBalancePsi::FillPairsPreBinned(TObjArray *particles, Bool_t mixing,
+				       const vector<Double_t> &firstVariable0,
+				       const TArrayF &secondEta, const TArrayF &secondPhi,
+				       const TArrayF &secondPt, const TArrayS &secondCharge,
+				       const TArrayD &secondCorrection, Double_t vertexZ) {
+  // Fills the pair histograms from cells of (eta, phi, pT) instead of pair by pair (see UsePreBinnedPairs).
+  // The trigger and the associated particles are summed in cells (separately per charge and for the
+  // trigger particles per value of the first variable), with the sums of the corrections and of the
+  // squared corrections. Each pair of cells is filled once at the cell centers with the product of the
+  // sums, which is the sum of the weights of the pairs of the two cells. With respect to CalculateBalance,
+  // pairs can migrate to the neighbouring delta eta and delta phi bin (see InitPreBinning); the pT bins,
+  // the weights and sumw2 are the same.
+  // With momentum ordering the pairs in the same pT bin are added one by one (at the cell centers).
+  // Without mixing the pairs of a particle with itself are subtracted.
+
+  const TAxis *axisPt[2] = {fHistPN->GetAxis(3,0), fHistPN->GetAxis(4,0)};
+  const Double_t offsetEta[2] = {fPreBinEtaOffset, 0.};
+  const Double_t offsetPhi[2] = {fPreBinPhiOffset, 0.};
+  Bool_t variable0IsPsi = (fEventClass != "Multiplicity" && fEventClass != "Centrality");
+
+  // cells of the trigger (0) and the associated (1) particles, cell, pT and correction of each particle
+  vector<AliBalancePsiCell> cells[2];
+  vector<Int_t> cellIndex[2];
+  vector<Float_t> pt[2];
+  vector<Double_t> correction[2];
+  std::unordered_map<Long64_t, Int_t> cellMap;
+
+  for(Int_t side = 0; side < 2; side++) {
+    Int_t nParticles = (side == 0) ? particles->GetEntriesFast() : secondEta.GetSize();
+    Int_t nPtBins = axisPt[side]->GetNbins();
+    cellIndex[side].assign(nParticles,-1);
+    pt[side].resize(nParticles);
+    correction[side].resize(nParticles);
+    cellMap.clear();
+
+    for(Int_t i = 0; i < nParticles; i++) {
+      Float_t eta, phi;
+      Short_t charge;
+      if(side == 1 || !mixing) {
+	eta           = secondEta[i];
+	phi           = secondPhi[i];
+	pt[side][i]   = secondPt[i];
+	charge        = secondCharge[i];
+	correction[side][i] = secondCorrection[i];
+      }
+      else {
+	AliBFBasicParticle* particle = (AliBFBasicParticle*) particles->At(i);
+	eta           = particle->Eta();
+	phi           = particle->Phi();
+	pt[side][i]   = particle->Pt();
+	charge        = (Short_t) particle->Charge();
+	correction[side][i] = particle->Correction();
+      }
+      // the trigger correction is a Float_t in CalculateBalance
+      if(side == 0)
+	correction[side][i] = (Float_t) correction[side][i];
+
+      // particles outside of the pT range do not contribute to the pair histograms
+      Int_t ptBin = axisPt[side]->FindFixBin(pt[side][i]);
+      if(charge == 0 || ptBin < 1 || ptBin > nPtBins)
+	continue;
+
+      Int_t etaBin = TMath::FloorNint((eta - offsetEta[side]) / fPreBinEtaWidth);
+      Int_t phiBin = TMath::FloorNint((phi - offsetPhi[side]) / fPreBinPhiWidth) % fPreBinNPhi;
+      if(phiBin < 0)
+	phiBin += fPreBinNPhi;
+      Double_t variable0 = (side == 0) ? firstVariable0[i] : 0.;
+      Int_t variable0Bin = (side == 0 && variable0IsPsi) ? (Int_t) variable0 : 0;
+
+      Long64_t key = ((((Long64_t) etaBin * fPreBinNPhi + phiBin) * nPtBins + ptBin - 1) * 4 + variable0Bin) * 2 + (charge > 0);
+      std::pair<std::unordered_map<Long64_t, Int_t>::iterator, bool> ins = cellMap.insert(std::make_pair(key,(Int_t) cells[side].size()));
+      if(ins.second) {
+	AliBalancePsiCell cell = {variable0,
+				  offsetEta[side] + (etaBin + 0.5) * fPreBinEtaWidth,
+				  offsetPhi[side] + (phiBin + 0.5) * fPreBinPhiWidth,
+				  axisPt[side]->GetBinCenter(ptBin),
+				  0., 0., ptBin, charge};
+	cells[side].push_back(cell);
+      }
+      AliBalancePsiCell &cell = cells[side][ins.first->second];
+      cell.fW  += correction[side][i];
+      cell.fW2 += correction[side][i] * correction[side][i];
+      cellIndex[side][i] = ins.first->second;
+    }
+  }
+
+  // PN, NP, PP, NN
+  AliBalancePsiPairBuffer buffers[4];
+  buffers[0].fTarget = fHistPN;
+  buffers[1].fTarget = fHistNP;
+  buffers[2].fTarget = fHistPP;
+  buffers[3].fTarget = fHistNN;
+
+  // pairs of cells
+  for(UInt_t t = 0; t < cells[0].size(); t++) {
+    const AliBalancePsiCell &trigger = cells[0][t];
+    for(UInt_t a = 0; a < cells[1].size(); a++) {
+      const AliBalancePsiCell &associated = cells[1][a];
+
+      // pT,Assoc < pT,Trig (if momentum ordering is switched ON), pairs in the same pT bin below
+      if(fMomentumOrdering && trigger.fPtBin <= associated.fPtBin)
+	continue;
+
+      Int_t iBuffer = (trigger.fCharge > 0) ? ((associated.fCharge < 0) ? 0 : 2) : ((associated.fCharge > 0) ? 1 : 3);
+      buffers[iBuffer].Add(trigger,associated,vertexZ,trigger.fW * associated.fW,trigger.fW2 * associated.fW2);
+    }
+  }
+
+  if(fMomentumOrdering) {
+    // pairs in the same pT bin one by one (the pT bins of trigger and associated particles are the same, see InitPreBinning)
+    Int_t nPtBins = axisPt[0]->GetNbins();
+    vector<vector<Int_t> > particlesInPtBin[2];
+    for(Int_t side = 0; side < 2; side++) {
+      particlesInPtBin[side].resize(nPtBins + 1);
+      for(UInt_t i = 0; i < cellIndex[side].size(); i++)
+	if(cellIndex[side][i] >= 0)
+	  particlesInPtBin[side][cells[side][cellIndex[side][i]].fPtBin].push_back(i);
+    }
+
+    for(Int_t ptBin = 1; ptBin <= nPtBins; ptBin++) {
+      const vector<Int_t> &triggers = particlesInPtBin[0][ptBin];
+      const vector<Int_t> &associated = particlesInPtBin[1][ptBin];
+      for(UInt_t i = 0; i < triggers.size(); i++) {
+	Int_t iTrigger = triggers[i];
+	const AliBalancePsiCell &triggerCell = cells[0][cellIndex[0][iTrigger]];
+	for(UInt_t j = 0; j < associated.size(); j++) {
+	  Int_t iAssociated = associated[j];
+	  if(!mixing && iTrigger == iAssociated) continue; // no auto correlations (only for non mixing)
+	  if(pt[0][iTrigger] < pt[1][iAssociated]) continue;
+
+	  const AliBalancePsiCell &associatedCell = cells[1][cellIndex[1][iAssociated]];
+	  Int_t iBuffer = (triggerCell.fCharge > 0) ? ((associatedCell.fCharge < 0) ? 0 : 2) : ((associatedCell.fCharge > 0) ? 1 : 3);
+	  Double_t weight = correction[0][iTrigger] * correction[1][iAssociated];
+	  buffers[iBuffer].Add(triggerCell,associatedCell,vertexZ,weight,weight * weight);
+	}
+      }
+    }
+  }
+  else if(!mixing) {
+    // no auto correlations: subtract the pairs of each particle with itself
+    for(UInt_t i = 0; i < cellIndex[0].size(); i++) {
+      if(cellIndex[0][i] < 0 || cellIndex[1][i] < 0) continue;
+      const AliBalancePsiCell &triggerCell = cells[0][cellIndex[0][i]];
+      const AliBalancePsiCell &associatedCell = cells[1][cellIndex[1][i]];
+      Int_t iBuffer = (triggerCell.fCharge > 0) ? 2 : 3;
+      Double_t weight = correction[0][i] * correction[1][i];
+      buffers[iBuffer].Add(triggerCell,associatedCell,vertexZ,-weight,-weight * weight);
+    }
+  }
+
+  for(Int_t iBuffer = 0; iBuffer < 4; iBuffer++)
+    buffers[iBuffer].Flush();
+}
+
 //____________________________________________________________________//
 TH1D *AliBalancePsi::GetBalanceFunctionHistogram(Int_t iVariableSingle,
 						 Int_t iVariablePair,
@@ -10,6 +10,14 @@
 //   This is the class for the Balance Function writ Psi analysis
 //
 //    Origin: Panos Christakoglou, Nikhef, Panos.Christakoglou@cern.ch
+//
+//   Pre-binned pairs (UsePreBinnedPairs, off by default) are an
+//   approximation: the particles are summed in cells of one delta eta /
+//   delta phi bin width and each pair of cells is filled at the cell
+//   centers. A pair can therefore be counted in the neighbouring delta
+//   eta or delta phi bin; the pT bins, the weights and sumw2 are exact.
+//   Bin-scale structures are smeared by up to one bin, use the default
+//   pair by pair filling where this matters.
 //-------------------------------------------------------------------------
 
 #include <vector>
@@ -28,6 +36,9 @@ using std::vector;
 class TH1D;
 class TH2D;
 class TH3D;
+class TArrayF;
+class TArrayS;
+class TArrayD;
 
 const Int_t kTrackVariablesSingle = 3;       // track variables in histogram (event class, pTtrig, vertexZ)
 const Int_t kTrackVariablesPair   = 6;       // track variables in histogram (event class, dEta, dPhi, pTtrig, ptAssociated, vertexZ)
@@ -231,6 +242,10 @@ class AliBalancePsi : public TObject {
     fConversionCut = kTRUE; fInvMassCutConversion = setInvMassCutConversion; }
   void UseMomentumDifferenceCut(Double_t gDeltaPtCutMin) {
     fQCut = kTRUE; fDeltaPtMin = gDeltaPtCutMin;}
+  // opt-in fast mode: pairs filled from cells of (eta, phi, pT) instead of pair by pair (see FillPairsPreBinned)
+  // approximate in delta eta and delta phi (see class comment)
+  // not used with resonances, HBT, conversion or momentum difference cut (pair by pair filling)
+  void UsePreBinnedPairs(Bool_t preBinnedPairs = kTRUE) {fPreBinnedPairs = preBinnedPairs;}
 
   // related to customized binning of output AliTHn
   Bool_t    IsUseVertexBinning() { return fVertexBinning; }
@@ -239,6 +254,12 @@ class AliBalancePsi : public TObject {
 
  private:
   Float_t   GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign); 
+  Bool_t    InitPreBinning();
+  void      FillPairsPreBinned(TObjArray *particles, Bool_t mixing,
+			       const vector<Double_t> &firstVariable0,
+			       const TArrayF &secondEta, const TArrayF &secondPhi,
+			       const TArrayF &secondPt, const TArrayS &secondCharge,
+			       const TArrayD &secondCorrection, Double_t vertexZ);
 
   Bool_t fShuffle; //shuffled balance function object
   TString fAnalysisLevel; //ESD, AOD or MC
@@ -288,9 +309,17 @@ class AliBalancePsi : public TObject {
 
   TString fEventClass;
 
+  Bool_t fPreBinnedPairs;//fill pairs from cells of (eta, phi, pT)
+  Int_t fPreBinStatus;//! 0: cells not yet defined, 1: cells defined, -1: binning not suited for cells
+  Double_t fPreBinEtaWidth;//! width of the eta cells (delta eta bin width)
+  Double_t fPreBinEtaOffset;//! offset of the trigger eta cells with respect to the associated eta cells
+  Double_t fPreBinPhiWidth;//! width of the phi cells (delta phi bin width)
+  Double_t fPreBinPhiOffset;//! offset of the trigger phi cells with respect to the associated phi cells
+  Int_t fPreBinNPhi;//! number of phi cells
+
   AliBalancePsi & operator=(const AliBalancePsi & ) {return *this;}
 
-  ClassDef(AliBalancePsi, 2)
+  ClassDef(AliBalancePsi, 3)
 };
 
 #endif
@@ -48,6 +48,7 @@ public:
 
   void WriteOutHistos();
   virtual TList* GetOutputList();
+  virtual UInt_t MixedTrackFields() const { return PairCutTrackFields(); }
 
   //  void SetCoulombCorrection(AliFemtoCoulomb* Correction);
 
@@ -53,6 +53,7 @@ public:
 
   void WriteOutHistos();
   virtual TList* GetOutputList();
+  virtual UInt_t MixedTrackFields() const { return PairCutTrackFields(); }
 
   //  void SetCoulombCorrection(AliFemtoCoulomb* Correction);
 
@@ -35,6 +35,7 @@ public:
   void SetBetaTRange(double minbetat, double maxbetat);
   void SetParticleMasses(double masspart1, double masspart2);
   virtual bool Pass(const AliFemtoPair* pair);
+  virtual UInt_t MixedTrackFields() const { return 0; }  ///< only the momentum is read
 
 protected:
   Double_t fBetaTMin;   ///< Minimum allowed BetaT
@@ -37,11 +37,22 @@ public:
 
   virtual AliFemtoCorrFctn* Clone() { return 0;}
 
+  // track fields of the mixed pairs read besides the momentum, including the ones of
+  // the specific pair cut (AliFemtoPicoEventPool::EField); by default any field
+  virtual UInt_t MixedTrackFields() const { return AliFemtoPicoEventPool::kUnstored; }
+
+  // true if AddMixedPair only fills the histograms of GetOutputList() with unit weights,
+  // so the mixed pairs can be filled into clones in several threads and added exactly
+  virtual bool MixedPairsMergeable() const { return false; }
+
   AliFemtoAnalysis* HbtAnalysis(){return fyAnalysis;};
   void SetAnalysis(AliFemtoAnalysis* aAnalysis);
   void SetPairSelectionCut(AliFemtoPairCut* aCut);
+  AliFemtoPairCut* PairSelectionCut() const { return fPairCut; }
 
 protected:
+  UInt_t PairCutTrackFields() const { return fPairCut ? fPairCut->MixedTrackFields() : 0; }
+
   AliFemtoAnalysis* fyAnalysis; //! link to the analysis
   AliFemtoPairCut* fPairCut;    //! this is a PairSelection criteria for this Correlation Function
 
@@ -43,6 +43,7 @@ public:
 
   void WriteOutHistos();
   virtual TList* GetOutputList();
+  virtual UInt_t MixedTrackFields() const { return PairCutTrackFields(); }
 
   void SetUseLCMS(int);
   int  GetUseLCMS();
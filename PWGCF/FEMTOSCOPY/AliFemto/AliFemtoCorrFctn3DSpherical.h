@@ -36,6 +36,7 @@ public:
 
   void WriteOutHistos();
   virtual TList* GetOutputList();
+  virtual UInt_t MixedTrackFields() const { return PairCutTrackFields(); }
 
   //  void SetSpecificPairCut(AliFemtoPairCut* aCut);
 
@@ -34,6 +34,7 @@ public:
 
   void WriteHistos();
   virtual TList* GetOutputList();
+  virtual UInt_t MixedTrackFields() const { return AliFemtoPicoEventPool::kCharge | PairCutTrackFields(); }
 
   void SetMinimumRadius(double minrad);
   void SetMagneticFieldSign(int magsign);
@@ -34,6 +34,8 @@ public:
   virtual void Finish();
 
   virtual TList* GetOutputList();
+  virtual UInt_t MixedTrackFields() const { return PairCutTrackFields(); }
+  virtual bool MixedPairsMergeable() const { return true; }
   void Write();
 
   virtual AliFemtoCorrFctn* Clone();
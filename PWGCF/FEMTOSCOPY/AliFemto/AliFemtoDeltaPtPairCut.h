@@ -29,6 +29,7 @@ public:
   AliFemtoPairCut* Clone();
   void SetDeltaPtRange(double ktmin, double ktmax);
   virtual bool Pass(const AliFemtoPair* pair);
+  virtual UInt_t MixedTrackFields() const { return 0; }  ///< only the momentum is read
 
 protected:
   Double_t fDeltaPtMin; ///< Minimum allowed pair transverse momentum
@@ -82,9 +82,12 @@ public:
   AliFemtoDummyPairCut& operator=(const AliFemtoDummyPairCut&);
 
   virtual bool Pass(const AliFemtoPair*);
+  virtual UInt_t MixedTrackFields() const { return 0; }  ///< no track field is read
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   AliFemtoDummyPairCut* Clone();
+  virtual void AddCounts(const AliFemtoPairCut* aCut);
+  virtual void ResetCounts();
 
 private:
   long fNPairsPassed;  ///< number of pairs analyzed by this cut that passed
@@ -101,4 +104,13 @@ inline AliFemtoDummyPairCut::AliFemtoDummyPairCut(const AliFemtoDummyPairCut& c)
 inline AliFemtoDummyPairCut& AliFemtoDummyPairCut::operator=(const AliFemtoDummyPairCut& c) {   if (this != &c) { AliFemtoPairCut::operator=(c); }  return *this; }
 inline AliFemtoDummyPairCut* AliFemtoDummyPairCut::Clone() { AliFemtoDummyPairCut* c = new AliFemtoDummyPairCut(*this); return c;}
 
+inline void AliFemtoDummyPairCut::AddCounts(const AliFemtoPairCut* aCut)
+{
+  if (const AliFemtoDummyPairCut* tCut = dynamic_cast<const AliFemtoDummyPairCut*>(aCut)) {
+    fNPairsPassed += tCut->fNPairsPassed;
+    fNPairsFailed += tCut->fNPairsFailed;
+  }
+}
+inline void AliFemtoDummyPairCut::ResetCounts() { fNPairsPassed = 0; fNPairsFailed = 0; }
+
 #endif
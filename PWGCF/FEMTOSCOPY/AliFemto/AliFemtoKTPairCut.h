@@ -44,6 +44,7 @@ public:
   void SetPhiRange(double phimin, double phimax);
   void SetPTMin(double ptmin, double ptmax=1000.0);
   virtual bool Pass(const AliFemtoPair* pair);
+  virtual UInt_t MixedTrackFields() const { return 0; }  ///< only the momentum is read
   virtual bool Pass(const AliFemtoPair* pair, double aRPAngle);
 
  protected:
@@ -31,6 +31,8 @@ public:
   // track Sets:
   void SetTrack1(const AliFemtoParticle* trkPtr);
   void SetTrack2(const AliFemtoParticle* trkPtr);
+  /// Set precalculated k* quantities (see AliFemtoPairEngineSoA), after SetTrack1/2
+  void SetNonIdPar(double aKOut, double aKSide, double aKLong, double aKStar, double aCVK);
 
   AliFemtoLorentzVector FourMomentumDiff() const;
   AliFemtoLorentzVector FourMomentumSum() const;
@@ -247,6 +249,15 @@ inline void AliFemtoPair::SetTrack2(const AliFemtoParticle* trkPtr){
   ResetParCalculated();
 }
 
+inline void AliFemtoPair::SetNonIdPar(double aKOut, double aKSide, double aKLong, double aKStar, double aCVK){
+  fDKOut = aKOut;
+  fDKSide = aKSide;
+  fDKLong = aKLong;
+  fKStarCalc = aKStar;
+  fCVK = aCVK;
+  fNonIdParNotCalculated = 0;
+}
+
 inline AliFemtoParticle* AliFemtoPair::Track1() const {return fTrack1;}
 inline AliFemtoParticle* AliFemtoPair::Track2() const {return fTrack2;}
 
@@ -18,6 +18,7 @@ class AliFemtoAnalysis;
 #include "AliFemtoEvent.h"
 #include "AliFemtoPair.h"
 #include "AliFemtoCutMonitorHandler.h"
+#include "AliFemtoPicoEventPool.h"
 #include <TList.h>
 #include <TObjString.h>
 
@@ -33,6 +34,9 @@ public:
   AliFemtoPairCut(const AliFemtoPairCut& c);         ///< copy constructor
   virtual ~AliFemtoPairCut();                        ///< destructor
   virtual AliFemtoPairCut* Clone() { return NULL; }  ///< Clones the object. The default implementation simply returns NULL
+  virtual void AddCounts(const AliFemtoPairCut* /*aCut*/) { }  ///< Add the pair counts of a clone of this cut (mixing threads). The default implementation does nothing
+  virtual void ResetCounts() { }                              ///< Reset the pair counts
+  virtual UInt_t MixedTrackFields() const { return AliFemtoPicoEventPool::kUnstored; }  ///< Track fields read by Pass besides the momentum (AliFemtoPicoEventPool::EField). The default implementation may read any field
 
   AliFemtoPairCut& operator=(const AliFemtoPairCut &aCut);
 
@@ -0,0 +1,235 @@
+///
+/// \file AliFemtoPairEngineSoA.cxx
+///
+
+#include "AliFemtoPairEngineSoA.h"
+#include "AliFemtoPair.h"
+
+#include <cmath>
+
+//_________________
+AliFemtoPairEngineSoA::AliFemtoPairEngineSoA():
+  fCollection1(NULL),
+  fCollection2(NULL),
+  fKTMin(-1.0),
+  fKTMax(-1.0),
+  fQInvMax(-1.0),
+  fMinEntranceSeparation(-1.0),
+  fBlockSize(256),
+  fOuter(0),
+  fInner(0),
+  fSwap(false),
+  fNCandidates(0),
+  fIndex1(),
+  fIndex2(),
+  fQInv(),
+  fKT(),
+  fKStar(),
+  fKStarOut(),
+  fKStarSide(),
+  fKStarLong(),
+  fCVK(),
+  fPass()
+{
+  // Default constructor - no pre-cuts
+}
+//_________________
+void AliFemtoPairEngineSoA::Begin(const AliFemtoParticleCollectionSoA* aCollection1,
+                                  const AliFemtoParticleCollectionSoA* aCollection2,
+                                  bool aSwap)
+{
+  // Start the pair loop over the given collections
+  fCollection1 = aCollection1;
+  fCollection2 = aCollection2;
+  fOuter = 0;
+  fInner = fCollection2 ? 0 : 1;
+  fSwap = aSwap;
+  fNCandidates = 0;
+
+  fIndex1.resize(fBlockSize);
+  fIndex2.resize(fBlockSize);
+  fQInv.resize(fBlockSize);
+  fKT.resize(fBlockSize);
+  fKStar.resize(fBlockSize);
+  fKStarOut.resize(fBlockSize);
+  fKStarSide.resize(fBlockSize);
+  fKStarLong.resize(fBlockSize);
+  fCVK.resize(fBlockSize);
+  fPass.resize(fBlockSize);
+}
+//_________________
+UInt_t AliFemtoPairEngineSoA::NextBlock()
+{
+  // Collect the next block of pairs in the order of
+  // AliFemtoSimpleAnalysis::MakePairs, evaluate them, and keep the
+  // pairs passing the pre-cuts. Blocks in which no pair passes are
+  // skipped, so 0 is only returned at the end of the loop.
+  if (!fCollection1) {
+    return 0;
+  }
+
+  const UInt_t size1 = fCollection1->Size();
+  const UInt_t size2 = fCollection2 ? fCollection2->Size() : size1;
+
+  while (true) {
+    UInt_t n = 0;
+    while (n < fBlockSize && fOuter < size1) {
+      if (fInner >= size2) {
+        fOuter++;
+        fInner = fCollection2 ? 0 : fOuter + 1;
+        continue;
+      }
+
+      if (fCollection2) {
+        fIndex1[n] = fOuter;
+        fIndex2[n] = fInner;
+      } else {
+        // swap between first and second particles to avoid biased ordering
+        fIndex1[n] = fSwap ? fInner : fOuter;
+        fIndex2[n] = fSwap ? fOuter : fInner;
+        fSwap = !fSwap;
+      }
+      n++;
+      fInner++;
+    }
+
+    fNCandidates = n;
+    if (n == 0) {
+      return 0;
+    }
+
+    Compute(n);
+
+    // compact the passing pairs, keeping their order
+    UInt_t nPass = 0;
+    for (UInt_t i = 0; i < n; ++i) {
+      if (!fPass[i]) {
+        continue;
+      }
+      fIndex1[nPass] = fIndex1[i];
+      fIndex2[nPass] = fIndex2[i];
+      fQInv[nPass] = fQInv[i];
+      fKT[nPass] = fKT[i];
+      fKStar[nPass] = fKStar[i];
+      fKStarOut[nPass] = fKStarOut[i];
+      fKStarSide[nPass] = fKStarSide[i];
+      fKStarLong[nPass] = fKStarLong[i];
+      fCVK[nPass] = fCVK[i];
+      nPass++;
+    }
+
+    if (nPass > 0) {
+      return nPass;
+    }
+  }
+}
+//_________________
+void AliFemtoPairEngineSoA::Compute(UInt_t aNCandidates)
+{
+  // Evaluate the pair quantities and pre-cuts of the current block.
+  // The formulas are the ones of AliFemtoPair (QInv, KT and
+  // CalcNonIdPar) such that the results are identical.
+  const AliFemtoParticleCollectionSoA* coll2 = fCollection2 ? fCollection2 : fCollection1;
+
+  const double *px1 = fCollection1->Px(), *py1 = fCollection1->Py(), *pz1 = fCollection1->Pz(), *e1 = fCollection1->E();
+  const double *px2 = coll2->Px(), *py2 = coll2->Py(), *pz2 = coll2->Pz(), *e2 = coll2->E();
+
+  const UInt_t *index1 = fIndex1.data();
+  const UInt_t *index2 = fIndex2.data();
+
+  for (UInt_t i = 0; i < aNCandidates; ++i) {
+    const double tPx1 = px1[index1[i]], tPy1 = py1[index1[i]], tPz1 = pz1[index1[i]], tE1 = e1[index1[i]];
+    const double tPx2 = px2[index2[i]], tPy2 = py2[index2[i]], tPz2 = pz2[index2[i]], tE2 = e2[index2[i]];
+
+    // qinv
+    const double dx = tPx1 - tPx2, dy = tPy1 - tPy2, dz = tPz1 - tPz2, dt = tE1 - tE2;
+    const double tDiffMass2 = dt*dt - (dx*dx + dy*dy + dz*dz);
+    fQInv[i] = (tDiffMass2 < 0) ? ::sqrt(-tDiffMass2) : -::sqrt(tDiffMass2);
+
+    // kT
+    const double xt = tPx1 + tPx2, yt = tPy1 + tPy2, zz = tPz1 + tPz2, tt = tE1 + tE2;
+    const double k1 = ::sqrt(xt*xt + yt*yt);
+    fKT[i] = k1 * .5;
+
+    // k* and its components, see AliFemtoPair::CalcNonIdPar
+    const double tMass1Sq = tE1*tE1 - tPx1*tPx1 - tPy1*tPy1 - tPz1*tPz1;
+    const double tParticle1Mass = (tMass1Sq > 0) ? ::sqrt(tMass1Sq) : 0;
+    const double tMass2Sq = tE2*tE2 - tPx2*tPx2 - tPy2*tPy2 - tPz2*tPz2;
+    const double tParticle2Mass = (tMass2Sq > 0) ? ::sqrt(tMass2Sq) : 0;
+
+    double tPtrans = xt*xt + yt*yt;
+    double tMtrans = tt*tt - zz*zz;
+    const double tPinv = ::sqrt(tMtrans - tPtrans);
+    tMtrans = ::sqrt(tMtrans);
+    tPtrans = ::sqrt(tPtrans);
+
+    const double tQinvL = dt*dt - dx*dx - dy*dy - dz*dz;
+    double tQ = (tParticle1Mass*tParticle1Mass - tParticle2Mass*tParticle2Mass)/tPinv;
+    tQ = ::sqrt(tQ*tQ - tQinvL);
+    fKStar[i] = tQ/2;
+
+    double beta = zz/tt;
+    double gamma = tt/tMtrans;
+    const double pz1L = gamma * (tPz1 - beta * tE1);
+    const double pE1L = gamma * (tE1 - beta * tPz1);
+    fKStarLong[i] = pz1L;
+
+    const double px1R = (tPx1*xt + tPy1*yt)/tPtrans;
+    const double py1R = (-tPx1*yt + tPy1*xt)/tPtrans;
+    fKStarSide[i] = py1R;
+
+    beta = tPtrans/tMtrans;
+    gamma = tMtrans/tPinv;
+    fKStarOut[i] = gamma * (px1R - beta * pE1L);
+
+    fCVK[i] = (fKStarOut[i]*tPtrans + fKStarLong[i]*zz)/fKStar[i]/::sqrt(tPtrans*tPtrans + zz*zz);
+  }
+
+  // pre-cuts
+  for (UInt_t i = 0; i < aNCandidates; ++i) {
+    bool pass = true;
+    if (fKTMax >= 0) {
+      pass = pass && (fKT[i] >= fKTMin) && (fKT[i] <= fKTMax);
+    }
+    if (fQInvMax >= 0) {
+      pass = pass && (fQInv[i] <= fQInvMax);
+    }
+    fPass[i] = pass;
+  }
+
+  if (fMinEntranceSeparation > 0) {
+    const float *x1 = fCollection1->EntranceX(), *y1 = fCollection1->EntranceY(), *z1 = fCollection1->EntranceZ();
+    const float *x2 = coll2->EntranceX(), *y2 = coll2->EntranceY(), *z2 = coll2->EntranceZ();
+    const char *track1 = fCollection1->HasTrack(), *track2 = coll2->HasTrack();
+    const double tMinSep2 = fMinEntranceSeparation * fMinEntranceSeparation;
+
+    for (UInt_t i = 0; i < aNCandidates; ++i) {
+      // particles without a track have no entrance point
+      if (!track1[index1[i]] || !track2[index2[i]]) {
+        continue;
+      }
+      const double sx = x1[index1[i]] - x2[index2[i]];
+      const double sy = y1[index1[i]] - y2[index2[i]];
+      const double sz = z1[index1[i]] - z2[index2[i]];
+      fPass[i] = fPass[i] && (sx*sx + sy*sy + sz*sz >= tMinSep2);
+    }
+  }
+}
+//_________________
+AliFemtoParticle* AliFemtoPairEngineSoA::Particle1(UInt_t i) const
+{
+  return fCollection1->Particle(fIndex1[i]);
+}
+//_________________
+AliFemtoParticle* AliFemtoPairEngineSoA::Particle2(UInt_t i) const
+{
+  return (fCollection2 ? fCollection2 : fCollection1)->Particle(fIndex2[i]);
+}
+//_________________
+void AliFemtoPairEngineSoA::FillPair(UInt_t i, AliFemtoPair* aPair) const
+{
+  // Set the particles and the precalculated k* quantities of pair i
+  aPair->SetTrack1(Particle1(i));
+  aPair->SetTrack2(Particle2(i));
+  aPair->SetNonIdPar(fKStarOut[i], fKStarSide[i], fKStarLong[i], fKStar[i], fCVK[i]);
+}
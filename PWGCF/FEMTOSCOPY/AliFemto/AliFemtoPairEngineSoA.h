@@ -0,0 +1,133 @@
+///
+/// \file AliFemtoPairEngineSoA.h
+///
+
+#ifndef ALIFEMTOPAIRENGINESOA_H
+#define ALIFEMTOPAIRENGINESOA_H
+
+#include <vector>
+
+#include "AliFemtoParticleCollectionSoA.h"
+
+class AliFemtoPair;
+
+///
+/// \class AliFemtoPairEngineSoA
+/// \brief Block-wise pair builder working on AliFemtoParticleCollectionSoA
+///
+/// The engine enumerates pairs in exactly the order (and with the same
+/// swapping of identical particles) as AliFemtoSimpleAnalysis::MakePairs.
+/// Pairs are processed in blocks: for every block the pair quantities
+/// (qinv, kT, and k* with its out, side and long components) are
+/// calculated in flat loops, and the optional pre-cuts (kT range, maximum
+/// qinv, minimum nominal TPC entrance separation) are applied. Only pairs
+/// passing the pre-cuts are kept in the block. The entrance separation is
+/// only required for pairs of two particles made from tracks; pairs with a
+/// V0, kink or Xi are not affected by it.
+///
+/// Usage:
+///
+/// ~~~{.cxx}
+/// engine.Begin(coll1, coll2, swap);
+/// while (UInt_t n = engine.NextBlock()) {
+///   for (UInt_t i = 0; i < n; ++i) {
+///     engine.FillPair(i, pair);  // pair with precalculated k* quantities
+///     ...
+///   }
+/// }
+/// ~~~
+///
+/// The k* quantities are handed to the AliFemtoPair, so correlation
+/// functions do not recalculate them. Pair cuts and correlation functions
+/// which need other quantities still use the full AliFemtoPair.
+///
+class AliFemtoPairEngineSoA {
+public:
+  AliFemtoPairEngineSoA();
+
+  /// Pre-cut on the pair transverse momentum, kT = |pT1 + pT2| / 2
+  void SetKTRange(double aMin, double aMax);
+  /// Pre-cut on the invariant relative momentum
+  void SetQInvMax(double aMax);
+  /// Pre-cut on the separation of the nominal TPC entrance points (pairs of two tracks only)
+  void SetMinEntranceSeparation(double aMin);
+  /// Number of pairs evaluated per block
+  void SetBlockSize(UInt_t aSize);
+
+  /// Start a pair loop
+  ///
+  /// \param aCollection1 first collection
+  /// \param aCollection2 second collection, if NULL pairs are formed within the first collection
+  /// \param aSwap start value for the swapping of identical particles
+  void Begin(const AliFemtoParticleCollectionSoA* aCollection1,
+             const AliFemtoParticleCollectionSoA* aCollection2,
+             bool aSwap);
+
+  /// Evaluate the next block of pairs; returns the number of pairs
+  /// passing the pre-cuts (0 when all pairs have been processed)
+  UInt_t NextBlock();
+
+  /// Number of pairs evaluated in the last block (before pre-cuts)
+  UInt_t NCandidates() const;
+
+  // pair quantities of the passing pair i of the current block
+  AliFemtoParticle* Particle1(UInt_t i) const;
+  AliFemtoParticle* Particle2(UInt_t i) const;
+  double QInv(UInt_t i) const;
+  double KT(UInt_t i) const;
+  double KStar(UInt_t i) const;
+  double KStarOut(UInt_t i) const;
+  double KStarSide(UInt_t i) const;
+  double KStarLong(UInt_t i) const;
+  double CVK(UInt_t i) const;
+
+  /// Set the particles of pair i on the AliFemtoPair, together with the precalculated k* quantities
+  void FillPair(UInt_t i, AliFemtoPair* aPair) const;
+
+private:
+  void Compute(UInt_t aNCandidates);
+
+  const AliFemtoParticleCollectionSoA* fCollection1;  ///< first collection of the current loop
+  const AliFemtoParticleCollectionSoA* fCollection2;  ///< second collection of the current loop (NULL for pairs within the first)
+
+  double fKTMin;                  ///< pre-cut: minimum kT
+  double fKTMax;                  ///< pre-cut: maximum kT
+  double fQInvMax;                ///< pre-cut: maximum qinv
+  double fMinEntranceSeparation;  ///< pre-cut: minimum nominal TPC entrance separation
+  UInt_t fBlockSize;              ///< number of pairs per block
+
+  // loop state
+  UInt_t fOuter;   ///< index in the first collection
+  UInt_t fInner;   ///< index in the second (or first) collection
+  bool fSwap;      ///< swap particles of the next pair of identical particles
+  UInt_t fNCandidates;  ///< number of pairs evaluated in the current block
+
+  // per-block arrays
+  std::vector<UInt_t> fIndex1;   ///< index of particle 1 (in the first collection)
+  std::vector<UInt_t> fIndex2;   ///< index of particle 2 (in the second collection, or the first for identical particles)
+  std::vector<double> fQInv;
+  std::vector<double> fKT;
+  std::vector<double> fKStar;
+  std::vector<double> fKStarOut;
+  std::vector<double> fKStarSide;
+  std::vector<double> fKStarLong;
+  std::vector<double> fCVK;
+  std::vector<char> fPass;       ///< pair passes the pre-cuts
+};
+
+inline void AliFemtoPairEngineSoA::SetKTRange(double aMin, double aMax) { fKTMin = aMin; fKTMax = aMax; }
+inline void AliFemtoPairEngineSoA::SetQInvMax(double aMax) { fQInvMax = aMax; }
+inline void AliFemtoPairEngineSoA::SetMinEntranceSeparation(double aMin) { fMinEntranceSeparation = aMin; }
+inline void AliFemtoPairEngineSoA::SetBlockSize(UInt_t aSize) { fBlockSize = aSize > 0 ? aSize : 1; }
+
+inline UInt_t AliFemtoPairEngineSoA::NCandidates() const { return fNCandidates; }
+
+inline double AliFemtoPairEngineSoA::QInv(UInt_t i) const { return fQInv[i]; }
+inline double AliFemtoPairEngineSoA::KT(UInt_t i) const { return fKT[i]; }
+inline double AliFemtoPairEngineSoA::KStar(UInt_t i) const { return fKStar[i]; }
+inline double AliFemtoPairEngineSoA::KStarOut(UInt_t i) const { return fKStarOut[i]; }
+inline double AliFemtoPairEngineSoA::KStarSide(UInt_t i) const { return fKStarSide[i]; }
+inline double AliFemtoPairEngineSoA::KStarLong(UInt_t i) const { return fKStarLong[i]; }
+inline double AliFemtoPairEngineSoA::CVK(UInt_t i) const { return fCVK[i]; }
+
+#endif
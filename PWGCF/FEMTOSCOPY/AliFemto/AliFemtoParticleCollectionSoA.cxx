@@ -0,0 +1,120 @@
+///
+/// \file AliFemtoParticleCollectionSoA.cxx
+///
+
+#include "AliFemtoParticleCollectionSoA.h"
+#include "AliFemtoTrack.h"
+
+//_________________
+AliFemtoParticleCollectionSoA::AliFemtoParticleCollectionSoA():
+  fPx(),
+  fPy(),
+  fPz(),
+  fE(),
+  fEntranceX(),
+  fEntranceY(),
+  fEntranceZ(),
+  fHasTrack(),
+  fCharge(),
+  fPidProbPion(),
+  fPidProbKaon(),
+  fPidProbProton(),
+  fParticles()
+{
+  // Default constructor
+}
+//_________________
+AliFemtoParticleCollectionSoA::AliFemtoParticleCollectionSoA(const AliFemtoParticleCollection* aCollection):
+  fPx(),
+  fPy(),
+  fPz(),
+  fE(),
+  fEntranceX(),
+  fEntranceY(),
+  fEntranceZ(),
+  fHasTrack(),
+  fCharge(),
+  fPidProbPion(),
+  fPidProbKaon(),
+  fPidProbProton(),
+  fParticles()
+{
+  // Constructor filling the arrays from the collection
+  Fill(aCollection);
+}
+//_________________
+void AliFemtoParticleCollectionSoA::Clear()
+{
+  // Remove all entries, keeping the allocated memory
+  fPx.clear();
+  fPy.clear();
+  fPz.clear();
+  fE.clear();
+  fEntranceX.clear();
+  fEntranceY.clear();
+  fEntranceZ.clear();
+  fHasTrack.clear();
+  fCharge.clear();
+  fPidProbPion.clear();
+  fPidProbKaon.clear();
+  fPidProbProton.clear();
+  fParticles.clear();
+}
+//_________________
+void AliFemtoParticleCollectionSoA::Fill(const AliFemtoParticleCollection* aCollection)
+{
+  // Copy the particles of the collection into the arrays
+  Clear();
+  if (!aCollection) {
+    return;
+  }
+
+  const UInt_t size = aCollection->size();
+  fPx.reserve(size);
+  fPy.reserve(size);
+  fPz.reserve(size);
+  fE.reserve(size);
+  fEntranceX.reserve(size);
+  fEntranceY.reserve(size);
+  fEntranceZ.reserve(size);
+  fHasTrack.reserve(size);
+  fCharge.reserve(size);
+  fPidProbPion.reserve(size);
+  fPidProbKaon.reserve(size);
+  fPidProbProton.reserve(size);
+  fParticles.reserve(size);
+
+  for (AliFemtoParticleConstIterator iter = aCollection->begin(); iter != aCollection->end(); ++iter) {
+    AliFemtoParticle *particle = *iter;
+    const AliFemtoLorentzVector &p = particle->FourMomentum();
+
+    fPx.push_back(p.px());
+    fPy.push_back(p.py());
+    fPz.push_back(p.pz());
+    fE.push_back(p.e());
+
+    const AliFemtoTrack *track = particle->Track();
+    if (track) {
+      const AliFemtoThreeVector &entrance = track->NominalTpcEntrancePoint();
+      fEntranceX.push_back(entrance.x());
+      fEntranceY.push_back(entrance.y());
+      fEntranceZ.push_back(entrance.z());
+      fHasTrack.push_back(1);
+      fCharge.push_back(track->Charge());
+      fPidProbPion.push_back(track->PidProbPion());
+      fPidProbKaon.push_back(track->PidProbKaon());
+      fPidProbProton.push_back(track->PidProbProton());
+    } else {
+      fEntranceX.push_back(0.0);
+      fEntranceY.push_back(0.0);
+      fEntranceZ.push_back(0.0);
+      fHasTrack.push_back(0);
+      fCharge.push_back(0);
+      fPidProbPion.push_back(0.0);
+      fPidProbKaon.push_back(0.0);
+      fPidProbProton.push_back(0.0);
+    }
+
+    fParticles.push_back(particle);
+  }
+}
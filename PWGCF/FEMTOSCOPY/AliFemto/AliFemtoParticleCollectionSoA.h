@@ -0,0 +1,100 @@
+///
+/// \file AliFemtoParticleCollectionSoA.h
+///
+
+#ifndef ALIFEMTOPARTICLECOLLECTIONSOA_H
+#define ALIFEMTOPARTICLECOLLECTIONSOA_H
+
+#include <vector>
+
+#include "AliFemtoParticleCollection.h"
+
+///
+/// \class AliFemtoParticleCollectionSoA
+/// \brief Contiguous copy of an AliFemtoParticleCollection
+///
+/// The particle collection of the pico event is a linked list of heap
+/// allocated AliFemtoParticles. For pair building this collection stores
+/// the quantities needed for the pair kinematics and the two-track cuts
+/// in flat arrays (one array per quantity), in the order of the linked
+/// list, so that pair quantities can be calculated for blocks of pairs
+/// in loops which the compiler can vectorize.
+///
+/// A pointer to the original AliFemtoParticle is kept for every entry,
+/// such that an AliFemtoPair can be formed for pair cuts and correlation
+/// functions which need the full object.
+///
+/// Positions are the nominal TPC entrance points for particles made from
+/// tracks, and (0,0,0) otherwise; HasTrack() tells which entries are made
+/// from tracks. PID probabilities are only filled for particles made from
+/// tracks.
+///
+class AliFemtoParticleCollectionSoA {
+public:
+  AliFemtoParticleCollectionSoA();
+
+  /// Construct and fill from the particle collection
+  AliFemtoParticleCollectionSoA(const AliFemtoParticleCollection* aCollection);
+
+  /// Replace the content with the particles of the collection
+  void Fill(const AliFemtoParticleCollection* aCollection);
+  void Clear();
+
+  UInt_t Size() const;
+
+  const double* Px() const;
+  const double* Py() const;
+  const double* Pz() const;
+  const double* E() const;
+
+  const float* EntranceX() const;
+  const float* EntranceY() const;
+  const float* EntranceZ() const;
+  const char* HasTrack() const;
+
+  const short* Charge() const;
+  const float* PidProbPion() const;
+  const float* PidProbKaon() const;
+  const float* PidProbProton() const;
+
+  AliFemtoParticle* Particle(UInt_t i) const;
+
+private:
+  std::vector<double> fPx;  ///< momentum x-component
+  std::vector<double> fPy;  ///< momentum y-component
+  std::vector<double> fPz;  ///< momentum z-component
+  std::vector<double> fE;   ///< energy
+
+  std::vector<float> fEntranceX;  ///< nominal TPC entrance point x-coordinate
+  std::vector<float> fEntranceY;  ///< nominal TPC entrance point y-coordinate
+  std::vector<float> fEntranceZ;  ///< nominal TPC entrance point z-coordinate
+  std::vector<char> fHasTrack;    ///< 1 if the particle is made from a track, 0 otherwise
+
+  std::vector<short> fCharge;         ///< charge of the track (0 for other particles)
+  std::vector<float> fPidProbPion;    ///< pion PID probability of the track
+  std::vector<float> fPidProbKaon;    ///< kaon PID probability of the track
+  std::vector<float> fPidProbProton;  ///< proton PID probability of the track
+
+  std::vector<AliFemtoParticle*> fParticles;  ///< original particles (not owned)
+};
+
+inline UInt_t AliFemtoParticleCollectionSoA::Size() const { return fParticles.size(); }
+
+inline const double* AliFemtoParticleCollectionSoA::Px() const { return fPx.data(); }
+inline const double* AliFemtoParticleCollectionSoA::Py() const { return fPy.data(); }
+inline const double* AliFemtoParticleCollectionSoA::Pz() const { return fPz.data(); }
+inline const double* AliFemtoParticleCollectionSoA::E() const { return fE.data(); }
+
+inline const float* AliFemtoParticleCollectionSoA::EntranceX() const { return fEntranceX.data(); }
+inline const float* AliFemtoParticleCollectionSoA::EntranceY() const { return fEntranceY.data(); }
+inline const float* AliFemtoParticleCollectionSoA::EntranceZ() const { return fEntranceZ.data(); }
+inline const char* AliFemtoParticleCollectionSoA::HasTrack() const { return fHasTrack.data(); }
+
+inline const short* AliFemtoParticleCollectionSoA::Charge() const { return fCharge.data(); }
+inline const float* AliFemtoParticleCollectionSoA::PidProbPion() const { return fPidProbPion.data(); }
+inline const float* AliFemtoParticleCollectionSoA::PidProbKaon() const { return fPidProbKaon.data(); }
+inline const float* AliFemtoParticleCollectionSoA::PidProbProton() const { return fPidProbProton.data(); }
+
+inline AliFemtoParticle* AliFemtoParticleCollectionSoA::Particle(UInt_t i) const { return fParticles[i]; }
+
+#endif
@@ -62,12 +62,17 @@
 
 #include "AliFemtoPicoEvent.h"
 #include "AliFemtoParticleCollection.h"
+#include "AliFemtoParticleCollectionSoA.h"
 
 //________________
 AliFemtoPicoEvent::AliFemtoPicoEvent() :
   fFirstParticleCollection(0),
   fSecondParticleCollection(0),
-  fThirdParticleCollection(0)
+  fThirdParticleCollection(0),
+  fFirstParticleCollectionSoA(0),
+  fSecondParticleCollectionSoA(0),
+  fFirstParticleCollectionSoAValid(false),
+  fSecondParticleCollectionSoAValid(false)
 {
   // Default constructor
   fFirstParticleCollection = new AliFemtoParticleCollection;
@@ -78,7 +83,11 @@ AliFemtoPicoEvent::AliFemtoPicoEvent() :
 AliFemtoPicoEvent::AliFemtoPicoEvent(const AliFemtoPicoEvent& aPicoEvent) :
   fFirstParticleCollection(0),
   fSecondParticleCollection(0),
-  fThirdParticleCollection(0)
+  fThirdParticleCollection(0),
+  fFirstParticleCollectionSoA(0),
+  fSecondParticleCollectionSoA(0),
+  fFirstParticleCollectionSoAValid(false),
+  fSecondParticleCollectionSoAValid(false)
 {
   // Copy constructor
   AliFemtoParticleIterator iter;
@@ -106,6 +115,9 @@ AliFemtoPicoEvent::AliFemtoPicoEvent(const AliFemtoPicoEvent& aPicoEvent) :
 AliFemtoPicoEvent::~AliFemtoPicoEvent(){
   // Destructor
   AliFemtoParticleIterator iter;
+
+  delete fFirstParticleCollectionSoA;
+  delete fSecondParticleCollectionSoA;
   
   if (fFirstParticleCollection){
     for (iter=fFirstParticleCollection->begin();iter!=fFirstParticleCollection->end();iter++){
@@ -144,6 +156,9 @@ AliFemtoPicoEvent& AliFemtoPicoEvent::operator=(const AliFemtoPicoEvent& aPicoEv
     return *this;
 
   AliFemtoParticleIterator iter;
+
+  fFirstParticleCollectionSoAValid = false;
+  fSecondParticleCollectionSoAValid = false;
    
   if (fFirstParticleCollection){
       for (iter=fFirstParticleCollection->begin();iter!=fFirstParticleCollection->end();iter++){
@@ -195,4 +210,36 @@ AliFemtoPicoEvent& AliFemtoPicoEvent::operator=(const AliFemtoPicoEvent& aPicoEv
 
   return *this;
 }
-
+//_________________
+const AliFemtoParticleCollectionSoA* AliFemtoPicoEvent::FirstParticleCollectionSoA()
+{
+  // Contiguous copy of the first collection, made when first requested
+  // (the collections are not changed once the event is filled)
+  if (!fFirstParticleCollectionSoA)
+    fFirstParticleCollectionSoA = new AliFemtoParticleCollectionSoA;
+  if (!fFirstParticleCollectionSoAValid) {
+    fFirstParticleCollectionSoA->Fill(fFirstParticleCollection);
+    fFirstParticleCollectionSoAValid = true;
+  }
+  return fFirstParticleCollectionSoA;
+}
+//_________________
+const AliFemtoParticleCollectionSoA* AliFemtoPicoEvent::SecondParticleCollectionSoA()
+{
+  // Contiguous copy of the second collection, made when first requested
+  if (!fSecondParticleCollectionSoA)
+    fSecondParticleCollectionSoA = new AliFemtoParticleCollectionSoA;
+  if (!fSecondParticleCollectionSoAValid) {
+    fSecondParticleCollectionSoA->Fill(fSecondParticleCollection);
+    fSecondParticleCollectionSoAValid = true;
+  }
+  return fSecondParticleCollectionSoA;
+}
+//_________________
+void AliFemtoPicoEvent::ResetParticleCollectionSoA()
+{
+  // The contiguous copies are refilled on the next access, reusing
+  // their arrays
+  fFirstParticleCollectionSoAValid = false;
+  fSecondParticleCollectionSoAValid = false;
+}
@@ -44,6 +44,8 @@
 
 #include "AliFemtoParticleCollection.h"
 
+class AliFemtoParticleCollectionSoA;
+
 class AliFemtoPicoEvent{
 public:
   AliFemtoPicoEvent();
@@ -58,10 +60,23 @@ public:
   AliFemtoParticleCollection* SecondParticleCollection();
   AliFemtoParticleCollection* ThirdParticleCollection();
 
+  // Contiguous copies of the first and second collections for the blocked
+  // pair loop (AliFemtoPairEngineSoA), built on first access
+  const AliFemtoParticleCollectionSoA* FirstParticleCollectionSoA();
+  const AliFemtoParticleCollectionSoA* SecondParticleCollectionSoA();
+  /// Mark the contiguous copies as outdated, if the collections were
+  /// changed; they are refilled on the next access, keeping their memory
+  void ResetParticleCollectionSoA();
+
 private:
   AliFemtoParticleCollection* fFirstParticleCollection;  // Collection of particles of type 1
   AliFemtoParticleCollection* fSecondParticleCollection; // Collection of particles of type 2
   AliFemtoParticleCollection* fThirdParticleCollection;  // Collection of particles of type 3
+
+  AliFemtoParticleCollectionSoA* fFirstParticleCollectionSoA;  // Contiguous copy of collection 1
+  AliFemtoParticleCollectionSoA* fSecondParticleCollectionSoA; // Contiguous copy of collection 2
+  bool fFirstParticleCollectionSoAValid;                       // Copy of collection 1 is up to date
+  bool fSecondParticleCollectionSoAValid;                      // Copy of collection 2 is up to date
 };
 
 inline AliFemtoParticleCollection* AliFemtoPicoEvent::FirstParticleCollection(){return fFirstParticleCollection;}
@@ -17,7 +17,8 @@ AliFemtoPicoEventCollectionVectorHideAway::AliFemtoPicoEventCollectionVectorHide
   fMaxx(ux),  fMaxy(uy),  fMaxz(uz),
   fStepx(0),  fStepy(0),  fStepz(0),
   fCollection(0),
-  fCollectionVector(0)
+  fCollectionVector(0),
+  fEventPool(0)
 {
   // basic constructor
   fBinsTot = fBinsx * fBinsy * fBinsz;
@@ -66,7 +67,8 @@ AliFemtoPicoEventCollectionVectorHideAway::AliFemtoPicoEventCollectionVectorHide
   fMaxx(0),  fMaxy(0),  fMaxz(0),
   fStepx(0),  fStepy(0),  fStepz(0),
   fCollection(0),
-  fCollectionVector(0)
+  fCollectionVector(0),
+  fEventPool(0)
 {
   // copy constructor
   fBinsTot = aColl.fBinsTot;
@@ -94,6 +96,7 @@ AliFemtoPicoEventCollectionVectorHideAway::~AliFemtoPicoEventCollectionVectorHid
 {
   // destructor
   fCollectionVector.clear();
+  delete fEventPool;
 }
 //___________________________________
 AliFemtoPicoEventCollectionVectorHideAway& AliFemtoPicoEventCollectionVectorHideAway::operator=(const AliFemtoPicoEventCollectionVectorHideAway& aColl)
@@ -117,6 +120,10 @@ AliFemtoPicoEventCollectionVectorHideAway& AliFemtoPicoEventCollectionVectorHide
   fStepz = aColl.fStepz;
   fCollection = aColl.fCollection;
 
+  // the event snapshots are not copied
+  delete fEventPool;
+  fEventPool = 0;
+
   fCollectionVector.clear();
 
   for (int iter=0; aColl.fCollectionVector.size();iter++){
@@ -125,6 +132,30 @@ AliFemtoPicoEventCollectionVectorHideAway& AliFemtoPicoEventCollectionVectorHide
 
   return *this;
 }
+//___________________________________
+int AliFemtoPicoEventCollectionVectorHideAway::PicoEventBin(double x, double y, double z) const
+{
+  // global bin number for given values on x, y, z axes, -1 if outside
+  int ix=0, iy=0, iz=0;
+
+  if (fStepx != 0 && fStepy != 0 && fStepz != 0) {
+    ix = (int)floor( (x-fMinx)/fStepx );
+    iy = (int)floor( (y-fMiny)/fStepy );
+    iz = (int)floor( (z-fMinz)/fStepz );
+  }
+  if ( ix<0 || ix >= fBinsx) return -1;
+  if ( iy<0 || iy >= fBinsy) return -1;
+  if ( iz<0 || iz >= fBinsz) return -1;
+  return ix + iy*fBinsx + iz*fBinsy*fBinsx;
+}
+//___________________________________
+void AliFemtoPicoEventCollectionVectorHideAway::SetEventPool(unsigned int depth, unsigned int fields, ULong64_t maxBytes)
+{
+  // replace the event snapshots by a new (empty) pool for all bins
+  delete fEventPool;
+  fEventPool = new AliFemtoPicoEventPool(fBinsTot, depth, fields, maxBytes);
+}
+//___________________________________
 unsigned int AliFemtoPicoEventCollectionVectorHideAway::GetBinXNumber(double x) { return (int)floor( (x-fMinx)/fStepx ); }
 unsigned int AliFemtoPicoEventCollectionVectorHideAway::GetBinYNumber(double y) { return (int)floor( (y-fMiny)/fStepy ); }
 unsigned int AliFemtoPicoEventCollectionVectorHideAway::GetBinZNumber(double z) { return (int)floor( (z-fMinz)/fStepz ); }
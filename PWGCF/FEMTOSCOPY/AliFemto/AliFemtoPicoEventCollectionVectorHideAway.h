@@ -11,6 +11,7 @@
 #include "AliFemtoPicoEvent.h"
 #include "AliFemtoPicoEventCollection.h"
 #include "AliFemtoPicoEventCollectionVector.h"
+#include "AliFemtoPicoEventPool.h"
 #include <vector>
 #include <list>
 #include <float.h>
@@ -32,6 +33,12 @@ public:
 
   AliFemtoPicoEventCollection* PicoEventCollection(int bx, int by, int bz);
   AliFemtoPicoEventCollection* PicoEventCollection(double x, double y=0, double z=0);
+  int PicoEventBin(double x, double y=0, double z=0) const;   // global bin number, -1 if outside
+
+  // Keep compact snapshots of the events in ring buffers instead of the
+  // pico events (see AliFemtoPicoEventPool); maxBytes limits the memory of all bins
+  void SetEventPool(unsigned int depth, unsigned int fields, ULong64_t maxBytes);
+  AliFemtoPicoEventPool* EventPool();
   unsigned int GetBinXNumber(double x);
   unsigned int GetBinYNumber(double y);
   unsigned int GetBinZNumber(double z);
@@ -43,6 +50,9 @@ private:
   double fStepx,fStepy,fStepz;                         // Steps on x, y, z axis
   AliFemtoPicoEventCollection* fCollection;            // Pico event collection
   AliFemtoPicoEventCollectionVector fCollectionVector; // Collection vector
+  AliFemtoPicoEventPool* fEventPool;                   // Compact event snapshots of all bins (optional)
 };
 
+inline AliFemtoPicoEventPool* AliFemtoPicoEventCollectionVectorHideAway::EventPool() { return fEventPool; }
+
 #endif
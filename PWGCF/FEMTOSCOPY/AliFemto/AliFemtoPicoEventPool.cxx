@@ -0,0 +1,314 @@
+///
+/// \file AliFemtoPicoEventPool.cxx
+///
+
+#include <algorithm>
+
+#include "AliFemtoPicoEventPool.h"
+#include "AliFemtoTrack.h"
+
+//_________________
+AliFemtoPicoEventPool::AliFemtoPicoEventPool(UInt_t aNBins, UInt_t aDepth, UInt_t aFields, ULong64_t aMaxBytes):
+  fNBins(aNBins),
+  fDepth(aDepth > 0 ? aDepth : 1),
+  fFields(aFields & kAllFields),
+  fMaxBytes(aMaxBytes),
+  fUsedBytes(0),
+  fSequence(0),
+  fNDropped(0),
+  fArena(),
+  fWrite(0),
+  fBlocks(),
+  fHead(),
+  fViews(),
+  fViewCollection(),
+  fParticles()
+{
+  // Constructor - with a memory limit the arena is allocated here,
+  // otherwise it grows with the first events
+  Block empty;
+  empty.fOffset = empty.fSize = 0;
+  empty.fN[0] = empty.fN[1] = 0;
+  empty.fSequence = 0;
+  fBlocks.assign((size_t) fNBins * fDepth, empty);
+  fHead.assign(fNBins, 0);
+  fArena.assign(fMaxBytes / sizeof(double), 0.0);
+}
+//_________________
+AliFemtoPicoEventPool::~AliFemtoPicoEventPool()
+{
+  // Destructor - the particles of the returned events belong to the pool
+  for (size_t i = 0; i < fViews.size(); ++i) {
+    fViews[i]->FirstParticleCollection()->clear();
+    fViews[i]->SecondParticleCollection()->clear();
+    delete fViews[i];
+  }
+  for (size_t i = 0; i < fParticles.size(); ++i) {
+    delete fParticles[i];
+  }
+}
+//_________________
+UInt_t AliFemtoPicoEventPool::NColumns() const
+{
+  // Number of values stored per particle
+  UInt_t ncol = 4;  // px, py, pz, e
+  if (fFields & kEntrancePoint) ncol += 3;
+  if (fFields & kCharge) ncol += 1;
+  if (fFields & kPid) ncol += 4;
+  if (fFields & kTrackId) ncol += 1;
+  return ncol;
+}
+//_________________
+void AliFemtoPicoEventPool::Release(Block& aBlock)
+{
+  // Drop the snapshot, its part of the arena can be reused
+  fUsedBytes -= aBlock.fSize * sizeof(double);
+  aBlock.fOffset = aBlock.fSize = 0;
+  aBlock.fN[0] = aBlock.fN[1] = 0;
+  aBlock.fSequence = 0;
+}
+//_________________
+void AliFemtoPicoEventPool::DropRange(size_t aBegin, size_t aEnd)
+{
+  // Drop the events whose blocks overlap the arena positions [aBegin, aEnd)
+  for (size_t i = 0; i < fBlocks.size(); ++i) {
+    Block &block = fBlocks[i];
+    if (block.fSequence && block.fSize > 0 && block.fOffset < aEnd && aBegin < block.fOffset + block.fSize) {
+      Release(block);
+      fNDropped++;
+    }
+  }
+}
+//_________________
+void AliFemtoPicoEventPool::Grow(size_t aSize)
+{
+  // Enlarge the arena (no memory limit) such that aSize values fit behind
+  // the stored blocks, which are moved to its start in insertion order
+  std::vector<Block*> stored;
+  size_t used = 0;
+  for (size_t i = 0; i < fBlocks.size(); ++i) {
+    if (fBlocks[i].fSequence) {
+      stored.push_back(&fBlocks[i]);
+      used += fBlocks[i].fSize;
+    }
+  }
+  std::sort(stored.begin(), stored.end(), [](const Block* a, const Block* b) { return a->fSequence < b->fSequence; });
+
+  std::vector<double> arena(std::max(2 * fArena.size(), used + aSize));
+  size_t offset = 0;
+  for (size_t i = 0; i < stored.size(); ++i) {
+    std::copy(fArena.begin() + stored[i]->fOffset, fArena.begin() + stored[i]->fOffset + stored[i]->fSize, arena.begin() + offset);
+    stored[i]->fOffset = offset;
+    offset += stored[i]->fSize;
+  }
+  fArena.swap(arena);
+  fWrite = offset;
+}
+//_________________
+size_t AliFemtoPicoEventPool::Allocate(size_t aSize)
+{
+  // Place a block of aSize values at the write position of the arena,
+  // wrapping at its end. With a memory limit the events in the way are
+  // dropped, otherwise the arena grows.
+  if (aSize == 0) {
+    return fWrite;
+  }
+
+  size_t start = fWrite + aSize <= fArena.size() ? fWrite : 0;
+
+  if (fMaxBytes == 0) {
+    bool occupied = start + aSize > fArena.size();
+    for (size_t i = 0; !occupied && i < fBlocks.size(); ++i) {
+      const Block &block = fBlocks[i];
+      occupied = block.fSequence && block.fSize > 0 && block.fOffset < start + aSize && start < block.fOffset + block.fSize;
+    }
+    if (occupied) {
+      Grow(aSize);
+      start = fWrite;
+    }
+  } else {
+    if (start != fWrite) {
+      // the blocks behind the write position are the oldest ones
+      DropRange(fWrite, fArena.size());
+    }
+    DropRange(start, start + aSize);
+  }
+
+  fWrite = start + aSize;
+  return start;
+}
+//_________________
+void AliFemtoPicoEventPool::Store(UInt_t aBin, AliFemtoPicoEvent* aEvent)
+{
+  // Copy the selected fields of the particles of the event into the
+  // arena, replacing the oldest event of the bin
+  if (aBin >= fNBins || !aEvent) {
+    return;
+  }
+
+  AliFemtoParticleCollection *collections[2] = { aEvent->FirstParticleCollection(), aEvent->SecondParticleCollection() };
+  const UInt_t ncol = NColumns();
+  const size_t need = (size_t) ncol * (collections[0]->size() + collections[1]->size());
+
+  if (fMaxBytes > 0 && need > fArena.size()) {
+    // larger than the limit on its own
+    fNDropped++;
+    return;
+  }
+
+  Block &block = fBlocks[(size_t) aBin * fDepth + fHead[aBin]];
+  Release(block);
+
+  block.fOffset = Allocate(need);
+  block.fSize = need;
+  fUsedBytes += need * sizeof(double);
+
+  double *data = fArena.data() + block.fOffset;
+  for (UInt_t icoll = 0; icoll < 2; icoll++) {
+    const UInt_t n = collections[icoll]->size();
+    block.fN[icoll] = n;
+
+    UInt_t i = 0;
+    for (AliFemtoParticleConstIterator iter = collections[icoll]->begin(); iter != collections[icoll]->end(); ++iter, ++i) {
+      const AliFemtoLorentzVector &p = (*iter)->FourMomentum();
+      const AliFemtoTrack *track = (*iter)->Track();
+
+      double *column = data + i;
+      column[0] = p.px();
+      column[n] = p.py();
+      column[2*n] = p.pz();
+      column[3*n] = p.e();
+      column += 4*n;
+
+      if (fFields & kEntrancePoint) {
+        column[0] = track ? track->NominalTpcEntrancePoint().x() : 0;
+        column[n] = track ? track->NominalTpcEntrancePoint().y() : 0;
+        column[2*n] = track ? track->NominalTpcEntrancePoint().z() : 0;
+        column += 3*n;
+      }
+      if (fFields & kCharge) {
+        column[0] = track ? track->Charge() : 0;
+        column += n;
+      }
+      if (fFields & kPid) {
+        column[0] = track ? track->PidProbElectron() : 0;
+        column[n] = track ? track->PidProbPion() : 0;
+        column[2*n] = track ? track->PidProbKaon() : 0;
+        column[3*n] = track ? track->PidProbProton() : 0;
+        column += 4*n;
+      }
+      if (fFields & kTrackId) {
+        column[0] = track ? track->TrackId() : 0;
+      }
+    }
+
+    data += (size_t) ncol * n;
+  }
+
+  block.fSequence = ++fSequence;
+  fHead[aBin] = (fHead[aBin] + 1) % fDepth;
+}
+//_________________
+void AliFemtoPicoEventPool::FillParticles(const Block& aBlock, UInt_t aCollection, AliFemtoParticleCollection* aParticles, UInt_t aFirst)
+{
+  // Set the particles starting at aFirst from the snapshot of collection aCollection
+  const UInt_t n = aBlock.fN[aCollection];
+  const double *data = fArena.data() + aBlock.fOffset + (aCollection == 1 ? (size_t) NColumns() * aBlock.fN[0] : 0);
+
+  while (fParticles.size() < aFirst + n) {
+    AliFemtoTrack track;
+    fParticles.push_back(new AliFemtoParticle(&track, 0.0));
+  }
+
+  for (UInt_t i = 0; i < n; i++) {
+    AliFemtoParticle *particle = fParticles[aFirst + i];
+    AliFemtoTrack *track = particle->Track();
+    const double *column = data + i;
+
+    const AliFemtoThreeVector p(column[0], column[n], column[2*n]);
+    particle->ResetFourMomentum(AliFemtoLorentzVector(column[3*n], p));
+    track->SetP(p);
+    track->SetPt(p.Perp());
+    column += 4*n;
+
+    if (fFields & kEntrancePoint) {
+      track->SetNominalTPCEntrancePoint(AliFemtoThreeVector(column[0], column[n], column[2*n]));
+      column += 3*n;
+    }
+    if (fFields & kCharge) {
+      track->SetCharge((short) column[0]);
+      column += n;
+    }
+    if (fFields & kPid) {
+      track->SetPidProbElectron(column[0]);
+      track->SetPidProbPion(column[n]);
+      track->SetPidProbKaon(column[2*n]);
+      track->SetPidProbProton(column[3*n]);
+      column += 4*n;
+    }
+    if (fFields & kTrackId) {
+      track->SetTrackId((int) column[0]);
+    }
+
+    aParticles->push_back(particle);
+  }
+}
+//_________________
+AliFemtoPicoEventCollection* AliFemtoPicoEventPool::MixingEvents(UInt_t aBin)
+{
+  // Fill the events of the bin from their snapshots, newest first
+  fViewCollection.clear();
+  if (aBin >= fNBins) {
+    return &fViewCollection;
+  }
+
+  while (fViews.size() < fDepth) {
+    fViews.push_back(new AliFemtoPicoEvent);
+  }
+
+  UInt_t nparticles = 0;
+  for (UInt_t k = 0; k < fDepth; k++) {
+    const Block &block = fBlocks[(size_t) aBin * fDepth + (fHead[aBin] + fDepth - 1 - k) % fDepth];
+    if (!block.fSequence) {
+      // older events of the bin were dropped or not stored yet
+      break;
+    }
+
+    AliFemtoPicoEvent *view = fViews[k];
+    view->FirstParticleCollection()->clear();
+    view->SecondParticleCollection()->clear();
+    view->ResetParticleCollectionSoA();
+
+    FillParticles(block, 0, view->FirstParticleCollection(), nparticles);
+    nparticles += block.fN[0];
+    FillParticles(block, 1, view->SecondParticleCollection(), nparticles);
+    nparticles += block.fN[1];
+
+    fViewCollection.push_back(view);
+  }
+
+  return &fViewCollection;
+}
+//_________________
+UInt_t AliFemtoPicoEventPool::Size(UInt_t aBin) const
+{
+  // Number of events stored in the bin
+  UInt_t n = 0;
+  for (UInt_t r = 0; aBin < fNBins && r < fDepth; r++) {
+    if (fBlocks[(size_t) aBin * fDepth + r].fSequence) {
+      n++;
+    }
+  }
+  return n;
+}
+//_________________
+void AliFemtoPicoEventPool::Clear()
+{
+  // Drop all events, the arena keeps its memory
+  for (size_t i = 0; i < fBlocks.size(); ++i) {
+    Release(fBlocks[i]);
+  }
+  fHead.assign(fNBins, 0);
+  fWrite = 0;
+  fViewCollection.clear();
+}
@@ -0,0 +1,128 @@
+///
+/// \file AliFemtoPicoEventPool.h
+///
+
+#ifndef ALIFEMTOPICOEVENTPOOL_H
+#define ALIFEMTOPICOEVENTPOOL_H
+
+#include <vector>
+
+#include "AliFemtoPicoEvent.h"
+#include "AliFemtoPicoEventCollection.h"
+
+///
+/// \class AliFemtoPicoEventPool
+/// \brief Ring buffers of compact event snapshots for event mixing
+///
+/// Instead of keeping the AliFemtoPicoEvent (with a copy of every
+/// AliFemtoTrack) in the mixing buffer, the pool stores for every event
+/// a snapshot of the selected particle fields in one contiguous block.
+/// The blocks of all bins are placed one after the other in a single
+/// arena, which is used as a ring: a new block is written behind the
+/// previous one and the arena is wrapped at its end. Every mixing bin
+/// has a ring of `depth` events; when the ring is full, the oldest event
+/// of the bin is replaced.
+///
+/// With a memory limit the arena is allocated once with the size of the
+/// limit, and the events whose blocks are in the way of a new block are
+/// dropped, which are the oldest events of all bins. An event which is
+/// larger than the limit on its own is not stored. Without a limit the
+/// arena grows (moving the stored blocks) until the events fit, so after
+/// the first events no memory is allocated.
+///
+/// For pair making, MixingEvents returns the events of a bin (newest
+/// first) as AliFemtoPicoEvents, whose particles are reused objects
+/// filled from the snapshots: the four-momentum, the track momentum and
+/// the selected fields of the track (nominal TPC entrance point, charge,
+/// PID probabilities, track id). The fields are the ones declared by the
+/// pair cut and the correlation functions (MixedTrackFields); a cut or
+/// correlation function which reads other fields (kUnstored) cannot be
+/// used with the pool. The events and particles stay owned by the pool
+/// and are valid until the next call.
+///
+/// Only particles made from tracks are supported.
+///
+class AliFemtoPicoEventPool {
+public:
+  /// Fields stored in addition to the four-momentum
+  enum EField {
+    kEntrancePoint = 0x1,  ///< nominal TPC entrance point
+    kCharge        = 0x2,  ///< charge
+    kPid           = 0x4,  ///< electron, pion, kaon and proton probabilities
+    kTrackId       = 0x8,  ///< track id
+    kAllFields     = 0xf,
+    kUnstored      = 0x100 ///< fields which are not stored (TPC cluster and sharing maps, TPC points, helix, MC information, ...)
+  };
+
+  /// \param aNBins number of mixing bins
+  /// \param aDepth number of events stored per bin
+  /// \param aFields fields stored in addition to the four-momentum (EField)
+  /// \param aMaxBytes size of the arena holding the snapshots of all bins (0: no limit)
+  AliFemtoPicoEventPool(UInt_t aNBins, UInt_t aDepth, UInt_t aFields=kAllFields, ULong64_t aMaxBytes=0);
+  ~AliFemtoPicoEventPool();
+
+  /// Store a snapshot of the event in the given bin; the event is not kept
+  void Store(UInt_t aBin, AliFemtoPicoEvent* aEvent);
+
+  /// Events of the bin, newest first (owned by the pool, valid until the next call)
+  AliFemtoPicoEventCollection* MixingEvents(UInt_t aBin);
+
+  UInt_t NBins() const;
+  UInt_t Depth() const;
+  UInt_t Fields() const;
+  UInt_t Size(UInt_t aBin) const;   ///< number of events stored in the bin
+
+  ULong64_t MemoryUsed() const;     ///< bytes used by the stored snapshots
+  ULong64_t MemoryAllocated() const; ///< bytes of the arena
+  ULong64_t MaxMemory() const;      ///< limit on the memory of the snapshots (0: no limit)
+  ULong64_t NDropped() const;       ///< number of events dropped or not stored because of the memory limit
+
+  /// Drop all events, the arena keeps its memory
+  void Clear();
+
+private:
+  AliFemtoPicoEventPool(const AliFemtoPicoEventPool&);
+  AliFemtoPicoEventPool& operator=(const AliFemtoPicoEventPool&);
+
+  /// Snapshot of one event, columns of collection 1 then collection 2
+  struct Block {
+    size_t fOffset;             ///< first value in the arena
+    size_t fSize;               ///< number of values
+    UInt_t fN[2];               ///< number of particles in collection 1 and 2
+    ULong64_t fSequence;        ///< insertion number (0: empty)
+  };
+
+  UInt_t NColumns() const;
+  void Release(Block& aBlock);
+  size_t Allocate(size_t aSize);
+  void DropRange(size_t aBegin, size_t aEnd);
+  void Grow(size_t aSize);
+  void FillParticles(const Block& aBlock, UInt_t aCollection, AliFemtoParticleCollection* aParticles, UInt_t aFirst);
+
+  UInt_t fNBins;             ///< number of mixing bins
+  UInt_t fDepth;             ///< events per bin
+  UInt_t fFields;            ///< stored fields (EField)
+  ULong64_t fMaxBytes;       ///< memory limit (0: none)
+  ULong64_t fUsedBytes;      ///< memory of the stored blocks
+  ULong64_t fSequence;       ///< insertion counter
+  ULong64_t fNDropped;       ///< events dropped because of the memory limit
+
+  std::vector<double> fArena;      ///< values of all blocks
+  size_t fWrite;                   ///< arena position of the next block
+  std::vector<Block> fBlocks;      ///< block of ring position r of bin b at b * fDepth + r
+  std::vector<UInt_t> fHead;       ///< ring position of the next event, per bin
+
+  std::vector<AliFemtoPicoEvent*> fViews;        ///< events returned by MixingEvents
+  AliFemtoPicoEventCollection fViewCollection;   ///< list returned by MixingEvents
+  std::vector<AliFemtoParticle*> fParticles;     ///< particles of the returned events
+};
+
+inline UInt_t AliFemtoPicoEventPool::NBins() const { return fNBins; }
+inline UInt_t AliFemtoPicoEventPool::Depth() const { return fDepth; }
+inline UInt_t AliFemtoPicoEventPool::Fields() const { return fFields; }
+inline ULong64_t AliFemtoPicoEventPool::MemoryUsed() const { return fUsedBytes; }
+inline ULong64_t AliFemtoPicoEventPool::MemoryAllocated() const { return fArena.size() * sizeof(double); }
+inline ULong64_t AliFemtoPicoEventPool::MaxMemory() const { return fMaxBytes; }
+inline ULong64_t AliFemtoPicoEventPool::NDropped() const { return fNDropped; }
+
+#endif
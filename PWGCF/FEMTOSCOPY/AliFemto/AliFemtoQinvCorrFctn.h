@@ -78,6 +78,9 @@ public:
   TH1D* Ratio();
 
   virtual TList* GetOutputList();
+  /// The track momentum is always set; the charge is read for the
+  /// \f$ \Delta\eta\Delta\phi^* \f$ histograms
+  virtual UInt_t MixedTrackFields() const { return (fDetaDphiscal ? AliFemtoPicoEventPool::kCharge : 0) | PairCutTrackFields(); }
   void Write();
 
 private:
@@ -9,17 +9,99 @@
 #include "AliFemtoXiCut.h"
 #include "AliFemtoXiTrackCut.h"
 #include "AliFemtoPicoEvent.h"
+#include "AliFemtoPairEngineSoA.h"
+#include "AliFemtoPicoEventPool.h"
 
 #include <string>
+#include <cstring>
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <iostream>
 #include <iterator>
 
+#include "TH1.h"
+#include "THnSparse.h"
+#include "TROOT.h"
+
 #ifdef __ROOT__
   /// \cond CLASSIMP
   ClassImp(AliFemtoSimpleAnalysis);
   /// \endcond
 #endif
 
+/// Threads making the mixed pairs, started once and reused for every
+/// event. Run(job) calls job(t) for t = 0..n-1, job(0) in the calling
+/// thread, and returns when all calls have finished.
+class AliFemtoMixingWorkerPool {
+public:
+  AliFemtoMixingWorkerPool(UInt_t aNumThreads):
+    fThreads(), fMutex(), fStart(), fDone(), fJob(), fGeneration(0), fPending(0), fStop(false)
+  {
+    for (UInt_t ithread = 1; ithread < aNumThreads; ++ithread) {
+      fThreads.push_back(std::thread(&AliFemtoMixingWorkerPool::Work, this, ithread));
+    }
+  }
+
+  ~AliFemtoMixingWorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fStop = true;
+    }
+    fStart.notify_all();
+    for (size_t ithread = 0; ithread < fThreads.size(); ++ithread) {
+      fThreads[ithread].join();
+    }
+  }
+
+  void Run(const std::function<void(UInt_t)> &aJob)
+  {
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fJob = aJob;
+      fPending = fThreads.size();
+      fGeneration++;
+    }
+    fStart.notify_all();
+    aJob(0);
+    std::unique_lock<std::mutex> lock(fMutex);
+    fDone.wait(lock, [this]() { return fPending == 0; });
+  }
+
+private:
+  void Work(UInt_t aThread)
+  {
+    ULong64_t done = 0;
+    while (true) {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fStart.wait(lock, [this, done]() { return fStop || fGeneration != done; });
+      if (fStop) {
+        return;
+      }
+      done = fGeneration;
+      lock.unlock();
+      fJob(aThread);
+      lock.lock();
+      if (--fPending == 0) {
+        fDone.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> fThreads;          ///< threads 1..n-1, thread 0 is the caller of Run
+  std::mutex fMutex;                          ///< protects the members below
+  std::condition_variable fStart;             ///< signals a new job or the stop
+  std::condition_variable fDone;              ///< signals that all threads finished the job
+  std::function<void(UInt_t)> fJob;           ///< job of the current event
+  ULong64_t fGeneration;                      ///< number of jobs started
+  size_t fPending;                            ///< threads still running the current job
+  bool fStop;                                 ///< threads have to return
+};
+
 AliFemtoEventCut*    copyTheCut(AliFemtoEventCut*);
 AliFemtoParticleCut* copyTheCut(AliFemtoParticleCut*);
 AliFemtoPairCut*     copyTheCut(AliFemtoPairCut*);
@@ -169,13 +251,25 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fFirstParticleCut(NULL),
   fSecondParticleCut(NULL),
   fMixingBuffer(NULL),
+  fEventPool(NULL),
+  fEventPoolBin(0),
   fPicoEvent(NULL),
   fNumEventsToMix(0),
   fNeventsProcessed(0),
   fMinSizePartCollection(0),
   fVerbose(kTRUE),
   fPerformSharedDaughterCut(kFALSE),
-  fEnablePairMonitors(kFALSE)
+  fEnablePairMonitors(kFALSE),
+  fPairEngine(NULL),
+  fNumMixingThreads(1),
+  fMixingPool(NULL),
+  fMixingPairCuts(),
+  fMixingCorrFctns(),
+  fMixingPairEngines(),
+  fMergedCorrFctns(),
+  fReplayedCorrFctns(),
+  fMixedPairs(),
+  fMixingShardsFilled(false)
 {
   // Default constructor
   fCorrFctnCollection = new AliFemtoCorrFctnCollection;
@@ -191,13 +285,25 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fFirstParticleCut(NULL),
   fSecondParticleCut(NULL),
   fMixingBuffer(NULL),
+  fEventPool(NULL),
+  fEventPoolBin(0),
   fPicoEvent(NULL),
   fNumEventsToMix(a.fNumEventsToMix),
   fNeventsProcessed(0),
   fMinSizePartCollection(a.fMinSizePartCollection),
   fVerbose(a.fVerbose),
   fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-  fEnablePairMonitors(a.fEnablePairMonitors)
+  fEnablePairMonitors(a.fEnablePairMonitors),
+  fPairEngine(a.fPairEngine ? new AliFemtoPairEngineSoA(*a.fPairEngine) : NULL),
+  fNumMixingThreads(a.fNumMixingThreads),
+  fMixingPool(NULL),
+  fMixingPairCuts(),
+  fMixingCorrFctns(),
+  fMixingPairEngines(),
+  fMergedCorrFctns(),
+  fReplayedCorrFctns(),
+  fMixedPairs(),
+  fMixingShardsFilled(false)
 {
   /// Copy constructor
 
@@ -292,6 +398,8 @@ AliFemtoSimpleAnalysis::~AliFemtoSimpleAnalysis()
   delete fEventCut;
   delete fFirstParticleCut;
   delete fSecondParticleCut;
+  delete fPairEngine;
+  DeleteMixingShards();
 
   // delete every CorrFunction in the collection, then the collection
   if (fCorrFctnCollection) {
@@ -350,6 +458,9 @@ AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAn
     fMixingBuffer = new AliFemtoPicoEventCollection;
   }
 
+  // the event pool belongs to the subclass
+  fEventPool = NULL;
+
   // clone objects
   fPairCut = aAna.fPairCut->Clone();
   fEventCut = aAna.fEventCut->Clone();
@@ -394,6 +505,12 @@ AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAn
   fPerformSharedDaughterCut = aAna.fPerformSharedDaughterCut;
   fEnablePairMonitors = aAna.fEnablePairMonitors;
 
+  delete fPairEngine;
+  fPairEngine = aAna.fPairEngine ? new AliFemtoPairEngineSoA(*aAna.fPairEngine) : NULL;
+
+  DeleteMixingShards();
+  fNumMixingThreads = aAna.fNumMixingThreads;
+
   return *this;
 }
 //______________________
@@ -410,6 +527,20 @@ AliFemtoCorrFctn* AliFemtoSimpleAnalysis::CorrFctn(int n)
   return *iter;
 }
 //____________________________
+void AliFemtoSimpleAnalysis::SetPairEngine(AliFemtoPairEngineSoA* aEngine)
+{
+  /// Set the engine for the blocked pair loop, deleting the previous one
+
+  if (aEngine != fPairEngine) {
+    delete fPairEngine;
+    fPairEngine = aEngine;
+
+    // the mixing threads take a copy of the engine when they are set up
+    MergeMixingShards();
+    DeleteMixingShards();
+  }
+}
+//____________________________
 AliFemtoString AliFemtoSimpleAnalysis::Report()
 {
   /// Create a simple report from the analysis execution
@@ -527,30 +658,54 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
     collection2 = NULL;
   }
 
-  MakePairs("real", collection1, collection2, EnablePairMonitors());
+  if (fPairEngine) {
+    MakePairs("real", fPicoEvent->FirstParticleCollectionSoA(),
+                      collection2 ? fPicoEvent->SecondParticleCollectionSoA() : NULL,
+                      EnablePairMonitors());
+  } else {
+    MakePairs("real", collection1, collection2, EnablePairMonitors());
+  }
 
   if (fVerbose) {
     cout << "AliFemtoSimpleAnalysis::ProcessEvent() - reals done ";
   }
 
   //---- Make pairs for mixed events, looping over events in mixingBuffer ----//
-  for (AliFemtoPicoEventIterator fPicoEventIter = MixingBuffer()->begin();
-                                 fPicoEventIter != MixingBuffer()->end();
-                               ++fPicoEventIter) {
-
-    AliFemtoPicoEvent *storedEvent = *fPicoEventIter;
-
-    // If identical - only mix the first particle collections
-    if (AnalyzeIdenticalParticles()) {
-      MakePairs("mixed", collection1, storedEvent->FirstParticleCollection());
-
-    // If non-identical - mix both combinations of first and second particles
-    } else {
-        MakePairs("mixed", collection1,
-                           storedEvent->SecondParticleCollection());
+  if (fNumMixingThreads > 1 && !MixingBuffer()->empty() && !fMixingPairCuts.empty()) {
+    // distribute the mixed pairings over the mixing threads
+    MakeMixedPairsThreaded();
+  } else {
+    for (AliFemtoPicoEventIterator fPicoEventIter = MixingBuffer()->begin();
+                                   fPicoEventIter != MixingBuffer()->end();
+                                 ++fPicoEventIter) {
+
+      AliFemtoPicoEvent *storedEvent = *fPicoEventIter;
+
+      // Blocked pair loop on the contiguous copies of the collections
+      if (fPairEngine) {
+        if (AnalyzeIdenticalParticles()) {
+          MakePairs("mixed", fPicoEvent->FirstParticleCollectionSoA(),
+                             storedEvent->FirstParticleCollectionSoA(), kFALSE);
+        } else {
+          MakePairs("mixed", fPicoEvent->FirstParticleCollectionSoA(),
+                             storedEvent->SecondParticleCollectionSoA(), kFALSE);
+
+          MakePairs("mixed", storedEvent->FirstParticleCollectionSoA(),
+                             fPicoEvent->SecondParticleCollectionSoA(), kFALSE);
+        }
+
+      // If identical - only mix the first particle collections
+      } else if (AnalyzeIdenticalParticles()) {
+        MakePairs("mixed", collection1, storedEvent->FirstParticleCollection());
+
+      // If non-identical - mix both combinations of first and second particles
+      } else {
+          MakePairs("mixed", collection1,
+                             storedEvent->SecondParticleCollection());
 
-        MakePairs("mixed", storedEvent->FirstParticleCollection(),
-                           collection2);
+          MakePairs("mixed", storedEvent->FirstParticleCollection(),
+                             collection2);
+      }
     }
   }
 
@@ -558,16 +713,27 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
     cout << " - mixed done   " << endl;
   }
 
-  //--------- If mixing buffer is full, delete oldest event ---------//
-  if ( MixingBufferFull() ) {
-    delete MixingBuffer()->back();
-    MixingBuffer()->pop_back();
-  }
+  if (fEventPool) {
+    //-------- Store a snapshot of the current event, replacing the oldest one --------//
+    fEventPool->Store(fEventPoolBin, fPicoEvent);
+  } else {
+    //--------- If mixing buffer is full, delete oldest event ---------//
+    if ( MixingBufferFull() ) {
+      delete MixingBuffer()->back();
+      MixingBuffer()->pop_back();
+    }
 
-  //-------- Add current event (fPicoEvent) to mixing buffer --------//
-  MixingBuffer()->push_front(fPicoEvent);
+    //-------- Add current event (fPicoEvent) to mixing buffer --------//
+    MixingBuffer()->push_front(fPicoEvent);
+  }
 
   EventEnd(hbtEvent);  // cleanup for EbyE
+
+  // the pool keeps only the snapshot
+  if (fEventPool) {
+    delete fPicoEvent;
+    fPicoEvent = NULL;
+  }
   //cout << "AliFemtoSimpleAnalysis::ProcessEvent() - return to caller ... " << endl;
 }
 
@@ -575,7 +741,10 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
 void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
                                        AliFemtoParticleCollection *partCollection1,
                                        AliFemtoParticleCollection *partCollection2,
-                                       Bool_t enablePairMonitors)
+                                       Bool_t enablePairMonitors,
+                                       AliFemtoPairCut *pairCut,
+                                       AliFemtoCorrFctnCollection *corrFctns,
+                                       std::vector<AliFemtoMixedPairRecord> *passingPairs)
 {
 /// Build pairs, check pair cuts, and call CFs' AddRealPair() or
 /// AddMixedPair() methods. If no second particle collection is
@@ -583,6 +752,10 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
 
   const string type = typeIn;
 
+  // the mixing threads use their own pair cut and correlation functions
+  AliFemtoPairCut *tPairCut = pairCut ? pairCut : fPairCut;
+  AliFemtoCorrFctnCollection *tCorrFctns = corrFctns ? corrFctns : fCorrFctnCollection;
+
   //  int swpart = ((long int) partCollection1) % 2;
 
   // Used to swap particle 1 & 2 in identical-particle analysis
@@ -648,17 +821,21 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
       }
 
       // check if the pair passes the cut
-      bool tmpPassPair = fPairCut->Pass(tPair);
+      bool tmpPassPair = tPairCut->Pass(tPair);
 
       // This is a condition for speed reasons
       if (enablePairMonitors) {
-        fPairCut->FillCutMonitor(tPair, tmpPassPair);
+        tPairCut->FillCutMonitor(tPair, tmpPassPair);
       }
 
       // If pair passes cut, loop over CF's and add pair to real/mixed
       if (tmpPassPair) {
-        for (AliFemtoCorrFctnIterator tCorrFctnIter = fCorrFctnCollection->begin();
-                                      tCorrFctnIter != fCorrFctnCollection->end();
+        if (passingPairs) {
+          AliFemtoMixedPairRecord record = { tPair->Track1(), tPair->Track2(), false, 0.0, 0.0, 0.0, 0.0, 0.0 };
+          passingPairs->push_back(record);
+        }
+        for (AliFemtoCorrFctnIterator tCorrFctnIter = tCorrFctns->begin();
+                                      tCorrFctnIter != tCorrFctns->end();
                                     ++tCorrFctnIter) {
 
           AliFemtoCorrFctn* tCorrFctn = *tCorrFctnIter;
@@ -678,6 +855,71 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
   delete tPair;
 }
 //_________________________
+void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
+                                       const AliFemtoParticleCollectionSoA *partCollection1,
+                                       const AliFemtoParticleCollectionSoA *partCollection2,
+                                       Bool_t enablePairMonitors,
+                                       AliFemtoPairEngineSoA *pairEngine,
+                                       AliFemtoPairCut *pairCut,
+                                       AliFemtoCorrFctnCollection *corrFctns,
+                                       std::vector<AliFemtoMixedPairRecord> *passingPairs)
+{
+/// Build pairs block-wise with fPairEngine. Pairs are made in the same
+/// order and with the same swapping of identical particles as in the
+/// default MakePairs; pairs passing the engine's pre-cuts go through the
+/// pair cut and to the CFs' AddRealPair() or AddMixedPair() methods.
+
+  const bool isReal = (strcmp(typeIn, "real") == 0);
+  if (!isReal && strcmp(typeIn, "mixed") != 0) {
+    cout << "Problem with pair type, type = " << typeIn << endl;
+    return;
+  }
+
+  AliFemtoPairEngineSoA *tPairEngine = pairEngine ? pairEngine : fPairEngine;
+  AliFemtoPairCut *tPairCut = pairCut ? pairCut : fPairCut;
+  AliFemtoCorrFctnCollection *tCorrFctns = corrFctns ? corrFctns : fCorrFctnCollection;
+
+  // Used to swap particle 1 & 2 in identical-particle analysis
+  bool swpart = fNeventsProcessed % 2;
+
+  AliFemtoPair* tPair = new AliFemtoPair;
+
+  tPairEngine->Begin(partCollection1, partCollection2, swpart);
+  while (const UInt_t tNPairs = tPairEngine->NextBlock()) {
+    for (UInt_t i = 0; i < tNPairs; ++i) {
+      tPairEngine->FillPair(i, tPair);
+
+      bool tmpPassPair = tPairCut->Pass(tPair);
+
+      if (enablePairMonitors) {
+        tPairCut->FillCutMonitor(tPair, tmpPassPair);
+      }
+
+      if (!tmpPassPair) {
+        continue;
+      }
+
+      if (passingPairs) {
+        AliFemtoMixedPairRecord record = { tPairEngine->Particle1(i), tPairEngine->Particle2(i), true,
+                                           tPairEngine->KStarOut(i), tPairEngine->KStarSide(i), tPairEngine->KStarLong(i),
+                                           tPairEngine->KStar(i), tPairEngine->CVK(i) };
+        passingPairs->push_back(record);
+      }
+
+      for (AliFemtoCorrFctnIterator tCorrFctnIter = tCorrFctns->begin();
+                                    tCorrFctnIter != tCorrFctns->end();
+                                  ++tCorrFctnIter) {
+        if (isReal)
+          (*tCorrFctnIter)->AddRealPair(tPair);
+        else
+          (*tCorrFctnIter)->AddMixedPair(tPair);
+      }
+    }
+  }
+
+  delete tPair;
+}
+//_________________________
 void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
 {
   /// Perform initialization operations at the beginning of the event processing
@@ -691,12 +933,43 @@ void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
                                 ++iter) {
     (*iter)->EventBegin(ev);
   }
+
+  // the pair cuts and correlation functions of the mixing threads are
+  // created (empty) before the first event they are filled in, and again
+  // if correlation functions were added since
+  if (!fMixingPairCuts.empty()
+      && fMergedCorrFctns.size() + fReplayedCorrFctns.size() != fCorrFctnCollection->size()) {
+    DeleteMixingShards();
+  }
+  if (fNumMixingThreads > 1 && fMixingPairCuts.empty()) {
+    MakeMixingShards();
+  }
+  for (size_t ishard = 0; ishard < fMixingPairCuts.size(); ++ishard) {
+    fMixingPairCuts[ishard]->EventBegin(ev);
+    for (AliFemtoCorrFctnIterator iter = fMixingCorrFctns[ishard]->begin();
+                                  iter != fMixingCorrFctns[ishard]->end();
+                                  ++iter) {
+      (*iter)->EventBegin(ev);
+    }
+  }
 }
 //_________________________
 void AliFemtoSimpleAnalysis::EventEnd(const AliFemtoEvent* ev)
 {
   // Finish operations at the end of event processing
 
+  for (size_t ishard = 0; ishard < fMixingPairCuts.size(); ++ishard) {
+    fMixingPairCuts[ishard]->EventEnd(ev);
+    for (AliFemtoCorrFctnIterator iter = fMixingCorrFctns[ishard]->begin();
+                                  iter != fMixingCorrFctns[ishard]->end();
+                                  ++iter) {
+      (*iter)->EventEnd(ev);
+    }
+  }
+
+  // add the mixed pairs of this event to the pair cut and CFs of the analysis
+  MergeMixingShards();
+
   fFirstParticleCut->EventEnd(ev);
   fSecondParticleCut->EventEnd(ev);
   fPairCut->EventEnd(ev);
@@ -711,6 +984,9 @@ void AliFemtoSimpleAnalysis::Finish()
 {
   // Perform finishing operations after all events are processed
 
+  // mixed pairs of the mixing threads not merged by EventEnd
+  MergeMixingShards();
+
   for (AliFemtoCorrFctnIterator iter = fCorrFctnCollection->begin();
                                 iter != fCorrFctnCollection->end();
                                 ++iter) {
@@ -718,6 +994,348 @@ void AliFemtoSimpleAnalysis::Finish()
   }
 }
 //_________________________
+void AliFemtoSimpleAnalysis::SetNumMixingThreads(UInt_t aNumThreads)
+{
+  /// Set the number of threads making the mixed pairs. Existing shards
+  /// are merged into the correlation functions first.
+
+  MergeMixingShards();
+  DeleteMixingShards();
+  fNumMixingThreads = (aNumThreads > 0) ? aNumThreads : 1;
+}
+//_________________________
+bool AliFemtoSimpleAnalysis::MakeMixingShards()
+{
+  /// Create the threads and the pair cut and correlation function clones
+  /// of the mixing threads, if not done yet. The clones are copies of
+  /// filled objects, so their histograms and pair counts are reset: they
+  /// only hold the mixed pairs of the current event. Only correlation
+  /// functions declaring MixedPairsMergeable(), with histogram output,
+  /// and whose pair selection cut (if any) can be cloned are filled by the
+  /// threads; the others get the recorded mixed pairs in ReplayMixedPairs.
+  /// If the pair cut cannot be cloned the analysis falls back to mixing
+  /// in the calling thread.
+
+  if (!fMixingPairCuts.empty()) {
+    return true;
+  }
+
+  bool cloned = true;
+  for (UInt_t ishard = 0; ishard < fNumMixingThreads; ++ishard) {
+    AliFemtoPairCut *pairCut = fPairCut->Clone();
+    if (!pairCut) {
+      cloned = false;
+      break;
+    }
+    pairCut->SetAnalysis(this);
+    pairCut->ResetCounts();
+    ResetOutput(fPairCut, pairCut);
+
+    fMixingPairCuts.push_back(pairCut);
+    fMixingCorrFctns.push_back(new AliFemtoCorrFctnCollection);
+    fMixingPairEngines.push_back(fPairEngine ? new AliFemtoPairEngineSoA(*fPairEngine) : NULL);
+  }
+
+  if (!cloned) {
+    cerr << " WARNING [AliFemtoSimpleAnalysis::MakeMixingShards()] Could not clone the pair cut"
+            " - mixing in a single thread." << endl;
+    DeleteMixingShards();
+    fNumMixingThreads = 1;
+    return false;
+  }
+
+  for (AliFemtoCorrFctnIterator iter = fCorrFctnCollection->begin();
+                                iter != fCorrFctnCollection->end();
+                                ++iter) {
+    AliFemtoCorrFctn *fctn = *iter;
+    AliFemtoPairCut *selectionCut = fctn->PairSelectionCut();
+
+    std::vector<AliFemtoCorrFctn*> clones;
+    bool merged = fctn->MixedPairsMergeable() && HistogramOutput(fctn);
+    for (UInt_t ishard = 0; merged && ishard < fNumMixingThreads; ++ishard) {
+      AliFemtoCorrFctn *clone = fctn->Clone();
+      if (!clone) {
+        merged = false;
+        break;
+      }
+      clones.push_back(clone);
+      clone->SetAnalysis(this);
+      clone->SetPairSelectionCut(NULL);
+      ResetOutput(fctn, clone);
+
+      // each clone gets its own copy of the pair selection cut
+      if (selectionCut) {
+        AliFemtoPairCut *cloneCut = selectionCut->Clone();
+        if (!cloneCut) {
+          merged = false;
+          break;
+        }
+        cloneCut->ResetCounts();
+        ResetOutput(selectionCut, cloneCut);
+        clone->SetPairSelectionCut(cloneCut);
+      }
+    }
+
+    if (merged) {
+      for (UInt_t ishard = 0; ishard < fNumMixingThreads; ++ishard) {
+        fMixingCorrFctns[ishard]->push_back(clones[ishard]);
+      }
+      fMergedCorrFctns.push_back(fctn);
+    } else {
+      for (size_t iclone = 0; iclone < clones.size(); ++iclone) {
+        delete clones[iclone]->PairSelectionCut();
+        delete clones[iclone];
+      }
+      fReplayedCorrFctns.push_back(fctn);
+    }
+  }
+
+  ROOT::EnableThreadSafety();
+  fMixingPool = new AliFemtoMixingWorkerPool(fNumMixingThreads);
+
+  return true;
+}
+//_________________________
+void AliFemtoSimpleAnalysis::DeleteMixingShards()
+{
+  /// Stop the mixing threads and delete their pair cuts and correlation
+  /// functions
+
+  delete fMixingPool;
+  fMixingPool = NULL;
+
+  for (size_t ishard = 0; ishard < fMixingPairCuts.size(); ++ishard) {
+    delete fMixingPairCuts[ishard];
+    delete fMixingPairEngines[ishard];
+  }
+  for (size_t ishard = 0; ishard < fMixingCorrFctns.size(); ++ishard) {
+    for (AliFemtoCorrFctnIterator iter = fMixingCorrFctns[ishard]->begin();
+                                  iter != fMixingCorrFctns[ishard]->end();
+                                  ++iter) {
+      delete (*iter)->PairSelectionCut();
+      delete *iter;
+    }
+    delete fMixingCorrFctns[ishard];
+  }
+
+  fMixingPairCuts.clear();
+  fMixingCorrFctns.clear();
+  fMixingPairEngines.clear();
+  fMergedCorrFctns.clear();
+  fReplayedCorrFctns.clear();
+  fMixedPairs.clear();
+  fMixingShardsFilled = false;
+}
+//_________________________
+void AliFemtoSimpleAnalysis::MakeMixedPairsThreaded()
+{
+  /// Make the mixed pairs of the current event with the events in the
+  /// mixing buffer. The pairings are listed in the order of the serial
+  /// loop and pairing k is made by thread k % fNumMixingThreads, which
+  /// fills its own pair cut and correlation function clones and records
+  /// the pairs passing the pair cut. The recorded pairs are then passed,
+  /// in the order of the pairings, to the other correlation functions.
+
+  struct MixingTask {
+    AliFemtoParticleCollection *fCollection1;
+    AliFemtoParticleCollection *fCollection2;
+    const AliFemtoParticleCollectionSoA *fCollectionSoA1;
+    const AliFemtoParticleCollectionSoA *fCollectionSoA2;
+  };
+
+  // The contiguous copies are built here, as they are created on first access
+  std::vector<MixingTask> tasks;
+  for (AliFemtoPicoEventIterator piter = MixingBuffer()->begin(); piter != MixingBuffer()->end(); ++piter) {
+    AliFemtoPicoEvent *storedEvent = *piter;
+
+    if (AnalyzeIdenticalParticles()) {
+      MixingTask task = { fPicoEvent->FirstParticleCollection(), storedEvent->FirstParticleCollection(),
+                          fPairEngine ? fPicoEvent->FirstParticleCollectionSoA() : NULL,
+                          fPairEngine ? storedEvent->FirstParticleCollectionSoA() : NULL };
+      tasks.push_back(task);
+    } else {
+      MixingTask task1 = { fPicoEvent->FirstParticleCollection(), storedEvent->SecondParticleCollection(),
+                           fPairEngine ? fPicoEvent->FirstParticleCollectionSoA() : NULL,
+                           fPairEngine ? storedEvent->SecondParticleCollectionSoA() : NULL };
+      MixingTask task2 = { storedEvent->FirstParticleCollection(), fPicoEvent->SecondParticleCollection(),
+                           fPairEngine ? storedEvent->FirstParticleCollectionSoA() : NULL,
+                           fPairEngine ? fPicoEvent->SecondParticleCollectionSoA() : NULL };
+      tasks.push_back(task1);
+      tasks.push_back(task2);
+    }
+  }
+
+  // the records keep their capacity from event to event
+  const bool record = !fReplayedCorrFctns.empty();
+  if (fMixedPairs.size() < tasks.size()) {
+    fMixedPairs.resize(tasks.size());
+  }
+  for (size_t itask = 0; itask < fMixedPairs.size(); ++itask) {
+    fMixedPairs[itask].clear();
+  }
+
+  fMixingShardsFilled = true;
+
+  fMixingPool->Run([this, &tasks, record](UInt_t ithread) {
+    for (size_t itask = ithread; itask < tasks.size(); itask += fNumMixingThreads) {
+      const MixingTask &task = tasks[itask];
+      std::vector<AliFemtoMixedPairRecord> *passingPairs = record ? &fMixedPairs[itask] : NULL;
+      if (fPairEngine) {
+        MakePairs("mixed", task.fCollectionSoA1, task.fCollectionSoA2, kFALSE,
+                  fMixingPairEngines[ithread], fMixingPairCuts[ithread], fMixingCorrFctns[ithread],
+                  passingPairs);
+      } else {
+        MakePairs("mixed", task.fCollection1, task.fCollection2, kFALSE,
+                  fMixingPairCuts[ithread], fMixingCorrFctns[ithread], passingPairs);
+      }
+    }
+  });
+
+  if (record) {
+    ReplayMixedPairs();
+  }
+}
+//_________________________
+void AliFemtoSimpleAnalysis::ReplayMixedPairs()
+{
+  /// Pass the mixed pairs recorded by the mixing threads to the correlation
+  /// functions not filled by the threads, in the order of the serial loop
+
+  AliFemtoPair* tPair = new AliFemtoPair;
+
+  for (size_t itask = 0; itask < fMixedPairs.size(); ++itask) {
+    const std::vector<AliFemtoMixedPairRecord> &pairs = fMixedPairs[itask];
+    for (size_t ipair = 0; ipair < pairs.size(); ++ipair) {
+      const AliFemtoMixedPairRecord &record = pairs[ipair];
+      tPair->SetTrack1(record.fTrack1);
+      tPair->SetTrack2(record.fTrack2);
+      if (record.fNonIdPar) {
+        tPair->SetNonIdPar(record.fKStarOut, record.fKStarSide, record.fKStarLong, record.fKStar, record.fCVK);
+      }
+      for (size_t ifctn = 0; ifctn < fReplayedCorrFctns.size(); ++ifctn) {
+        fReplayedCorrFctns[ifctn]->AddMixedPair(tPair);
+      }
+    }
+  }
+
+  delete tPair;
+}
+//_________________________
+void AliFemtoSimpleAnalysis::MergeMixingShards()
+{
+  /// Add the mixed pairs of the current event, held by the pair cuts and
+  /// correlation functions of the mixing threads, to the ones of the
+  /// analysis, in the order of the threads, and reset the clones: the
+  /// pair counts of the cuts, the histograms of the correlation functions
+  /// and of the pair cut monitors.
+
+  if (!fMixingShardsFilled) {
+    return;
+  }
+  fMixingShardsFilled = false;
+
+  for (size_t ishard = 0; ishard < fMixingPairCuts.size(); ++ishard) {
+    AliFemtoPairCut *shardCut = fMixingPairCuts[ishard];
+    fPairCut->AddCounts(shardCut);
+    shardCut->ResetCounts();
+    MergeOutput(fPairCut, shardCut);
+
+    AliFemtoCorrFctnIterator shardIter = fMixingCorrFctns[ishard]->begin();
+    for (size_t ifctn = 0; ifctn < fMergedCorrFctns.size(); ++ifctn, ++shardIter) {
+      AliFemtoCorrFctn *fctn = fMergedCorrFctns[ifctn];
+      MergeOutput(fctn, *shardIter);
+
+      AliFemtoPairCut *selectionCut = fctn->PairSelectionCut();
+      if (selectionCut) {
+        AliFemtoPairCut *shardSelectionCut = (*shardIter)->PairSelectionCut();
+        selectionCut->AddCounts(shardSelectionCut);
+        shardSelectionCut->ResetCounts();
+        MergeOutput(selectionCut, shardSelectionCut);
+      }
+    }
+  }
+}
+//_________________________
+template <class T>
+void AliFemtoSimpleAnalysis::MergeOutput(T *aTarget, T *aShard)
+{
+  /// Add the histograms of the output list of aShard to the ones of
+  /// aTarget and reset them. Objects shared by both are left alone.
+
+  TList *output = aTarget->GetOutputList();
+  TList *shardOutput = aShard->GetOutputList();
+
+  TIter next(output);
+  TIter nextShard(shardOutput);
+  while (TObject *shardObj = nextShard()) {
+    TObject *obj = next();
+    if (!obj || strcmp(obj->GetName(), shardObj->GetName()) != 0) {
+      cerr << " WARNING [AliFemtoSimpleAnalysis::MergeOutput()] Output of " << shardObj->GetName()
+           << " does not match between the mixing threads - not merged." << endl;
+      break;
+    }
+    if (obj == shardObj) {
+      continue;
+    }
+    if (obj->InheritsFrom(TH1::Class())) {
+      ((TH1*) obj)->Add((TH1*) shardObj);
+      ((TH1*) shardObj)->Reset();
+    } else if (obj->InheritsFrom(THnSparse::Class())) {
+      ((THnSparse*) obj)->Add((THnSparse*) shardObj);
+      ((THnSparse*) shardObj)->Reset();
+    }
+  }
+
+  delete output;
+  delete shardOutput;
+}
+//_________________________
+template <class T>
+void AliFemtoSimpleAnalysis::ResetOutput(T *aOriginal, T *aClone)
+{
+  /// Reset the histograms of the output list of aClone, which the copy
+  /// constructor took over filled from aOriginal
+
+  TList *output = aOriginal->GetOutputList();
+  TList *cloneOutput = aClone->GetOutputList();
+
+  TIter nextClone(cloneOutput);
+  while (TObject *obj = nextClone()) {
+    if (output->FindObject(obj) == obj) {
+      continue;
+    }
+    if (obj->InheritsFrom(TH1::Class())) {
+      ((TH1*) obj)->Reset();
+    } else if (obj->InheritsFrom(THnSparse::Class())) {
+      ((THnSparse*) obj)->Reset();
+    }
+  }
+
+  delete output;
+  delete cloneOutput;
+}
+//_________________________
+template <class T>
+bool AliFemtoSimpleAnalysis::HistogramOutput(T *aObject)
+{
+  /// Check that the output list of aObject has only histograms, which the
+  /// mixing threads can add to the original ones
+
+  TList *output = aObject->GetOutputList();
+  bool histograms = true;
+
+  TIter next(output);
+  while (TObject *obj = next()) {
+    if (!obj->InheritsFrom(TH1::Class()) && !obj->InheritsFrom(THnSparse::Class())) {
+      histograms = false;
+      break;
+    }
+  }
+
+  delete output;
+  return histograms;
+}
+//_________________________
 void AliFemtoSimpleAnalysis::AddEventProcessed()
 {
   // Increase count of processed events
@@ -16,8 +16,27 @@
 #include "AliFemtoV0SharedDaughterCut.h"
 #include "AliFemtoXiSharedDaughterCut.h"
 
+#include <vector>
+
 class AliFemtoPicoEventCollectionVectorHideAway;
 class AliFemtoPicoEvent;
+class AliFemtoPicoEventPool;
+class AliFemtoParticleCollectionSoA;
+class AliFemtoPairEngineSoA;
+class AliFemtoMixingWorkerPool;
+
+/// A mixed pair passing the pair cut in a mixing thread, with the k*
+/// quantities of AliFemtoPairEngineSoA if the pair was made by the engine
+struct AliFemtoMixedPairRecord {
+  AliFemtoParticle* fTrack1;
+  AliFemtoParticle* fTrack2;
+  bool fNonIdPar;
+  double fKStarOut;
+  double fKStarSide;
+  double fKStarLong;
+  double fKStar;
+  double fCVK;
+};
 
 ///
 /// \class AliFemtoSimpleAnalysis
@@ -40,6 +59,30 @@ class AliFemtoPicoEvent;
 /// - specify how many events are to be strored in the mixing buffer for
 ///  background construction
 ///
+/// - optionally set an AliFemtoPairEngineSoA via SetPairEngine: pairs are
+///  then built block-wise from contiguous copies of the particle
+///  collections, with the engine's pre-cuts (kT, qinv, entrance
+///  separation) applied before the pair cut and with the k* quantities
+///  precalculated. Pairs failing the pre-cuts are not seen by the pair cut
+///  monitors.
+///
+/// - optionally set the number of threads for the mixed pairs via
+///  SetNumMixingThreads. The threads are started once and reused for
+///  every event. Each thread has its own clone of the pair cut; the
+///  pair counts of the clones (AliFemtoPairCut::AddCounts) and their cut
+///  monitors are added to the pair cut of the analysis in EventEnd.
+///  Correlation functions declaring AliFemtoCorrFctn::MixedPairsMergeable()
+///  are filled by the threads too, in clones with a clone of their pair
+///  selection cut, and their histograms are added to the original ones in
+///  EventEnd, before the EventEnd of the analysis objects. All other
+///  correlation functions (weighted fills, output other than histograms,
+///  no Clone()) receive the mixed pairs passing the pair cut from the
+///  calling thread, in the order of the single-threaded loop. The output
+///  is therefore identical to the single-threaded one. The clones are
+///  created in the first EventBegin; analyses overriding EventBegin
+///  without calling this class' one mix in a single thread. Requires that
+///  the pair cut implements Clone().
+///
 /// Then, when the analysis is run, for each event, the EventBegin is
 /// called before any processing is done, then the ProcessEvent is called
 /// which takes care of creating real and mixed pairs and sending them
@@ -99,6 +142,15 @@ public:
   void SetEnablePairMonitors(Bool_t aEnable);
   Bool_t EnablePairMonitors();
 
+  /// Use the blocked pair loop with the given engine (the analysis takes
+  /// ownership); NULL restores the default loop over the particle lists
+  void SetPairEngine(AliFemtoPairEngineSoA* aEngine);
+  AliFemtoPairEngineSoA* PairEngine();
+
+  /// Number of threads making the mixed pairs (default 1)
+  void SetNumMixingThreads(UInt_t aNumThreads);
+  UInt_t NumMixingThreads() const;
+
   unsigned int NumEventsToMix() const;
   void SetNumEventsToMix(const unsigned int& NumberOfEventsToMix);
   AliFemtoPicoEvent* CurrentPicoEvent();
@@ -154,10 +206,42 @@ protected:
   ///
   /// \param type Either the string "real" or "mixed", specifying which method
   ///             to call (AddRealPair or AddMixedPair)
+  /// \param pairCut, corrFctns Pair cut and correlation functions to use
+  ///             instead of the ones of the analysis (mixing threads)
+  /// \param passingPairs if set, the pairs passing the pair cut are also
+  ///             appended to it (mixing threads)
   void MakePairs(const char* type,
                  AliFemtoParticleCollection* ParticlesPassingCut1,
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
-                 Bool_t enablePairMonitors=kFALSE);
+                 Bool_t enablePairMonitors=kFALSE,
+                 AliFemtoPairCut* pairCut=NULL,
+                 AliFemtoCorrFctnCollection* corrFctns=NULL,
+                 std::vector<AliFemtoMixedPairRecord>* passingPairs=NULL);
+
+  /// Same as above, using the blocked pair loop of fPairEngine on the
+  /// contiguous copies of the particle collections
+  void MakePairs(const char* type,
+                 const AliFemtoParticleCollectionSoA* ParticlesPassingCut1,
+                 const AliFemtoParticleCollectionSoA* ParticlesPassingCut2,
+                 Bool_t enablePairMonitors,
+                 AliFemtoPairEngineSoA* pairEngine=NULL,
+                 AliFemtoPairCut* pairCut=NULL,
+                 AliFemtoCorrFctnCollection* corrFctns=NULL,
+                 std::vector<AliFemtoMixedPairRecord>* passingPairs=NULL);
+
+  bool MakeMixingShards();          ///< Clone pair cut and CFs for the mixing threads
+  void DeleteMixingShards();        ///< Delete the clones of the mixing threads
+  void MakeMixedPairsThreaded();    ///< Make the mixed pairs of the current event in fNumMixingThreads threads
+  void MergeMixingShards();         ///< Add the mixed pairs of the mixing threads to the pair cut and CFs
+  void ReplayMixedPairs();          ///< Pass the recorded mixed pairs to the CFs not filled by the mixing threads
+
+  /// True if all objects of the output list of aObject are histograms (TH1, THnSparse)
+  template <class T> static bool HistogramOutput(T *aObject);
+
+  /// Add the output histograms of a mixing thread's clone to the original and reset them
+  template <class T> void MergeOutput(T *aTarget, T *aShard);
+  /// Reset the output histograms of a fresh clone
+  template <class T> void ResetOutput(T *aOriginal, T *aClone);
 
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
@@ -167,6 +251,8 @@ protected:
   AliFemtoParticleCut*         fFirstParticleCut;    ///< select particles of type #1
   AliFemtoParticleCut*         fSecondParticleCut;   ///< select particles of type #2
   AliFemtoPicoEventCollection* fMixingBuffer;        ///< mixing buffer used in this simplest analysis
+  AliFemtoPicoEventPool*       fEventPool;           //!<! if set by a subclass, events are stored in bin fEventPoolBin of this pool instead of fMixingBuffer
+  UInt_t                       fEventPoolBin;        //!<! bin of fEventPool for the current event
   AliFemtoPicoEvent*           fPicoEvent;           //!<! The current event, in the small (pico) form
 
   unsigned int fNumEventsToMix;                      ///< How many "previous" events get mixed with this one, to make background
@@ -178,6 +264,18 @@ protected:
   Bool_t fPerformSharedDaughterCut;
   Bool_t fEnablePairMonitors;
 
+  AliFemtoPairEngineSoA*       fPairEngine;          //!<! blocked pair loop (NULL: loop over the particle lists)
+
+  UInt_t fNumMixingThreads;                                    ///< number of threads making the mixed pairs
+  AliFemtoMixingWorkerPool* fMixingPool;                       //!<! threads making the mixed pairs
+  std::vector<AliFemtoPairCut*> fMixingPairCuts;               //!<! pair cut of each mixing thread
+  std::vector<AliFemtoCorrFctnCollection*> fMixingCorrFctns;   //!<! clones of fMergedCorrFctns of each mixing thread
+  std::vector<AliFemtoPairEngineSoA*> fMixingPairEngines;      //!<! blocked pair loop of each mixing thread
+  std::vector<AliFemtoCorrFctn*> fMergedCorrFctns;             //!<! correlation functions filled by the mixing threads
+  std::vector<AliFemtoCorrFctn*> fReplayedCorrFctns;           //!<! correlation functions filled from fMixedPairs
+  std::vector<std::vector<AliFemtoMixedPairRecord> > fMixedPairs; //!<! mixed pairs passing the pair cut, for each pairing
+  bool fMixingShardsFilled;                                    //!<! mixed pairs of the current event are held by the mixing threads
+
 #ifdef __ROOT__
   /// \cond CLASSIMP
   ClassDef(AliFemtoSimpleAnalysis, 0);
@@ -242,6 +340,16 @@ inline bool AliFemtoSimpleAnalysis::EnablePairMonitors()
   return fEnablePairMonitors;
 }
 
+inline AliFemtoPairEngineSoA* AliFemtoSimpleAnalysis::PairEngine()
+{
+  return fPairEngine;
+}
+
+inline UInt_t AliFemtoSimpleAnalysis::NumMixingThreads() const
+{
+  return fNumMixingThreads;
+}
+
 // Sets
 inline void AliFemtoSimpleAnalysis::SetPairCut(AliFemtoPairCut* x)
 {
@@ -23,6 +23,8 @@ public:
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   virtual AliFemtoPairCut *Clone(); ///< Creates a new object with ALL the same attributes as the original
+  virtual void AddCounts(const AliFemtoPairCut* aCut);
+  virtual void ResetCounts();
   void SetV0Max(Double_t aAliFemtoV0Max);
   Double_t GetAliFemtoV0Max() const;
   void SetRemoveSameLabel(Bool_t aRemove);
@@ -79,4 +81,13 @@ inline AliFemtoPairCut *AliFemtoV0PairCut::Clone()
   return c;
 }
 
+inline void AliFemtoV0PairCut::AddCounts(const AliFemtoPairCut* aCut)
+{
+  if (const AliFemtoV0PairCut* tCut = dynamic_cast<const AliFemtoV0PairCut*>(aCut)) {
+    fNPairsPassed += tCut->fNPairsPassed;
+    fNPairsFailed += tCut->fNPairsFailed;
+  }
+}
+inline void AliFemtoV0PairCut::ResetCounts() { fNPairsPassed = 0; fNPairsFailed = 0; }
+
 #endif
@@ -30,6 +30,8 @@ public:
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   virtual AliFemtoPairCut *Clone();
+  virtual void AddCounts(const AliFemtoPairCut* aCut);
+  virtual void ResetCounts();
   void SetV0Max(Double_t aAliFemtoV0Max);
   Double_t GetAliFemtoV0Max() const;
   void SetRemoveSameLabel(Bool_t aRemove);
@@ -109,4 +111,13 @@ inline AliFemtoPairCut *AliFemtoV0TrackPairCut::Clone()
   return c;
 }
 
+inline void AliFemtoV0TrackPairCut::AddCounts(const AliFemtoPairCut* aCut)
+{
+  if (const AliFemtoV0TrackPairCut* tCut = dynamic_cast<const AliFemtoV0TrackPairCut*>(aCut)) {
+    fNPairsPassed += tCut->fNPairsPassed;
+    fNPairsFailed += tCut->fNPairsFailed;
+  }
+}
+inline void AliFemtoV0TrackPairCut::ResetCounts() { fNPairsPassed = 0; fNPairsFailed = 0; }
+
 #endif
@@ -33,7 +33,9 @@ AliFemtoVertexMultAnalysis::AliFemtoVertexMultAnalysis(UInt_t binsVertex,
   fUnderFlowVertexZ(0),
   fMultBins(binsMult),
   fOverFlowMult(0),
-  fUnderFlowMult(0)
+  fUnderFlowMult(0),
+  fUseEventPool(kFALSE),
+  fEventPoolMaxBytes(0)
 {
   fVertexZ[0] = minVertex;
   fVertexZ[1] = maxVertex;
@@ -91,7 +93,9 @@ AliFemtoVertexMultAnalysis::AliFemtoVertexMultAnalysis(const AliFemtoVertexMultA
   fUnderFlowVertexZ(0),
   fMultBins(orig.fMultBins),
   fOverFlowMult(0),
-  fUnderFlowMult(0)
+  fUnderFlowMult(0),
+  fUseEventPool(orig.fUseEventPool),
+  fEventPoolMaxBytes(orig.fEventPoolMaxBytes)
 {
   fVertexZ[0] = orig.fVertexZ[0];
   fVertexZ[1] = orig.fVertexZ[1];
@@ -142,6 +146,9 @@ AliFemtoVertexMultAnalysis& AliFemtoVertexMultAnalysis::operator=(const AliFemto
   fUnderFlowMult = 0;
   fOverFlowMult = 0;
 
+  fUseEventPool = rhs.fUseEventPool;
+  fEventPoolMaxBytes = rhs.fEventPoolMaxBytes;
+
   if (fMixingBuffer) {
     delete fMixingBuffer;
     fMixingBuffer = NULL;
@@ -166,6 +173,36 @@ AliFemtoVertexMultAnalysis::~AliFemtoVertexMultAnalysis()
   delete fPicoEventCollectionVectorHideAway;
 }
 
+//____________________________
+void AliFemtoVertexMultAnalysis::SetEventPool(ULong64_t aMaxBytes)
+{
+  /// Mix with compact event snapshots; the pool is created with the first event
+  fUseEventPool = kTRUE;
+  fEventPoolMaxBytes = aMaxBytes;
+}
+//____________________________
+UInt_t AliFemtoVertexMultAnalysis::EventPoolFields() const
+{
+  /// Track fields of the mixed particles read by the pair cut and the
+  /// correlation functions; prints the ones which read fields that are
+  /// not stored (AliFemtoPicoEventPool::kUnstored)
+  UInt_t fields = fPairCut->MixedTrackFields();
+  if (fields & AliFemtoPicoEventPool::kUnstored) {
+    cout << "E-AliFemtoVertexMultAnalysis: the pair cut reads track fields which are not in the compact event snapshots\n";
+  }
+
+  int icf = 0;
+  for (AliFemtoCorrFctnIterator iter = fCorrFctnCollection->begin(); iter != fCorrFctnCollection->end(); ++iter, ++icf) {
+    const UInt_t cfFields = (*iter)->MixedTrackFields();
+    if (cfFields & AliFemtoPicoEventPool::kUnstored) {
+      cout << "E-AliFemtoVertexMultAnalysis: correlation function " << icf
+           << " reads track fields which are not in the compact event snapshots\n";
+    }
+    fields |= cfFields;
+  }
+
+  return fields;
+}
 //____________________________
 AliFemtoString AliFemtoVertexMultAnalysis::Report()
 {
@@ -182,6 +219,9 @@ AliFemtoString AliFemtoVertexMultAnalysis::Report()
           + TString::Format("Events are mixed in %d Mult bins in the range %E cm to %E cm.\n", fMultBins, fMult[0], fMult[1])
           + TString::Format("Events underflowing: %d\n", fUnderFlowMult)
           + TString::Format("Events overflowing: %d\n", fOverFlowMult)
+          + (fEventPool ? TString::Format("Compact event snapshots: %llu bytes in a %llu byte arena, %llu events dropped by the memory limit\n",
+                                          fEventPool->MemoryUsed(), fEventPool->MemoryAllocated(), fEventPool->NDropped())
+                        : TString())
           + TString::Format("Now adding AliFemtoSimpleAnalysis(base) Report\n")
           + AliFemtoSimpleAnalysis::Report();
 
@@ -253,6 +293,27 @@ void AliFemtoVertexMultAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
     return;
   }
 
+  // with compact snapshots, mix with the events of the pool instead
+  if (fUseEventPool && !fEventPool) {
+    const UInt_t fields = EventPoolFields();
+    if (fFirstParticleCut->Type() != hbtTrack || fSecondParticleCut->Type() != hbtTrack) {
+      cout << "W-AliFemtoVertexMultAnalysis: compact event snapshots need particles from tracks - "
+              "storing full events.\n";
+      fUseEventPool = kFALSE;
+    } else if (fields & AliFemtoPicoEventPool::kUnstored) {
+      cout << "E-AliFemtoVertexMultAnalysis: compact event snapshots cannot be used with this pair cut "
+              "and these correlation functions - storing full events.\n";
+      fUseEventPool = kFALSE;
+    } else {
+      fPicoEventCollectionVectorHideAway->SetEventPool(fNumEventsToMix, fields, fEventPoolMaxBytes);
+      fEventPool = fPicoEventCollectionVectorHideAway->EventPool();
+    }
+  }
+  if (fEventPool) {
+    fEventPoolBin = fPicoEventCollectionVectorHideAway->PicoEventBin(vertexZ, mult);
+    fMixingBuffer = fEventPool->MixingEvents(fEventPoolBin);
+  }
+
   // now that fMixingBuffer has been set - call superclass ProcessEvent()
   AliFemtoSimpleAnalysis::ProcessEvent(hbtEvent);
 
@@ -6,6 +6,7 @@
 #define ALIFEMTOVERTEXMULTANALYSIS_H
 
 #include "AliFemtoSimpleAnalysis.h"
+#include "AliFemtoPicoEventPool.h"
 
 /// \class AliFemtoVertexMultAnalysis
 /// \brief Femtoscopic analysis which mixes events binned by vertices'
@@ -21,6 +22,19 @@
 /// this member is not created or deleted by the superclass, so this class
 /// deletes the member in its destructor.
 ///
+/// The mixed pairs of an event with the events of its mixing bin can be
+/// made in several threads, see AliFemtoSimpleAnalysis::SetNumMixingThreads.
+///
+/// With SetEventPool the mixing buffers keep compact snapshots of the
+/// events (the four-momenta and the track fields read by the pair cut and
+/// the correlation functions, see AliFemtoPicoEventPool) in preallocated
+/// ring buffers, optionally with a limit on the memory of all bins. The
+/// fields are taken from MixedTrackFields of the pair cut and of the
+/// correlation functions with the first event. If one of them reads a
+/// field which cannot be stored (or does not declare its fields), or a
+/// particle cut does not select tracks, an error is printed and the full
+/// events are stored.
+///
 class AliFemtoVertexMultAnalysis : public AliFemtoSimpleAnalysis {
 public:
 
@@ -61,6 +75,11 @@ public:
   virtual UInt_t OverflowMult() const;      ///< Number of events above multiplicity range
   virtual UInt_t UnderflowMult() const;     ///< Number of events below multiplicity range
 
+  /// Store compact event snapshots for mixing
+  ///
+  /// \param aMaxBytes limit on the memory of the snapshots of all bins in bytes (0: no limit)
+  void SetEventPool(ULong64_t aMaxBytes=0);
+
 protected:
 
   Double_t fVertexZ[2];     ///< min/max z-vertex position allowed to be processed
@@ -73,9 +92,14 @@ protected:
   UInt_t fOverFlowMult;     ///< number of events encountered which had too large multiplicity
   UInt_t fUnderFlowMult;    ///< number of events encountered which had too small multiplicity
 
+  UInt_t EventPoolFields() const;  ///< track fields needed by the pair cut and the correlation functions
+
+  Bool_t fUseEventPool;          ///< mix with compact event snapshots
+  ULong64_t fEventPoolMaxBytes;  ///< limit on the memory of the snapshots (0: no limit)
+
 #ifdef __ROOT__
   /// \cond CLASSIMP
-  ClassDef(AliFemtoVertexMultAnalysis, 1);
+  ClassDef(AliFemtoVertexMultAnalysis, 3);
   /// \endcond
 #endif
 
@@ -14,6 +14,8 @@ public:
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   virtual AliFemtoPairCut *Clone(); ///< Creates a new object with ALL the same attributes as the original
+  virtual void AddCounts(const AliFemtoPairCut* aCut);
+  virtual void ResetCounts();
   void SetDataType(AliFemtoDataType type);
 
 protected:
@@ -45,4 +47,13 @@ inline AliFemtoPairCut *AliFemtoXiPairCut::Clone()
   return c;
 }
 
+inline void AliFemtoXiPairCut::AddCounts(const AliFemtoPairCut* aCut)
+{
+  if (const AliFemtoXiPairCut* tCut = dynamic_cast<const AliFemtoXiPairCut*>(aCut)) {
+    fNPairsPassed += tCut->fNPairsPassed;
+    fNPairsFailed += tCut->fNPairsFailed;
+  }
+}
+inline void AliFemtoXiPairCut::ResetCounts() { fNPairsPassed = 0; fNPairsFailed = 0; }
+
 #endif
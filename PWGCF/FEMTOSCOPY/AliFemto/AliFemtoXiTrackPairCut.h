@@ -23,6 +23,8 @@ public:
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   virtual AliFemtoPairCut *Clone(); ///< Creates a new object with ALL the same attributes as the original
+  virtual void AddCounts(const AliFemtoPairCut* aCut);
+  virtual void ResetCounts();
   void SetDataType(AliFemtoDataType type);
   void SetTPCOnly(Bool_t tpconly);
 
@@ -69,4 +71,13 @@ inline AliFemtoPairCut *AliFemtoXiTrackPairCut::Clone()
 inline AliFemtoV0TrackPairCut* AliFemtoXiTrackPairCut::GetV0TrackPairCut() {return fV0TrackPairCut;}
 inline void AliFemtoXiTrackPairCut::SetMinAvgSepTrackBacPion(double aMin) {fMinAvgSepTrackBacPion = aMin;}
 
+inline void AliFemtoXiTrackPairCut::AddCounts(const AliFemtoPairCut* aCut)
+{
+  if (const AliFemtoXiTrackPairCut* tCut = dynamic_cast<const AliFemtoXiTrackPairCut*>(aCut)) {
+    fNPairsPassed += tCut->fNPairsPassed;
+    fNPairsFailed += tCut->fNPairsFailed;
+  }
+}
+inline void AliFemtoXiTrackPairCut::ResetCounts() { fNPairsPassed = 0; fNPairsFailed = 0; }
+
 #endif
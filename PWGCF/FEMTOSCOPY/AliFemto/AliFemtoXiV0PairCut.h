@@ -15,6 +15,8 @@ public:
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   virtual AliFemtoPairCut *Clone(); ///< Creates a new object with ALL the same attributes as the original
+  virtual void AddCounts(const AliFemtoPairCut* aCut);
+  virtual void ResetCounts();
   void SetDataType(AliFemtoDataType type);
 
   AliFemtoV0PairCut* GetV0PairCut(); //allows one to set fV0PairCut attributes, so no need to explicitly state here
@@ -62,4 +64,13 @@ inline AliFemtoV0PairCut* AliFemtoXiV0PairCut::GetV0PairCut() {return fV0PairCut
 inline void AliFemtoXiV0PairCut::SetMinAvgSepBacPos(double aMin) {fMinAvgSepBacPos = aMin;}
 inline void AliFemtoXiV0PairCut::SetMinAvgSepBacNeg(double aMin) {fMinAvgSepBacNeg = aMin;}
 
+inline void AliFemtoXiV0PairCut::AddCounts(const AliFemtoPairCut* aCut)
+{
+  if (const AliFemtoXiV0PairCut* tCut = dynamic_cast<const AliFemtoXiV0PairCut*>(aCut)) {
+    fNPairsPassed += tCut->fNPairsPassed;
+    fNPairsFailed += tCut->fNPairsFailed;
+  }
+}
+inline void AliFemtoXiV0PairCut::ResetCounts() { fNPairsPassed = 0; fNPairsFailed = 0; }
+
 #endif
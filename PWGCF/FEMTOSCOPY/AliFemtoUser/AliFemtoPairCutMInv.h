@@ -26,6 +26,8 @@ public:
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   AliFemtoPairCut* Clone();
+  virtual void AddCounts(const AliFemtoPairCut* aCut);
+  virtual void ResetCounts();
   
  protected:
   Double_t fNPairsFailed;
@@ -42,4 +44,13 @@ public:
 
 inline AliFemtoPairCut* AliFemtoPairCutMInv::Clone() { AliFemtoPairCutMInv* c = new AliFemtoPairCutMInv(*this); return c;}
 
+inline void AliFemtoPairCutMInv::AddCounts(const AliFemtoPairCut* aCut)
+{
+  if (const AliFemtoPairCutMInv* tCut = dynamic_cast<const AliFemtoPairCutMInv*>(aCut)) {
+    fNPairsPassed += tCut->fNPairsPassed;
+    fNPairsFailed += tCut->fNPairsFailed;
+  }
+}
+inline void AliFemtoPairCutMInv::ResetCounts() { fNPairsPassed = 0; fNPairsFailed = 0; }
+
 #endif
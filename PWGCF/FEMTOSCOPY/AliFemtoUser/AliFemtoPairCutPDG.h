@@ -27,6 +27,8 @@ public:
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   AliFemtoPairCut* Clone();
+  virtual void AddCounts(const AliFemtoPairCut* aCut);
+  virtual void ResetCounts();
   void SetMinSumPt(Double_t sumptmin);
   void SetMaxSumPt(Double_t sumptmax);
   void SetPDG1(Double_t pdg1);
@@ -48,4 +50,13 @@ public:
 
 inline AliFemtoPairCut* AliFemtoPairCutPDG::Clone() { AliFemtoPairCutPDG* c = new AliFemtoPairCutPDG(*this); return c;}
 
+inline void AliFemtoPairCutPDG::AddCounts(const AliFemtoPairCut* aCut)
+{
+  if (const AliFemtoPairCutPDG* tCut = dynamic_cast<const AliFemtoPairCutPDG*>(aCut)) {
+    fNPairsPassed += tCut->fNPairsPassed;
+    fNPairsFailed += tCut->fNPairsFailed;
+  }
+}
+inline void AliFemtoPairCutPDG::ResetCounts() { fNPairsPassed = 0; fNPairsFailed = 0; }
+
 #endif
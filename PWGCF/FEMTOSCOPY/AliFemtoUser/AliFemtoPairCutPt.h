@@ -27,6 +27,8 @@ public:
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   AliFemtoPairCut* Clone();
+  virtual void AddCounts(const AliFemtoPairCut* aCut);
+  virtual void ResetCounts();
 
   void SetMinSumPt(Double_t sumptmin);
   void SetMaxSumPt(Double_t sumptmax);
@@ -50,4 +52,13 @@ inline AliFemtoPairCut* AliFemtoPairCutPt::Clone()
   return c;
 }
 
+inline void AliFemtoPairCutPt::AddCounts(const AliFemtoPairCut* aCut)
+{
+  if (const AliFemtoPairCutPt* tCut = dynamic_cast<const AliFemtoPairCutPt*>(aCut)) {
+    fNPairsPassed += tCut->fNPairsPassed;
+    fNPairsFailed += tCut->fNPairsFailed;
+  }
+}
+inline void AliFemtoPairCutPt::ResetCounts() { fNPairsPassed = 0; fNPairsFailed = 0; }
+
 #endif
@@ -58,6 +58,8 @@ public:
   void Setqside(const float& lo, const float& hi);
   void Setqinv(const float& lo, const float& hi);
   AliFemtoQPairCut* Clone();
+  virtual void AddCounts(const AliFemtoPairCut* aCut);
+  virtual void ResetCounts();
 
 
 private:
@@ -85,4 +87,13 @@ inline void AliFemtoQPairCut::Setqout(const float& lo,const float& hi) {fQout[0]
 inline void AliFemtoQPairCut::Setqside(const float& lo,const float& hi){fQside[0]=lo; fQside[1]=hi;}
 inline void AliFemtoQPairCut::Setqinv(const float& lo,const float& hi) {fQinv[0]=lo;  fQinv[1]=hi;}
 
+inline void AliFemtoQPairCut::AddCounts(const AliFemtoPairCut* aCut)
+{
+  if (const AliFemtoQPairCut* tCut = dynamic_cast<const AliFemtoQPairCut*>(aCut)) {
+    fNPairsPassed += tCut->fNPairsPassed;
+    fNPairsFailed += tCut->fNPairsFailed;
+  }
+}
+inline void AliFemtoQPairCut::ResetCounts() { fNPairsPassed = 0; fNPairsFailed = 0; }
+
 #endif
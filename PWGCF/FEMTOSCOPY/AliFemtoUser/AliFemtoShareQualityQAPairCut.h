@@ -41,6 +41,8 @@ public:
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   virtual AliFemtoPairCut* Clone();
+  virtual void AddCounts(const AliFemtoPairCut* aCut);
+  virtual void ResetCounts();
   void SetShareQualityMax(Double_t aAliFemtoShareQualityMax);
   void SetShareQualitymin(Double_t aAliFemtoShareQualitymin);
   void SetShareQualityQASwitch(bool aSwitch);
@@ -97,4 +99,13 @@ inline AliFemtoShareQualityQAPairCut::AliFemtoShareQualityQAPairCut(const AliFem
 
 inline AliFemtoPairCut* AliFemtoShareQualityQAPairCut::Clone() { AliFemtoShareQualityQAPairCut* c = new AliFemtoShareQualityQAPairCut(*this); return c;}
 
+inline void AliFemtoShareQualityQAPairCut::AddCounts(const AliFemtoPairCut* aCut)
+{
+  if (const AliFemtoShareQualityQAPairCut* tCut = dynamic_cast<const AliFemtoShareQualityQAPairCut*>(aCut)) {
+    fNPairsPassed += tCut->fNPairsPassed;
+    fNPairsFailed += tCut->fNPairsFailed;
+  }
+}
+inline void AliFemtoShareQualityQAPairCut::ResetCounts() { fNPairsPassed = 0; fNPairsFailed = 0; }
+
 #endif
@@ -64,12 +64,15 @@ The names are available via the function PairClassName(Int_t i)
 #include "AliDielectronMC.h"
 #include "AliDielectronVarManager.h"
 #include "AliDielectronTrackRotator.h"
+#include "AliDielectronPairPreSelection.h"
 #include "AliDielectronDebugTree.h"
 #include "AliDielectronSignalMC.h"
 #include "AliDielectronMixingHandler.h"
 #include "AliDielectronPairLegCuts.h"
 #include "AliDielectronV0Cuts.h"
 #include "AliDielectronPID.h"
+#include "AliDielectronVarCuts.h"
+#include "AliDielectronCutGroup.h"
 #include "AliDielectronHistos.h"
 
 #include "AliDielectron.h"
@@ -133,9 +136,14 @@ AliDielectron::AliDielectron() :
   fHistoArray(0x0),
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
+  fColumnVars(new TBits(AliDielectronVarManager::kNMaxValues)),
+  fColumnList(),
+  fNColumns(0),
+  fColumns(),
   fPairCandidates(new TObjArray(11)),
   fCfManagerPair(0x0),
   fTrackRotator(0x0),
+  fPairPreSelection(0x0),
   fRotatePP(kFALSE),
   fRotateMM(kFALSE),
   fDebugTree(0x0),
@@ -208,9 +216,14 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fHistoArray(0x0),
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
+  fColumnVars(new TBits(AliDielectronVarManager::kNMaxValues)),
+  fColumnList(),
+  fNColumns(0),
+  fColumns(),
   fPairCandidates(new TObjArray(11)),
   fCfManagerPair(0x0),
   fTrackRotator(0x0),
+  fPairPreSelection(0x0),
   fRotatePP(kFALSE),
   fRotateMM(kFALSE),
   fDebugTree(0x0),
@@ -265,9 +278,11 @@ AliDielectron::~AliDielectron()
   if (fPairEffMap) delete fPairEffMap;
   if (fHistos) delete fHistos;
   if (fUsedVars) delete fUsedVars;
+  if (fColumnVars) delete fColumnVars;
   if (fPairCandidates && fEventProcess) delete fPairCandidates;
   if (fDebugTree) delete fDebugTree;
   if (fMixing) delete fMixing;
+  if (fPairPreSelection) delete fPairPreSelection;
   if (fSignalsMC) delete fSignalsMC;
   if (fCfManagerPair) delete fCfManagerPair;
   if (fHistoArray) delete fHistoArray;
@@ -300,6 +315,8 @@ void AliDielectron::Init()
     fTrackRotator->SetPdgLegs(fPdgLeg1,fPdgLeg2);
   }
   if (fDebugTree) fDebugTree->SetDielectron(this);
+  if (fPairPreSelection && (fCfManagerPair || fCutQA))
+    AliWarning("The pair pre-selection is not used together with the pair CF container or the cut QA");
 
   if(fEstimatorFilename.Contains(".root"))        AliDielectronVarManager::InitEstimatorAvg(fEstimatorFilename.Data());
   if(fEstimatorObjArray)			  AliDielectronVarManager::InitEstimatorObjArrayAvg(fEstimatorObjArray);
@@ -338,6 +355,77 @@ void AliDielectron::Init()
     (*fUsedVars)|= (*fHistos->GetUsedVars());
   }
 
+  // collect the variables of all cuts, histograms and CF containers
+  // and compile them into the list used by FillColumns
+  fColumnVars->ResetAllBits();
+  (*fColumnVars)|= (*fUsedVars);
+  AddColumnVars(fEventFilter);
+  AddColumnVars(fTrackFilter);
+  AddColumnVars(fPairPreFilter1);
+  AddColumnVars(fPairPreFilter2);
+  AddColumnVars(fPairPreFilterLegs1);
+  AddColumnVars(fPairPreFilterLegs2);
+  AddColumnVars(fPairFilter);
+  if (fCfManagerPair && fCfManagerPair->GetUsedVars()) (*fColumnVars)|= (*fCfManagerPair->GetUsedVars());
+  if (fDebugTree && fDebugTree->GetUsedVars()) (*fColumnVars)|= (*fDebugTree->GetUsedVars());
+  fColumnList.Set(AliDielectronVarManager::kNMaxValues);
+  fNColumns=AliDielectronVarManager::CompileFillList(fColumnVars, fColumnList.GetArray());
+}
+
+//________________________________________________________________
+void AliDielectron::AddColumnVars(AliAnalysisFilter &filter)
+{
+  //
+  // Add the variables of all cuts of the filter to the column variables
+  //
+  TIter nextCut(filter.GetCuts());
+  while (TObject *cut=nextCut()) AddColumnVars(cut);
+}
+
+//________________________________________________________________
+void AliDielectron::AddColumnVars(const TObject *cut)
+{
+  //
+  // Add the variables used by the cut to the column variables,
+  // cut groups and pair leg cuts are searched recursively
+  //
+  if (!cut) return;
+  const TBits *used=0x0;
+  if      (cut->InheritsFrom(AliDielectronVarCuts::Class())) used=static_cast<const AliDielectronVarCuts*>(cut)->GetUsedVars();
+  else if (cut->InheritsFrom(AliDielectronPID::Class()))     used=static_cast<const AliDielectronPID*>(cut)->GetUsedVars();
+  else if (cut->InheritsFrom(AliDielectronCutGroup::Class())) {
+    const AliDielectronCutGroup *group=static_cast<const AliDielectronCutGroup*>(cut);
+    for (Int_t icut=0; icut<group->GetNCuts(); ++icut) AddColumnVars(group->GetCut(icut));
+  }
+  else if (cut->InheritsFrom(AliDielectronPairLegCuts::Class())) {
+    AliDielectronPairLegCuts *legCuts=const_cast<AliDielectronPairLegCuts*>(static_cast<const AliDielectronPairLegCuts*>(cut));
+    AddColumnVars(legCuts->GetLeg1Filter());
+    AddColumnVars(legCuts->GetLeg2Filter());
+  }
+  if (used) (*fColumnVars)|= (*used);
+}
+
+//________________________________________________________________
+Int_t AliDielectron::GetColumnIndex(Int_t var) const
+{
+  //
+  // Index of the variable in the column buffer of FillColumns, -1 if not used
+  //
+  for (Int_t icol=0; icol<fNColumns; ++icol)
+    if (fColumnList.At(icol)==var) return icol;
+  return -1;
+}
+
+//________________________________________________________________
+void AliDielectron::FillColumns(const TObjArray *objects, Double_t * const columns) const
+{
+  //
+  // Evaluate only the variables used by the cuts, histograms and CF containers
+  // for all objects of the array. The buffer must hold GetNColumns()*N values,
+  // N=objects->GetEntriesFast(); variable GetColumnIndex(var) of object i is
+  // stored at columns[GetColumnIndex(var)*N+i]
+  //
+  AliDielectronVarManager::FillColumns(objects, fColumnVars, fColumnList.GetArray(), fNColumns, columns);
 }
 
 //________________________________________________________________
@@ -410,6 +498,10 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
   if(fPostPIDCntrdCorrTOF)  AliDielectronPID::SetCentroidCorrFunctionTOF(fPostPIDCntrdCorrTOF);
   if(fPostPIDWdthCorrTOF)   AliDielectronPID::SetWidthCorrFunctionTOF(fPostPIDWdthCorrTOF);
 
+  // the expensive track variables are only evaluated if one of the cuts,
+  // histograms or CF containers of this object reads them
+  AliDielectronVarManager::SetCompiledFillMap(fColumnVars);
+
   // set event
   AliDielectronVarManager::SetFillMap(fUsedVars);
   AliDielectronVarManager::SetEvent(ev1);
@@ -444,7 +536,10 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
   if(fCutQA) fQAmonitor->FillAll(ev1);
   if(fCutQA) fQAmonitor->Fill(cutmask,ev1);
   if ((ev1&&cutmask!=selectedMask) ||
-      (ev2&&fEventFilter.IsSelected(ev2)!=selectedMask)) return 0;
+      (ev2&&fEventFilter.IsSelected(ev2)!=selectedMask)) {
+    AliDielectronVarManager::SetCompiledFillMap(0x0);
+    return 0;
+  }
 
   //fill track arrays for the first event
   if (ev1){
@@ -538,6 +633,8 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
     }
   }
 
+  AliDielectronVarManager::SetCompiledFillMap(0x0);
+
   return 1;
 
 }
@@ -743,9 +840,13 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
       Bool_t mergedtrkClass=fHistos->GetHistogramList()->FindObject(className2.Data())!=0x0;
       Bool_t trkClass=fHistos->GetHistogramList()->FindObject(className.Data())!=0x0;
       if (!trkClass && !mergedtrkClass) continue;
+      // evaluate the compiled variables for the whole array at once
       Int_t ntracks=fTracks[i].GetEntriesFast();
+      if (fColumns.GetSize()<fNColumns*ntracks) fColumns.Set(fNColumns*ntracks);
+      FillColumns(&fTracks[i], fColumns.GetArray());
       for (Int_t itrack=0; itrack<ntracks; ++itrack){
-        AliDielectronVarManager::Fill(fTracks[i].UncheckedAt(itrack), values);
+        for (Int_t icol=0; icol<fNColumns; ++icol)
+          values[fColumnList.At(icol)]=fColumns.At(icol*ntracks+itrack);
         if(trkClass)
           fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
         if(mergedtrkClass && i<2)
@@ -1404,10 +1505,18 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
 
   UInt_t selectedMask=(1<<fPairFilter.GetCuts()->GetEntries())-1;
 
+  // the kinematic pre-selection skips combinations before the pair is built,
+  // not possible if the CF container or the cut QA need all candidates
+  const Bool_t preSelect=fPairPreSelection && !fCfManagerPair && !fCutQA;
+  if (preSelect) fPairPreSelection->Begin(arrTracks1, fPdgLeg1, arrTracks2, fPdgLeg2, ev ? ev->GetMagneticField() : 0.);
+
   for (Int_t itrack1=0; itrack1<ntrack1; ++itrack1){
     Int_t end=ntrack2;
     if (arr1==arr2) end=itrack1;
-    for (Int_t itrack2=0; itrack2<end; ++itrack2){
+    const Int_t nsel=preSelect ? fPairPreSelection->Select(itrack1, end) : end;
+    const Int_t *selected=preSelect ? fPairPreSelection->GetSelected() : 0x0;
+    for (Int_t isel=0; isel<nsel; ++isel){
+      const Int_t itrack2=selected ? selected[isel] : isel;
       //create the pair (direct pointer to the memory by this daughter reference are kept also for ME)
       candidate->SetTracks(&(*static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1))), fPdgLeg1,
                            &(*static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2))), fPdgLeg2);
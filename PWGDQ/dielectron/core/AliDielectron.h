@@ -18,6 +18,8 @@
 
 #include <TNamed.h>
 #include <TObjArray.h>
+#include <TArrayI.h>
+#include <TArrayD.h>
 #include <THnBase.h>
 #include <TSpline.h>
 
@@ -35,6 +37,7 @@ class THashList;
 class AliDielectronCF;
 class AliDielectronDebugTree;
 class AliDielectronTrackRotator;
+class AliDielectronPairPreSelection;
 class AliDielectronPair;
 class AliDielectronSignalMC;
 class AliDielectronMixingHandler;
@@ -108,6 +111,12 @@ public:
   void SetCFManagerPair(AliDielectronCF * const cf) { fCfManagerPair=cf; }
   AliDielectronCF* GetCFManagerPair() const { return fCfManagerPair; }
 
+  // variables of all cuts, histograms and CF containers, compiled at Init
+  const TBits* GetColumnVars() const { return fColumnVars; }
+  Int_t GetNColumns() const { return fNColumns; }
+  Int_t GetColumnIndex(Int_t var) const;
+  void  FillColumns(const TObjArray *objects, Double_t * const columns) const;
+
   void SetPreFilterEventPlane(Bool_t setValue=kTRUE){fPreFilterEventPlane=setValue;};
   void SetLikeSignSubEvents(Bool_t setValue=kTRUE){fLikeSignSubEvents=setValue;};
 
@@ -126,6 +135,9 @@ public:
   void SetTrackRotator(AliDielectronTrackRotator * const rot) { fTrackRotator=rot; }
   AliDielectronTrackRotator* GetTrackRotator() const { return fTrackRotator; }
 
+  void SetPairPreSelection(AliDielectronPairPreSelection * const presel) { fPairPreSelection=presel; }
+  AliDielectronPairPreSelection* GetPairPreSelection() const { return fPairPreSelection; }
+
   void SetRotatePP(Bool_t const rotate){ fRotatePP = rotate;}
   void SetRotateMM(Bool_t const rotate){ fRotateMM = rotate;}
 
@@ -229,6 +241,10 @@ private:
                                   //  Streaming and merging should be handled
                                   //  by the analysis framework
   TBits *fUsedVars;               // used variables
+  TBits *fColumnVars;             //! variables used by the cuts, histograms and CF containers
+  TArrayI fColumnList;            //! compiled list of the column variables
+  Int_t fNColumns;                //! number of column variables
+  TArrayD fColumns;               //! column buffer of the track histograms
 
   TObjArray fTracks[4];           //! Selected track candidates
                                   //  0: Event1, positive particles
@@ -241,6 +257,7 @@ private:
 
   AliDielectronCF *fCfManagerPair;//Correction Framework Manager for the Pair
   AliDielectronTrackRotator *fTrackRotator; //Track rotator
+  AliDielectronPairPreSelection *fPairPreSelection; //kinematic pre-selection of the leg combinations
   Bool_t fRotatePP; // combine rotated positive tracks
   Bool_t fRotateMM; // combine rotated negative tracks
   AliDielectronDebugTree *fDebugTree;  // Debug tree output
@@ -300,10 +317,13 @@ private:
 
   void  FillDebugTree();
 
+  void  AddColumnVars(const TObject *cut);
+  void  AddColumnVars(AliAnalysisFilter &filter);
+
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,17);
+  ClassDef(AliDielectron,18);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
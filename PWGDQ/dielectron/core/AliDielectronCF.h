@@ -75,6 +75,7 @@ public:
   void FillMC(Int_t label1, Int_t label2, Int_t nSignal);
 
   AliCFContainer* GetContainer() const { return fCfContainer; }
+  const TBits* GetUsedVars() const { return fUsedVars; }
   
 private:
   TBits     *fUsedVars;             // list of used variables
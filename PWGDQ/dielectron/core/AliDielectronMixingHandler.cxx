@@ -20,6 +20,22 @@
 /*
 Detailed description
 
+By default the events of each mixing bin are buffered as
+AliDielectronEvent copies in a TClonesArray ring.
+
+With SetUseCompactPool(kTRUE) the events are instead buffered in an
+AliDielectronMixingPool, which keeps only compact leg records and reuses
+their memory. SetMaxPoolMemory limits the memory of all buffered events;
+when it is reached the oldest events of all bins are dropped. The mixed
+legs are then rebuilt as AliAODTrack objects carrying the kinematics,
+covariance, charge and label of the original tracks only, so the pair
+and leg variables of the mixed pairs must not rely on other track
+information (e.g. PID). If a histogram manager is set, the pool
+occupancy, the number of mixed events and the memory use are filled in
+the class 'MixingPool'.
+
+  mix->SetUseCompactPool(kTRUE);
+  mix->SetMaxPoolMemory(200*1024*1024);  // 200 MB
 
 */
 //                                                                       //
@@ -27,6 +43,7 @@ Detailed description
 
 #include <TVectorD.h>
 #include <TH1.h>
+#include <TProfile.h>
 #include <TAxis.h>
 
 #include <AliLog.h>
@@ -36,6 +53,7 @@ Detailed description
 #include "AliDielectronHelper.h"
 #include "AliDielectronHistos.h"
 #include "AliDielectronEvent.h"
+#include "AliDielectronMixingPool.h"
 
 #include "AliDielectronMixingHandler.h"
 
@@ -50,7 +68,10 @@ AliDielectronMixingHandler::AliDielectronMixingHandler() :
   fMixIncomplete(kTRUE),
   fMoveToSameVertex(kFALSE),
   fSkipFirstEvt(kFALSE),
-  fPID(0x0)
+  fUseCompactPool(kFALSE),
+  fMaxPoolMemory(0),
+  fPID(0x0),
+  fPool(0x0)
 {
   //
   // Default Constructor
@@ -71,7 +92,10 @@ AliDielectronMixingHandler::AliDielectronMixingHandler(const char* name, const c
   fMixIncomplete(kTRUE),
   fMoveToSameVertex(kFALSE),
   fSkipFirstEvt(kFALSE),
-  fPID(0x0)
+  fUseCompactPool(kFALSE),
+  fMaxPoolMemory(0),
+  fPID(0x0),
+  fPool(0x0)
 {
   //
   // Named Constructor
@@ -90,6 +114,7 @@ AliDielectronMixingHandler::~AliDielectronMixingHandler()
   //
   fAxes.Delete();
   delete fPID;
+  delete fPool;
 }
 
 //________________________________________________________________
@@ -169,6 +194,25 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
     return;
   }
 
+  if (fPool){
+    // mix with the buffered events, then buffer the current one
+    DoMixing(bin,diele);
+    const Double_t vtx[3]={AliDielectronVarManager::GetValue(AliDielectronVarManager::kXvPrim),
+                           AliDielectronVarManager::GetValue(AliDielectronVarManager::kYvPrim),
+                           AliDielectronVarManager::GetValue(AliDielectronVarManager::kZvPrim)};
+    const ULong64_t nDropped=fPool->GetNDropped();
+    fPool->Store(bin, *diele->GetTrackArray(0), *diele->GetTrackArray(1), vtx);
+
+    if (diele->fHistos && diele->fHistos->GetHistogramList()->FindObject("MixingPool")){
+      AliDielectronHistos *histos=diele->fHistos;
+      histos->GetHistogram("MixingPool","Stats")->Fill(0);
+      histos->GetHistogram("MixingPool","Stats")->Fill(1,fPool->GetNDropped()-nDropped);
+      histos->GetHistogram("MixingPool","Occupancy")->Fill(bin,fPool->GetNEvents(bin));
+      histos->GetHistogram("MixingPool","Memory")->Fill(fPool->GetMemoryUsed()/1024./1024.);
+    }
+    return;
+  }
+
   // get mixing pool, create it if it does not yet exist.
   TClonesArray *poolp=static_cast<TClonesArray*>(fArrPools.At(bin));
 
@@ -267,7 +311,6 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
   // the event data are already the ones from the current event, no need to set them again
   // AliDielectronVarManager::SetEventData(ev1->GetEventData());
   
-  TObject *o=0x0;
   // Get the tracks arrays from the last event in dielectron, stored in the temp arrays
   // TIter ev1P(ev1->GetTrackArrayP());
   // TIter ev1N(ev1->GetTrackArrayN());
@@ -281,15 +324,7 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
     if (!ev2) continue;
     // if (!ev1 || !ev2 || ev1==ev2) continue;
     
-    //clear arryas
-    diele->fTracks[0].Clear();
-    diele->fTracks[1].Clear();
-    diele->fTracks[2].Clear();
-    diele->fTracks[3].Clear();
-
     //setup track arrays
-    ev1P.Reset();
-    ev1N.Reset();
     TIter ev2P(ev2->GetTrackArrayP());
     TIter ev2N(ev2->GetTrackArrayN());
 
@@ -323,30 +358,52 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
       ev2N.Reset();
     }
 
-    //mixing of ev1- ev2+ (pair type4). This is common for all mixing types
-    while ( (o=ev1N()) ) diele->fTracks[1].Add(o);
-    while ( (o=ev2P()) ) diele->fTracks[2].Add(o);
-    diele->FillPairArrays(1,2);
+    MixTracks(diele, ev1P, ev1N, ev2P, ev2N);
+  }
 
-    if (fMixType==kAll || fMixType==kOSandLS){
-      // all 4 pair arrays will be filled
-      while ( (o=ev1P()) ) diele->fTracks[0].Add(o);
-      while ( (o=ev2N()) ) diele->fTracks[3].Add(o);
-      diele->FillPairArrays(0,2);
-      diele->FillPairArrays(1,3);
-      if (fMixType==kAll) diele->FillPairArrays(0,3);
-    }
+  //copy back the tracks
+  for (Int_t i=0; i<4; ++i) {
+    diele->fTracks[i].Clear();
+    diele->fTracks[i]=arrTrDummy[i];
+  }
 
-    if (fMixType==kOSonly || fMixType==kOSandLS){
-      //use the pair type of ev1- ev1+ also for ev1+ ev1-
-      diele->fTracks[1].Clear();
-      diele->fTracks[2].Clear();
-      while ( (o=ev1P()) ) diele->fTracks[1].Add(o);
-      while ( (o=ev2N()) ) diele->fTracks[2].Add(o);
-      diele->FillPairArrays(1,2);
-    }
+  //set back global event values
+  AliDielectronVarManager::SetEventData(values);
+}
+
+//______________________________________________
+void AliDielectronMixingHandler::DoMixing(Int_t bin, AliDielectron *diele)
+{
+  //
+  // perform the mixing with the events of 'bin' in the compact pool
+  //
+
+  //buffer track arrays and copy them back afterwards
+  TObjArray arrTrDummy[4];
+  for (Int_t i=0; i<4; ++i) arrTrDummy[i]=diele->fTracks[i];
+
+  //buffer also global event data
+  Double_t values[AliDielectronVarManager::kNMaxValues]={0};
+  for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
+    values[i]=AliDielectronVarManager::GetValue((AliDielectronVarManager::ValueTypes)i);
+
+  //the pool moves the tracks to the vertex of the current event, if requested
+  const Double_t vFirst[3]={values[AliDielectronVarManager::kXvPrim],
+                            values[AliDielectronVarManager::kYvPrim],
+                            values[AliDielectronVarManager::kZvPrim]};
+  const Int_t nevents=fPool->LoadBin(bin, fMoveToSameVertex ? vFirst : 0x0);
+
+  TIter ev1P(&arrTrDummy[0]);
+  TIter ev1N(&arrTrDummy[1]);
+  for (Int_t i1=0; i1<nevents; ++i1){
+    TIter ev2P(fPool->GetTracksP(i1));
+    TIter ev2N(fPool->GetTracksN(i1));
+    MixTracks(diele, ev1P, ev1N, ev2P, ev2N);
   }
 
+  if (diele->fHistos && diele->fHistos->GetHistogramList()->FindObject("MixingPool"))
+    diele->fHistos->GetHistogram("MixingPool","Depth")->Fill(nevents);
+
   //copy back the tracks
   for (Int_t i=0; i<4; ++i) {
     diele->fTracks[i].Clear();
@@ -357,6 +414,48 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
   AliDielectronVarManager::SetEventData(values);
 }
 
+//______________________________________________
+void AliDielectronMixingHandler::MixTracks(AliDielectron *diele, TIter &ev1P, TIter &ev1N, TIter &ev2P, TIter &ev2N)
+{
+  //
+  // fill the mixed pairs of the current event (ev1) with one buffered event (ev2)
+  //
+  TObject *o=0x0;
+
+  //clear arryas
+  diele->fTracks[0].Clear();
+  diele->fTracks[1].Clear();
+  diele->fTracks[2].Clear();
+  diele->fTracks[3].Clear();
+
+  //setup track arrays
+  ev1P.Reset();
+  ev1N.Reset();
+
+  //mixing of ev1- ev2+ (pair type4). This is common for all mixing types
+  while ( (o=ev1N()) ) diele->fTracks[1].Add(o);
+  while ( (o=ev2P()) ) diele->fTracks[2].Add(o);
+  diele->FillPairArrays(1,2);
+
+  if (fMixType==kAll || fMixType==kOSandLS){
+    // all 4 pair arrays will be filled
+    while ( (o=ev1P()) ) diele->fTracks[0].Add(o);
+    while ( (o=ev2N()) ) diele->fTracks[3].Add(o);
+    diele->FillPairArrays(0,2);
+    diele->FillPairArrays(1,3);
+    if (fMixType==kAll) diele->FillPairArrays(0,3);
+  }
+
+  if (fMixType==kOSonly || fMixType==kOSandLS){
+    //use the pair type of ev1- ev1+ also for ev1+ ev1-
+    diele->fTracks[1].Clear();
+    diele->fTracks[2].Clear();
+    while ( (o=ev1P()) ) diele->fTracks[1].Add(o);
+    while ( (o=ev2N()) ) diele->fTracks[2].Add(o);
+    diele->FillPairArrays(1,2);
+  }
+}
+
 //______________________________________________
 Bool_t AliDielectronMixingHandler::MixRemaining(AliDielectron */*diele*/, Int_t /*ipool*/)
 {
@@ -413,7 +512,26 @@ void AliDielectronMixingHandler::Init(const AliDielectron *diele)
 
   AliDebug(10,Form("Creating a pool array with size %d \n",size));
 
-  if(diele && diele->DoEventProcess()) fArrPools.Expand(size);
+  if(diele && diele->DoEventProcess()) {
+    if (fUseCompactPool) {
+      delete fPool;
+      fPool=new AliDielectronMixingPool(size, fDepth, fMaxPoolMemory);
+    } else {
+      fArrPools.Expand(size);
+    }
+  }
+
+  //add pool statistics histograms if we have a histogram manager
+  if (fPool && diele->fHistos && !diele->fHistos->GetHistogramList()->FindObject("MixingPool")) {
+    diele->fHistos->AddClass("MixingPool");
+    TH1 *h=new TH1D("Stats","Mixing pool statistics;;#events",2,0,2);
+    h->GetXaxis()->SetBinLabel(1,"Stored");
+    h->GetXaxis()->SetBinLabel(2,"Dropped");
+    diele->fHistos->UserHistogram("MixingPool",h);
+    diele->fHistos->UserHistogram("MixingPool",new TProfile("Occupancy","Mixing pool occupancy;bin;#buffered events",size,0,size));
+    diele->fHistos->UserHistogram("MixingPool",new TH1D("Depth","Mixing depth;#mixed events;#events",fDepth+1,0,fDepth+1));
+    diele->fHistos->UserHistogram("MixingPool",new TH1D("Memory","Mixing pool memory;memory (MB);#events",200,0,(fMaxPoolMemory>0 ? fMaxPoolMemory/1024./1024. : 1000.)*1.05));
+  }
 
   //add statics histogram if we have a histogram manager
   //if (diele && diele->fHistos && diele->DoEventProcess()) {
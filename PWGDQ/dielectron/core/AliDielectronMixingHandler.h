@@ -20,6 +20,7 @@
 #include "AliDielectronVarManager.h"
 
 class AliDielectron;
+class AliDielectronMixingPool;
 class AliVTrack;
 class AliVEvent;
 
@@ -55,6 +56,14 @@ public:
 
   void SetSkipFirstEvent(Bool_t skip) { fSkipFirstEvt=skip; }
 
+  void SetUseCompactPool(Bool_t use)       { fUseCompactPool=use; }
+  Bool_t GetUseCompactPool() const         { return fUseCompactPool; }
+
+  void SetMaxPoolMemory(ULong64_t bytes)   { fMaxPoolMemory=bytes; }
+  ULong64_t GetMaxPoolMemory() const       { return fMaxPoolMemory; }
+
+  const AliDielectronMixingPool* GetPool() const { return fPool; }
+
   Int_t GetNumberOfBins() const;
   Int_t FindBin(const Double_t values[], TString *dim=0x0);
   void Fill(const AliVEvent *ev, AliDielectron *diele);
@@ -77,15 +86,21 @@ private:
   Bool_t fMoveToSameVertex; //whether to move the mixed tracks to the same vertex position
   Bool_t fSkipFirstEvt;   //whether to skip the first event in the pool
 
+  Bool_t    fUseCompactPool; // whether to buffer the events in the compact pool
+  ULong64_t fMaxPoolMemory;  // memory budget of the compact pool in bytes, 0 for none
+
   TProcessID *fPID;             //! internal PID for references to buffered objects
+  AliDielectronMixingPool *fPool; //! compact event pool
   
   void DoMixing(TClonesArray &pool, AliDielectron *diele);
+  void DoMixing(Int_t bin, AliDielectron *diele);
+  void MixTracks(AliDielectron *diele, TIter &ev1P, TIter &ev1N, TIter &ev2P, TIter &ev2N);
 
   AliDielectronMixingHandler(const AliDielectronMixingHandler &c);
   AliDielectronMixingHandler &operator=(const AliDielectronMixingHandler &c);
 
   
-  ClassDef(AliDielectronMixingHandler,1)         // Dielectron MixingHandler
+  ClassDef(AliDielectronMixingHandler,2)         // Dielectron MixingHandler
 };
 
 
@@ -0,0 +1,244 @@
+/*************************************************************************
+* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+///////////////////////////////////////////////////////////////////////////
+//                Dielectron MixingPool                                  //
+//                                                                       //
+//                                                                       //
+/*
+Event buffer of AliDielectronMixingHandler in compact mode.
+
+Instead of a copy of every AliESDtrack / AliAODTrack (and its vertex) in
+an AliDielectronEvent, only the information needed to rebuild the
+AliKFParticle of a pair leg is kept per track as a float record:
+position, momentum, covariance, charge, label and ID. The events of a
+mixing bin are a ring of 'depth' slots; a full ring overwrites the slot
+of its oldest event in place, so once the slots have grown to the
+typical event size no memory is allocated any more.
+
+A memory budget for all slots can be set. If storing an event would
+exceed it, the oldest events of all bins are dropped until it fits.
+
+For the mixing, LoadBin fills reused AliAODTrack objects from the records
+of all events of a bin (newest first). These tracks carry only the
+stored information, so cuts and histograms of mixed pairs can only use
+the pair and leg kinematics. The tracks stay valid until the next call.
+
+*/
+//                                                                       //
+///////////////////////////////////////////////////////////////////////////
+
+#include <AliVTrack.h>
+#include <AliAODTrack.h>
+
+#include "AliDielectronMixingPool.h"
+
+AliDielectronMixingPool::AliDielectronMixingPool(Int_t nbins, UShort_t depth, ULong64_t maxBytes) :
+  fNBins(nbins>0 ? nbins : 1),
+  fDepth(depth>0 ? depth : 1),
+  fMaxBytes(maxBytes),
+  fUsedBytes(0),
+  fSequence(0),
+  fNDropped(0),
+  fSlots(),
+  fHead(),
+  fTracks(),
+  fViewP(),
+  fViewN()
+{
+  //
+  // Constructor, the slots get their memory with the first events
+  //
+  Slot empty;
+  empty.fNP=0;
+  empty.fVertex[0]=empty.fVertex[1]=empty.fVertex[2]=0.;
+  empty.fSequence=0;
+  fSlots.assign((size_t)fNBins*fDepth, empty);
+  fHead.assign(fNBins, 0);
+  fViewP.resize(fDepth);
+  fViewN.resize(fDepth);
+}
+
+//______________________________________________
+AliDielectronMixingPool::~AliDielectronMixingPool()
+{
+  //
+  // Destructor
+  //
+  for (size_t i=0; i<fTracks.size(); ++i) delete fTracks[i];
+}
+
+//______________________________________________
+void AliDielectronMixingPool::FillLeg(Leg &leg, const AliVTrack *track)
+{
+  //
+  // copy the track information into the record
+  //
+  Double_t x[3]={0.}, p[3]={0.}, cov[21]={0.};
+  track->GetXYZ(x);
+  track->PxPyPz(p);
+  track->GetCovarianceXYZPxPyPz(cov);
+  for (Int_t i=0; i<3; ++i)  { leg.fX[i]=x[i]; leg.fP[i]=p[i]; }
+  for (Int_t i=0; i<21; ++i) leg.fCov[i]=cov[i];
+  leg.fLabel=track->GetLabel();
+  leg.fID=track->GetID();
+  leg.fCharge=track->Charge();
+}
+
+//______________________________________________
+void AliDielectronMixingPool::FillTrack(AliAODTrack *track, const Leg &leg, Double_t dz) const
+{
+  //
+  // set the reused track from the record, moving it by dz along the beam axis
+  //
+  const Double_t x[3]={leg.fX[0], leg.fX[1], leg.fX[2]-dz};
+  const Double_t p[3]={leg.fP[0], leg.fP[1], leg.fP[2]};
+  Double_t cov[21];
+  for (Int_t i=0; i<21; ++i) cov[i]=leg.fCov[i];
+  track->SetPosition(x, kFALSE);
+  track->SetP(p, kTRUE);
+  track->SetCovMatrix(cov);
+  track->SetCharge(leg.fCharge);
+  track->SetLabel(leg.fLabel);
+  track->SetID(leg.fID);
+}
+
+//______________________________________________
+void AliDielectronMixingPool::Release(Slot &slot)
+{
+  //
+  // drop the event and free its memory
+  //
+  fUsedBytes-=slot.fLegs.capacity()*sizeof(Leg);
+  std::vector<Leg>().swap(slot.fLegs);
+  slot.fNP=0;
+  slot.fSequence=0;
+}
+
+//______________________________________________
+Bool_t AliDielectronMixingPool::DropOldest()
+{
+  //
+  // drop the oldest event of all bins, return kFALSE if there is none
+  //
+  Slot *oldest=0x0;
+  for (size_t i=0; i<fSlots.size(); ++i){
+    if (fSlots[i].fSequence && (!oldest || fSlots[i].fSequence<oldest->fSequence)) oldest=&fSlots[i];
+  }
+  if (!oldest) return kFALSE;
+  Release(*oldest);
+  ++fNDropped;
+  return kTRUE;
+}
+
+//______________________________________________
+void AliDielectronMixingPool::Store(Int_t bin, const TObjArray &arrP, const TObjArray &arrN, const Double_t vertex[3])
+{
+  //
+  // store the tracks of the event in the slot of the oldest event of the bin
+  //
+  if (bin<0 || bin>=fNBins) return;
+
+  Slot &slot=fSlots[(size_t)bin*fDepth+fHead[bin]];
+  slot.fSequence=0;
+
+  const Int_t nP=arrP.GetEntriesFast();
+  const Int_t nN=arrN.GetEntriesFast();
+  const size_t need=nP+nN;
+
+  // make room within the budget, the slot itself keeps its memory
+  if (need>slot.fLegs.capacity()){
+    const ULong64_t extra=(need-slot.fLegs.capacity())*sizeof(Leg);
+    while (fMaxBytes>0 && fUsedBytes+extra>fMaxBytes && DropOldest()) { }
+  }
+
+  fUsedBytes-=slot.fLegs.capacity()*sizeof(Leg);
+  slot.fLegs.resize(need);
+  fUsedBytes+=slot.fLegs.capacity()*sizeof(Leg);
+
+  Int_t ileg=0;
+  for (Int_t itrack=0; itrack<nP; ++itrack)
+    FillLeg(slot.fLegs[ileg++], static_cast<const AliVTrack*>(arrP.UncheckedAt(itrack)));
+  for (Int_t itrack=0; itrack<nN; ++itrack)
+    FillLeg(slot.fLegs[ileg++], static_cast<const AliVTrack*>(arrN.UncheckedAt(itrack)));
+
+  slot.fNP=nP;
+  for (Int_t i=0; i<3; ++i) slot.fVertex[i]=vertex[i];
+  slot.fSequence=++fSequence;
+  fHead[bin]=(fHead[bin]+1)%fDepth;
+}
+
+//______________________________________________
+Int_t AliDielectronMixingPool::LoadBin(Int_t bin, const Double_t *vertex)
+{
+  //
+  // fill the track arrays of all events of the bin, newest first
+  // if vertex is given, the tracks are moved to the same z vertex
+  // return the number of events
+  //
+  if (bin<0 || bin>=fNBins) return 0;
+
+  Int_t nevents=0;
+  size_t itrack=0;
+  for (Int_t k=0; k<fDepth; ++k){
+    const Slot &slot=fSlots[(size_t)bin*fDepth+(fHead[bin]+fDepth-1-k)%fDepth];
+    // older events were dropped or not stored yet
+    if (!slot.fSequence) break;
+
+    const Double_t dz=vertex ? slot.fVertex[2]-vertex[2] : 0.;
+    const Int_t nlegs=slot.fLegs.size();
+    while (fTracks.size()<itrack+nlegs) fTracks.push_back(new AliAODTrack);
+
+    TObjArray &arrP=fViewP[nevents];
+    TObjArray &arrN=fViewN[nevents];
+    arrP.Clear();
+    arrN.Clear();
+    for (Int_t ileg=0; ileg<nlegs; ++ileg){
+      AliAODTrack *track=fTracks[itrack++];
+      FillTrack(track, slot.fLegs[ileg], dz);
+      if (ileg<slot.fNP) arrP.Add(track);
+      else arrN.Add(track);
+    }
+    ++nevents;
+  }
+  return nevents;
+}
+
+//______________________________________________
+Int_t AliDielectronMixingPool::GetNEvents(Int_t bin) const
+{
+  //
+  // number of events stored in the bin
+  //
+  Int_t n=0;
+  for (Int_t r=0; bin>=0 && bin<fNBins && r<fDepth; ++r){
+    if (fSlots[(size_t)bin*fDepth+r].fSequence) ++n;
+  }
+  return n;
+}
+
+//______________________________________________
+void AliDielectronMixingPool::Clear()
+{
+  //
+  // drop all events and free their memory
+  //
+  for (size_t i=0; i<fSlots.size(); ++i) Release(fSlots[i]);
+  fHead.assign(fNBins, 0);
+  for (Int_t k=0; k<fDepth; ++k){
+    fViewP[k].Clear();
+    fViewN[k].Clear();
+  }
+}
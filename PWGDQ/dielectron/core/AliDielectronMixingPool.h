@@ -0,0 +1,84 @@
+#ifndef ALIDIELECTRONMIXINGPOOL_H
+#define ALIDIELECTRONMIXINGPOOL_H
+
+/* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//#############################################################
+//#                                                           #
+//#         Class AliDielectronMixingPool                     #
+//#                                                           #
+//#  Compact event buffer for AliDielectronMixingHandler      #
+//#                                                           #
+//#############################################################
+
+#include <vector>
+
+#include <TObjArray.h>
+
+class AliAODTrack;
+class AliVTrack;
+
+class AliDielectronMixingPool {
+public:
+  AliDielectronMixingPool(Int_t nbins, UShort_t depth, ULong64_t maxBytes=0);
+  ~AliDielectronMixingPool();
+
+  void  Store(Int_t bin, const TObjArray &arrP, const TObjArray &arrN, const Double_t vertex[3]);
+  Int_t LoadBin(Int_t bin, const Double_t *vertex=0x0);
+
+  const TObjArray* GetTracksP(Int_t ievent) const { return &fViewP[ievent]; }
+  const TObjArray* GetTracksN(Int_t ievent) const { return &fViewN[ievent]; }
+
+  Int_t     GetNBins() const       { return fNBins; }
+  UShort_t  GetDepth() const       { return fDepth; }
+  Int_t     GetNEvents(Int_t bin) const;
+  ULong64_t GetMemoryUsed() const  { return fUsedBytes; }
+  ULong64_t GetMaxMemory() const   { return fMaxBytes; }
+  ULong64_t GetNDropped() const    { return fNDropped; }
+
+  void Clear();
+
+private:
+  // leg information needed to rebuild the AliKFParticle of the pair
+  struct Leg {
+    Float_t fX[3];        // position
+    Float_t fP[3];        // momentum
+    Float_t fCov[21];     // covariance in (x,y,z,px,py,pz)
+    Int_t   fLabel;       // MC label
+    Int_t   fID;          // track ID
+    Short_t fCharge;      // charge
+  };
+
+  // one buffered event, reused in place
+  struct Slot {
+    std::vector<Leg> fLegs;   // positive legs, then negative legs
+    Int_t     fNP;            // number of positive legs
+    Double_t  fVertex[3];     // primary vertex
+    ULong64_t fSequence;      // insertion number, 0 if empty
+  };
+
+  Int_t     fNBins;                   // number of mixing bins
+  UShort_t  fDepth;                   // events per bin
+  ULong64_t fMaxBytes;                // memory budget of all events, 0 for none
+  ULong64_t fUsedBytes;               // memory of all events
+  ULong64_t fSequence;                // insertion counter
+  ULong64_t fNDropped;                // events dropped for the memory budget
+
+  std::vector<Slot>   fSlots;         // slot r of bin b at b*fDepth+r
+  std::vector<UShort_t> fHead;        // ring position of the next event per bin
+
+  std::vector<AliAODTrack*> fTracks;  // tracks filled from the legs by LoadBin
+  std::vector<TObjArray>    fViewP;   // positive tracks of the loaded events
+  std::vector<TObjArray>    fViewN;   // negative tracks of the loaded events
+
+  static void FillLeg(Leg &leg, const AliVTrack *track);
+  void FillTrack(AliAODTrack *track, const Leg &leg, Double_t dz) const;
+  void Release(Slot &slot);
+  Bool_t DropOldest();
+
+  AliDielectronMixingPool(const AliDielectronMixingPool &c);
+  AliDielectronMixingPool &operator=(const AliDielectronMixingPool &c);
+};
+
+#endif
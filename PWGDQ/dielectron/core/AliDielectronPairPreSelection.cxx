@@ -0,0 +1,240 @@
+/*************************************************************************
+* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+///////////////////////////////////////////////////////////////////////////
+//                Dielectron PairPreSelection                            //
+//                                                                       //
+//                                                                       //
+/*
+First stage of the pair building in AliDielectron::FillPairArrays.
+
+The momenta, energies and charges of the legs are copied into flat
+arrays once per track array combination. For every leg1 the pair mass,
+the opening angle and phiv are then computed for all leg2 candidates
+in one plain loop over these arrays, which the compiler vectorises, and
+the pre-cuts are applied. Only the selected combinations are turned into
+AliDielectronPair objects and passed to the pair cuts.
+
+The pre-cuts use the track momenta and the PDG masses of the legs, not
+the KF pair, so they should be chosen somewhat looser than the
+corresponding pair cuts; they only have to reject pairs which would not
+pass the pair cuts anyway. All pairs still have to pass the pair filter.
+
+  AliDielectronPairPreSelection *presel=new AliDielectronPairPreSelection("presel","presel");
+  presel->SetMassRange(0.,5.);
+  presel->SetPhivRejection(2.,0.05);  // reject phiv>2 for m<0.05 GeV/c^2
+  die->SetPairPreSelection(presel);
+
+*/
+//                                                                       //
+///////////////////////////////////////////////////////////////////////////
+
+#include <TMath.h>
+#include <TObjArray.h>
+#include <TDatabasePDG.h>
+
+#include <AliVTrack.h>
+
+#include "AliDielectronPairPreSelection.h"
+
+ClassImp(AliDielectronPairPreSelection)
+
+AliDielectronPairPreSelection::AliDielectronPairPreSelection() :
+  TNamed(),
+  fMassMin(0.),
+  fMassMax(-1.),
+  fOpeningAngleMin(0.),
+  fOpeningAngleMax(-1.),
+  fPhivMin(0.),
+  fPhivMassMax(-1.),
+  fMagField(0.),
+  fMass1(0.),
+  fMass2(0.),
+  fPx1(),
+  fPy1(),
+  fPz1(),
+  fE1(),
+  fP1(),
+  fQ1(),
+  fPx2(),
+  fPy2(),
+  fPz2(),
+  fE2(),
+  fP2(),
+  fQ2(),
+  fPass(),
+  fSelected(),
+  fNCandidates(0),
+  fNSelected(0)
+{
+  //
+  // Default Constructor
+  //
+}
+
+//______________________________________________
+AliDielectronPairPreSelection::AliDielectronPairPreSelection(const char* name, const char* title) :
+  TNamed(name, title),
+  fMassMin(0.),
+  fMassMax(-1.),
+  fOpeningAngleMin(0.),
+  fOpeningAngleMax(-1.),
+  fPhivMin(0.),
+  fPhivMassMax(-1.),
+  fMagField(0.),
+  fMass1(0.),
+  fMass2(0.),
+  fPx1(),
+  fPy1(),
+  fPz1(),
+  fE1(),
+  fP1(),
+  fQ1(),
+  fPx2(),
+  fPy2(),
+  fPz2(),
+  fE2(),
+  fP2(),
+  fQ2(),
+  fPass(),
+  fSelected(),
+  fNCandidates(0),
+  fNSelected(0)
+{
+  //
+  // Named Constructor
+  //
+}
+
+//______________________________________________
+AliDielectronPairPreSelection::~AliDielectronPairPreSelection()
+{
+  //
+  // Default Destructor
+  //
+}
+
+//______________________________________________
+void AliDielectronPairPreSelection::FillArrays(const TObjArray &arr, Double_t mass,
+                                               std::vector<Double_t> &px, std::vector<Double_t> &py, std::vector<Double_t> &pz,
+                                               std::vector<Double_t> &e, std::vector<Double_t> &p, std::vector<Double_t> &q)
+{
+  //
+  // copy the leg kinematics of the track array into the flat arrays
+  //
+  const Int_t ntracks=arr.GetEntriesFast();
+  px.resize(ntracks); py.resize(ntracks); pz.resize(ntracks);
+  e.resize(ntracks);  p.resize(ntracks);  q.resize(ntracks);
+  for (Int_t itrack=0; itrack<ntracks; ++itrack){
+    const AliVTrack *track=static_cast<const AliVTrack*>(arr.UncheckedAt(itrack));
+    px[itrack]=track->Px();
+    py[itrack]=track->Py();
+    pz[itrack]=track->Pz();
+    const Double_t p2=px[itrack]*px[itrack]+py[itrack]*py[itrack]+pz[itrack]*pz[itrack];
+    p[itrack]=TMath::Sqrt(p2);
+    e[itrack]=TMath::Sqrt(p2+mass*mass);
+    q[itrack]=track->Charge();
+  }
+}
+
+//______________________________________________
+void AliDielectronPairPreSelection::Begin(const TObjArray &arr1, Int_t pdgLeg1, const TObjArray &arr2, Int_t pdgLeg2, Double_t magField)
+{
+  //
+  // set up the arrays for the combinations of the two track arrays
+  //
+  TParticlePDG *part1=TDatabasePDG::Instance()->GetParticle(pdgLeg1);
+  TParticlePDG *part2=TDatabasePDG::Instance()->GetParticle(pdgLeg2);
+  fMass1=part1 ? part1->Mass() : 0.;
+  fMass2=part2 ? part2->Mass() : 0.;
+  fMagField=magField;
+
+  FillArrays(arr1, fMass1, fPx1, fPy1, fPz1, fE1, fP1, fQ1);
+  FillArrays(arr2, fMass2, fPx2, fPy2, fPz2, fE2, fP2, fQ2);
+
+  const Int_t nmax=arr2.GetEntriesFast();
+  if ((Int_t)fPass.size()<nmax) {
+    fPass.resize(nmax);
+    fSelected.resize(nmax);
+  }
+}
+
+//______________________________________________
+Int_t AliDielectronPairPreSelection::Select(Int_t itrack1, Int_t end)
+{
+  //
+  // apply the pre-cuts to the combinations of leg1 itrack1 with the leg2 candidates [0,end)
+  // return the number of selected combinations, their leg2 indices are in GetSelected()
+  //
+  if (end<=0) return 0;
+
+  const Double_t px1=fPx1[itrack1], py1=fPy1[itrack1], pz1=fPz1[itrack1];
+  const Double_t e1=fE1[itrack1], p1=fP1[itrack1];
+  const Double_t massSq12=fMass1*fMass1+fMass2*fMass2;
+
+  // cut values are turned into limits on mass^2, cos(opening angle) and cos(phiv)
+  const Bool_t cutMass=fMassMax>fMassMin;
+  const Double_t massSqMin=(cutMass && fMassMin>0.) ? fMassMin*fMassMin : -1.e30;
+  const Double_t massSqMax=cutMass ? fMassMax*fMassMax : 1.e30;
+  const Bool_t cutAngle=fOpeningAngleMax>fOpeningAngleMin;
+  const Double_t cosAngleMax=cutAngle ? TMath::Cos(fOpeningAngleMin) :  2.;
+  const Double_t cosAngleMin=cutAngle ? TMath::Cos(fOpeningAngleMax) : -2.;
+  const Bool_t cutPhiv=(fPhivMassMax>0.) && (fMagField!=0.);
+  const Double_t cosPhivMax=TMath::Cos(fPhivMin);
+  const Double_t phivMassSqMax=fPhivMassMax*fPhivMassMax;
+
+  const Double_t *px2=fPx2.data(), *py2=fPy2.data(), *pz2=fPz2.data();
+  const Double_t *e2=fE2.data(), *p2=fP2.data(), *q2=fQ2.data();
+  Char_t *pass=fPass.data();
+
+  for (Int_t j=0; j<end; ++j){
+    const Double_t dot=px1*px2[j]+py1*py2[j]+pz1*pz2[j];
+    const Double_t massSq=massSq12+2.*(e1*e2[j]-dot);
+    const Double_t cosAngle=dot/(p1*p2[j]);
+
+    // comparisons are written as rejections, undefined (nan) values are kept
+    Bool_t reject=(massSq<massSqMin) || (massSq>massSqMax) ||
+                  (cosAngle>cosAngleMax) || (cosAngle<cosAngleMin);
+
+    if (cutPhiv){
+      // see AliDielectronPair::PhivPair, the leg order depends on the charges and the field
+      const Double_t px=px1+px2[j], py=py1+py2[j], pz=pz1+pz2[j];
+      const Double_t pl=TMath::Sqrt(px*px+py*py+pz*pz);
+      const Double_t ux=px/pl, uy=py/pl, uz=pz/pl;
+      const Double_t ut=TMath::Sqrt(ux*ux+uy*uy);
+      const Double_t ax=uy/ut, ay=-ux/ut;
+      const Double_t vpx=py1*pz2[j]-pz1*py2[j];
+      const Double_t vpy=pz1*px2[j]-px1*pz2[j];
+      const Double_t vpz=px1*py2[j]-py1*px2[j];
+      const Double_t vp=TMath::Sqrt(vpx*vpx+vpy*vpy+vpz*vpz);
+      const Double_t vx=vpx/vp, vy=vpy/vp, vz=vpz/vp;
+      const Double_t wx=uy*vz-uz*vy;
+      const Double_t wy=uz*vx-ux*vz;
+      const Double_t order=(q2[j]*fMagField<0.) ? 1. : -1.;
+      const Double_t cosPhiv=order*(wx*ax+wy*ay);
+      reject=reject || ((cosPhiv<=cosPhivMax) && (massSq<phivMassSqMax));
+    }
+    pass[j]=!reject;
+  }
+
+  Int_t nsel=0;
+  for (Int_t j=0; j<end; ++j){
+    if (pass[j]) fSelected[nsel++]=j;
+  }
+
+  fNCandidates+=end;
+  fNSelected+=nsel;
+  return nsel;
+}
@@ -0,0 +1,90 @@
+#ifndef ALIDIELECTRONPAIRPRESELECTION_H
+#define ALIDIELECTRONPAIRPRESELECTION_H
+
+/* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//#############################################################
+//#                                                           #
+//#         Class AliDielectronPairPreSelection               #
+//#                                                           #
+//#  Cheap kinematic pre-selection of leg combinations        #
+//#  before the AliDielectronPair objects are built           #
+//#                                                           #
+//#############################################################
+
+#include <vector>
+
+#include <TNamed.h>
+
+class TObjArray;
+
+class AliDielectronPairPreSelection : public TNamed {
+public:
+  AliDielectronPairPreSelection();
+  AliDielectronPairPreSelection(const char*name, const char* title);
+
+  virtual ~AliDielectronPairPreSelection();
+
+  //Setters
+  void SetMassRange(Double_t min, Double_t max)          { fMassMin=min; fMassMax=max; }
+  void SetOpeningAngleRange(Double_t min, Double_t max)  { fOpeningAngleMin=min; fOpeningAngleMax=max; }
+  void SetPhivRejection(Double_t phivMin, Double_t massMax) { fPhivMin=phivMin; fPhivMassMax=massMax; }
+
+  //Getters
+  Double_t GetMassMin() const         { return fMassMin; }
+  Double_t GetMassMax() const         { return fMassMax; }
+  Double_t GetOpeningAngleMin() const { return fOpeningAngleMin; }
+  Double_t GetOpeningAngleMax() const { return fOpeningAngleMax; }
+  Double_t GetPhivMin() const         { return fPhivMin; }
+  Double_t GetPhivMassMax() const     { return fPhivMassMax; }
+
+  void  Begin(const TObjArray &arr1, Int_t pdgLeg1, const TObjArray &arr2, Int_t pdgLeg2, Double_t magField);
+  Int_t Select(Int_t itrack1, Int_t end);
+  const Int_t* GetSelected() const { return fSelected.data(); }
+
+  Long64_t GetNCandidates() const { return fNCandidates; }
+  Long64_t GetNSelected() const   { return fNSelected; }
+
+private:
+  Double_t fMassMin;                // minimum pair mass
+  Double_t fMassMax;                // maximum pair mass
+  Double_t fOpeningAngleMin;        // minimum opening angle
+  Double_t fOpeningAngleMax;        // maximum opening angle
+  Double_t fPhivMin;                // pairs with phiv above ...
+  Double_t fPhivMassMax;            // ... and mass below are rejected
+
+  Double_t fMagField;               //! magnetic field of the current event
+  Double_t fMass1;                  //! mass of leg1
+  Double_t fMass2;                  //! mass of leg2
+
+  std::vector<Double_t> fPx1;       //! leg1 px
+  std::vector<Double_t> fPy1;       //! leg1 py
+  std::vector<Double_t> fPz1;       //! leg1 pz
+  std::vector<Double_t> fE1;        //! leg1 energy
+  std::vector<Double_t> fP1;        //! leg1 momentum
+  std::vector<Double_t> fQ1;        //! leg1 charge
+  std::vector<Double_t> fPx2;       //! leg2 px
+  std::vector<Double_t> fPy2;       //! leg2 py
+  std::vector<Double_t> fPz2;       //! leg2 pz
+  std::vector<Double_t> fE2;        //! leg2 energy
+  std::vector<Double_t> fP2;        //! leg2 momentum
+  std::vector<Double_t> fQ2;        //! leg2 charge
+
+  std::vector<Char_t> fPass;        //! pass flag of the current row
+  std::vector<Int_t>  fSelected;    //! selected leg2 indices of the current row
+
+  Long64_t fNCandidates;            //! number of tested leg combinations
+  Long64_t fNSelected;              //! number of selected leg combinations
+
+  static void FillArrays(const TObjArray &arr, Double_t mass,
+                         std::vector<Double_t> &px, std::vector<Double_t> &py, std::vector<Double_t> &pz,
+                         std::vector<Double_t> &e, std::vector<Double_t> &p, std::vector<Double_t> &q);
+
+  AliDielectronPairPreSelection(const AliDielectronPairPreSelection &c);
+  AliDielectronPairPreSelection &operator=(const AliDielectronPairPreSelection &c);
+
+  ClassDef(AliDielectronPairPreSelection,1)         // Dielectron pair pre-selection
+};
+
+#endif
@@ -78,6 +78,7 @@ public:
   const char*  GetCutName(Int_t iCut) const;
   Bool_t       IsCutOnVariableX(Int_t iCut, Int_t varNumber) const;
   Int_t        GetCutLimits(Int_t iCut, Double_t &cutMin, Double_t &cutMax) const;
+  const TBits* GetUsedVars() const { return fUsedVars; }
 
 
  private:
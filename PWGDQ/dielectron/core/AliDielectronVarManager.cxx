@@ -656,6 +656,9 @@ TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
 TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
 TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
 TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
+TBits*          AliDielectronVarManager::fgCompiledFillMap  = 0x0;
+TBits*          AliDielectronVarManager::fgLegEffVars       = 0x0;
+TBits*          AliDielectronVarManager::fgLegEffFillMap    = 0x0;
 Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
 TString         AliDielectronVarManager::fgVZEROCalibrationFile = "";
 TString         AliDielectronVarManager::fgVZERORecenteringFile = "";
@@ -750,3 +753,74 @@ UInt_t AliDielectronVarManager::GetValueType(const char* valname) {
   }
   return -1;
 }
+
+//________________________________________________________________
+Int_t AliDielectronVarManager::CompileFillList(const TBits *map, Int_t * const list)
+{
+  //
+  // Convert the variable map into the ordered list of variable indices
+  // used for FillColumns; list must hold kNMaxValues entries.
+  // Returns the number of variables.
+  //
+  if (!map) return 0;
+  const UInt_t nbits=TMath::Min(map->GetNbits(),(UInt_t)kNMaxValues);
+  Int_t nvars=0;
+  for (UInt_t ivar=map->FirstSetBit(); ivar<nbits; ivar=map->FirstSetBit(ivar+1))
+    list[nvars++]=ivar;
+  return nvars;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::FillColumns(const TObjArray *objects, TBits *map, const Int_t * const list, Int_t nvars, Double_t * const columns)
+{
+  //
+  // Fill the variables of list (see CompileFillList) for all objects of the array.
+  // Only the variables requested in map are evaluated. The values are stored
+  // column-wise: variable list[ivar] of object iobj goes to columns[ivar*nobj+iobj],
+  // with nobj=objects->GetEntriesFast(). Empty slots of the array give zeros.
+  //
+  if (!objects) return;
+  const Int_t nobj=objects->GetEntriesFast();
+
+  TBits *oldMap=fgFillMap;
+  fgFillMap=map;
+
+  Double_t values[kNMaxValues];
+  for (Int_t iobj=0; iobj<nobj; ++iobj) {
+    const TObject *obj=objects->UncheckedAt(iobj);
+    if (!obj) {
+      for (Int_t ivar=0; ivar<nvars; ++ivar) columns[ivar*nobj+iobj]=0.;
+      continue;
+    }
+    Fill(obj, values);
+    for (Int_t ivar=0; ivar<nvars; ++ivar) columns[ivar*nobj+iobj]=values[list[ivar]];
+  }
+
+  fgFillMap=oldMap;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::SetLegEffMap(TObject *map)
+{
+  //
+  // Set the single leg efficiency map. The variables on its axes are
+  // filled for a track whenever kLegEff or kOneOverLegEff is requested
+  //
+  if (map==fgLegEffMap) return;
+  fgLegEffMap=map;
+
+  if (!fgLegEffVars) {
+    fgLegEffVars=new TBits(kNMaxValues);
+    fgLegEffFillMap=new TBits(kNMaxValues);
+  }
+  fgLegEffVars->ResetAllBits();
+  fgLegEffVars->SetBitNumber(kLegEff);
+  fgLegEffVars->SetBitNumber(kOneOverLegEff);
+  if (map && map->InheritsFrom(THnBase::Class())) {
+    THnBase *eff=static_cast<THnBase*>(map);
+    for (Int_t idim=0; idim<eff->GetNdimensions(); idim++) {
+      UInt_t var=GetValueType(eff->GetAxis(idim)->GetName());
+      if (var<kNMaxValues) fgLegEffVars->SetBitNumber(var);
+    }
+  }
+}
@@ -693,9 +693,12 @@ public:
   static void InitEstimatorAvg(const Char_t* filename);
   static void InitEstimatorObjArrayAvg(const TObjArray* array);
   static void InitTRDpidEffHistograms(const Char_t* filename);
-  static void SetLegEffMap( TObject *map) { fgLegEffMap=map; }
+  static void SetLegEffMap( TObject *map);
   static void SetPairEffMap(TObject *map) { fgPairEffMap=map; }
   static void SetFillMap(   TBits   *map) { fgFillMap=map; }
+  static void SetCompiledFillMap(TBits *map) { fgCompiledFillMap=map; }
+  static Int_t CompileFillList(const TBits *map, Int_t * const list);
+  static void FillColumns(const TObjArray *objects, TBits *map, const Int_t * const list, Int_t nvars, Double_t * const columns);
   static void SetVZEROCalibrationFile(const Char_t* filename) {fgVZEROCalibrationFile = filename;}
 
   static void SetVZERORecenteringFile(const Char_t* filename) {fgVZERORecenteringFile = filename;}
@@ -734,6 +737,8 @@ private:
   static const char* fgkParticleNames[kNMaxValues][3];  //variable names
 
   static Bool_t Req(ValueTypes var) { return (fgFillMap ? fgFillMap->TestBitNumber(var) : kTRUE); }
+  // expensive ESD track variables: skipped only while a compiled map is set and neither map requests them
+  static Bool_t ReqCompiled(ValueTypes var) { return (!fgCompiledFillMap || fgCompiledFillMap->TestBitNumber(var) || Req(var)); }
   static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values);
   static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values);
   static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values);
@@ -763,6 +768,9 @@ private:
   static TObject         *fgLegEffMap;             // single electron efficiencies
   static TObject         *fgPairEffMap;             // pair efficiencies
   static TBits           *fgFillMap;             // map for requested variable filling
+  static TBits           *fgCompiledFillMap;     // all variables read by the current AliDielectron, gates the expensive ESD track variables
+  static TBits           *fgLegEffVars;          // kLegEff, kOneOverLegEff and the variables on the axes of fgLegEffMap
+  static TBits           *fgLegEffFillMap;       // fgFillMap extended by fgLegEffVars for a track fill
   static TString          fgVZEROCalibrationFile;  // file with VZERO channel-by-channel calibrations
   static TString          fgVZERORecenteringFile;  // file with VZERO Q-vector averages needed for event plane recentering
   static TProfile2D      *fgVZEROCalib[64];           // 1 histogram per VZERO channel
@@ -796,8 +804,19 @@ inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * cons
   // Main function to fill all available variables according to the type of particle
   //
   if (!object) return;
-  if      (object->IsA() == AliESDtrack::Class())       FillVarESDtrack(static_cast<const AliESDtrack*>(object), values);
-  else if (object->IsA() == AliAODTrack::Class())       FillVarAODTrack(static_cast<const AliAODTrack*>(object), values);
+  if (object->IsA() == AliESDtrack::Class() || object->IsA() == AliAODTrack::Class()) {
+    // the single leg efficiency needs the variables on the axes of the efficiency map
+    TBits *fillMap=fgFillMap;
+    if (fgFillMap && fgLegEffVars && fgLegEffMap && (Req(kLegEff) || Req(kOneOverLegEff))) {
+      fgLegEffFillMap->ResetAllBits();
+      (*fgLegEffFillMap)|= (*fgFillMap);
+      (*fgLegEffFillMap)|= (*fgLegEffVars);
+      fgFillMap=fgLegEffFillMap;
+    }
+    if (object->IsA() == AliESDtrack::Class()) FillVarESDtrack(static_cast<const AliESDtrack*>(object), values);
+    else                                       FillVarAODTrack(static_cast<const AliAODTrack*>(object), values);
+    fgFillMap=fillMap;
+  }
   else if (object->IsA() == AliMCParticle::Class())     FillVarMCParticle(static_cast<const AliMCParticle*>(object), values);
   else if (object->IsA() == AliAODMCParticle::Class())  FillVarAODMCParticle(static_cast<const AliAODMCParticle*>(object), values);
   else if (object->IsA() == AliDielectronPair::Class()) FillVarDielectronPair(static_cast<const AliDielectronPair*>(object), values);
@@ -1066,59 +1085,64 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
 
   values[AliDielectronVarManager::kTOFsignal]=particle->GetTOFsignal();
 
-  Double_t l = particle->GetIntegratedLength();  // cm
-  Double_t t = particle->GetTOFsignal();
-  Double_t t0 = fgPIDResponse->GetTOFResponse().GetTimeZero(); // ps
+  // TOF beta calculation
+  if(ReqCompiled(kTOFbeta)) {
+    Double_t l = particle->GetIntegratedLength();  // cm
+    Double_t t = particle->GetTOFsignal();
+    Double_t t0 = fgPIDResponse->GetTOFResponse().GetTimeZero(); // ps
 
-  if( (l < 360. || l > 800.) || (t <= 0.) || (t0 >999990.0) ) {
-	values[AliDielectronVarManager::kTOFbeta]=0.0;
-  }
-  else {
-	t -= t0; // subtract the T0
-	l *= 0.01;  // cm ->m
-	t *= 1e-12; //ps -> s
+    if( (l < 360. || l > 800.) || (t <= 0.) || (t0 >999990.0) ) {
+      values[AliDielectronVarManager::kTOFbeta]=0.0;
+    }
+    else {
+      t -= t0; // subtract the T0
+      l *= 0.01;  // cm ->m
+      t *= 1e-12; //ps -> s
 
-	Double_t v = l / t;
-	Float_t beta = v / TMath::C();
-	values[AliDielectronVarManager::kTOFbeta]=beta;
+      Double_t v = l / t;
+      Float_t beta = v / TMath::C();
+      values[AliDielectronVarManager::kTOFbeta]=beta;
+    }
   }
   values[AliDielectronVarManager::kTOFPIDBit]=(particle->GetStatus()&AliESDtrack::kTOFpid? 1: 0);
 
-  values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
+  if(ReqCompiled(kTOFmismProb)) values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
 
   // nsigma to Electron band
   // TODO: for the moment we set the bethe bloch parameters manually
   //       this should be changed in future!
-  values[AliDielectronVarManager::kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
-
-  values[AliDielectronVarManager::kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
-
-  values[AliDielectronVarManager::kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron)
-                                                     -AliDielectronPID::GetCntrdCorrITS(particle)
-                                                     ) / AliDielectronPID::GetWdthCorrITS(particle);
-
-  values[AliDielectronVarManager::kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
-
-  values[AliDielectronVarManager::kTOFnSigmaEleRaw]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTOFnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
-  values[AliDielectronVarManager::kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
+  if(ReqCompiled(kTPCnSigmaEleRaw)) values[AliDielectronVarManager::kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
+  if(ReqCompiled(kTPCnSigmaEle))    values[AliDielectronVarManager::kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
+
+  if(ReqCompiled(kTPCnSigmaPio)) values[AliDielectronVarManager::kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
+  if(ReqCompiled(kTPCnSigmaMuo)) values[AliDielectronVarManager::kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
+  if(ReqCompiled(kTPCnSigmaKao)) values[AliDielectronVarManager::kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
+  if(ReqCompiled(kTPCnSigmaPro)) values[AliDielectronVarManager::kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
+
+  if(ReqCompiled(kITSnSigmaEleRaw)) values[AliDielectronVarManager::kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
+  if(ReqCompiled(kITSnSigmaEle))    values[AliDielectronVarManager::kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron)
+                                                                              -AliDielectronPID::GetCntrdCorrITS(particle)
+                                                                              ) / AliDielectronPID::GetWdthCorrITS(particle);
+
+  if(ReqCompiled(kITSnSigmaPio)) values[AliDielectronVarManager::kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
+  if(ReqCompiled(kITSnSigmaMuo)) values[AliDielectronVarManager::kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
+  if(ReqCompiled(kITSnSigmaKao)) values[AliDielectronVarManager::kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
+  if(ReqCompiled(kITSnSigmaPro)) values[AliDielectronVarManager::kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
+
+  if(ReqCompiled(kTOFnSigmaEleRaw)) values[AliDielectronVarManager::kTOFnSigmaEleRaw]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
+  if(ReqCompiled(kTOFnSigmaEle))    values[AliDielectronVarManager::kTOFnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
+  if(ReqCompiled(kTOFnSigmaPio)) values[AliDielectronVarManager::kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
+  if(ReqCompiled(kTOFnSigmaMuo)) values[AliDielectronVarManager::kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
+  if(ReqCompiled(kTOFnSigmaKao)) values[AliDielectronVarManager::kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
+  if(ReqCompiled(kTOFnSigmaPro)) values[AliDielectronVarManager::kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
 
   //EMCAL PID information
   Double_t eop=0;
   Double_t showershape[4]={0.,0.,0.,0.};
 //   values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
+  if(ReqCompiled(kEMCALnSigmaEle) || ReqCompiled(kEMCALE) || ReqCompiled(kEMCALEoverP) ||
+     ReqCompiled(kEMCALNCells) || ReqCompiled(kEMCALM02) || ReqCompiled(kEMCALM20) || ReqCompiled(kEMCALDispersion))
+    values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
   values[AliDielectronVarManager::kEMCALEoverP]     = eop;
   values[AliDielectronVarManager::kEMCALE]          = eop*values[AliDielectronVarManager::kP];
   values[AliDielectronVarManager::kEMCALNCells]     = showershape[0];
@@ -1126,8 +1150,12 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   values[AliDielectronVarManager::kEMCALM20]        = showershape[2];
   values[AliDielectronVarManager::kEMCALDispersion] = showershape[3];
 
-  values[AliDielectronVarManager::kLegEff]        = GetSingleLegEff(values);
-  values[AliDielectronVarManager::kOneOverLegEff] = (values[AliDielectronVarManager::kLegEff]>0.0 ? 1./values[AliDielectronVarManager::kLegEff] : 0.0);
+  values[AliDielectronVarManager::kLegEff]=0.0;
+  values[AliDielectronVarManager::kOneOverLegEff]=0.0;
+  if(ReqCompiled(kLegEff) || ReqCompiled(kOneOverLegEff)) {
+    values[AliDielectronVarManager::kLegEff]        = GetSingleLegEff(values);
+    values[AliDielectronVarManager::kOneOverLegEff] = (values[AliDielectronVarManager::kLegEff]>0.0 ? 1./values[AliDielectronVarManager::kLegEff] : 0.0);
+  }
   //restore TPC signal if it was changed
   if (esdTrack) esdTrack->SetTPCsignal(origdEdx,esdTrack->GetTPCsignalSigma(),esdTrack->GetTPCsignalN());
 
@@ -1135,21 +1163,26 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   if(Req(kTRDonlineA)||Req(kTRDonlineLayerMask)||Req(kTRDonlinePID)||Req(kTRDonlinePt)||Req(kTRDonlineStack)||Req(kTRDonlineTrackInTime)||Req(kTRDonlineSector)||Req(kTRDonlineFlagsTiming)||Req(kTRDonlineLabel)||Req(kTRDonlineNTracklets)||Req(kTRDonlineFirstLayer))
     FillVarVTrdTrack(particle,values);
 
+  // propagation to the TRD and the active length are expensive, only do them on request
   if( fgEvent && fgEvent->GetMagneticField() ){
-    if(out){
-      AliExternalTrackParam out_tmp(*out);
-      out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
-      values[AliDielectronVarManager::kTRDeta] = out_tmp.Eta();
+    if( ReqCompiled(kTRDeta) || ReqCompiled(kInTRDacceptance) ){
+      if(out){
+        AliExternalTrackParam out_tmp(*out);
+        out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
+        values[AliDielectronVarManager::kTRDeta] = out_tmp.Eta();
+      }
+      else{
+        AliESDtrack particle_tmp(*particle);
+        particle_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
+        values[AliDielectronVarManager::kTRDeta] = particle_tmp.Eta();
+      }
+      values[AliDielectronVarManager::kInTRDacceptance] = TMath::Abs( values[AliDielectronVarManager::kTRDeta] )<0.85 && (  (values[AliDielectronVarManager::kCharge]<0&&(  values[AliDielectronVarManager::kPhi]<1.32 || (values[AliDielectronVarManager::kPhi]>1.98 && values[AliDielectronVarManager::kPhi]<4.10)||  ( values[AliDielectronVarManager::kPhi]>5.12  && values[AliDielectronVarManager::kPhi]<5.48  && TMath::Abs( values[AliDielectronVarManager::kTRDeta] )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.48 )) ||   (values[AliDielectronVarManager::kCharge]>0&&(  values[AliDielectronVarManager::kPhi]<1.52 || (values[AliDielectronVarManager::kPhi]>2.20 && values[AliDielectronVarManager::kPhi]<4.32)||  ( values[AliDielectronVarManager::kPhi]>5.32  && values[AliDielectronVarManager::kPhi]<5.68  && TMath::Abs( values[AliDielectronVarManager::kTRDeta]  )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.68 )) )  ? 1: 0;
     }
-    else{
-      AliESDtrack particle_tmp(*particle);
-      particle_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
-      values[AliDielectronVarManager::kTRDeta] = particle_tmp.Eta();
+    if( ReqCompiled(kTPCActiveLength) || ReqCompiled(kTPCGeomLength) ){
+      int mode = particle->GetInnerParam() ? 1:0;
+      values[kTPCActiveLength] = particle->GetLengthInActiveZone(mode, 2., 220., fgEvent->GetMagneticField());
+      values[kTPCGeomLength] = values[kTPCActiveLength] / ( 130 - TMath::Power( TMath::Abs( particle->GetSigned1Pt() ),1.5 ) );
     }
-    int mode = particle->GetInnerParam() ? 1:0;
-    values[kTPCActiveLength] = particle->GetLengthInActiveZone(mode, 2., 220., fgEvent->GetMagneticField());
-    values[kTPCGeomLength] = values[kTPCActiveLength] / ( 130 - TMath::Power( TMath::Abs( particle->GetSigned1Pt() ),1.5 ) );
-    values[AliDielectronVarManager::kInTRDacceptance] = TMath::Abs( values[AliDielectronVarManager::kTRDeta] )<0.85 && (  (values[AliDielectronVarManager::kCharge]<0&&(  values[AliDielectronVarManager::kPhi]<1.32 || (values[AliDielectronVarManager::kPhi]>1.98 && values[AliDielectronVarManager::kPhi]<4.10)||  ( values[AliDielectronVarManager::kPhi]>5.12  && values[AliDielectronVarManager::kPhi]<5.48  && TMath::Abs( values[AliDielectronVarManager::kTRDeta] )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.48 )) ||   (values[AliDielectronVarManager::kCharge]>0&&(  values[AliDielectronVarManager::kPhi]<1.52 || (values[AliDielectronVarManager::kPhi]>2.20 && values[AliDielectronVarManager::kPhi]<4.32)||  ( values[AliDielectronVarManager::kPhi]>5.32  && values[AliDielectronVarManager::kPhi]<5.68  && TMath::Abs( values[AliDielectronVarManager::kTRDeta]  )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.68 )) )  ? 1: 0;
   }
 
 }
@@ -2259,8 +2292,13 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   values[AliDielectronVarManager::kOneOverPairEff]=0.0;
   values[AliDielectronVarManager::kOneOverPairEffSq]=0.0;
   if (leg1 && leg2 && fgLegEffMap) {
+    // the legs are filled with the variables of the single leg efficiency only,
+    // kLegEff is not part of the fill map of the pair
+    TBits *fillMap=fgFillMap;
+    fgFillMap=fgLegEffVars;
     Fill(leg1, valuesLeg1);
     Fill(leg2, valuesLeg2);
+    fgFillMap=fillMap;
     values[AliDielectronVarManager::kPairEff] = valuesLeg1[AliDielectronVarManager::kLegEff] *valuesLeg2[AliDielectronVarManager::kLegEff];
   }
   else if(fgPairEffMap) {
@@ -18,6 +18,7 @@ using std::endl;
 #include "AliReducedTrackInfo.h"
 #include "AliReducedPairInfo.h"
 #include "AliHistogramManager.h"
+#include "AliReducedCutProgram.h"
 
 ClassImp(AliReducedAnalysisJpsi2ee);
 
@@ -32,6 +33,7 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee() :
   fOptionRunOverMC(kFALSE),
   fOptionRunLikeSignPairing(kTRUE),
   fOptionLoopOverTracks(kTRUE),
+  fOptionUseCompiledTrackCuts(kTRUE),
   fEventCuts(),
   fTrackCuts(),
   fPreFilterTrackCuts(),
@@ -41,7 +43,8 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee() :
   fNegTracks(),
   fPrefilterPosTracks(),
   fPrefilterNegTracks(),
-  fEventCounter(0)
+  fEventCounter(0),
+  fTrackCutProgram(0x0)
 {
   //
   // default constructor
@@ -59,6 +62,7 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
   fOptionRunOverMC(kFALSE),
   fOptionRunLikeSignPairing(kTRUE),
   fOptionLoopOverTracks(kTRUE),
+  fOptionUseCompiledTrackCuts(kTRUE),
   fEventCuts(),
   fTrackCuts(),
   fPreFilterTrackCuts(),
@@ -68,7 +72,8 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
   fNegTracks(),
   fPrefilterPosTracks(),
   fPrefilterNegTracks(),
-  fEventCounter(0)
+  fEventCounter(0),
+  fTrackCutProgram(0x0)
 {
   //
   // named constructor
@@ -95,6 +100,7 @@ AliReducedAnalysisJpsi2ee::~AliReducedAnalysisJpsi2ee()
    fPosTracks.Clear("C"); fNegTracks.Clear("C"); fPrefilterPosTracks.Clear("C"); fPrefilterNegTracks.Clear("C");
    if(fHistosManager) delete fHistosManager;
    if(fMixingHandler) delete fMixingHandler;
+   if(fTrackCutProgram) delete fTrackCutProgram;
 }
 
 
@@ -198,6 +204,13 @@ void AliReducedAnalysisJpsi2ee::Init() {
    fHistosManager->SetDefaultVarNames(AliReducedVarManager::fgVariableNames,AliReducedVarManager::fgVariableUnits);
    
    fMixingHandler->SetHistogramManager(fHistosManager);
+   
+   if(fOptionUseCompiledTrackCuts && fTrackCuts.GetEntries()>0) {
+      if(!fTrackCutProgram) fTrackCutProgram = new AliReducedCutProgram();
+      fTrackCutProgram->Compile(&fTrackCuts);
+      cout << "AliReducedAnalysisJpsi2ee::Init() " << fTrackCutProgram->GetNCompiledCuts() << " of " << fTrackCutProgram->GetNCuts()
+           << " track cuts compiled into " << fTrackCutProgram->GetNInstructions() << " instructions" << endl;
+   }
 }
 
 
@@ -379,6 +392,9 @@ void AliReducedAnalysisJpsi2ee::RunTrackSelection() {
    TClonesArray* trackList = fEvent->GetTracks();
    TIter nextTrack(trackList);
    Float_t nsigma = 0.;
+   // with the compiled track cuts, the tracks are only collected here and selected after the loop
+   AliReducedCutProgram* program = (fTrackCutProgram && fTrackCuts.GetEntries()>0 ? fTrackCutProgram : 0x0);
+   if(program) program->BeginEvent(fEvent->NTracks());
    for(Int_t it=0; it<fEvent->NTracks(); ++it) {
       track = (AliReducedTrackInfo*)nextTrack();
       if(fOptionRunOverMC && track->IsMCTruth()) continue;
@@ -398,7 +414,8 @@ void AliReducedAnalysisJpsi2ee::RunTrackSelection() {
          AliReducedVarManager::FillTPCclusterBitFlag(track, iLayer, fValues);
          fHistosManager->FillHistClass("TrackTPCclusterMap_BeforeCuts", fValues);
       }
-      if(IsTrackSelected(track, fValues)) {
+      if(program) program->AddTrack(track, fValues);
+      else if(IsTrackSelected(track, fValues)) {
          fValues[AliReducedVarManager::kEvAverageTPCchi2] += track->TPCchi2();
          if(track->Charge()>0) fPosTracks.Add(track);
          if(track->Charge()<0) fNegTracks.Add(track);
@@ -408,6 +425,22 @@ void AliReducedAnalysisJpsi2ee::RunTrackSelection() {
          if(track->Charge()<0) fPrefilterNegTracks.Add(track);
       }
    }   // end loop over tracks
+   
+   if(!program) return;
+   // evaluate the compiled cuts for all tracks and keep the ones passing at least one cut
+   program->Evaluate();
+   nextTrack.Reset();
+   Int_t itrack = 0;
+   for(Int_t it=0; it<fEvent->NTracks(); ++it) {
+      track = (AliReducedTrackInfo*)nextTrack();
+      if(fOptionRunOverMC && track->IsMCTruth()) continue;
+      track->SetFlags(program->GetMask(itrack++));
+      if(track->GetFlags()>0) {
+         fValues[AliReducedVarManager::kEvAverageTPCchi2] += track->TPCchi2();
+         if(track->Charge()>0) fPosTracks.Add(track);
+         if(track->Charge()<0) fNegTracks.Add(track);
+      }
+   }
 }
 
 
@@ -15,6 +15,7 @@
 #include "AliHistogramManager.h"
 #include "AliMixingHandler.h"
 
+class AliReducedCutProgram;
 
 //________________________________________________________________
 class AliReducedAnalysisJpsi2ee : public AliReducedAnalysisTaskSE {
@@ -41,6 +42,7 @@ public:
   void SetRunPairing(Bool_t option) {fOptionRunPairing = option;};
   void SetRunOverMC(Bool_t option) {fOptionRunOverMC = option;};
   void SetRunLikeSignPairing(Bool_t option) {fOptionRunLikeSignPairing = option;}
+  void SetUseCompiledTrackCuts(Bool_t option) {fOptionUseCompiledTrackCuts = option;}
   void SetLoopOverTracks(Bool_t option) {
      fOptionLoopOverTracks = option; 
      if(!fOptionLoopOverTracks) {fOptionRunPairing = kFALSE; fOptionRunMixing = kFALSE; fOptionRunLikeSignPairing = kFALSE;}     
@@ -56,6 +58,7 @@ public:
   Bool_t GetRunEventMixing() {return fOptionRunMixing;}
   Bool_t GetRunPairing() {return fOptionRunPairing;}
   Bool_t GetLoopOverTracks() {return fOptionLoopOverTracks;}
+  Bool_t GetUseCompiledTrackCuts() {return fOptionUseCompiledTrackCuts;}
   
 protected:
    AliHistogramManager* fHistosManager;   // Histogram manager
@@ -66,6 +69,7 @@ protected:
    Bool_t fOptionRunOverMC;  // true: trees contain MC info -> fill histos to compute efficiencies, false: run normally as on data
    Bool_t fOptionRunLikeSignPairing;   // true (default): performs the like sign pairing in addition to the opposite pairing
    Bool_t fOptionLoopOverTracks;       // true (default); if false do not loop over tracks and consequently no pairing
+   Bool_t fOptionUseCompiledTrackCuts; // true (default): evaluate the track cuts for all tracks of the event at once with an AliReducedCutProgram
   
    TList fEventCuts;               // array of event cuts
    TList fTrackCuts;               // array of track cuts
@@ -80,6 +84,8 @@ protected:
    
    ULong_t fEventCounter;   // event counter
    
+   AliReducedCutProgram* fTrackCutProgram;   //! compiled track cuts
+   
   Bool_t IsEventSelected(AliReducedBaseEvent* event, Float_t* values=0x0);
   Bool_t IsTrackSelected(AliReducedBaseTrack* track, Float_t* values=0x0);
   Bool_t IsTrackPrefilterSelected(AliReducedBaseTrack* track, Float_t* values=0x0);
@@ -97,7 +103,7 @@ protected:
   void FillPairHistograms(ULong_t mask, Int_t pairType, TString pairClass = "PairSE", Bool_t isMCTruth = kFALSE);
   void FillMCTruthHistograms();
   
-  ClassDef(AliReducedAnalysisJpsi2ee,3);
+  ClassDef(AliReducedAnalysisJpsi2ee,4);
 };
 
 #endif
@@ -0,0 +1,194 @@
+/*
+***********************************************************
+  Implementation of AliReducedCutProgram class.
+
+  The (variable, low, high, exclude) ranges of a list of AliReducedVarCut
+  are compiled into a flat instruction table. The values of the used
+  variables are collected per event in columns, and every instruction is
+  applied to all tracks in one loop, clearing the bit of its cut in the
+  track masks. The result is the same as calling IsSelected() of every cut
+  for every track.
+  *********************************************************
+*/
+
+#include <iostream>
+using std::cout;
+using std::endl;
+
+#include <TList.h>
+
+#ifndef ALIREDUCEDCUTPROGRAM_H
+#include "AliReducedCutProgram.h"
+#endif
+
+#include "AliReducedInfoCut.h"
+#include "AliReducedVarCut.h"
+#include "AliReducedTrackCut.h"
+
+//____________________________________________________________________________
+AliReducedCutProgram::AliReducedCutProgram() :
+  fCuts(),
+  fCutModes(),
+  fInstructions(),
+  fColumnVars(),
+  fColumns(),
+  fMasks(),
+  fNTracks(0),
+  fCapacity(0)
+{
+  //
+  // default constructor
+  //
+  for(Int_t i=0; i<AliReducedVarManager::kNVars; ++i) fColumnOfVar[i] = -1;
+}
+
+//____________________________________________________________________________
+AliReducedCutProgram::~AliReducedCutProgram() {
+  //
+  // destructor
+  //
+}
+
+//____________________________________________________________________________
+Short_t AliReducedCutProgram::GetColumn(Short_t var) {
+  //
+  // column of the variable, added if not yet used
+  //
+  if(fColumnOfVar[var]<0) {
+    fColumnOfVar[var] = fColumnVars.size();
+    fColumnVars.push_back(var);
+  }
+  return fColumnOfVar[var];
+}
+
+//____________________________________________________________________________
+void AliReducedCutProgram::AddInstruction(Int_t bit, Short_t var, Float_t low, Float_t high, Bool_t exclude,
+                                          Short_t depVar /*=AliReducedVarManager::kNothing*/, Float_t depLow /*=0.*/,
+                                          Float_t depHigh /*=0.*/, Bool_t depExclude /*=kFALSE*/) {
+  //
+  // add one range of the cut at bit
+  //
+  Instruction inst;
+  inst.fVar = GetColumn(var);
+  inst.fDepVar = (depVar!=AliReducedVarManager::kNothing ? GetColumn(depVar) : -1);
+  inst.fLow = low; inst.fHigh = high; inst.fExclude = exclude;
+  inst.fDepLow = depLow; inst.fDepHigh = depHigh; inst.fDepExclude = depExclude;
+  inst.fBit = (ULong_t(1)<<bit);
+  fInstructions.push_back(inst);
+}
+
+//____________________________________________________________________________
+void AliReducedCutProgram::Compile(const TList* cuts) {
+  //
+  // compile the cuts in the list
+  //
+  fCuts.clear(); fCutModes.clear(); fInstructions.clear(); fColumnVars.clear();
+  for(Int_t i=0; i<AliReducedVarManager::kNVars; ++i) fColumnOfVar[i] = -1;
+  fCapacity = 0;
+
+  const Int_t nMaxCuts = 8*sizeof(ULong_t);
+  if(cuts->GetEntries()>nMaxCuts) {
+    cout << "AliReducedCutProgram::Compile() Only the first " << nMaxCuts << " cuts fit in the track mask!" << endl;
+  }
+  for(Int_t icut=0; icut<cuts->GetEntries() && icut<nMaxCuts; ++icut) {
+    AliReducedInfoCut* cut = (AliReducedInfoCut*)cuts->At(icut);
+    fCuts.push_back(cut);
+    // derived classes with their own selection logic are only compiled if known
+    Char_t mode = kPerTrack;
+    if(cut->IsA()==AliReducedVarCut::Class() || cut->IsA()==AliReducedTrackCut::Class()) {
+      const Int_t nInstructions = fInstructions.size();
+      if(((AliReducedVarCut*)cut)->Compile(this, icut))
+        mode = (cut->IsA()==AliReducedTrackCut::Class() ? kCompiledTrackFlags : kCompiled);
+      else
+        fInstructions.resize(nInstructions);
+    }
+    fCutModes.push_back(mode);
+  }
+}
+
+//____________________________________________________________________________
+Int_t AliReducedCutProgram::GetNCompiledCuts() const {
+  //
+  // number of cuts in the instruction table
+  //
+  Int_t n = 0;
+  for(UInt_t i=0; i<fCutModes.size(); ++i) if(fCutModes[i]!=kPerTrack) ++n;
+  return n;
+}
+
+//____________________________________________________________________________
+void AliReducedCutProgram::BeginEvent(Int_t nTracks) {
+  //
+  // prepare the columns for at most nTracks tracks
+  //
+  fNTracks = 0;
+  if(nTracks>fCapacity) {
+    fCapacity = nTracks;
+    fColumns.resize(fColumnVars.size()*fCapacity);
+    fMasks.resize(fCapacity);
+  }
+}
+
+//____________________________________________________________________________
+void AliReducedCutProgram::AddTrack(TObject* track, Float_t* values) {
+  //
+  // add a track with its filled values to the current event
+  // the cuts not in the instruction table are applied here
+  //
+  if(fNTracks>=fCapacity) {
+    // more tracks than announced, keep the already stored ones
+    const Int_t capacity = 2*fCapacity+16;
+    std::vector<Float_t> columns(fColumnVars.size()*capacity);
+    for(UInt_t icol=0; icol<fColumnVars.size(); ++icol)
+      for(Int_t it=0; it<fNTracks; ++it) columns[icol*capacity+it] = fColumns[icol*fCapacity+it];
+    fColumns.swap(columns);
+    fMasks.resize(capacity);
+    fCapacity = capacity;
+  }
+
+  for(UInt_t icol=0; icol<fColumnVars.size(); ++icol)
+    fColumns[icol*fCapacity+fNTracks] = values[fColumnVars[icol]];
+
+  ULong_t mask = 0;
+  for(UInt_t icut=0; icut<fCuts.size(); ++icut) {
+    Bool_t pass = kTRUE;
+    if(fCutModes[icut]==kCompiledTrackFlags) pass = ((AliReducedTrackCut*)fCuts[icut])->IsTrackFlagSelected(track);
+    if(fCutModes[icut]==kPerTrack) pass = fCuts[icut]->IsSelected(track, values);
+    if(pass) mask |= (ULong_t(1)<<icut);
+  }
+  fMasks[fNTracks] = mask;
+  ++fNTracks;
+}
+
+//____________________________________________________________________________
+void AliReducedCutProgram::Evaluate() {
+  //
+  // apply the instruction table to all tracks of the event
+  //
+  ULong_t* masks = fMasks.data();
+  const Int_t nTracks = fNTracks;
+  for(UInt_t i=0; i<fInstructions.size(); ++i) {
+    const Instruction& inst = fInstructions[i];
+    const Float_t* x = fColumns.data()+inst.fVar*fCapacity;
+    const Float_t low = inst.fLow, high = inst.fHigh;
+    const Bool_t exclude = inst.fExclude;
+    const ULong_t bit = inst.fBit;
+    if(inst.fDepVar<0) {
+      for(Int_t it=0; it<nTracks; ++it) {
+        const Bool_t fail = ((x[it]>=low && x[it]<=high) == exclude);
+        masks[it] &= ~(ULong_t(fail)*bit);
+      }
+    }
+    else {
+      // the cut applies inside the dependent variable range, or outside if fDepExclude
+      const Float_t* y = fColumns.data()+inst.fDepVar*fCapacity;
+      const Float_t depLow = inst.fDepLow, depHigh = inst.fDepHigh;
+      const Bool_t depExclude = inst.fDepExclude;
+      for(Int_t it=0; it<nTracks; ++it) {
+        const Bool_t applies = ((y[it]>=depLow && y[it]<=depHigh) != depExclude);
+        const Bool_t fail = applies && ((x[it]>=low && x[it]<=high) == exclude);
+        masks[it] &= ~(ULong_t(fail)*bit);
+      }
+    }
+  }
+}
@@ -0,0 +1,76 @@
+// Compiled form of a list of AliReducedVarCut / AliReducedTrackCut selections,
+// evaluated column-wise over all the tracks of an event
+// Each cut in the list corresponds to one bit in the selection mask of a track
+
+#ifndef ALIREDUCEDCUTPROGRAM_H
+#define ALIREDUCEDCUTPROGRAM_H
+
+#include <vector>
+
+#include <Rtypes.h>
+
+#include "AliReducedVarManager.h"
+
+class TList;
+class TObject;
+class AliReducedInfoCut;
+
+//_________________________________________________________________________
+class AliReducedCutProgram {
+
+ public:
+  AliReducedCutProgram();
+  virtual ~AliReducedCutProgram();
+
+  // NOTE: the cut at position i in the list sets bit i of the track mask
+  // NOTE: cuts which cannot be compiled (e.g. with TF1 limits or of another type) are evaluated one track at a time
+  void Compile(const TList* cuts);
+  void AddInstruction(Int_t bit, Short_t var, Float_t low, Float_t high, Bool_t exclude,
+                      Short_t depVar=AliReducedVarManager::kNothing, Float_t depLow=0., Float_t depHigh=0., Bool_t depExclude=kFALSE);
+
+  void BeginEvent(Int_t nTracks);
+  void AddTrack(TObject* track, Float_t* values);
+  void Evaluate();
+
+  Int_t   GetNCuts() const {return fCuts.size();}
+  Int_t   GetNCompiledCuts() const;
+  Int_t   GetNInstructions() const {return fInstructions.size();}
+  Int_t   GetNTracks() const {return fNTracks;}
+  ULong_t GetMask(Int_t itrack) const {return fMasks[itrack];}
+
+ private:
+  enum CutModes {
+    kCompiled=0,          // only variable ranges, fully compiled
+    kCompiledTrackFlags,  // compiled variable ranges and track flags checked per track
+    kPerTrack             // evaluated per track with IsSelected()
+  };
+
+  struct Instruction {
+    Short_t fVar;           // column of the cut variable
+    Short_t fDepVar;        // column of the dependent variable, -1 if none
+    Float_t fLow;           // lower limit
+    Float_t fHigh;          // upper limit
+    Float_t fDepLow;        // lower limit of the dependent variable
+    Float_t fDepHigh;       // upper limit of the dependent variable
+    Bool_t  fExclude;       // use the range for exclusion
+    Bool_t  fDepExclude;    // apply the cut outside the dependent variable range
+    ULong_t fBit;           // bit of the cut in the track mask
+  };
+
+  std::vector<AliReducedInfoCut*> fCuts;       // cuts, not owned
+  std::vector<Char_t>        fCutModes;        // how each cut is evaluated
+  std::vector<Instruction>   fInstructions;    // instruction table of the compiled cuts
+  Short_t                    fColumnOfVar[AliReducedVarManager::kNVars];  // column of each variable, -1 if not used
+  std::vector<Short_t>       fColumnVars;      // variable of each column
+  std::vector<Float_t>       fColumns;         // values, column c of track t at c*fCapacity+t
+  std::vector<ULong_t>       fMasks;           // selection mask of each track
+  Int_t                      fNTracks;         // number of tracks in the current event
+  Int_t                      fCapacity;        // number of tracks the columns can hold
+
+  Short_t GetColumn(Short_t var);
+
+  AliReducedCutProgram(const AliReducedCutProgram &c);
+  AliReducedCutProgram& operator= (const AliReducedCutProgram &c);
+};
+
+#endif
@@ -79,6 +79,17 @@ Bool_t AliReducedTrackCut::IsSelected(TObject* obj, Float_t* values) {
    //
    // apply cuts
    //      
+   if(!IsTrackFlagSelected(obj)) return kFALSE;
+   
+   return AliReducedVarCut::IsSelected(values);   
+}
+
+
+//____________________________________________________________________________
+Bool_t AliReducedTrackCut::IsTrackFlagSelected(TObject* obj) const {
+   //
+   // apply the cuts on the track flags
+   //      
    if(!obj->InheritsFrom(AliReducedBaseTrack::Class())) return kFALSE;
    
    if(obj->InheritsFrom(AliReducedTrackInfo::Class())) {
@@ -98,5 +109,5 @@ Bool_t AliReducedTrackCut::IsSelected(TObject* obj, Float_t* values) {
    if(fRejectTaggedGamma && ((AliReducedBaseTrack*)obj)->IsGammaLeg()) return kFALSE;
    if(fRejectTaggedPureGamma && ((AliReducedBaseTrack*)obj)->IsPureGammaLeg()) return kFALSE;
    
-   return AliReducedVarCut::IsSelected(values);   
+   return kTRUE;
 }
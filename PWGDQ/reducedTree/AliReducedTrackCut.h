@@ -39,6 +39,8 @@ class AliReducedTrackCut : public AliReducedVarCut {
   
   virtual Bool_t IsSelected(TObject* obj);
   virtual Bool_t IsSelected(TObject* obj, Float_t* values);
+  // NOTE: Apply only the track flag requirements (refit, ITS hit map, kinks, tagged gammas), not the variable cuts
+  Bool_t IsTrackFlagSelected(TObject* obj) const;
   
  protected: 
       
@@ -18,6 +18,7 @@ using std::endl;
 #include "AliReducedBaseEvent.h"
 #include "AliReducedPairInfo.h"
 #include "AliReducedVarManager.h"
+#include "AliReducedCutProgram.h"
 
 ClassImp(AliReducedVarCut)
 
@@ -249,3 +250,22 @@ Bool_t AliReducedVarCut::IsSelected(Float_t* values) {
    
    return kTRUE;
 }
+
+
+//____________________________________________________________________________
+Bool_t AliReducedVarCut::Compile(AliReducedCutProgram* program, Int_t bit) const {
+   //
+   // add the cut ranges to the instruction table of the program
+   //
+   for(Int_t i=0; i<fNCuts; ++i)
+      if(fFuncCutLow[i] || fFuncCutHigh[i]) return kFALSE;
+   
+   for(Int_t i=0; i<fNCuts; ++i) {
+      if(fCutHasDependentVariable[i])
+         program->AddInstruction(bit, fCutVariables[i], fCutLow[i], fCutHigh[i], fCutExclude[i],
+                                 fDependentVariable[i], fDependentVariableCutLow[i], fDependentVariableCutHigh[i], fDependentVariableExclude[i]);
+      else
+         program->AddInstruction(bit, fCutVariables[i], fCutLow[i], fCutHigh[i], fCutExclude[i]);
+   }
+   return kTRUE;
+}
@@ -9,6 +9,8 @@
 #include "AliReducedInfoCut.h"
 #include "AliReducedVarManager.h"
 
+class AliReducedCutProgram;
+
 //_________________________________________________________________________
 class AliReducedVarCut : public AliReducedInfoCut {
    
@@ -39,6 +41,10 @@ class AliReducedVarCut : public AliReducedInfoCut {
   virtual Bool_t IsSelected(Float_t* values);
   virtual Bool_t IsSelected(TObject* obj, Float_t* values);
   
+  // NOTE: Add the cut ranges to the instruction table of "program" for the mask bit "bit"
+  // NOTE: Returns false if the cut cannot be compiled (cuts with function limits), then it has to be evaluated with IsSelected()
+  Bool_t Compile(AliReducedCutProgram* program, Int_t bit) const;
+  
  protected: 
   
    Int_t       fNCuts;                                    // number of enabled cuts
@@ -54,9 +54,68 @@
 #include "AliAODMCHeader.h"
 #include "AliEventplane.h"
 #include "AliAODEvent.h"
+#include "TROOT.h"
 #include <vector>
 #include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 
+//________________________________________________________________________
+// Worker threads of the cut-parallel meson pass of AliAnalysisTaskGammaConvV1.
+// The threads are started once and wait for the job of the next event;
+// Run(job) calls job(t) on thread t = 1..n-1 and job(0) on the calling thread
+// and returns when all threads have finished.
+class AliGammaConvV1WorkerPool {
+  public:
+    AliGammaConvV1WorkerPool(Int_t nThreads) : fThreads(), fMutex(), fStart(), fDone(), fJob(), fGeneration(0), fPending(0), fStop(kFALSE) {
+      for(Int_t t = 1; t < nThreads; t++) fThreads.push_back(std::thread(&AliGammaConvV1WorkerPool::Work, this, t));
+    }
+    ~AliGammaConvV1WorkerPool() {
+      {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = kTRUE;
+      }
+      fStart.notify_all();
+      for(UInt_t t = 0; t < fThreads.size(); t++) fThreads[t].join();
+    }
+    Int_t GetNThreads() const { return fThreads.size() + 1; }
+    void Run(const std::function<void(Int_t)> &job) {
+      {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fJob = job;
+        fPending = fThreads.size();
+        fGeneration++;
+      }
+      fStart.notify_all();
+      job(0);
+      std::unique_lock<std::mutex> lock(fMutex);
+      fDone.wait(lock, [this]() { return fPending == 0; });
+    }
+  private:
+    void Work(Int_t t) {
+      ULong64_t done = 0;
+      while (kTRUE) {
+        std::unique_lock<std::mutex> lock(fMutex);
+        fStart.wait(lock, [this, done]() { return fStop || fGeneration != done; });
+        if (fStop) return;
+        done = fGeneration;
+        lock.unlock();
+        fJob(t);
+        lock.lock();
+        if (--fPending == 0) fDone.notify_one();
+      }
+    }
+    std::vector<std::thread>     fThreads;    // threads 1..n-1, thread 0 is the caller of Run
+    std::mutex                   fMutex;      // protects the members below
+    std::condition_variable      fStart;      // signals a new job or the stop
+    std::condition_variable      fDone;       // signals that all threads finished the job
+    std::function<void(Int_t)>   fJob;        // job of the current event
+    ULong64_t                    fGeneration; // number of jobs started
+    Int_t                        fPending;    // threads still running the current job
+    Bool_t                       fStop;       // threads have to return
+};
 
 ClassImp(AliAnalysisTaskGammaConvV1)
 
@@ -264,7 +323,17 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fEnableClusterCutsForTrigger(kFALSE),
   fDoMaterialBudgetWeightingOfGammasForTrueMesons(kFALSE),
   tBrokenFiles(NULL),
-  fFileNameBroken(NULL)
+  fFileNameBroken(NULL),
+  fDoCutParallelMesons(kFALSE),
+  fNCutParallelThreads(1),
+  fCutParallelPhotonCuts(),
+  fCutParallelNGammas(),
+  fCutParallelWeight(),
+  fCutParallelCuts(0),
+  fCutParallelMothers(),
+  fCutParallelMotherCuts(),
+  fCutParallelThreadCuts(),
+  fCutParallelPool(NULL)
 {
 
 }
@@ -474,7 +543,17 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   fEnableClusterCutsForTrigger(kFALSE),
   fDoMaterialBudgetWeightingOfGammasForTrueMesons(kFALSE),
   tBrokenFiles(NULL),
-  fFileNameBroken(NULL)
+  fFileNameBroken(NULL),
+  fDoCutParallelMesons(kFALSE),
+  fNCutParallelThreads(1),
+  fCutParallelPhotonCuts(),
+  fCutParallelNGammas(),
+  fCutParallelWeight(),
+  fCutParallelCuts(0),
+  fCutParallelMothers(),
+  fCutParallelMotherCuts(),
+  fCutParallelThreadCuts(),
+  fCutParallelPool(NULL)
 {
   // Define output slots here
   DefineOutput(1, TList::Class());
@@ -499,7 +578,10 @@ AliAnalysisTaskGammaConvV1::~AliAnalysisTaskGammaConvV1()
     delete[] fWeightCentrality; 
     fWeightCentrality = 0x0; 
   }
-    
+  if(fCutParallelPool){
+    delete fCutParallelPool; // stops and joins the worker threads
+    fCutParallelPool = NULL;
+  }
 }
 //___________________________________________________________
 void AliAnalysisTaskGammaConvV1::InitBack(){
@@ -1592,6 +1674,12 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
     tBrokenFiles->Branch("fileName",&fFileNameBroken);
     fOutputContainer->Add(tBrokenFiles);
   }
+
+  if(fDoCutParallelMesons && fDoMesonAnalysis && UseCutParallelThreads() && !fCutParallelPool){
+    // the worker threads fill histograms, the ROOT globals they touch need the locks
+    ROOT::EnableThreadSafety();
+    fCutParallelPool = new AliGammaConvV1WorkerPool(fNCutParallelThreads);
+  }
   
   PostData(1, fOutputContainer);
 }
@@ -1667,6 +1755,13 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
   }
 
   fReaderGammas = fV0Reader->GetReconstructedGammas(); // Gammas from default Cut
+  if(fDoCutParallelMesons && fDoMesonAnalysis){
+    // cut masks of the reader photons, filled by the cuts running in the shared pass
+    fCutParallelPhotonCuts.assign(fReaderGammas->GetEntriesFast(),0);
+    fCutParallelNGammas.resize(fnCuts,0);
+    fCutParallelWeight.resize(fnCuts,1.);
+    fCutParallelCuts = 0;
+  }
   
   // ------------------- BeginEvent ----------------------------
 
@@ -1808,6 +1903,7 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
     }
     
     if(fDoMesonAnalysis){ // Meson Analysis
+      Bool_t cutParallel = fDoCutParallelMesons && IsCutParallelMesonCut(iCut);
       if(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseMCPSmearing() && fIsMC > 0 ){
         fUnsmearedPx = new Double_t[fGammaCandidates->GetEntries()]; // Store unsmeared Momenta
         fUnsmearedPy = new Double_t[fGammaCandidates->GetEntries()];
@@ -1823,7 +1919,8 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
         }
       }
 
-      CalculatePi0Candidates(); // Combine Gammas
+      if(cutParallel) AddCutParallelPhotons(); // Gammas are combined after the loop over the cuts
+      else CalculatePi0Candidates(); // Combine Gammas
       if(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->DoBGCalculation()){
         if(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->BackgroundHandlerType() == 0){
           CalculateBackground(); // Combinatorial Background
@@ -1846,7 +1943,7 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
         delete[] fUnsmearedE;  fUnsmearedE  = 0x0;
       }
 
-      if( fIsMC > 0 ){
+      if( fIsMC > 0 && !cutParallel ){
         vecDoubleCountTruePi0s.clear();
         vecDoubleCountTrueEtas.clear();
         FillMultipleCountHistoAndClear(mapMultipleCountTruePi0s,fHistoMultipleCountTruePi0[iCut]);
@@ -1862,6 +1959,8 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
     fGammaCandidates->Clear(); // delete this cuts good gammas
   }
 
+  if(fDoCutParallelMesons && fDoMesonAnalysis) CalculatePi0CandidatesCutParallel(); // Combine Gammas of all cuts in the shared pass
+
   if( fIsMC > 0 && fInputEvent->IsA()==AliAODEvent::Class() && !(fV0Reader->AreAODsRelabeled())){
     RelabelAODPhotonCandidates(kFALSE); // Back to ESDMC Label
     fV0Reader->RelabelAODs(kFALSE);
@@ -2908,107 +3007,252 @@ void AliAnalysisTaskGammaConvV1::CalculatePi0Candidates(){
         pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
         pi0cand->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
         
-        if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
-          if(fDoCentralityFlat > 0){
-            fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
-            if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[fiCut]->Fill(pi0cand->M(),pi0cand->E(), fWeightCentrality[fiCut]*fWeightJetJetMC);
-          } else {
-            fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
-            if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[fiCut]->Fill(pi0cand->M(),pi0cand->E(),fWeightJetJetMC);
-          }
-          
-          if (fDoMesonQA > 0){
+        FillMesonCandidate(fiCut,pi0cand,gamma0,gamma1,fGammaCandidates->GetEntries(),fWeightJetJetMC);
+        delete pi0cand;
+        pi0cand=0x0;
+      }
+    }
+  }
+}
 
-            if(fDoMesonQA == 3 && TMath::Abs(gamma0->GetConversionRadius()-gamma1->GetConversionRadius())<10 && pi0cand->GetOpeningAngle()<0.1){
-                    Double_t sparesFill[4] = {gamma0->GetPhotonPt(),gamma0->GetConversionRadius(),TMath::Abs(gamma0->GetConversionRadius()-gamma1->GetConversionRadius()),pi0cand->GetOpeningAngle()};
-                    sPtRDeltaROpenAngle[fiCut]->Fill(sparesFill, 1);
-            }
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvV1::FillMesonCandidate(Int_t iCut, AliAODConversionMother *pi0cand, AliAODConversionPhoton *gamma0, AliAODConversionPhoton *gamma1, Int_t nGammaCandidates, Double_t weight, Bool_t checkSelection){
 
-            if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
-              if (fIsMC < 2){
-                fHistoMotherPi0PtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift());
-                fHistoMotherPi0PtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle());
-              }
-              fHistoMotherPi0PtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()),fWeightJetJetMC);
-              
-            } 
-            if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
-              if (fIsMC < 2){
-                fHistoMotherEtaPtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift());
-                fHistoMotherEtaPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle());
-              } 
-              fHistoMotherEtaPtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()),fWeightJetJetMC);
-            }
-          }   
-          if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
-            Int_t psibin = 0;
-            Int_t zbin = 0;
-            Int_t mbin = 0;
-
-            Double_t sparesFill[4];
-            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
-              zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
-              if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
-              } else {
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fGammaCandidates->GetEntries());
-              }
-              sparesFill[0] = pi0cand->M();
-              sparesFill[1] = pi0cand->Pt();
-              sparesFill[2] = (Double_t)zbin; 
-              sparesFill[3] = (Double_t)mbin;
-            } else {
-              psibin = fBGHandlerRP[fiCut]->GetRPBinIndex(TMath::Abs(fEventPlaneAngle));
-              zbin = fBGHandlerRP[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
-//               if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
-//                 mbin = fBGHandlerRP[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
+  // Fills one same event gamma-gamma pair into the histograms of cut iCut
+  // nGammaCandidates: number of photon candidates of the cut, weight: jet-jet MC weight of the cut
+  // checkSelection: kFALSE if the pair already passed the meson cut (cut-parallel pass with threads)
+  if(!checkSelection || (((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(iCut))->GetEtaShift()))){
+    if(fDoCentralityFlat > 0){
+      fHistoMotherInvMassPt[iCut]->Fill(pi0cand->M(),pi0cand->Pt(), fWeightCentrality[iCut]*weight);
+      if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[iCut]->Fill(pi0cand->M(),pi0cand->E(), fWeightCentrality[iCut]*weight);
+    } else {
+      fHistoMotherInvMassPt[iCut]->Fill(pi0cand->M(),pi0cand->Pt(),weight);
+      if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[iCut]->Fill(pi0cand->M(),pi0cand->E(),weight);
+    }
+    
+    if (fDoMesonQA > 0){
+
+      if(fDoMesonQA == 3 && TMath::Abs(gamma0->GetConversionRadius()-gamma1->GetConversionRadius())<10 && pi0cand->GetOpeningAngle()<0.1){
+              Double_t sparesFill[4] = {gamma0->GetPhotonPt(),gamma0->GetConversionRadius(),TMath::Abs(gamma0->GetConversionRadius()-gamma1->GetConversionRadius()),pi0cand->GetOpeningAngle()};
+              sPtRDeltaROpenAngle[iCut]->Fill(sparesFill, 1);
+      }
+
+      if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
+        if (fIsMC < 2){
+          fHistoMotherPi0PtY[iCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(iCut))->GetEtaShift());
+          fHistoMotherPi0PtOpenAngle[iCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle());
+        }
+        fHistoMotherPi0PtAlpha[iCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()),weight);
+        
+      } 
+      if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
+        if (fIsMC < 2){
+          fHistoMotherEtaPtY[iCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(iCut))->GetEtaShift());
+          fHistoMotherEtaPtOpenAngle[iCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle());
+        } 
+        fHistoMotherEtaPtAlpha[iCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()),weight);
+      }
+    }   
+    if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->DoBGCalculation()){
+      Int_t psibin = 0;
+      Int_t zbin = 0;
+      Int_t mbin = 0;
+
+      Double_t sparesFill[4];
+      if(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->BackgroundHandlerType() == 0){
+        zbin = fBGHandler[iCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+        if(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseTrackMultiplicity()){
+          mbin = fBGHandler[iCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
+        } else {
+          mbin = fBGHandler[iCut]->GetMultiplicityBinIndex(nGammaCandidates);
+        }
+        sparesFill[0] = pi0cand->M();
+        sparesFill[1] = pi0cand->Pt();
+        sparesFill[2] = (Double_t)zbin; 
+        sparesFill[3] = (Double_t)mbin;
+      } else {
+        psibin = fBGHandlerRP[iCut]->GetRPBinIndex(TMath::Abs(fEventPlaneAngle));
+        zbin = fBGHandlerRP[iCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+//               if(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseTrackMultiplicity()){
+//                 mbin = fBGHandlerRP[iCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
 //               } else {
-//                 mbin = fBGHandlerRP[fiCut]->GetMultiplicityBinIndex(fGammaCandidates->GetEntries());
+//                 mbin = fBGHandlerRP[iCut]->GetMultiplicityBinIndex(nGammaCandidates);
 //               }
-              sparesFill[0] = pi0cand->M();
-              sparesFill[1] = pi0cand->Pt();
-              sparesFill[2] = (Double_t)zbin; 
-              sparesFill[3] = (Double_t)psibin;              
-            }
+        sparesFill[0] = pi0cand->M();
+        sparesFill[1] = pi0cand->Pt();
+        sparesFill[2] = (Double_t)zbin; 
+        sparesFill[3] = (Double_t)psibin;              
+      }
 //             Double_t sparesFill[4] = {pi0cand->M(),pi0cand->Pt(),(Double_t)zbin,(Double_t)mbin};
-            if(fDoCentralityFlat > 0) sESDMotherInvMassPtZM[fiCut]->Fill(sparesFill, fWeightCentrality[fiCut]*fWeightJetJetMC); //instead of weight 1
-            else  sESDMotherInvMassPtZM[fiCut]->Fill(sparesFill, fWeightJetJetMC);
-          }
-          
+      if(fDoCentralityFlat > 0) sESDMotherInvMassPtZM[iCut]->Fill(sparesFill, fWeightCentrality[iCut]*weight); //instead of weight 1
+      else  sESDMotherInvMassPtZM[iCut]->Fill(sparesFill, weight);
+    }
+    
 
-          if( fIsMC > 0 ){
-            if(fInputEvent->IsA()==AliESDEvent::Class())
-              ProcessTrueMesonCandidates(pi0cand,gamma0,gamma1);
-            if(fInputEvent->IsA()==AliAODEvent::Class())
-              ProcessTrueMesonCandidatesAOD(pi0cand,gamma0,gamma1);
-          }
-          if (fDoMesonQA == 2){
-            fInvMass = pi0cand->M();
-            fPt  = pi0cand->Pt();
-            if (TMath::Abs(gamma0->GetDCAzToPrimVtx()) < TMath::Abs(gamma1->GetDCAzToPrimVtx())){
-              fDCAzGammaMin = gamma0->GetDCAzToPrimVtx();
-              fDCAzGammaMax = gamma1->GetDCAzToPrimVtx();
-            } else {
-              fDCAzGammaMin = gamma1->GetDCAzToPrimVtx();
-              fDCAzGammaMax = gamma0->GetDCAzToPrimVtx();
-            }
-            iFlag = pi0cand->GetMesonQuality();
+    if( fIsMC > 0 ){
+      if(fInputEvent->IsA()==AliESDEvent::Class())
+        ProcessTrueMesonCandidates(pi0cand,gamma0,gamma1);
+      if(fInputEvent->IsA()==AliAODEvent::Class())
+        ProcessTrueMesonCandidatesAOD(pi0cand,gamma0,gamma1);
+    }
+    if (fDoMesonQA == 2){
+      fInvMass = pi0cand->M();
+      fPt  = pi0cand->Pt();
+      if (TMath::Abs(gamma0->GetDCAzToPrimVtx()) < TMath::Abs(gamma1->GetDCAzToPrimVtx())){
+        fDCAzGammaMin = gamma0->GetDCAzToPrimVtx();
+        fDCAzGammaMax = gamma1->GetDCAzToPrimVtx();
+      } else {
+        fDCAzGammaMin = gamma1->GetDCAzToPrimVtx();
+        fDCAzGammaMax = gamma0->GetDCAzToPrimVtx();
+      }
+      iFlag = pi0cand->GetMesonQuality();
     //                   cout << "gamma 0: " << gamma0->GetV0Index()<< "\t" << gamma0->GetPx() << "\t" << gamma0->GetPy() << "\t" <<  gamma0->GetPz() << "\t" << endl; 
     //                   cout << "gamma 1: " << gamma1->GetV0Index()<< "\t"<< gamma1->GetPx() << "\t" << gamma1->GetPy() << "\t" <<  gamma1->GetPz() << "\t" << endl; 
     //                    cout << "pi0: "<<fInvMass << "\t" << fPt <<"\t" << fDCAzGammaMin << "\t" << fDCAzGammaMax << "\t" << (Int_t)iFlag << "\t" << (Int_t)iMesonMCInfo <<endl;
-            if (fIsHeavyIon == 1 && fPt > 0.399 && fPt < 20. ) {
-              if (fInvMass > 0.08 && fInvMass < 0.2) tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
-              if ((fInvMass > 0.45 && fInvMass < 0.6) &&  (fPt > 0.999 && fPt < 20.) )tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
-            } else if (fPt > 0.299 && fPt < 20. )  {
-              if ( (fInvMass > 0.08 && fInvMass < 0.6) ) tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
-            }   
-          }
-        }
-        delete pi0cand;
-        pi0cand=0x0;
+      if (fIsHeavyIon == 1 && fPt > 0.399 && fPt < 20. ) {
+        if (fInvMass > 0.08 && fInvMass < 0.2) tESDMesonsInvMassPtDcazMinDcazMaxFlag[iCut]->Fill();
+        if ((fInvMass > 0.45 && fInvMass < 0.6) &&  (fPt > 0.999 && fPt < 20.) )tESDMesonsInvMassPtDcazMinDcazMaxFlag[iCut]->Fill();
+      } else if (fPt > 0.299 && fPt < 20. )  {
+        if ( (fInvMass > 0.08 && fInvMass < 0.6) ) tESDMesonsInvMassPtDcazMinDcazMaxFlag[iCut]->Fill();
+      }   
+    }
+  }
+}
+
+//________________________________________________________________________
+Bool_t AliAnalysisTaskGammaConvV1::IsCutParallelMesonCut(Int_t iCut){
+
+  // Cut configurations whose same event pairs can be built in the shared pass
+  if (iCut >= 64) return kFALSE; // one bit per cut in fCutParallelCuts
+  // the smeared photons differ between the cut configurations
+  if (fIsMC > 0 && ((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseMCPSmearing()) return kFALSE;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvV1::AddCutParallelPhotons(){
+
+  // Marks the photon candidates of the current cut in the cut masks of the reader photons
+  // (fGammaCandidates is a subset of fReaderGammas in the same order)
+  const Int_t nReader = fReaderGammas->GetEntriesFast();
+  Int_t readerIndex = 0;
+  for(Int_t i = 0; i < fGammaCandidates->GetEntries(); i++){
+    TObject *gamma = fGammaCandidates->At(i);
+    while (readerIndex < nReader && fReaderGammas->At(readerIndex) != gamma) readerIndex++;
+    if (readerIndex == nReader){
+      readerIndex = fReaderGammas->IndexOf(gamma);
+      if (readerIndex < 0){
+        readerIndex = 0;
+        continue;
+      }
+    }
+    fCutParallelPhotonCuts[readerIndex] |= ((ULong64_t)1) << fiCut;
+  }
+  fCutParallelNGammas[fiCut] = fGammaCandidates->GetEntries();
+  fCutParallelWeight[fiCut] = fWeightJetJetMC;
+  fCutParallelCuts |= ((ULong64_t)1) << fiCut;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvV1::CalculatePi0CandidatesCutParallel(){
+
+  // Builds the same event gamma-gamma pairs once for all cuts marked in AddCutParallelPhotons
+  // and fills each pair into the cuts which selected both photons
+
+  if (!fCutParallelCuts) return;
+
+  const Int_t nReader = fReaderGammas->GetEntriesFast();
+  for(Int_t firstGammaIndex=0;firstGammaIndex<nReader-1;firstGammaIndex++){
+    ULong64_t firstGammaCuts = fCutParallelPhotonCuts[firstGammaIndex];
+    if (!firstGammaCuts) continue;
+    AliAODConversionPhoton *gamma0=(AliAODConversionPhoton*)fReaderGammas->At(firstGammaIndex);
+    for(Int_t secondGammaIndex=firstGammaIndex+1;secondGammaIndex<nReader;secondGammaIndex++){
+      ULong64_t pairCuts = firstGammaCuts & fCutParallelPhotonCuts[secondGammaIndex];
+      if (!pairCuts) continue;
+      AliAODConversionPhoton *gamma1=(AliAODConversionPhoton*)fReaderGammas->At(secondGammaIndex);
+      //Check for same Electron ID
+      if(gamma0->GetTrackLabelPositive() == gamma1->GetTrackLabelPositive() ||
+      gamma0->GetTrackLabelNegative() == gamma1->GetTrackLabelNegative() ||
+      gamma0->GetTrackLabelNegative() == gamma1->GetTrackLabelPositive() ||
+      gamma0->GetTrackLabelPositive() == gamma1->GetTrackLabelNegative() ) continue;
+
+      AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
+      pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
+      pi0cand->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
+      fCutParallelMothers.push_back(pi0cand);
+      fCutParallelMotherCuts.push_back(pairCuts);
+    }
+  }
+
+  if (fCutParallelPool){
+    // the meson selection fills the QA histograms of the cut objects and evaluates their TF1s,
+    // it runs here on the calling thread; the threads only fill the histograms of the task,
+    // each cut is filled by one thread
+    fCutParallelThreadCuts.clear();
+    for(Int_t iCut = 0; iCut < fnCuts && iCut < 64; iCut++){
+      if (!(fCutParallelCuts & (((ULong64_t)1) << iCut))) continue;
+      SelectMesonCandidatesCutParallel(iCut);
+      fCutParallelThreadCuts.push_back(iCut);
+    }
+    const Int_t nThreads = fCutParallelPool->GetNThreads();
+    fCutParallelPool->Run([this, nThreads](Int_t t) {
+      for(UInt_t k = t; k < fCutParallelThreadCuts.size(); k += nThreads) FillMesonCandidatesCutParallel(fCutParallelThreadCuts[k],kFALSE);
+    });
+  } else {
+    for(Int_t iCut = 0; iCut < fnCuts && iCut < 64; iCut++){
+      if (!(fCutParallelCuts & (((ULong64_t)1) << iCut))) continue;
+      fiCut = iCut;
+      fWeightJetJetMC = fCutParallelWeight[iCut];
+      FillMesonCandidatesCutParallel(iCut,kTRUE);
+      if( fIsMC > 0 ){
+        vecDoubleCountTruePi0s.clear();
+        vecDoubleCountTrueEtas.clear();
+        FillMultipleCountHistoAndClear(mapMultipleCountTruePi0s,fHistoMultipleCountTruePi0[iCut]);
+        FillMultipleCountHistoAndClear(mapMultipleCountTrueEtas,fHistoMultipleCountTrueEta[iCut]);
       }
     }
   }
+
+  for(UInt_t i = 0; i < fCutParallelMothers.size(); i++) delete fCutParallelMothers[i];
+  fCutParallelMothers.clear();
+  fCutParallelMotherCuts.clear();
+}
+
+//________________________________________________________________________
+Bool_t AliAnalysisTaskGammaConvV1::UseCutParallelThreads(){
+
+  // The histograms of the task are disjoint between the cuts, the MC matching and the meson tree are not
+  return fNCutParallelThreads > 1 && fIsMC == 0 && fDoMesonQA != 2;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvV1::SelectMesonCandidatesCutParallel(Int_t iCut){
+
+  // Applies the meson cut iCut to the pairs of the shared pass and removes the cut from the mask
+  // of the rejected pairs
+  const ULong64_t cutBit = ((ULong64_t)1) << iCut;
+  AliConversionMesonCuts *mesonCuts = (AliConversionMesonCuts*)fMesonCutArray->At(iCut);
+  Double_t etaShift = ((AliConvEventCuts*)fEventCutArray->At(iCut))->GetEtaShift();
+  for(UInt_t i = 0; i < fCutParallelMothers.size(); i++){
+    if (!(fCutParallelMotherCuts[i] & cutBit)) continue;
+    if (!mesonCuts->MesonIsSelected(fCutParallelMothers[i],kTRUE,etaShift)) fCutParallelMotherCuts[i] &= ~cutBit;
+  }
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvV1::FillMesonCandidatesCutParallel(Int_t iCut, Bool_t checkSelection){
+
+  // Fills the pairs of the shared pass selected by cut iCut
+  // checkSelection: kFALSE if SelectMesonCandidatesCutParallel was already called for the cut
+  const ULong64_t cutBit = ((ULong64_t)1) << iCut;
+  for(UInt_t i = 0; i < fCutParallelMothers.size(); i++){
+    if (!(fCutParallelMotherCuts[i] & cutBit)) continue;
+    AliAODConversionMother *pi0cand = fCutParallelMothers[i];
+    FillMesonCandidate(iCut,pi0cand,
+                       (AliAODConversionPhoton*)fReaderGammas->At(pi0cand->GetLabel1()),
+                       (AliAODConversionPhoton*)fReaderGammas->At(pi0cand->GetLabel2()),
+                       fCutParallelNGammas[iCut],fCutParallelWeight[iCut],checkSelection);
+  }
 }
 
 //______________________________________________________________________
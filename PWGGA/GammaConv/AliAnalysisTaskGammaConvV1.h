@@ -17,6 +17,8 @@
 #include <vector>
 #include <map>
 
+class AliGammaConvV1WorkerPool;
+
 class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
 
   public:
@@ -43,9 +45,18 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     void SetDoPlotVsCentrality(Bool_t flag)                       { fDoPlotVsCentrality         = flag    ;}
     void SetDoTHnSparse(Bool_t flag)                              { fDoTHnSparse                = flag    ;}
     void SetDoCentFlattening(Int_t flag)                          { fDoCentralityFlat           = flag    ;}
+    void SetDoCutParallelMesons(Bool_t flag, Int_t nThreads = 1)  { fDoCutParallelMesons        = flag    ;
+                                                                    fNCutParallelThreads        = nThreads;}
     void ProcessPhotonCandidates();
     void ProcessClusters();
     void CalculatePi0Candidates();
+    void FillMesonCandidate(Int_t iCut, AliAODConversionMother *pi0cand, AliAODConversionPhoton *gamma0, AliAODConversionPhoton *gamma1, Int_t nGammaCandidates, Double_t weight, Bool_t checkSelection = kTRUE);
+    Bool_t IsCutParallelMesonCut(Int_t iCut);
+    void AddCutParallelPhotons();
+    void CalculatePi0CandidatesCutParallel();
+    Bool_t UseCutParallelThreads();
+    void SelectMesonCandidatesCutParallel(Int_t iCut);
+    void FillMesonCandidatesCutParallel(Int_t iCut, Bool_t checkSelection);
     void CalculateBackground();
     void CalculateBackgroundRP();
     void ProcessMCParticles();
@@ -302,12 +313,22 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     Bool_t                            fDoMaterialBudgetWeightingOfGammasForTrueMesons;
     TTree*                            tBrokenFiles;                               // tree for keeping track of broken files
     TObjString*                       fFileNameBroken;                            // string object for broken file name
+    Bool_t                            fDoCutParallelMesons;                       // build the same event gamma-gamma pairs once for all cuts
+    Int_t                             fNCutParallelThreads;                       // number of threads filling the cuts in the shared pass (data only)
+    vector<ULong64_t>                 fCutParallelPhotonCuts;                     //! per reader photon: bit mask of the cuts which selected it
+    vector<Int_t>                     fCutParallelNGammas;                        //! per cut: number of photon candidates in the event
+    vector<Double_t>                  fCutParallelWeight;                         //! per cut: jet-jet MC weight of the event
+    ULong64_t                         fCutParallelCuts;                           //! bit mask of the cuts in the shared pass of the event
+    vector<AliAODConversionMother*>   fCutParallelMothers;                        //! pairs of the shared pass
+    vector<ULong64_t>                 fCutParallelMotherCuts;                     //! per pair: bit mask of the cuts which selected both photons
+    vector<Int_t>                     fCutParallelThreadCuts;                     //! cuts of the event filled by the worker threads
+    AliGammaConvV1WorkerPool*         fCutParallelPool;                           //! worker threads of the shared pass, started once in UserCreateOutputObjects
 
   private:
 
     AliAnalysisTaskGammaConvV1(const AliAnalysisTaskGammaConvV1&); // Prevent copy-construction
     AliAnalysisTaskGammaConvV1 &operator=(const AliAnalysisTaskGammaConvV1&); // Prevent assignment
-    ClassDef(AliAnalysisTaskGammaConvV1, 42);
+    ClassDef(AliAnalysisTaskGammaConvV1, 43);
 };
 
 #endif
@@ -24,6 +24,7 @@
 #include "AliAODEvent.h"
 #include "AliCaloTrackMatcher.h"
 #include "AliEMCALRecoUtils.h"
+#include "AliEmcalTrackMatchCache.h"
 #include "AliESDEvent.h"
 #include "AliESDtrack.h"
 #include "AliESDtrackCuts.h"
@@ -55,6 +56,7 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType) :
   fMatchingWindow(200),
   fMatchingResidual(0.2),
   fRunNumber(-1),
+  fUseMatchCache(kFALSE),
   fGeomEMCAL(NULL),
   fGeomPHOS(NULL),
   fMapTrackToCluster(),
@@ -214,6 +216,23 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     }
   }
 
+  // propagations shared with the other track matchers in this event
+  AliEmcalTrackMatchCache* cache = 0;
+  Int_t hypSurface = -1, hypCluster = -1;
+  if(fUseMatchCache){
+    cache = AliEmcalTrackMatchCache::Instance();
+    cache->BeginEvent(event);
+    // ESD tracks start from the inner parameters, AOD tracks from the parameters stored in the AOD
+    Int_t start = esdev ? AliEmcalTrackMatchCache::kInnerParamStart : AliEmcalTrackMatchCache::kAODParamStart;
+    if(fClusterType == 1 || fClusterType == 3){
+      hypSurface = cache->GetHypothesis(AliEmcalTrackMatchCache::kEMCal, 440., 0.139, 20., start);
+      hypCluster = cache->GetHypothesis(AliEmcalTrackMatchCache::kEMCal, 0., 0.139, 5., start);
+    }else if(fClusterType == 2){
+      hypSurface = cache->GetHypothesis(AliEmcalTrackMatchCache::kPHOS, 460., 0.139, 20., start);
+      hypCluster = cache->GetHypothesis(AliEmcalTrackMatchCache::kPHOS, 0., 0.139, 5., start);
+    }
+  }
+
   for (Int_t itr=0;itr<event->GetNumberOfTracks();itr++){
     AliExternalTrackParam *trackParam = 0;
     AliVTrack *inTrack = 0x0;
@@ -244,8 +263,14 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     Float_t eta, phi, pt;
 
     //propagate tracks to emc surfaces
+    Int_t cached = cache ? cache->FindPropagation(hypSurface, inTrack, &emcParam, eta, phi, pt) : AliEmcalTrackMatchCache::kNotCached;
     if(fClusterType == 1 || fClusterType == 3){
-      if (!AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&emcParam, 440., 0.139, 20., eta, phi, pt)) {
+      Bool_t propagated = (cached == AliEmcalTrackMatchCache::kPropagated);
+      if(cached == AliEmcalTrackMatchCache::kNotCached){
+        propagated = AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&emcParam, 440., 0.139, 20., eta, phi, pt);
+        if(cache) cache->AddPropagation(hypSurface, inTrack, propagated, &emcParam, eta, phi, pt);
+      }
+      if (!propagated) {
         delete trackParam;
         fHistControlMatches->Fill(2.,inTrack->Pt());
         continue;
@@ -277,7 +302,12 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
       }
 
     }else if(fClusterType == 2){
-      if( !AliTrackerBase::PropagateTrackToBxByBz(&emcParam, 460., 0.139, 20, kTRUE, 0.8, -1)){
+      Bool_t propagated = (cached == AliEmcalTrackMatchCache::kPropagated);
+      if(cached == AliEmcalTrackMatchCache::kNotCached){
+        propagated = AliTrackerBase::PropagateTrackToBxByBz(&emcParam, 460., 0.139, 20, kTRUE, 0.8, -1);
+        if(cache) cache->AddPropagation(hypSurface, inTrack, propagated, &emcParam, 0., 0., 0.);
+      }
+      if( !propagated ){
         delete trackParam;
         fHistControlMatches->Fill(3.,inTrack->Pt());
         continue;
@@ -304,19 +334,31 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
       if (dR > fMatchingWindow) continue;
       Double_t clusterR = TMath::Sqrt( clsPos[0]*clsPos[0] + clsPos[1]*clsPos[1] );
 
-      AliExternalTrackParam trackParamTmp(emcParam);//Retrieve the starting point every time before the extrapolation
       if(fClusterType == 1 || fClusterType == 3){
         if (!cluster->IsEMCAL()) continue;
-        if(!AliEMCALRecoUtils::ExtrapolateTrackToCluster(&trackParamTmp, cluster, 0.139, 5., dEta, dPhi)){fHistControlMatches->Fill(4.,inTrack->Pt()); continue;}
       }else if(fClusterType == 2){
         if (!cluster->IsPHOS()) continue;
-        if(!AliTrackerBase::PropagateTrackToBxByBz(&trackParamTmp, clusterR, 0.139, 5., kTRUE, 0.8, -1)){fHistControlMatches->Fill(4.,inTrack->Pt()); continue;}
-        Double_t trkPos[3] = {0,0,0};
-        trackParamTmp.GetXYZ(trkPos);
-        TVector3 trkPosVec(trkPos[0],trkPos[1],trkPos[2]);
-        TVector3 clsPosVec(clsPos);
-        dPhi = clsPosVec.DeltaPhi(trkPosVec);
-        dEta = clsPosVec.Eta()-trkPosVec.Eta();
+      }
+      cached = cache ? cache->FindResidual(hypCluster, inTrack, cluster, dEta, dPhi) : AliEmcalTrackMatchCache::kNotCached;
+      if(cached == AliEmcalTrackMatchCache::kFailed){fHistControlMatches->Fill(4.,inTrack->Pt()); continue;}
+      if(cached == AliEmcalTrackMatchCache::kNotCached){
+        AliExternalTrackParam trackParamTmp(emcParam);//Retrieve the starting point every time before the extrapolation
+        Bool_t propagated = kFALSE;
+        if(fClusterType == 1 || fClusterType == 3){
+          propagated = AliEMCALRecoUtils::ExtrapolateTrackToCluster(&trackParamTmp, cluster, 0.139, 5., dEta, dPhi);
+        }else if(fClusterType == 2){
+          propagated = AliTrackerBase::PropagateTrackToBxByBz(&trackParamTmp, clusterR, 0.139, 5., kTRUE, 0.8, -1);
+          if(propagated){
+            Double_t trkPos[3] = {0,0,0};
+            trackParamTmp.GetXYZ(trkPos);
+            TVector3 trkPosVec(trkPos[0],trkPos[1],trkPos[2]);
+            TVector3 clsPosVec(clsPos);
+            dPhi = clsPosVec.DeltaPhi(trkPosVec);
+            dEta = clsPosVec.Eta()-trkPosVec.Eta();
+          }
+        }
+        if(cache) cache->AddResidual(hypCluster, inTrack, cluster, propagated, dEta, dPhi);
+        if(!propagated){fHistControlMatches->Fill(4.,inTrack->Pt()); continue;}
       }
 
 
@@ -423,9 +465,23 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
   Float_t dPhiTemp = 0;
   Float_t dEtaTemp = 0;
 
+  // propagations shared with the other track matchers in this event
+  AliEmcalTrackMatchCache* cache = 0;
+  if(fUseMatchCache){
+    cache = AliEmcalTrackMatchCache::Instance();
+    cache->BeginEvent(event);
+  }
+  Int_t cached = AliEmcalTrackMatchCache::kNotCached;
+  Int_t start = esdt ? AliEmcalTrackMatchCache::kInnerParamStart : AliEmcalTrackMatchCache::kAODParamStart;
+
   if(cluster->IsEMCAL()){
     Float_t eta = 0;Float_t phi = 0;Float_t pt = 0;
-    propagated = AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&emcParam, 430, 0.000510999, 20, eta, phi, pt);
+    Int_t hypSurface = cache ? cache->GetHypothesis(AliEmcalTrackMatchCache::kEMCal, 430., 0.000510999, 20., start) : -1;
+    if(cache) cached = cache->FindPropagation(hypSurface, inSecTrack, &emcParam, eta, phi, pt);
+    if(cached == AliEmcalTrackMatchCache::kNotCached){
+      propagated = AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&emcParam, 430, 0.000510999, 20, eta, phi, pt);
+      if(cache) cache->AddPropagation(hypSurface, inSecTrack, propagated, &emcParam, eta, phi, pt);
+    }else propagated = (cached == AliEmcalTrackMatchCache::kPropagated);
     if(propagated){
       if( TMath::Abs(eta) > 0.8 ) {
         delete trackParam;
@@ -441,7 +497,12 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
         return kFALSE;
       }
 
-      propagated = AliEMCALRecoUtils::ExtrapolateTrackToCluster(&emcParam, cluster, 0.000510999, 5, dEtaTemp, dPhiTemp);
+      Int_t hypCluster = cache ? cache->GetHypothesis(AliEmcalTrackMatchCache::kEMCal, 0., 0.000510999, 5., start) : -1;
+      cached = cache ? cache->FindResidual(hypCluster, inSecTrack, cluster, dEtaTemp, dPhiTemp) : AliEmcalTrackMatchCache::kNotCached;
+      if(cached == AliEmcalTrackMatchCache::kNotCached){
+        propagated = AliEMCALRecoUtils::ExtrapolateTrackToCluster(&emcParam, cluster, 0.000510999, 5, dEtaTemp, dPhiTemp);
+        if(cache) cache->AddResidual(hypCluster, inSecTrack, cluster, propagated, dEtaTemp, dPhiTemp);
+      }else propagated = (cached == AliEmcalTrackMatchCache::kPropagated);
       if(!propagated){
         delete trackParam;
         fSecHistControlMatches->Fill(4.,inSecTrack->Pt());
@@ -456,15 +517,21 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
     }
 
   }else if(cluster->IsPHOS()){
-    propagated = AliTrackerBase::PropagateTrackToBxByBz(&emcParam, clusterR, 0.000510999, 20, kTRUE, 0.8, -1);
-    if (propagated){
-      Double_t trkPos[3] = {0,0,0};
-      emcParam.GetXYZ(trkPos);
-      TVector3 trkPosVec(trkPos[0],trkPos[1],trkPos[2]);
-      TVector3 clsPosVec(clusterPosition);
-      dPhiTemp = clsPosVec.DeltaPhi(trkPosVec);
-      dEtaTemp = clsPosVec.Eta()-trkPosVec.Eta();
-    }else{
+    Int_t hypCluster = cache ? cache->GetHypothesis(AliEmcalTrackMatchCache::kPHOS, 0., 0.000510999, 20., start) : -1;
+    if(cache) cached = cache->FindResidual(hypCluster, inSecTrack, cluster, dEtaTemp, dPhiTemp);
+    if(cached == AliEmcalTrackMatchCache::kNotCached){
+      propagated = AliTrackerBase::PropagateTrackToBxByBz(&emcParam, clusterR, 0.000510999, 20, kTRUE, 0.8, -1);
+      if (propagated){
+        Double_t trkPos[3] = {0,0,0};
+        emcParam.GetXYZ(trkPos);
+        TVector3 trkPosVec(trkPos[0],trkPos[1],trkPos[2]);
+        TVector3 clsPosVec(clusterPosition);
+        dPhiTemp = clsPosVec.DeltaPhi(trkPosVec);
+        dEtaTemp = clsPosVec.Eta()-trkPosVec.Eta();
+      }
+      if(cache) cache->AddResidual(hypCluster, inSecTrack, cluster, propagated, dEtaTemp, dPhiTemp);
+    }else propagated = (cached == AliEmcalTrackMatchCache::kPropagated);
+    if (!propagated){
       delete trackParam;
       fSecHistControlMatches->Fill(2.,inSecTrack->Pt());
       fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
@@ -522,8 +589,9 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  mapT::const_iterator itPos = fMap_TrID_ClID_ToIndex.find(make_pair(trackID,clusterID));
+  if(itPos == fMap_TrID_ClID_ToIndex.end() || itPos->second == 0) return kFALSE;
+  Int_t position = itPos->second;
 
   pairFloat tempEtaPhi = fVectorDeltaEtaDeltaPhi.at(position-1);
   dEta = tempEtaPhi.first;
@@ -534,7 +602,8 @@ Bool_t AliCaloTrackMatcher::GetTrackClusterMatchingResidual(Int_t trackID, Int_t
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   Int_t matched = 0;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fMapClusterToTrack.equal_range(clusterID);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -558,7 +627,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   Int_t matched = 0;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fMapClusterToTrack.equal_range(clusterID);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -583,7 +653,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
   Int_t matched = 0;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fMapClusterToTrack.equal_range(clusterID);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -615,7 +686,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fMapTrackToCluster.equal_range(TrackPos);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -650,7 +722,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fMapTrackToCluster.equal_range(TrackPos);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -688,7 +761,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fMapTrackToCluster.equal_range(TrackPos);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -703,7 +777,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fMapClusterToTrack.equal_range(clusterID);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -726,7 +801,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fMapClusterToTrack.equal_range(clusterID);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -752,7 +828,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  Float_t dR){
   vector<Int_t> tempMatchedTracks;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fMapClusterToTrack.equal_range(clusterID);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -783,7 +860,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fMapTrackToCluster.equal_range(TrackPos);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -819,7 +897,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fMapTrackToCluster.equal_range(TrackPos);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -856,7 +935,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fMapTrackToCluster.equal_range(TrackPos);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -873,8 +953,9 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetSecTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fSecMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  mapT::const_iterator itPos = fSecMap_TrID_ClID_ToIndex.find(make_pair(trackID,clusterID));
+  if(itPos == fSecMap_TrID_ClID_ToIndex.end() || itPos->second == 0) return kFALSE;
+  Int_t position = itPos->second;
 
   pairFloat tempEtaPhi = fSecVectorDeltaEtaDeltaPhi.at(position-1);
   dEta = tempEtaPhi.first;
@@ -883,15 +964,16 @@ Bool_t AliCaloTrackMatcher::GetSecTrackClusterMatchingResidual(Int_t trackID, In
 }
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::IsSecTrackClusterAlreadyTried(Int_t trackID, Int_t clusterID){
-  Int_t position = fSecMap_TrID_ClID_AlreadyTried[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  mapT::const_iterator itPos = fSecMap_TrID_ClID_AlreadyTried.find(make_pair(trackID,clusterID));
+  if(itPos == fSecMap_TrID_ClID_AlreadyTried.end() || itPos->second == 0) return kFALSE;
   else return kTRUE;
 }
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   Int_t matched = 0;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fSecMapClusterToTrack.equal_range(clusterID);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -915,7 +997,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, In
 Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   Int_t matched = 0;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fSecMapClusterToTrack.equal_range(clusterID);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -941,7 +1024,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, In
 Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
   Int_t matched = 0;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fSecMapClusterToTrack.equal_range(clusterID);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -973,7 +1057,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fSecMapTrackToCluster.equal_range(TrackPos);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1009,7 +1094,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fSecMapTrackToCluster.equal_range(TrackPos);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1048,7 +1134,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fSecMapTrackToCluster.equal_range(TrackPos);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1064,7 +1151,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
 vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fSecMapClusterToTrack.equal_range(clusterID);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -1088,7 +1176,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *ev
 vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fSecMapClusterToTrack.equal_range(clusterID);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -1114,7 +1203,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *ev
 vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
   vector<Int_t> tempMatchedTracks;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fSecMapClusterToTrack.equal_range(clusterID);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -1146,7 +1236,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *ev
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fSecMapTrackToCluster.equal_range(TrackPos);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1182,7 +1273,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *ev
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fSecMapTrackToCluster.equal_range(TrackPos);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1220,7 +1312,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *ev
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
+  pair<multimap<Int_t,Int_t>::iterator,multimap<Int_t,Int_t>::iterator> range = fSecMapTrackToCluster.equal_range(TrackPos);
+  for (it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
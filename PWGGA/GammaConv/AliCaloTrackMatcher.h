@@ -30,6 +30,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     void SetAnalysisTrainMode(TString mode){fAnalysisTrainMode = mode; return;}
     void SetMatchingResidual(Float_t res) {fMatchingResidual = res; return;}
     void SetMatchingWindow(Float_t win) {fMatchingWindow = win; return;}
+    void SetUseMatchCache(Bool_t use) {fUseMatchCache = use; return;}
 
     // for cluster <-> primary matching
     Bool_t GetTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi);
@@ -99,6 +100,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     Double_t              fMatchingWindow;         // matching window to prevent unnecessary propagations
     Float_t               fMatchingResidual;       // matching residual below which track <-> cluster associations should be stored
     Int_t                 fRunNumber;              // current run number
+    Bool_t                fUseMatchCache;          // share propagations with the other AliCaloTrackMatcher instances of the event with the same hypotheses (AliEmcalTrackMatchCache)
 
     AliEMCALGeometry*     fGeomEMCAL;              // pointer to EMCAL geometry
     AliPHOSGeometry*      fGeomPHOS;               // pointer to PHOS geometry
@@ -124,7 +126,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     TH2F*                 fHistControlMatches;     // bookkeeping for processed tracks/clusters and succesful matches
     TH2F*                 fSecHistControlMatches;  // bookkeeping for processed V0-tracks/clusters and succesful matches
 
-    ClassDef(AliCaloTrackMatcher,3)
+    ClassDef(AliCaloTrackMatcher,4)
 };
 
 #endif
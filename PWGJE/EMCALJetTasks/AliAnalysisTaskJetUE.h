@@ -45,7 +45,7 @@ class AliAnalysisTaskJetUE : public AliAnalysisTaskEmcalJetLight {
 
  protected:
   virtual void                        CalculateEventProperties();
-  void                                SortJets();
+  virtual void                        SortJets();
   Bool_t                              IsB2BEvent(std::string jetCollName = "Signal");
   Bool_t                              AreJetsOverlapping(AliEmcalJet* jet1, AliEmcalJet* jet2);
 
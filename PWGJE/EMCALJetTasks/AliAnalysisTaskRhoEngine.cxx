@@ -0,0 +1,643 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include <algorithm>
+
+#include <TF1.h>
+#include <TH2F.h>
+#include <TMath.h>
+#include <TLorentzVector.h>
+
+#include <AliLog.h>
+#include <AliVEventHandler.h>
+#include <AliAnalysisManager.h>
+#include <AliVCluster.h>
+
+#include "AliEmcalJet.h"
+#include "AliRhoParameter.h"
+#include "AliLocalRhoParameter.h"
+#include "AliJetContainer.h"
+#include "AliParticleContainer.h"
+#include "AliClusterContainer.h"
+
+#include "AliAnalysisTaskRhoEngine.h"
+
+/// \cond CLASSIMP
+ClassImp(AliAnalysisTaskRhoEngine);
+/// \endcond
+
+/**
+ * Default constructor. Needed by ROOT I/O
+ */
+AliAnalysisTaskRhoEngine::AliAnalysisTaskRhoEngine() :
+  AliAnalysisTaskRhoBaseDev(),
+  fNExclLeadJets(0),
+  fExclJetOverlap(),
+  fOutRhoSparseName(),
+  fOutRhoMassName(),
+  fOutLocalRhoName(),
+  fRhoMassType(kMd),
+  fPionMassClusters(kFALSE),
+  fSoftTrackMinPt(0.15),
+  fSoftTrackMaxPt(5.),
+  fExcludeLeadingJetsFromFit(1.),
+  fLocalRhoEtaGap(0.4),
+  fCompareLocalRhoName(),
+  fOutRhoSparse(nullptr),
+  fOutRhoMass(nullptr),
+  fOutLocalRho(nullptr),
+  fLocalRhoModulation(nullptr),
+  fLeadingJets(nullptr, nullptr),
+  fRhoValues(),
+  fRhoSparseValues(),
+  fRhoMassValues(),
+  fOccupancyFactor(0),
+  fHistOccCorrvsCent(nullptr),
+  fHistRhoSparseVsCent(nullptr),
+  fHistRhoMassVsCent(nullptr),
+  fHistV2VsCent(nullptr),
+  fHistV3VsCent(nullptr),
+  fHistLocalRhoRatioVsPhi(nullptr),
+  fHistLocalRhoRatioVsCent(nullptr)
+{
+}
+
+/**
+ * Standard constructor. Should be used by the user.
+ *
+ * @param[in] name  Name of the task
+ * @param[in] histo If kTRUE, the task will also produce QA histograms
+ */
+AliAnalysisTaskRhoEngine::AliAnalysisTaskRhoEngine(const char *name, Bool_t histo) :
+  AliAnalysisTaskRhoBaseDev(name, histo),
+  fNExclLeadJets(0),
+  fExclJetOverlap(),
+  fOutRhoSparseName(),
+  fOutRhoMassName(),
+  fOutLocalRhoName(),
+  fRhoMassType(kMd),
+  fPionMassClusters(kFALSE),
+  fSoftTrackMinPt(0.15),
+  fSoftTrackMaxPt(5.),
+  fExcludeLeadingJetsFromFit(1.),
+  fLocalRhoEtaGap(0.4),
+  fCompareLocalRhoName(),
+  fOutRhoSparse(nullptr),
+  fOutRhoMass(nullptr),
+  fOutLocalRho(nullptr),
+  fLocalRhoModulation(nullptr),
+  fLeadingJets(nullptr, nullptr),
+  fRhoValues(),
+  fRhoSparseValues(),
+  fRhoMassValues(),
+  fOccupancyFactor(0),
+  fHistOccCorrvsCent(nullptr),
+  fHistRhoSparseVsCent(nullptr),
+  fHistRhoMassVsCent(nullptr),
+  fHistV2VsCent(nullptr),
+  fHistV3VsCent(nullptr),
+  fHistLocalRhoRatioVsPhi(nullptr),
+  fHistLocalRhoRatioVsCent(nullptr)
+{
+}
+
+/**
+ * Destructor
+ */
+AliAnalysisTaskRhoEngine::~AliAnalysisTaskRhoEngine()
+{
+  delete fLocalRhoModulation;
+}
+
+/**
+ * Performing run-independent initialization.
+ * Here the histograms should be instantiated.
+ */
+void AliAnalysisTaskRhoEngine::UserCreateOutputObjects()
+{
+  if (!fCreateHisto) return;
+
+  AliAnalysisTaskRhoBaseDev::UserCreateOutputObjects();
+
+  Double_t maxRho = 500;
+  if (fForceBeamType == kpp) {
+    maxRho = 50;
+  }
+  else if (fForceBeamType == kpA) {
+    maxRho = 200;
+  }
+
+  if (!fOutRhoSparseName.IsNull()) {
+    fHistOccCorrvsCent = new TH2F("fHistOccCorrvsCent", "fHistOccCorrvsCent;Centrality (%);#it{C}", 100, 0, 100, 2000, 0 , 2);
+    fOutput->Add(fHistOccCorrvsCent);
+
+    fHistRhoSparseVsCent = new TH2F("fHistRhoSparseVsCent", "fHistRhoSparseVsCent;Centrality (%);#rho_{sparse} (GeV/#it{c} #times rad^{-1})", 100, 0, 100, 500, 0, maxRho);
+    fOutput->Add(fHistRhoSparseVsCent);
+  }
+
+  if (!fOutRhoMassName.IsNull()) {
+    fHistRhoMassVsCent = new TH2F("fHistRhoMassVsCent", "fHistRhoMassVsCent;Centrality (%);#rho_{m} (GeV/#it{c}^{2} #times rad^{-1})", 100, 0, 100, 500, 0, maxRho / 10);
+    fOutput->Add(fHistRhoMassVsCent);
+  }
+
+  if (!fOutLocalRhoName.IsNull()) {
+    fHistV2VsCent = new TH2F("fHistV2VsCent", "fHistV2VsCent;Centrality (%);#it{v}_{2}", 100, 0, 100, 200, -1, 1);
+    fOutput->Add(fHistV2VsCent);
+
+    fHistV3VsCent = new TH2F("fHistV3VsCent", "fHistV3VsCent;Centrality (%);#it{v}_{3}", 100, 0, 100, 200, -1, 1);
+    fOutput->Add(fHistV3VsCent);
+
+    if (!fCompareLocalRhoName.IsNull()) {
+      fHistLocalRhoRatioVsPhi = new TH2F("fHistLocalRhoRatioVsPhi", "fHistLocalRhoRatioVsPhi;#varphi;#rho(#varphi) / #rho_{ref}(#varphi)", 18, 0, TMath::TwoPi(), 200, 0, 2);
+      fOutput->Add(fHistLocalRhoRatioVsPhi);
+
+      fHistLocalRhoRatioVsCent = new TH2F("fHistLocalRhoRatioVsCent", "fHistLocalRhoRatioVsCent;Centrality (%);#rho(#varphi) / #rho_{ref}(#varphi)", 100, 0, 100, 200, 0, 2);
+      fOutput->Add(fHistLocalRhoRatioVsCent);
+    }
+  }
+}
+
+/**
+ * Init the analysis: create the additional output objects and attach them to the event.
+ */
+void AliAnalysisTaskRhoEngine::ExecOnce()
+{
+  if (!fOutRhoSparseName.IsNull() && !fOutRhoSparse) {
+    fOutRhoSparse = new AliRhoParameter(fOutRhoSparseName, 0);
+
+    if (fAttachToEvent) {
+      if (!(InputEvent()->FindListObject(fOutRhoSparseName))) {
+        InputEvent()->AddObject(fOutRhoSparse);
+      } else {
+        AliFatal(Form("%s: Container with same name %s already present. Aborting", GetName(), fOutRhoSparseName.Data()));
+        return;
+      }
+    }
+  }
+
+  if (!fOutRhoMassName.IsNull() && !fOutRhoMass) {
+    fOutRhoMass = new AliRhoParameter(fOutRhoMassName, 0);
+
+    if (fAttachToEvent) {
+      if (!(InputEvent()->FindListObject(fOutRhoMassName))) {
+        InputEvent()->AddObject(fOutRhoMass);
+      } else {
+        AliFatal(Form("%s: Container with same name %s already present. Aborting", GetName(), fOutRhoMassName.Data()));
+        return;
+      }
+    }
+  }
+
+  if (!fOutLocalRhoName.IsNull() && !fOutLocalRho) {
+    fOutLocalRho = new AliLocalRhoParameter(fOutLocalRhoName, 0);
+    // same parametrization as the combined v2 and v3 fit of AliAnalysisTaskLocalRho
+    fLocalRhoModulation = new TF1(Form("%s_modulation", fOutLocalRhoName.Data()), "[0]*([1]+[2]*([3]*TMath::Cos([2]*(x-[4]))+[7]*TMath::Cos([5]*(x-[6]))))", 0, TMath::TwoPi());
+    fLocalRhoModulation->FixParameter(1, 1.);
+    fLocalRhoModulation->FixParameter(2, 2.);
+    fLocalRhoModulation->FixParameter(5, 3.);
+
+    if (fAttachToEvent) {
+      if (!(InputEvent()->FindListObject(fOutLocalRhoName))) {
+        InputEvent()->AddObject(fOutLocalRho);
+      } else {
+        AliFatal(Form("%s: Container with same name %s already present. Aborting", GetName(), fOutLocalRhoName.Data()));
+        return;
+      }
+    }
+  }
+
+  AliAnalysisTaskRhoBaseDev::ExecOnce();
+}
+
+/**
+ * Replaces the sorting of the jets of the base class: only the number of jets, their total area
+ * and the leading jets are needed, which are found in a single loop over the jets.
+ * The sorted jet lists are not filled.
+ */
+void AliAnalysisTaskRhoEngine::SortJets()
+{
+  fLeadingJets = std::make_pair(nullptr, nullptr);
+
+  for (auto jetCont : fJetCollArray) {
+    AliEmcalJet* leadingJet = nullptr;
+    AliEmcalJet* subleadingJet = nullptr;
+    Int_t nJets = 0;
+    Double_t totArea = 0;
+
+    for (auto jet : jetCont.second->accepted()) {
+      if (!jet->IsGhost()) {
+        nJets++;
+        totArea += jet->Area();
+      }
+      if (!leadingJet || jet->Pt() > leadingJet->Pt()) {
+        subleadingJet = leadingJet;
+        leadingJet = jet;
+      }
+      else if (!subleadingJet || jet->Pt() > subleadingJet->Pt()) {
+        subleadingJet = jet;
+      }
+    }
+
+    fLeadingJet[jetCont.first] = leadingJet;
+    fNjets[jetCont.first] = nJets;
+    fTotJetArea[jetCont.first] = totArea;
+    fSortedJets[jetCont.first].clear();
+
+    if (jetCont.first == "Background") {
+      if (fNExclLeadJets > 0) fLeadingJets.first = leadingJet;
+      if (fNExclLeadJets > 1) fLeadingJets.second = subleadingJet;
+    }
+  }
+}
+
+/**
+ * Median of a set of values, the average of the two central values for an even number of values
+ * (as TMath::Median). The values are partially reordered.
+ * @param values Values
+ * @return Median, 0 if there are no values
+ */
+Double_t AliAnalysisTaskRhoEngine::Median(std::vector<Double_t>& values)
+{
+  if (values.empty()) return 0;
+
+  auto mid = values.begin() + values.size() / 2;
+  std::nth_element(values.begin(), mid, values.end());
+  Double_t median = *mid;
+  if (values.size() % 2 == 0) median = 0.5 * (median + *std::max_element(values.begin(), mid));
+
+  return median;
+}
+
+/**
+ * Calculates all the requested background estimators from the background jets.
+ * The median rho is stored in fOutRho, the other estimators in their own output objects.
+ */
+void AliAnalysisTaskRhoEngine::CalculateRho()
+{
+  if (fOutRhoSparse) fOutRhoSparse->SetVal(0);
+  if (fOutRhoMass) fOutRhoMass->SetVal(0);
+  if (fOutLocalRho) fOutLocalRho->SetVal(0);
+
+  if (fJetCollArray.empty()) return;
+
+  AliJetContainer* bkgJetCont = fJetCollArray["Background"];
+  AliJetContainer* sigJetCont = nullptr;
+  if (fOutRhoSparse && !fExclJetOverlap.IsNull()) {
+    auto sigJetContIt = fJetCollArray.find(fExclJetOverlap.Data());
+    if (sigJetContIt != fJetCollArray.end()) sigJetCont = sigJetContIt->second;
+  }
+
+  fRhoValues.clear();
+  fRhoSparseValues.clear();
+  fRhoMassValues.clear();
+  Double_t totJetArea = 0; // Total area of background jets (including ghost jets)
+  Double_t totJetAreaPhys = 0; // Total area of physical background jets (excluding ghost jets)
+
+  for (auto jet : bkgJetCont->accepted()) {
+    totJetArea += jet->Area();
+    if (!jet->IsGhost()) totJetAreaPhys += jet->Area();
+
+    // excluding leading jets
+    if (jet == fLeadingJets.first || jet == fLeadingJets.second) continue;
+
+    if (jet->Area() <= 0) continue;
+
+    fRhoValues.push_back(jet->Pt() / jet->Area());
+
+    if (fOutRhoMass) fRhoMassValues.push_back(GetMd(jet, bkgJetCont) / jet->Area());
+
+    if (fOutRhoSparse && !jet->IsGhost()) {
+      Bool_t overlapsWithSignal = kFALSE;
+      if (sigJetCont) {
+        for (auto sigJet : sigJetCont->accepted()) {
+          if (AreJetsOverlapping(jet, sigJet)) {
+            overlapsWithSignal = kTRUE;
+            break;
+          }
+        }
+      }
+      if (!overlapsWithSignal) fRhoSparseValues.push_back(jet->Pt() / jet->Area());
+    }
+  }
+
+  if (!fRhoValues.empty()) fOutRho->SetVal(Median(fRhoValues));
+
+  // Occupancy correction for sparse event described in https://arxiv.org/abs/1207.2392
+  fOccupancyFactor = totJetArea > 0 ? totJetAreaPhys / totJetArea : 0;
+  if (fOutRhoSparse && !fRhoSparseValues.empty()) fOutRhoSparse->SetVal(Median(fRhoSparseValues) * fOccupancyFactor);
+
+  if (fOutRhoMass && !fRhoMassValues.empty()) fOutRhoMass->SetVal(Median(fRhoMassValues));
+
+  if (fOutLocalRho) CalculateLocalRho(bkgJetCont);
+}
+
+/**
+ * Calculates the local rho: the median rho modulated in phi with v2 and v3 w.r.t. the second
+ * and third order event planes of the soft tracks. Tracks in a strip in eta around the leading
+ * jet, and beyond the jet acceptance, are excluded as in AliAnalysisTaskLocalRho.
+ * The remaining tracks form two sub-events at negative and positive eta, separated by fLocalRhoEtaGap.
+ * The event planes are the angles of the Q-vectors of both sub-events together, the vn come from
+ * the correlation of the Q-vectors of the two sub-events. If the modulation becomes negative,
+ * the local rho is flat.
+ * @param bkgJetCont Background jet container, whose particle container provides the tracks
+ */
+void AliAnalysisTaskRhoEngine::CalculateLocalRho(AliJetContainer* bkgJetCont)
+{
+  Double_t rho = fOutRho->GetVal();
+  fOutLocalRho->SetVal(rho);
+  fOutLocalRho->SetLocalRho(nullptr);
+  if (rho <= 0) return;
+
+  AliParticleContainer* partCont = bkgJetCont->GetParticleContainer();
+  if (!partCont) return;
+
+  // leading (signal) jet, whose eta strip is excluded
+  AliEmcalJet* leadingJet = nullptr;
+  if (fExcludeLeadingJetsFromFit > 0) {
+    auto leadingJetIt = fLeadingJet.find(fExclJetOverlap.IsNull() ? "Background" : fExclJetOverlap.Data());
+    if (leadingJetIt != fLeadingJet.end()) leadingJet = leadingJetIt->second;
+  }
+  Double_t exclEtaHalfWidth = bkgJetCont->GetJetRadius() * fExcludeLeadingJetsFromFit;
+  Double_t maxEta = bkgJetCont->GetJetEtaMax() + bkgJetCont->GetJetRadius();
+
+  // multiplicities and Q-vectors of the sub-events at negative (0) and positive (1) eta
+  Double_t m[2] = {0, 0};
+  Double_t qx2[2] = {0, 0}, qy2[2] = {0, 0}, qx3[2] = {0, 0}, qy3[2] = {0, 0};
+  for (auto track : partCont->accepted()) {
+    if (track->Pt() < fSoftTrackMinPt || track->Pt() > fSoftTrackMaxPt) continue;
+    Double_t eta = track->Eta();
+    if (fExcludeLeadingJetsFromFit > 0 && ((leadingJet && TMath::Abs(eta - leadingJet->Eta()) < exclEtaHalfWidth) || TMath::Abs(eta) > maxEta)) continue;
+    if (TMath::Abs(eta) < .5 * fLocalRhoEtaGap) continue;
+
+    Int_t sub = eta > 0 ? 1 : 0;
+    Double_t phi = track->Phi();
+    qx2[sub] += TMath::Cos(2. * phi);
+    qy2[sub] += TMath::Sin(2. * phi);
+    qx3[sub] += TMath::Cos(3. * phi);
+    qy3[sub] += TMath::Sin(3. * phi);
+    m[sub]++;
+  }
+  if (m[0] == 0 || m[1] == 0) return;
+
+  Double_t psi2 = .5 * TMath::ATan2(qy2[0] + qy2[1], qx2[0] + qx2[1]);
+  Double_t psi3 = (1. / 3.) * TMath::ATan2(qy3[0] + qy3[1], qx3[0] + qx3[1]);
+
+  // vn^2 = <cos(n(phi_A - phi_B))> for pairs of tracks from different sub-events
+  Double_t c2 = (qx2[0] * qx2[1] + qy2[0] * qy2[1]) / (m[0] * m[1]);
+  Double_t c3 = (qx3[0] * qx3[1] + qy3[0] * qy3[1]) / (m[0] * m[1]);
+  Double_t v2 = c2 > 0 ? TMath::Sqrt(c2) : 0;
+  Double_t v3 = c3 > 0 ? TMath::Sqrt(c3) : 0;
+
+  if (fHistV2VsCent) fHistV2VsCent->Fill(fCent, v2);
+  if (fHistV3VsCent) fHistV3VsCent->Fill(fCent, v3);
+
+  // the modulation has its minimum above 1 - 2 (v2 + v3)
+  if (1. - 2. * (v2 + v3) < 0) return;
+
+  fLocalRhoModulation->FixParameter(0, rho);
+  fLocalRhoModulation->FixParameter(3, v2);
+  fLocalRhoModulation->FixParameter(4, psi2);
+  fLocalRhoModulation->FixParameter(6, psi3);
+  fLocalRhoModulation->FixParameter(7, v3);
+  fOutLocalRho->SetLocalRho(fLocalRhoModulation);
+}
+
+/**
+ * Mass of a background jet used for rho_m, as defined in http://arxiv.org/pdf/1211.2811.pdf
+ * (same as AliAnalysisTaskRhoMass).
+ * @param jet Background jet
+ * @param jetCont Jet container, whose particle and cluster containers are used to access the constituents
+ * @return Md of the jet
+ */
+Double_t AliAnalysisTaskRhoEngine::GetMd(AliEmcalJet* jet, AliJetContainer* jetCont)
+{
+  Double_t sum = 0.;
+  Double_t px = 0.;
+  Double_t py = 0.;
+  Double_t pz = 0.;
+  Double_t E = 0.;
+
+  AliParticleContainer* partCont = jetCont->GetParticleContainer();
+  if (partCont) {
+    for (Int_t icc = 0; icc < jet->GetNumberOfTracks(); icc++) {
+      AliVParticle* vp = jet->TrackAt(icc, partCont->GetArray());
+      if (!vp) continue;
+      if (fRhoMassType == kMd) sum += TMath::Sqrt(vp->M()*vp->M() + vp->Pt()*vp->Pt()) - vp->Pt();
+      else if (fRhoMassType == kMdP) sum += TMath::Sqrt(vp->M()*vp->M() + vp->P()*vp->P()) - vp->P();
+      else if (fRhoMassType == kMd4) {
+        px += vp->Px();
+        py += vp->Py();
+        pz += vp->Pz();
+        E += vp->E();
+      }
+    }
+  }
+
+  AliClusterContainer* clusCont = jetCont->GetClusterContainer();
+  if (clusCont) {
+    for (Int_t icc = 0; icc < jet->GetNumberOfClusters(); icc++) {
+      AliVCluster* vc = jet->ClusterAt(icc, clusCont->GetArray());
+      if (!vc) continue;
+      TLorentzVector nPart;
+      vc->GetMomentum(nPart, fVertex);
+      Double_t m = fPionMassClusters ? 0.13957 : 0.;
+      if (fRhoMassType == kMd) sum += TMath::Sqrt(m*m + nPart.Pt()*nPart.Pt()) - nPart.Pt();
+      else if (fRhoMassType == kMdP) sum += TMath::Sqrt(nPart.M()*nPart.M() + nPart.P()*nPart.P()) - nPart.P();
+      else if (fRhoMassType == kMd4) {
+        px += nPart.Px();
+        py += nPart.Py();
+        pz += nPart.Pz();
+        E += nPart.E();
+      }
+    }
+  }
+
+  if (fRhoMassType == kMd4) {
+    Double_t pt = TMath::Sqrt(px*px + py*py);
+    Double_t m2 = E*E - pt*pt - pz*pz;
+    sum = TMath::Sqrt(m2 + pt*pt) - pt;
+  }
+  return sum;
+}
+
+/**
+ * Fill histograms.
+ */
+Bool_t AliAnalysisTaskRhoEngine::FillHistograms()
+{
+  Bool_t r = AliAnalysisTaskRhoBaseDev::FillHistograms();
+  if (!r) return kFALSE;
+
+  if (fHistOccCorrvsCent) fHistOccCorrvsCent->Fill(fCent, fOccupancyFactor);
+  if (fHistRhoSparseVsCent && fOutRhoSparse) fHistRhoSparseVsCent->Fill(fCent, fOutRhoSparse->GetVal());
+  if (fHistRhoMassVsCent && fOutRhoMass) fHistRhoMassVsCent->Fill(fCent, fOutRhoMass->GetVal());
+
+  if (fHistLocalRhoRatioVsPhi && fOutLocalRho) {
+    // local rho of AliAnalysisTaskLocalRho, averaged over the jet radius as used for the jets
+    AliLocalRhoParameter* refLocalRho = dynamic_cast<AliLocalRhoParameter*>(InputEvent()->FindListObject(fCompareLocalRhoName));
+    if (refLocalRho) {
+      Double_t r = fJetCollArray["Background"]->GetJetRadius();
+      for (Int_t ibin = 1; ibin <= fHistLocalRhoRatioVsPhi->GetNbinsX(); ibin++) {
+        Double_t phi = fHistLocalRhoRatioVsPhi->GetXaxis()->GetBinCenter(ibin);
+        Double_t refVal = refLocalRho->GetLocalVal(phi, r);
+        if (refVal <= 0) continue;
+        Double_t ratio = fOutLocalRho->GetLocalVal(phi, r) / refVal;
+        fHistLocalRhoRatioVsPhi->Fill(phi, ratio);
+        fHistLocalRhoRatioVsCent->Fill(fCent, ratio);
+      }
+    }
+    else {
+      AliWarning(Form("%s: Could not retrieve local rho %s!", GetName(), fCompareLocalRhoName.Data()));
+    }
+  }
+
+  return kTRUE;
+}
+
+/**
+ * Verify that the required particle, cluster and jet containers were provided.
+ * @return kTRUE if all requirements are satisfied, kFALSE otherwise
+ */
+Bool_t AliAnalysisTaskRhoEngine::VerifyContainers()
+{
+  if (fJetCollArray.count("Background") == 0) {
+    AliError("No background jet collection found. Task will not run!");
+    return kFALSE;
+  }
+
+  if (!fOutLocalRhoName.IsNull() && !fJetCollArray["Background"]->GetParticleContainer()) {
+    AliError("No particle container found for the local rho. Task will not run!");
+    return kFALSE;
+  }
+
+  return kTRUE;
+}
+
+/**
+ * Create an instance of this class and add it to the analysis manager.
+ * Only the median rho is calculated, the other estimators are enabled by
+ * giving the names of their output objects.
+ * @param trackName name of the track collection
+ * @param trackPtCut minimum pt of the tracks
+ * @param clusName name of the calorimeter cluster collection
+ * @param clusECut minimum energy of the calorimeter clustuers
+ * @param nRho name of the output rho object
+ * @param jetradius Radius of the kt jets used to calculate the background
+ * @param acceptance Fiducial acceptance of the kt jets
+ * @param jetType Jet type (full/charged)
+ * @param rscheme Recombination scheme
+ * @param histo If kTRUE the task will also produce QA histograms
+ * @param suffix additional suffix that can be added at the end of the task name
+ * @return pointer to the new AliAnalysisTaskRhoEngine task
+ */
+AliAnalysisTaskRhoEngine* AliAnalysisTaskRhoEngine::AddTaskRhoEngine(TString trackName, Double_t trackPtCut, TString clusName, Double_t clusECut, TString nRho, Double_t jetradius, UInt_t acceptance, AliJetContainer::EJetType_t jetType, AliJetContainer::ERecoScheme_t rscheme, Bool_t histo, TString suffix)
+{
+  // Get the pointer to the existing analysis manager via the static access method.
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!mgr) {
+    ::Error("AliAnalysisTaskRhoEngine::AddTaskRhoEngine", "No analysis manager to connect to.");
+    return nullptr;
+  }
+
+  // Check the analysis type using the event handlers connected to the analysis manager.
+  AliVEventHandler* handler = mgr->GetInputEventHandler();
+  if (!handler) {
+    ::Error("AliAnalysisTaskRhoEngine::AddTaskRhoEngine", "This task requires an input event handler");
+    return nullptr;
+  }
+
+  EDataType_t dataType = kUnknownDataType;
+
+  if (handler->InheritsFrom("AliESDInputHandler")) {
+    dataType = kESD;
+  }
+  else if (handler->InheritsFrom("AliAODInputHandler")) {
+    dataType = kAOD;
+  }
+
+  // Init the task and do settings
+  if (trackName == "usedefault") {
+    if (dataType == kESD) {
+      trackName = "Tracks";
+    }
+    else if (dataType == kAOD) {
+      trackName = "tracks";
+    }
+    else {
+      trackName = "";
+    }
+  }
+
+  if (clusName == "usedefault") {
+    if (dataType == kESD) {
+      clusName = "CaloClusters";
+    }
+    else if (dataType == kAOD) {
+      clusName = "caloClusters";
+    }
+    else {
+      clusName = "";
+    }
+  }
+
+  TString name(TString::Format("AliAnalysisTaskRhoEngine_%s", nRho.Data()));
+  if (!suffix.IsNull()) {
+    name += "_";
+    name += suffix;
+  }
+
+  AliAnalysisTaskRhoEngine* mgrTask = dynamic_cast<AliAnalysisTaskRhoEngine*>(mgr->GetTask(name.Data()));
+  if (mgrTask) {
+    ::Warning("AliAnalysisTaskRhoEngine::AddTaskRhoEngine", "Not adding the task again, since a task with the same name '%s' already exists", name.Data());
+    return mgrTask;
+  }
+
+  AliAnalysisTaskRhoEngine* rhotask = new AliAnalysisTaskRhoEngine(name, histo);
+  rhotask->SetOutRhoName(nRho);
+
+  AliParticleContainer* partCont = rhotask->AddParticleContainer(trackName.Data());
+  partCont->SetMinPt(trackPtCut);
+  AliClusterContainer *clusterCont = rhotask->AddClusterContainer(clusName.Data());
+  if (clusterCont) {
+    clusterCont->SetClusECut(0.);
+    clusterCont->SetClusPtCut(0.);
+    clusterCont->SetClusHadCorrEnergyCut(clusECut);
+    clusterCont->SetDefaultClusterEnergy(AliVCluster::kHadCorr);
+  }
+
+  AliJetContainer *jetCont = new AliJetContainer(jetType, AliJetContainer::kt_algorithm, rscheme, jetradius, partCont, clusterCont);
+  if (jetCont) {
+    jetCont->SetJetPtCut(0);
+    jetCont->SetJetAcceptanceType(acceptance);
+    jetCont->SetName("Background");
+    rhotask->AdoptJetContainer(jetCont);
+  }
+
+  // Final settings, pass to manager and set the containers
+  mgr->AddTask(rhotask);
+
+  // Create containers for input/output
+  mgr->ConnectInput(rhotask, 0, mgr->GetCommonInputContainer());
+  if (histo) {
+    TString contname(name);
+    contname += "_histos";
+    AliAnalysisDataContainer *coutput1 = mgr->CreateContainer(contname.Data(),
+        TList::Class(), AliAnalysisManager::kOutputContainer,
+        Form("%s", AliAnalysisManager::GetCommonFileName()));
+    mgr->ConnectOutput(rhotask, 1, coutput1);
+  }
+
+  return rhotask;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file AliAnalysisTaskRhoEngine.h
+ * @brief Declaration of class AliAnalysisTaskRhoEngine
+ *
+ * In this header file the class AliAnalysisTaskRhoEngine is declared.
+ */
+
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#ifndef ALIANALYSISTASKRHOENGINE_H
+#define ALIANALYSISTASKRHOENGINE_H
+
+#include <utility>
+#include <vector>
+
+#include "AliAnalysisTaskRhoBaseDev.h"
+
+class TF1;
+class AliLocalRhoParameter;
+
+/** \class AliAnalysisTaskRhoEngine
+ * \brief Class for a task that calculates several UE estimators from one kt jet collection
+ *
+ * This task calculates in a single loop over the kt jets of the "Background"
+ * jet collection (i.e. from a single kt clustering) all the background estimators
+ * that are otherwise calculated by separate tasks, each with its own kt jets:
+ * - the median of the pt density (as AliAnalysisTaskRho), exported with the name given by SetOutRhoName();
+ * - the median for sparse events, corrected by the occupancy (as AliAnalysisTaskRhoSparse),
+ *   exported if SetOutRhoSparseName() is given;
+ * - the median of the mass density (as AliAnalysisTaskRhoMass), exported if SetOutRhoMassName() is given;
+ * - the local rho, the median rho modulated in phi with v2 and v3 w.r.t. the TPC event plane
+ *   (as AliAnalysisTaskLocalRho with the combined v2 and v3 modulation and the TPC event plane),
+ *   exported as an AliLocalRhoParameter if SetOutLocalRhoName() is given.
+ *
+ * The medians are found by partial selection instead of sorting the jets, and the leading jets
+ * to be excluded are found in the same loop that counts the jets.
+ *
+ * For the local rho, the soft tracks in a strip in eta around the leading jet are excluded
+ * (as SetExcludeLeadingJetsFromFit of AliAnalysisTaskLocalRho), and the remaining tracks are split
+ * in two sub-events at negative and positive eta, separated by a gap (SetLocalRhoEtaGap()).
+ * The event planes are calculated from the Q-vectors of both sub-events, as the TPC event plane
+ * of AliAnalysisTaskLocalRho. Instead of a fit, v2 and v3 are taken from the correlation of the
+ * Q-vectors of the two sub-events, vn^2 = Re(Qn,A Qn,B*) / (M_A M_B), which does not correlate the
+ * tracks with themselves; vn is 0 if the correlation is negative.
+ * If SetCompareLocalRhoName() is given, the local rho is compared with the one of an
+ * AliAnalysisTaskLocalRho running in the same train.
+ */
+class AliAnalysisTaskRhoEngine : public AliAnalysisTaskRhoBaseDev {
+
+ public:
+  /**
+   * \enum ERhoMassType_t
+   * \brief Definition of the mass of a kt jet used for rho_m, as in AliAnalysisTaskRhoMass
+   */
+  enum ERhoMassType_t {
+    kMd     = 0,            ///< rho_m from arXiv:1211.2811
+    kMdP    = 1,            ///< rho_m using P instead of pT
+    kMd4    = 2             ///< rho_m using addition of 4-vectors
+  };
+
+  AliAnalysisTaskRhoEngine();
+  AliAnalysisTaskRhoEngine(const char *name, Bool_t histo=kFALSE);
+  virtual ~AliAnalysisTaskRhoEngine();
+
+  void             UserCreateOutputObjects();
+
+  void             SetExcludeLeadJets(UInt_t n)              { fNExclLeadJets     = n    ; }
+  void             SetExclJetOverlap(TString n)              { fExclJetOverlap    = n    ; }
+  void             SetOutRhoSparseName(const char *name)     { fOutRhoSparseName  = name ; }
+  void             SetOutRhoMassName(const char *name)       { fOutRhoMassName    = name ; }
+  void             SetOutLocalRhoName(const char *name)      { fOutLocalRhoName   = name ; }
+  void             SetRhoMassType(ERhoMassType_t t)          { fRhoMassType       = t    ; }
+  void             SetPionMassForClusters(Bool_t b)          { fPionMassClusters  = b    ; }
+  void             SetSoftTrackPtRange(Double_t min, Double_t max) { fSoftTrackMinPt = min; fSoftTrackMaxPt = max; }
+  void             SetExcludeLeadingJetsFromFit(Double_t n)  { fExcludeLeadingJetsFromFit = n; }
+  void             SetLocalRhoEtaGap(Double_t gap)           { fLocalRhoEtaGap    = gap  ; }
+  void             SetCompareLocalRhoName(const char *name)  { fCompareLocalRhoName = name; }
+
+  static AliAnalysisTaskRhoEngine* AddTaskRhoEngine(
+     TString        nTracks                        = "usedefault",
+     Double_t       trackPtCut                     = 0.15,
+     TString        nClusters                      = "usedefault",
+     Double_t       clusECut                       = 0.30,
+     TString        nRho                           = "Rho",
+     Double_t       jetradius                      = 0.2,
+     UInt_t         acceptance                     = AliEmcalJet::kTPCfid,
+     AliJetContainer::EJetType_t jetType           = AliJetContainer::kChargedJet,
+     AliJetContainer::ERecoScheme_t rscheme        = AliJetContainer::pt_scheme,
+     Bool_t         histo                          = kTRUE,
+     TString        suffix                         = ""
+  );
+
+  static Double_t  Median(std::vector<Double_t>& values);
+
+ protected:
+  void             ExecOnce();
+  void             SortJets();
+  void             CalculateRho();
+  void             CalculateLocalRho(AliJetContainer* bkgJetCont);
+  Bool_t           FillHistograms();
+  Bool_t           VerifyContainers();
+
+  Double_t         GetMd(AliEmcalJet* jet, AliJetContainer* jetCont);
+
+  UInt_t           fNExclLeadJets;                 ///< number of leading jets to be excluded from the median calculation
+  TString          fExclJetOverlap;                ///< name of the jet collection that should be used to reject jets that are considered "signal" (sparse rho only)
+  TString          fOutRhoSparseName;              ///< name of the output rho object for sparse events (not calculated if empty)
+  TString          fOutRhoMassName;                ///< name of the output rho_m object (not calculated if empty)
+  TString          fOutLocalRhoName;               ///< name of the output local rho object (not calculated if empty)
+  ERhoMassType_t   fRhoMassType;                   ///< method for the rho_m calculation
+  Bool_t           fPionMassClusters;              ///< assume pion mass for clusters in the rho_m calculation
+  Double_t         fSoftTrackMinPt;                ///< minimum pt of the tracks used for the local rho
+  Double_t         fSoftTrackMaxPt;                ///< maximum pt of the tracks used for the local rho
+  Double_t         fExcludeLeadingJetsFromFit;     ///< half width in eta, in units of the jet radius, of the strip around the leading jet excluded from the local rho (0: none)
+  Double_t         fLocalRhoEtaGap;                ///< eta gap between the two sub-events used for the local rho
+  TString          fCompareLocalRhoName;           ///< name of the local rho of an AliAnalysisTaskLocalRho to compare with (no comparison if empty)
+
+  AliRhoParameter      *fOutRhoSparse;             //!<!output rho object for sparse events
+  AliRhoParameter      *fOutRhoMass;               //!<!output rho_m object
+  AliLocalRhoParameter *fOutLocalRho;              //!<!output local rho object
+  TF1                  *fLocalRhoModulation;       //!<!phi modulation of the local rho
+
+  std::pair<AliEmcalJet*, AliEmcalJet*>
+                   fLeadingJets;                   //!<!leading and subleading background jets
+  std::vector<Double_t> fRhoValues;                //!<!pt densities of the background jets
+  std::vector<Double_t> fRhoSparseValues;          //!<!pt densities of the background jets used for the sparse rho
+  std::vector<Double_t> fRhoMassValues;            //!<!mass densities of the background jets
+  Double_t         fOccupancyFactor;               //!<!occupancy correction factor for sparse events
+
+  TH2F            *fHistOccCorrvsCent;             //!<!occupancy correction vs. centrality
+  TH2F            *fHistRhoSparseVsCent;           //!<!sparse rho vs. centrality
+  TH2F            *fHistRhoMassVsCent;             //!<!rho_m vs. centrality
+  TH2F            *fHistV2VsCent;                  //!<!v2 of the local rho vs. centrality
+  TH2F            *fHistV3VsCent;                  //!<!v3 of the local rho vs. centrality
+  TH2F            *fHistLocalRhoRatioVsPhi;        //!<!ratio of the local rho to the compared local rho vs. phi
+  TH2F            *fHistLocalRhoRatioVsCent;       //!<!ratio of the local rho to the compared local rho vs. centrality
+
+  AliAnalysisTaskRhoEngine(const AliAnalysisTaskRhoEngine&);             // not implemented
+  AliAnalysisTaskRhoEngine& operator=(const AliAnalysisTaskRhoEngine&);  // not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliAnalysisTaskRhoEngine, 2);
+  /// \endcond
+};
+#endif
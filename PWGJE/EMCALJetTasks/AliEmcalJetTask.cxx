@@ -14,6 +14,7 @@
  **************************************************************************/
 
 #include <vector>
+#include <thread>
 
 #include <TClonesArray.h>
 #include <TMath.h>
@@ -21,6 +22,7 @@
 
 #include <AliVCluster.h>
 #include <AliVEvent.h>
+#include <AliVHeader.h>
 #include <AliVParticle.h>
 #include <AliEMCALGeometry.h>
 
@@ -70,6 +72,12 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fUtilities(0),
   fLocked(0),
+  fAddJetAlgo(),
+  fAddRadius(),
+  fAddRecombScheme(),
+  fAddUtilities(),
+  fNThreads(0),
+  fUseGhostGrid(kFALSE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -77,6 +85,10 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
   fJets(0),
+  fAddJets(),
+  fAddFastJetWrappers(),
+  fAddGhosts(),
+  fClusteredOnce(kFALSE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
   fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask")
@@ -105,6 +117,12 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fUtilities(0),
   fLocked(0),
+  fAddJetAlgo(),
+  fAddRadius(),
+  fAddRecombScheme(),
+  fAddUtilities(),
+  fNThreads(0),
+  fUseGhostGrid(kFALSE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -112,6 +130,10 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
   fJets(0),
+  fAddJets(),
+  fAddFastJetWrappers(),
+  fAddGhosts(),
+  fClusteredOnce(kFALSE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
   fFastJetWrapper(name,name)
@@ -123,6 +145,29 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
  */
 AliEmcalJetTask::~AliEmcalJetTask()
 {
+  for (UInt_t i = 0; i < fAddFastJetWrappers.size(); i++) delete fAddFastJetWrappers[i];
+  for (UInt_t i = 0; i < fAddUtilities.size(); i++) delete fAddUtilities[i];
+}
+
+/**
+ * Add a jet definition, clustered in the same event loop on the same containers
+ * as the main jet definition. The jets are stored in a separate branch with the name
+ * generated as for the main jet definition.
+ * @param a Jet algorithm
+ * @param r Jet radius
+ * @param s Recombination scheme
+ * @return Index of the jet definition, to be used with AddUtility(utility, definition); -1 if the task is locked
+ */
+Int_t AliEmcalJetTask::AddJetDefinition(EJetAlgo_t a, Double_t r, ERecoScheme_t s)
+{
+  if (IsLocked()) return -1;
+
+  fAddJetAlgo.push_back(a);
+  fAddRadius.push_back(r);
+  fAddRecombScheme.push_back(s);
+  fAddUtilities.push_back(0);
+
+  return fAddRadius.size() - 1;
 }
 
 /**
@@ -142,59 +187,103 @@ AliEmcalJetUtility* AliEmcalJetTask::AddUtility(AliEmcalJetUtility* utility)
   return utility;
 }
 
+/**
+ * Add a utility to the utility list of an additional jet definition. The utility is
+ * executed with the jets of that definition, and must not be shared with other definitions.
+ * @param utility Jet utility
+ * @param definition Index of the jet definition returned by AddJetDefinition()
+ */
+AliEmcalJetUtility* AliEmcalJetTask::AddUtility(AliEmcalJetUtility* utility, Int_t definition)
+{
+  if (definition < 0 || definition >= (Int_t)fAddUtilities.size()) {
+    Error("AddUtility", "No jet definition with index %d.", definition);
+    return utility;
+  }
+  if (!fAddUtilities[definition]) fAddUtilities[definition] = new TObjArray();
+  if (fAddUtilities[definition]->FindObject(utility)) {
+    Error("AddUtility", "Jet utility %s already connected.", utility->GetName());
+    return utility;
+  }
+  fAddUtilities[definition]->Add(utility);
+  utility->SetJetTask(this);
+
+  return utility;
+}
+
 /**
  * This method is called once before analyzing the first event. It executes
  * the Init() method of all utilities (if any).
+ * @param utilities Utilities of a jet definition
  */
-void AliEmcalJetTask::InitUtilities()
+void AliEmcalJetTask::InitUtilities(TObjArray* utilities)
 {
-  TIter next(fUtilities);
+  TIter next(utilities);
   AliEmcalJetUtility *utility = 0;
   while ((utility=static_cast<AliEmcalJetUtility*>(next()))) utility->Init();
 }
+
 /**
  * This method is called before analyzing each event. It executes
- * the InitEvent() method of all utilities (if any).
+ * the InitEvent() method of the utilities of all jet definitions (if any).
  */
 void AliEmcalJetTask::InitEvent()
 {
-  TIter next(fUtilities);
+  InitEvent(fUtilities, fFastJetWrapper);
+  for (UInt_t i = 0; i < fAddFastJetWrappers.size(); i++) InitEvent(fAddUtilities[i], *fAddFastJetWrappers[i]);
+}
+
+/**
+ * It executes the InitEvent() method of the utilities of a jet definition (if any).
+ * @param utilities Utilities of the jet definition
+ * @param wrapper FastJet wrapper of the jet definition
+ */
+void AliEmcalJetTask::InitEvent(TObjArray* utilities, AliFJWrapper& wrapper)
+{
+  TIter next(utilities);
   AliEmcalJetUtility *utility = 0;
-  while ((utility=static_cast<AliEmcalJetUtility*>(next()))) utility->InitEvent(fFastJetWrapper);
+  while ((utility=static_cast<AliEmcalJetUtility*>(next()))) utility->InitEvent(wrapper);
 }
 
 /**
  * This method is called in the event loop after jet finding but before filling
  * the output jet branch to prepare the utilities.
  * It executes the Prepare() method of all utilities (if any).
+ * @param utilities Utilities of the jet definition
+ * @param wrapper FastJet wrapper of the jet definition
  */
-void AliEmcalJetTask::PrepareUtilities()
+void AliEmcalJetTask::PrepareUtilities(TObjArray* utilities, AliFJWrapper& wrapper)
 {
-  TIter next(fUtilities);
+  TIter next(utilities);
   AliEmcalJetUtility *utility = 0;
-  while ((utility=static_cast<AliEmcalJetUtility*>(next()))) utility->Prepare(fFastJetWrapper);
+  while ((utility=static_cast<AliEmcalJetUtility*>(next()))) utility->Prepare(wrapper);
 }
 
 /**
  * This method is called in the event loop for each jet found, while filling the output jet branch.
  * It executes the ProcessJet() method of all utilities (if any).
+ * @param utilities Utilities of the jet definition
+ * @param wrapper FastJet wrapper of the jet definition
+ * @param jet Jet in the output branch
+ * @param ij Index of the jet in the wrapper
  */
-void AliEmcalJetTask::ExecuteUtilities(AliEmcalJet* jet, Int_t ij)
+void AliEmcalJetTask::ExecuteUtilities(TObjArray* utilities, AliFJWrapper& wrapper, AliEmcalJet* jet, Int_t ij)
 {
-  TIter next(fUtilities);
+  TIter next(utilities);
   AliEmcalJetUtility *utility = 0;
-  while ((utility=static_cast<AliEmcalJetUtility*>(next()))) utility->ProcessJet(jet, ij, fFastJetWrapper);
+  while ((utility=static_cast<AliEmcalJetUtility*>(next()))) utility->ProcessJet(jet, ij, wrapper);
 }
 
 /**
  * This method is called in the event loop after jet finding has been completed.
  * It executes the Terminate() method of all utilities (if any).
+ * @param utilities Utilities of the jet definition
+ * @param wrapper FastJet wrapper of the jet definition
  */
-void AliEmcalJetTask::TerminateUtilities()
+void AliEmcalJetTask::TerminateUtilities(TObjArray* utilities, AliFJWrapper& wrapper)
 {
-  TIter next(fUtilities);
+  TIter next(utilities);
   AliEmcalJetUtility *utility = 0;
-  while ((utility=static_cast<AliEmcalJetUtility*>(next()))) utility->Terminate(fFastJetWrapper);
+  while ((utility=static_cast<AliEmcalJetUtility*>(next()))) utility->Terminate(wrapper);
 }
 
 /**
@@ -206,11 +295,13 @@ Bool_t AliEmcalJetTask::Run()
   InitEvent();
   // clear the jet array (normally a null operation)
   fJets->Delete();
+  for (UInt_t i = 0; i < fAddJets.size(); i++) fAddJets[i]->Delete();
   Int_t n = FindJets();
 
   if (n == 0) return kFALSE;
 
   FillJetBranch();
+  for (UInt_t i = 0; i < fAddJets.size(); i++) FillJetBranch(*fAddFastJetWrappers[i], fAddJets[i], fAddRadius[i], fAddUtilities[i]);
 
   return kTRUE;
 }
@@ -229,7 +320,10 @@ Int_t AliEmcalJetTask::FindJets()
     return 0;
   }
 
-  fFastJetWrapper.Clear();
+  // the constituents are added to the wrappers of all jet definitions
+  std::vector<AliFJWrapper*> wrappers(1, &fFastJetWrapper);
+  wrappers.insert(wrappers.end(), fAddFastJetWrappers.begin(), fAddFastJetWrappers.end());
+  for (UInt_t iw = 0; iw < wrappers.size(); iw++) wrappers[iw]->Clear();
 
   AliDebug(2,Form("Jet type = %d", fJetType));
 
@@ -240,20 +334,22 @@ Int_t AliEmcalJetTask::FindJets()
     AliDebug(2,Form("Tracks from collection %d: '%s'. Embedded: %i, nTracks: %i", iColl-1, tracks->GetName(), tracks->GetIsEmbedding(), tracks->GetNParticles()));
     AliParticleIterableMomentumContainer itcont = tracks->accepted_momentum();
     for (AliParticleIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
-      // artificial inefficiency
-      if (fTrackEfficiency < 1.) {
-        if (fTrackEfficiencyOnlyForEmbedding == kFALSE || (fTrackEfficiencyOnlyForEmbedding == kTRUE && tracks->GetIsEmbedding())) {
-          Double_t rnd = gRandom->Rndm();
-          if (fTrackEfficiency < rnd) {
-            AliDebug(2,Form("Track %d rejected due to artificial tracking inefficiency", it.current_index()));
-            continue;
+      Int_t uid = it.current_index() + fgkConstIndexShift * iColl;
+      for (UInt_t iw = 0; iw < wrappers.size(); iw++) {
+        // artificial inefficiency, drawn independently for each jet definition
+        if (fTrackEfficiency < 1.) {
+          if (fTrackEfficiencyOnlyForEmbedding == kFALSE || (fTrackEfficiencyOnlyForEmbedding == kTRUE && tracks->GetIsEmbedding())) {
+            Double_t rnd = gRandom->Rndm();
+            if (fTrackEfficiency < rnd) {
+              AliDebug(2,Form("Track %d rejected due to artificial tracking inefficiency", it.current_index()));
+              continue;
+            }
           }
         }
-      }
 
-      AliDebug(2,Form("Track %d accepted (label = %d, pt = %f, eta = %f, phi = %f, E = %f, m = %f, px = %f, py = %f, pz = %f)", it.current_index(), it->second->GetLabel(), it->first.Pt(), it->first.Eta(), it->first.Phi(), it->first.E(), it->first.M(), it->first.Px(), it->first.Py(), it->first.Pz()));
-      Int_t uid = it.current_index() + fgkConstIndexShift * iColl;
-      fFastJetWrapper.AddInputVector(it->first.Px(), it->first.Py(), it->first.Pz(), it->first.E(), uid);
+        AliDebug(2,Form("Track %d accepted (label = %d, pt = %f, eta = %f, phi = %f, E = %f, m = %f, px = %f, py = %f, pz = %f)", it.current_index(), it->second->GetLabel(), it->first.Pt(), it->first.Eta(), it->first.Phi(), it->first.E(), it->first.M(), it->first.Px(), it->first.Py(), it->first.Pz()));
+        wrappers[iw]->AddInputVector(it->first.Px(), it->first.Py(), it->first.Pz(), it->first.E(), uid);
+      }
     }
     iColl++;
   }
@@ -267,19 +363,90 @@ Int_t AliEmcalJetTask::FindJets()
     for (AliClusterIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
       AliDebug(2,Form("Cluster %d accepted (label = %d, energy = %.3f)", it.current_index(), it->second->GetLabel(), it->first.E()));
       Int_t uid = -it.current_index() - fgkConstIndexShift * iColl;
-      fFastJetWrapper.AddInputVector(it->first.Px(), it->first.Py(), it->first.Pz(), it->first.E(), uid);
+      for (UInt_t iw = 0; iw < wrappers.size(); iw++) wrappers[iw]->AddInputVector(it->first.Px(), it->first.Py(), it->first.Pz(), it->first.E(), uid);
     }
     iColl++;
   }
 
   if (fFastJetWrapper.GetInputVectors().size() == 0) return 0;
 
+  if (fUseGhostGrid) {
+    ULong64_t seed = GetGhostSeed();
+    for (UInt_t iw = 0; iw < wrappers.size(); iw++) wrappers[iw]->SetGhostSeed(seed);
+  }
+
   // run jet finder
   fFastJetWrapper.Run();
+  if (!fAddFastJetWrappers.empty()) RunAdditionalClusterings();
 
   return fFastJetWrapper.GetInclusiveJets().size();
 }
 
+/**
+ * Runs the jet finder for the additional jet definitions, distributed over fNThreads threads.
+ * Each jet definition gets its own ghosts, which are generated before the threads start, since
+ * FastJet draws them from a shared random generator; the clusterings themselves then draw no
+ * random numbers. The first event is clustered without threads, so that the one-time initialization
+ * of FastJet (banner, static tables) is done before the threads are started. Jet definitions whose
+ * utilities request the event-wise constituent subtraction, which clusters with FastJet's own ghosts,
+ * and the legacy mode are always clustered without threads.
+ */
+void AliEmcalJetTask::RunAdditionalClusterings()
+{
+  Int_t nThreads = fNThreads > 0 ? fNThreads : fAddFastJetWrappers.size();
+  if (nThreads > (Int_t)fAddFastJetWrappers.size()) nThreads = fAddFastJetWrappers.size();
+
+  Bool_t parallel = nThreads > 1 && fClusteredOnce && !fLegacyMode;
+  for (UInt_t i = 0; parallel && i < fAddFastJetWrappers.size(); i++) {
+    if (fAddFastJetWrappers[i]->GetEventSub()) parallel = kFALSE;
+  }
+  fClusteredOnce = kTRUE;
+
+  if (!parallel) {
+    for (UInt_t i = 0; i < fAddFastJetWrappers.size(); i++) {
+      fAddFastJetWrappers[i]->SetExternalGhosts(0, 0);
+      fAddFastJetWrappers[i]->Run();
+    }
+    return;
+  }
+
+  fAddGhosts.resize(fAddFastJetWrappers.size());
+  for (UInt_t i = 0; i < fAddFastJetWrappers.size(); i++) {
+    Double_t ghostArea = fAddFastJetWrappers[i]->GenerateGhosts(fAddGhosts[i]);
+    fAddFastJetWrappers[i]->SetExternalGhosts(&fAddGhosts[i], ghostArea);
+  }
+
+  // each thread runs every nThreads-th clustering, the main thread the first ones
+  std::vector<AliFJWrapper*>& wrappers = fAddFastJetWrappers;
+  std::vector<std::thread> workers;
+  for (Int_t t = 1; t < nThreads; t++) {
+    workers.push_back(std::thread([&wrappers, t, nThreads]() { for (UInt_t i = t; i < wrappers.size(); i += nThreads) wrappers[i]->Run(); }));
+  }
+  for (UInt_t i = 0; i < wrappers.size(); i += nThreads) wrappers[i]->Run();
+  for (UInt_t t = 0; t < workers.size(); t++) workers[t].join();
+}
+
+/**
+ * Seed of the ghost grid positions, from the event identification (run, period, orbit and bunch crossing),
+ * or from the entry of the analysis manager if the event has no identification (e.g. MC events).
+ * @return Seed of the current event
+ */
+ULong64_t AliEmcalJetTask::GetGhostSeed() const
+{
+  ULong64_t seed = InputEvent()->GetRunNumber();
+  AliVHeader* header = InputEvent()->GetHeader();
+  if (header && (header->GetOrbitNumber() || header->GetBunchCrossNumber())) {
+    seed = (seed << 24) ^ header->GetPeriodNumber();
+    seed = (seed << 24) ^ header->GetOrbitNumber();
+    seed = (seed << 12) ^ header->GetBunchCrossNumber();
+  }
+  else {
+    AliAnalysisManager* mgr = AliAnalysisManager::GetAnalysisManager();
+    seed = (seed << 32) ^ (mgr ? mgr->GetCurrentEntry() : 0);
+  }
+  return seed;
+}
+
 /**
  * This method fills the jet output branch (TClonesArray) with the jet found by the FastJet
  * wrapper. Before filling the jet branch, the utilities are prepared. Then the utilities are
@@ -287,10 +454,22 @@ Int_t AliEmcalJetTask::FindJets()
  */
 void AliEmcalJetTask::FillJetBranch()
 {
-  PrepareUtilities();
+  FillJetBranch(fFastJetWrapper, fJets, fRadius, fUtilities);
+}
+
+/**
+ * This method fills a jet output branch (TClonesArray) with the jets found by a FastJet wrapper.
+ * @param wrapper FastJet wrapper after the jet finding
+ * @param jets Jet output branch
+ * @param radius Jet radius used for the acceptance type
+ * @param utilities Utilities of the jet definition
+ */
+void AliEmcalJetTask::FillJetBranch(AliFJWrapper& wrapper, TClonesArray* jets, Double_t radius, TObjArray* utilities)
+{
+  PrepareUtilities(utilities, wrapper);
 
   // loop over fastjet jets
-  std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper.GetInclusiveJets();
+  std::vector<fastjet::PseudoJet> jets_incl = wrapper.GetInclusiveJets();
   // sort jets according to jet pt
   static Int_t indexes[9999] = {-1};
   GetSortedArray(indexes, jets_incl);
@@ -298,27 +477,27 @@ void AliEmcalJetTask::FillJetBranch()
   AliDebug(1,Form("%d jets found", (Int_t)jets_incl.size()));
   for (UInt_t ijet = 0, jetCount = 0; ijet < jets_incl.size(); ++ijet) {
     Int_t ij = indexes[ijet];
-    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), fFastJetWrapper.GetJetArea(ij)));
+    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), wrapper.GetJetArea(ij)));
 
     if (jets_incl[ij].perp() < fMinJetPt) continue;
-    if (fFastJetWrapper.GetJetArea(ij) < fMinJetArea) continue;
+    if (wrapper.GetJetArea(ij) < fMinJetArea) continue;
     if ((jets_incl[ij].eta() < fJetEtaMin) || (jets_incl[ij].eta() > fJetEtaMax) ||
         (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
       continue;
 
-    AliEmcalJet *jet = new ((*fJets)[jetCount])
+    AliEmcalJet *jet = new ((*jets)[jetCount])
     		          AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
     jet->SetLabel(ij);
 
-    fastjet::PseudoJet area(fFastJetWrapper.GetJetAreaVector(ij));
+    fastjet::PseudoJet area(wrapper.GetJetAreaVector(ij));
     jet->SetArea(area.perp());
     jet->SetAreaEta(area.eta());
     jet->SetAreaPhi(area.phi());
     jet->SetAreaE(area.E());
-    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), fRadius));
+    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), radius));
 
     // Fill constituent info
-    std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper.GetJetConstituents(ij));
+    std::vector<fastjet::PseudoJet> constituents(wrapper.GetJetConstituents(ij));
     FillJetConstituents(jet, constituents, constituents);
 
     if (fGeom) {
@@ -329,13 +508,13 @@ void AliEmcalJetTask::FillJetBranch()
         jet->SetAxisInEmcal(kTRUE);
     }
 
-    ExecuteUtilities(jet, ij);
+    ExecuteUtilities(utilities, wrapper, jet, ij);
 
     AliDebug(2,Form("Added jet n. %d, pt = %f, area = %f, constituents = %d", jetCount, jet->Pt(), jet->Area(), jet->GetNumberOfConstituents()));
     jetCount++;
   }
 
-  TerminateUtilities();
+  TerminateUtilities(utilities, wrapper);
 }
 
 /**
@@ -400,8 +579,41 @@ void AliEmcalJetTask::ExecOnce()
   if (fLegacyMode) {
     fFastJetWrapper.SetLegacyMode(kTRUE);
   }
+  fFastJetWrapper.SetUseGhostGrid(fUseGhostGrid);
+
+  // additional jet definitions: same settings except algorithm, radius and recombination scheme
+  fAddUtilities.resize(fAddRadius.size(), 0);
+  for (UInt_t i = 0; i < fAddRadius.size(); ) {
+    EJetAlgo_t algo = static_cast<EJetAlgo_t>(fAddJetAlgo[i]);
+    ERecoScheme_t reco = static_cast<ERecoScheme_t>(fAddRecombScheme[i]);
+    TString jetsName = AliJetContainer::GenerateJetName(fJetType, algo, reco, fAddRadius[i], GetParticleContainer(0), GetClusterContainer(0), fJetsTag);
+    if (jetsName == fJetsName || InputEvent()->FindListObject(jetsName)) {
+      AliError(Form("%s: Object with name %s already in event! Removing this jet definition", GetName(), jetsName.Data()));
+      fAddJetAlgo.erase(fAddJetAlgo.begin() + i);
+      fAddRadius.erase(fAddRadius.begin() + i);
+      fAddRecombScheme.erase(fAddRecombScheme.begin() + i);
+      delete fAddUtilities[i];
+      fAddUtilities.erase(fAddUtilities.begin() + i);
+      continue;
+    }
+    TClonesArray* jets = new TClonesArray("AliEmcalJet");
+    jets->SetName(jetsName);
+    ::Info("AliEmcalJetTask::ExecOnce", "Jet collection with name '%s' has been added to the event.", jetsName.Data());
+    InputEvent()->AddObject(jets);
+
+    AliFJWrapper* wrapper = new AliFJWrapper(jetsName, jetsName);
+    wrapper->CopySettingsFrom(fFastJetWrapper);
+    wrapper->SetR(fAddRadius[i]);
+    wrapper->SetAlgorithm(ConvertToFJAlgo(algo));
+    wrapper->SetRecombScheme(ConvertToFJRecoScheme(reco));
+
+    fAddJets.push_back(jets);
+    fAddFastJetWrappers.push_back(wrapper);
+    i++;
+  }
 
-  InitUtilities();
+  InitUtilities(fUtilities);
+  for (UInt_t i = 0; i < fAddUtilities.size(); i++) InitUtilities(fAddUtilities[i]);
 
   AliAnalysisTaskEmcal::ExecOnce();
 
@@ -44,6 +44,25 @@ namespace fastjet {
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
  * deriving a new class from AliEmcalJetUtility to interface functionalities of the FastJet contribs.
+ *
+ * Additional jet definitions (algorithm, radius, recombination scheme) can be added with
+ * AddJetDefinition(). They are clustered on the same containers as the main jet definition,
+ * which are read only once per event, and each of them fills its own jet branch, with the same
+ * name and content as an additional AliEmcalJetTask with the same settings would produce:
+ * the artificial tracking inefficiency is drawn independently for each jet definition, and each
+ * jet definition gets its own ghosts. The main jet definition is clustered as without additional
+ * definitions; the additional ones run in parallel on SetNThreads() threads, with ghosts generated
+ * before the threads start. Utilities are added to an additional jet definition with
+ * AddUtility(utility, definition), using the index returned by AddJetDefinition(). If the task is
+ * created with AddTaskEmcalJet(), it must not be locked before the additional definitions are added.
+ *
+ * With SetUseGhostGrid() the ghosts are not generated with the FastJet random generator, but taken
+ * from a ghost grid built once per jet definition for the ghost area and acceptance; in each event every
+ * ghost is scattered within its cell as in FastJet, with random numbers from a seed computed from the
+ * event identification. It applies to the active area with explicit ghosts and a single ghost repeat,
+ * otherwise the ghosts are left to FastJet. All tasks with the same ghost settings then
+ * use the same ghosts in an event, so that e.g. the kt jets used by several rho tasks get identical areas,
+ * and rerunning on the same events gives identical results.
  */
 class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  public:
@@ -79,6 +98,9 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetLegacyMode(Bool_t mode)                 { if (IsLocked()) return; fLegacyMode       = mode  ; }
   void                   SetFillGhost(Bool_t b=kTRUE)               { if (IsLocked()) return; fFillGhost        = b     ; }
   void                   SetRadius(Double_t r)                      { if (IsLocked()) return; fRadius           = r     ; }
+  void                   SetNThreads(Int_t n)                       { if (IsLocked()) return; fNThreads         = n     ; }
+  void                   SetUseGhostGrid(Bool_t b=kTRUE)            { if (IsLocked()) return; fUseGhostGrid     = b     ; }
+  Int_t                  AddJetDefinition(EJetAlgo_t a, Double_t r, ERecoScheme_t s = AliJetContainer::pt_scheme);
 
   void                   SetEtaRange(Double_t emi, Double_t ema);
   void                   SetMinJetClusPt(Double_t min);
@@ -87,6 +109,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetPhiRange(Double_t pmi, Double_t pma);
 
   AliEmcalJetUtility*    AddUtility(AliEmcalJetUtility* utility);
+  AliEmcalJetUtility*    AddUtility(AliEmcalJetUtility* utility, Int_t definition);
 
   Double_t               GetGhostArea()                   { return fGhostArea         ; }
   const char*            GetJetsName()                    { return fJetsName.Data()   ; }
@@ -105,6 +128,9 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Int_t                  GetRecombScheme()                { return fRecombScheme      ; }
   Double_t               GetTrackEfficiency()             { return fTrackEfficiency   ; }
   Bool_t                 GetTrackEfficiencyOnlyForEmbedding() { return fTrackEfficiencyOnlyForEmbedding; }
+  Int_t                  GetNThreads()                    { return fNThreads          ; }
+  Bool_t                 GetUseGhostGrid()                { return fUseGhostGrid      ; }
+  Int_t                  GetNJetDefinitions()             { return fAddRadius.size()  ; }
 
   TClonesArray*          GetJets()                        { return fJets              ; }
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
@@ -144,12 +170,16 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   Int_t                  FindJets();
   void                   FillJetBranch();
+  void                   FillJetBranch(AliFJWrapper& wrapper, TClonesArray* jets, Double_t radius, TObjArray* utilities);
+  void                   RunAdditionalClusterings();
+  ULong64_t              GetGhostSeed() const;
   void                   ExecOnce();
   void                   InitEvent();
-  void                   InitUtilities();
-  void                   PrepareUtilities();
-  void                   ExecuteUtilities(AliEmcalJet* jet, Int_t ij);
-  void                   TerminateUtilities();
+  void                   InitUtilities(TObjArray* utilities);
+  void                   InitEvent(TObjArray* utilities, AliFJWrapper& wrapper);
+  void                   PrepareUtilities(TObjArray* utilities, AliFJWrapper& wrapper);
+  void                   ExecuteUtilities(TObjArray* utilities, AliFJWrapper& wrapper, AliEmcalJet* jet, Int_t ij);
+  void                   TerminateUtilities(TObjArray* utilities, AliFJWrapper& wrapper);
   Bool_t                 GetSortedArray(Int_t indexes[], std::vector<fastjet::PseudoJet> array) const;
   Bool_t                 IsJetInEmcal(Double_t eta, Double_t phi, Double_t r);
   Bool_t                 IsJetInDcal(Double_t eta, Double_t phi, Double_t r);
@@ -173,6 +203,12 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   TObjArray             *fUtilities;              // jet utilities (gen subtractor, constituent subtractor etc.)
   Bool_t                 fTrackEfficiencyOnlyForEmbedding; // Apply aritificial tracking inefficiency only for embedded tracks
   Bool_t                 fLocked;                 // true if lock is set
+  std::vector<Int_t>     fAddJetAlgo;             // jet algorithms of the additional jet definitions
+  std::vector<Double_t>  fAddRadius;              // jet radii of the additional jet definitions
+  std::vector<Int_t>     fAddRecombScheme;        // recombination schemes of the additional jet definitions
+  std::vector<TObjArray*> fAddUtilities;          // jet utilities of the additional jet definitions
+  Int_t                  fNThreads;               // threads for the clusterings with additional jet definitions (0 = one per jet definition)
+  Bool_t                 fUseGhostGrid;           // take the ghosts from the seeded ghost grid of AliFJWrapper
 
   TString                fJetsName;               //!name of jet collection
   Bool_t                 fIsInit;                 //!=true if already initialized
@@ -183,6 +219,12 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   TClonesArray          *fJets;                   //!jet collection
   AliFJWrapper           fFastJetWrapper;         //!fastjet wrapper
+  std::vector<TClonesArray*> fAddJets;            //!jet collections of the additional jet definitions
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+  std::vector<AliFJWrapper*> fAddFastJetWrappers; //!fastjet wrappers of the additional jet definitions
+  std::vector<std::vector<fastjet::PseudoJet> > fAddGhosts; //!ghosts of the additional jet definitions in the event
+#endif
+  Bool_t                 fClusteredOnce;          //!=true after the first clustering (done without threads)
 
   static const Int_t     fgkConstIndexShift;      //!contituent index shift
 
@@ -197,7 +239,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 24);
+  ClassDef(AliEmcalJetTask, 27);
   /// \endcond
 };
 #endif
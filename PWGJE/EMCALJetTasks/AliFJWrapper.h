@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <TString.h>
+#include <TMath.h>
 #include "AliLog.h"
 #include "FJ_includes.h"
 #include "AliJetShape.h"
@@ -25,6 +26,8 @@ class AliFJWrapper
   virtual void  ClearMemory();
   virtual void  CopySettingsFrom (const AliFJWrapper& wrapper);
   virtual void  GetMedianAndSigma(Double_t& median, Double_t& sigma, Int_t remove = 0) const;
+  virtual Double_t GenerateGhosts(std::vector<fastjet::PseudoJet>& ghosts);
+  const std::vector<fastjet::PseudoJet>*  GetGridGhosts(Double_t& area);
   fastjet::ClusterSequenceArea*           GetClusterSequence() const   { return fClustSeq;                 }
   fastjet::ClusterSequence*               GetClusterSequenceSA() const { return fClustSeqSA;               }
   fastjet::ClusterSequenceActiveAreaExplicitGhosts* GetClusterSequenceGhosts() const { return fClustSeqActGhosts; }
@@ -50,6 +53,8 @@ class AliFJWrapper
   virtual std::vector<double>             GetSubtractedJetsPts(Double_t median_pt = -1, Bool_t sorted = kFALSE);
   Bool_t                                  GetLegacyMode()            { return fLegacyMode; }
   Bool_t                                  GetDoFilterArea()          { return fDoFilterArea; }
+  Bool_t                                  GetUseGhostGrid()    const { return fUseGhostGrid;               }
+  Bool_t                                  GetEventSub()        const { return fEventSub;                   }
   Double_t                                NSubjettiness(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Int_t Option=0, Int_t Measure=0, Double_t Beta_SD=0, Double_t ZCut=0.1);
   Double32_t                              NSubjettinessDerivativeSub(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Double_t JetR, fastjet::PseudoJet jet, Int_t Option=0, Int_t Measure=0);
 #ifdef FASTJET_VERSION
@@ -123,6 +128,9 @@ class AliFJWrapper
   void SetMinJetPt(Double_t MinPt) {fMinJetPt=MinPt;}
   void SetEventSub(Bool_t b) {fEventSub = b;}
   void SetMaxDelR(Double_t r)  {fUseMaxDelR = kTRUE; fMaxDelR = r;}
+  void SetExternalGhosts(const std::vector<fastjet::PseudoJet>* ghosts, Double_t area) { fExternalGhosts = ghosts; fExternalGhostArea = area; }
+  void SetUseGhostGrid(Bool_t b)        { fUseGhostGrid   = b;       }
+  void SetGhostSeed(ULong64_t seed)     { fGhostSeed      = seed;    }
 
  protected:
   TString                                fName;               //!
@@ -206,8 +214,35 @@ class AliFJWrapper
   std::vector<double>                      fGRDenominator;    //!
   std::vector<double>                      fGRNumeratorSub;   //!
   std::vector<double>                      fGRDenominatorSub; //!
+  const std::vector<fastjet::PseudoJet>   *fExternalGhosts;   //! ghosts used instead of generating them in Run() (not owned)
+  Double_t                                 fExternalGhostArea; //! area of each of the external ghosts
+  Bool_t                                   fUseGhostGrid;     //! ghosts from the ghost grid, scattered with fGhostSeed
+  ULong64_t                                fGhostSeed;        //! seed of the ghost positions in the current event
+
+  // Ghosts at the cell centres for the current ghost settings, and the ghosts scattered for one seed
+  struct GhostGrid {
+    Double_t                        fMaxRap;       // ghost settings
+    Double_t                        fGhostArea;    //
+    Double_t                        fGridScatter;  //
+    Double_t                        fKtScatter;    //
+    Double_t                        fMeanGhostKt;  //
+    Double_t                        fDRap;         // cell size in rapidity
+    Double_t                        fDPhi;         // cell size in phi
+    Double_t                        fArea;         // area of each ghost
+    std::vector<fastjet::PseudoJet> fGrid;         // ghosts at the cell centres
+    std::vector<fastjet::PseudoJet> fGhosts;       // ghosts scattered with fSeed
+    ULong64_t                       fSeed;         // seed of fGhosts
+    Bool_t                          fFilled;       // fGhosts filled
+  };
+  GhostGrid                               *fGhostGrid;        //! ghost grid of this wrapper (owned)
 
   virtual void   SubtractBackground(const Double_t median_pt = -1);
+  const fastjet::ClusterSequenceAreaBase* GetAreaSequence() const;
+  Bool_t                                  UseGhostGrid() const;
+  const GhostGrid*                        GetGhostGrid();
+  static Double_t                         NextUniform(ULong64_t& state);
+  static void                             SmallRotation(Double_t angle, Double_t& c, Double_t& s);
+  static void                             SmallBoost(Double_t rap, Double_t& c, Double_t& s);
 
  private:
   AliFJWrapper();
@@ -300,6 +335,11 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fGRDenominator()
   , fGRNumeratorSub()
   , fGRDenominatorSub()
+  , fExternalGhosts(0)
+  , fExternalGhostArea(0)
+  , fUseGhostGrid(kFALSE)
+  , fGhostSeed(0)
+  , fGhostGrid(0)
 {
   // Constructor.
 }
@@ -309,6 +349,7 @@ AliFJWrapper::~AliFJWrapper()
 {
   // Destructor.
   ClearMemory();
+  delete fGhostGrid;
 }
 
 //_________________________________________________________________________________________________
@@ -359,6 +400,7 @@ void AliFJWrapper::CopySettingsFrom(const AliFJWrapper& wrapper)
   fUseExternalBkg   = wrapper.fUseExternalBkg;
   fRho              = wrapper.fRho;
   fRhom             = wrapper.fRhom;
+  fUseGhostGrid     = wrapper.fUseGhostGrid;
 }
 
 //_________________________________________________________________________________________________
@@ -474,7 +516,7 @@ Double_t AliFJWrapper::GetJetArea(UInt_t idx) const
 
   Double_t retval = -1; // really wrong area..
   if ( idx < fInclusiveJets.size() ) {
-    retval = fClustSeq->area(fInclusiveJets[idx]);
+    retval = GetAreaSequence()->area(fInclusiveJets[idx]);
   } else {
     AliError(Form("[e] ::GetJetArea wrong index: %d",idx));
   }
@@ -514,7 +556,7 @@ fastjet::PseudoJet AliFJWrapper::GetJetAreaVector(UInt_t idx) const
   // Get the jet area as vector.
   fastjet::PseudoJet retval;
   if ( idx < fInclusiveJets.size() ) {
-    retval = fClustSeq->area_4vector(fInclusiveJets[idx]);
+    retval = GetAreaSequence()->area_4vector(fInclusiveJets[idx]);
   } else {
     AliError(Form("[e] ::GetJetArea wrong index: %d",idx));
   }
@@ -581,7 +623,7 @@ AliFJWrapper::GetJetConstituents(UInt_t idx) const
   std::vector<fastjet::PseudoJet> retval;
 
   if ( idx < fInclusiveJets.size() ) {
-    retval = fClustSeq->constituents(fInclusiveJets[idx]);
+    retval = GetAreaSequence()->constituents(fInclusiveJets[idx]);
   } else {
     AliError(Form("[e] ::GetJetConstituents wrong index: %d",idx));
   }
@@ -630,7 +672,8 @@ void AliFJWrapper::GetMedianAndSigma(Double_t &median, Double_t &sigma, Int_t re
   // Get the median and sigma from fastjet.
   // User can also do it on his own because the cluster sequence is exposed (via a getter)
 
-  if (!fClustSeq) {
+  const fj::ClusterSequenceAreaBase* clustSeq = GetAreaSequence();
+  if (!clustSeq) {
     AliError("[e] Run the jfinder first.");
     return;
   }
@@ -638,11 +681,11 @@ void AliFJWrapper::GetMedianAndSigma(Double_t &median, Double_t &sigma, Int_t re
   Double_t mean_area = 0;
   try {
     if(0 == remove) {
-      fClustSeq->get_median_rho_and_sigma(*fRange, fUseArea4Vector, median, sigma, mean_area);
+      clustSeq->get_median_rho_and_sigma(*fRange, fUseArea4Vector, median, sigma, mean_area);
     }  else {
-      std::vector<fastjet::PseudoJet> input_jets = sorted_by_pt(fClustSeq->inclusive_jets());
+      std::vector<fastjet::PseudoJet> input_jets = sorted_by_pt(clustSeq->inclusive_jets());
       input_jets.erase(input_jets.begin(), input_jets.begin() + remove);
-      fClustSeq->get_median_rho_and_sigma(input_jets, *fRange, fUseArea4Vector, median, sigma, mean_area);
+      clustSeq->get_median_rho_and_sigma(input_jets, *fRange, fUseArea4Vector, median, sigma, mean_area);
       input_jets.clear();
     }
   } catch (fj::Error) {
@@ -652,6 +695,172 @@ void AliFJWrapper::GetMedianAndSigma(Double_t &median, Double_t &sigma, Int_t re
   }
 }
 
+//_________________________________________________________________________________________________
+Double_t AliFJWrapper::GenerateGhosts(std::vector<fastjet::PseudoJet>& ghosts)
+{
+  // Generate the ghosts that Run() would add for the active area with explicit ghosts,
+  // to be passed with SetExternalGhosts() to a wrapper clustering in another thread.
+  // Returns the area of each ghost.
+
+  Double_t area = 0;
+  const std::vector<fj::PseudoJet>* gridGhosts = GetGridGhosts(area);
+  if (gridGhosts) {
+    ghosts = *gridGhosts;
+    return area;
+  }
+
+  fj::GhostedAreaSpec ghostSpec(fMaxRap, fNGhostRepeats, fGhostArea, fGridScatter, fKtScatter, fMeanGhostKt);
+  ghosts.clear();
+  ghostSpec.add_ghosts(ghosts);
+  return ghostSpec.actual_ghost_area();
+}
+
+//_________________________________________________________________________________________________
+const std::vector<fastjet::PseudoJet>* AliFJWrapper::GetGridGhosts(Double_t& area)
+{
+  // Ghosts of the ghost grid for the current seed, NULL if the ghost grid is not used.
+  // The ghosts stay valid until the next call with another seed or other ghost settings.
+
+  if (!UseGhostGrid()) return 0;
+
+  const GhostGrid* grid = GetGhostGrid();
+  area = grid->fArea;
+  return &grid->fGhosts;
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliFJWrapper::UseGhostGrid() const
+{
+  // The ghost grid replaces the ghosts of the GhostedAreaSpec for the active area with explicit ghosts
+  // (FastJet 3 placement, hence not in legacy mode). FastJet clusters explicit ghosts with a single
+  // set of ghosts; with more than one repeat the ghosts are left to FastJet, which handles the setting.
+
+  return fUseGhostGrid && fAreaType == fj::active_area_explicit_ghosts && !fLegacyMode && fNGhostRepeats == 1;
+}
+
+//_________________________________________________________________________________________________
+const AliFJWrapper::GhostGrid* AliFJWrapper::GetGhostGrid()
+{
+  // Ghost grid for the current ghost settings, built when the settings are first used, with the
+  // cells of the GhostedAreaSpec. For each new seed every ghost is moved, as in the GhostedAreaSpec,
+  // by its own random fraction (fGridScatter) of a cell in rapidity and phi, and its kt is scattered
+  // by fKtScatter. Since the moves are smaller than a cell, they only need a rotation and a boost of
+  // the ghost at the cell centre, computed from short series. The random numbers come from a
+  // splitmix64 sequence started at the seed, so the ghosts are reproducible from the seed.
+
+  if (fGhostGrid && !(fGhostGrid->fMaxRap == fMaxRap && fGhostGrid->fGhostArea == fGhostArea && fGhostGrid->fGridScatter == fGridScatter &&
+                      fGhostGrid->fKtScatter == fKtScatter && fGhostGrid->fMeanGhostKt == fMeanGhostKt)) {
+    delete fGhostGrid;
+    fGhostGrid = 0;
+  }
+
+  if (!fGhostGrid) {
+    GhostGrid* grid = new GhostGrid;
+    grid->fMaxRap      = fMaxRap;
+    grid->fGhostArea   = fGhostArea;
+    grid->fGridScatter = fGridScatter;
+    grid->fKtScatter   = fKtScatter;
+    grid->fMeanGhostKt = fMeanGhostKt;
+    grid->fSeed        = 0;
+    grid->fFilled      = kFALSE;
+
+    Double_t drap = TMath::Sqrt(fGhostArea);
+    Int_t nphi = TMath::CeilNint(TMath::TwoPi() / drap);
+    Int_t nrap = Int_t(fMaxRap / drap);
+    if (nrap < 1) nrap = 1;
+    grid->fDRap = fMaxRap / nrap;
+    grid->fDPhi = TMath::TwoPi() / nphi;
+    grid->fArea = grid->fDRap * grid->fDPhi;
+
+    grid->fGrid.reserve((2 * nrap + 1) * nphi);
+    for (Int_t irap = -nrap; irap <= nrap; irap++) {
+      Double_t rap = irap * grid->fDRap;
+      for (Int_t iphi = 0; iphi < nphi; iphi++) {
+        Double_t phi = (iphi + 0.5) * grid->fDPhi;
+        grid->fGrid.push_back(fj::PseudoJet(fMeanGhostKt * TMath::Cos(phi), fMeanGhostKt * TMath::Sin(phi),
+                                            fMeanGhostKt * TMath::SinH(rap), fMeanGhostKt * TMath::CosH(rap)));
+      }
+    }
+    fGhostGrid = grid;
+  }
+
+  GhostGrid* grid = fGhostGrid;
+  if (!grid->fFilled || grid->fSeed != fGhostSeed) {
+    ULong64_t state = fGhostSeed;
+    grid->fGhosts.resize(grid->fGrid.size());
+    for (UInt_t i = 0; i < grid->fGrid.size(); i++) {
+      const fj::PseudoJet& g = grid->fGrid[i];
+      Double_t shiftRap = grid->fDRap * fGridScatter * (NextUniform(state) - 0.5);
+      Double_t shiftPhi = grid->fDPhi * fGridScatter * (NextUniform(state) - 0.5);
+      Double_t scale = 1. + fKtScatter * (NextUniform(state) - 0.5);
+      Double_t cosPhi = 0, sinPhi = 0, coshRap = 0, sinhRap = 0;
+      SmallRotation(shiftPhi, cosPhi, sinPhi);
+      SmallBoost(shiftRap, coshRap, sinhRap);
+      grid->fGhosts[i].reset(scale * (g.px() * cosPhi - g.py() * sinPhi),
+                             scale * (g.px() * sinPhi + g.py() * cosPhi),
+                             scale * (g.pz() * coshRap + g.E() * sinhRap),
+                             scale * (g.E() * coshRap + g.pz() * sinhRap));
+    }
+    grid->fSeed = fGhostSeed;
+    grid->fFilled = kTRUE;
+  }
+
+  return grid;
+}
+
+//_________________________________________________________________________________________________
+Double_t AliFJWrapper::NextUniform(ULong64_t& state)
+{
+  // Uniform random number in [0,1) from a splitmix64 sequence, reproducible from the seed.
+
+  ULong64_t z = (state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z ^= z >> 31;
+  return (z >> 11) * (1. / 9007199254740992.);
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::SmallRotation(Double_t angle, Double_t& c, Double_t& s)
+{
+  // Cosine and sine of an angle; for the moves within a ghost cell (|angle| < 0.1)
+  // from their series, which are exact to double precision there.
+
+  if (TMath::Abs(angle) >= 0.1) {
+    c = TMath::Cos(angle);
+    s = TMath::Sin(angle);
+    return;
+  }
+  Double_t a2 = angle * angle;
+  c = 1. - a2 / 2. * (1. - a2 / 12. * (1. - a2 / 30. * (1. - a2 / 56.)));
+  s = angle * (1. - a2 / 6. * (1. - a2 / 20. * (1. - a2 / 42. * (1. - a2 / 72.))));
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::SmallBoost(Double_t rap, Double_t& c, Double_t& s)
+{
+  // Hyperbolic cosine and sine of a rapidity; for the moves within a ghost cell (|rap| < 0.1)
+  // from their series, which are exact to double precision there.
+
+  if (TMath::Abs(rap) >= 0.1) {
+    c = TMath::CosH(rap);
+    s = TMath::SinH(rap);
+    return;
+  }
+  Double_t r2 = rap * rap;
+  c = 1. + r2 / 2. * (1. + r2 / 12. * (1. + r2 / 30. * (1. + r2 / 56.)));
+  s = rap * (1. + r2 / 6. * (1. + r2 / 20. * (1. + r2 / 42. * (1. + r2 / 72.))));
+}
+
+//_________________________________________________________________________________________________
+const fastjet::ClusterSequenceAreaBase* AliFJWrapper::GetAreaSequence() const
+{
+  // Cluster sequence of the last Run(), with the ghosts generated by FastJet or external ghosts.
+
+  if (fClustSeq) return fClustSeq;
+  return fClustSeqActGhosts;
+}
+
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::Run()
 {
@@ -706,8 +915,17 @@ Int_t AliFJWrapper::Run()
     fJetDef = new fj::JetDefinition(fAlgor, fR, fScheme, fStrategy);
   }
 
+  const std::vector<fj::PseudoJet>* ghosts = fExternalGhosts;
+  Double_t ghostArea = fExternalGhostArea;
+  if (!ghosts) ghosts = GetGridGhosts(ghostArea);
+
   try {
-    fClustSeq = new fj::ClusterSequenceArea(fInputVectors, *fJetDef, *fAreaDef);
+    if (ghosts && fAreaType == fj::active_area_explicit_ghosts) {
+      // same clustering as below, with ghosts generated once by the caller or from the ghost grid
+      fClustSeqActGhosts = new fj::ClusterSequenceActiveAreaExplicitGhosts(fInputVectors, *fJetDef, *ghosts, ghostArea);
+    } else {
+      fClustSeq = new fj::ClusterSequenceArea(fInputVectors, *fJetDef, *fAreaDef);
+    }
     if(fEventSub){
       DoEventConstituentSubtraction();
       fClustSeqES = new fj::ClusterSequenceArea(fEventSubCorrectedVectors, *fJetDef, *fAreaDef);
@@ -727,7 +945,7 @@ Int_t AliFJWrapper::Run()
   // inclusive jets:
   fInclusiveJets.clear();
   fEventSubJets.clear();
-  fInclusiveJets = fClustSeq->inclusive_jets(0.0);
+  fInclusiveJets = GetAreaSequence()->inclusive_jets(0.0);
   if(fEventSub) fEventSubJets  = fClustSeqES->inclusive_jets(0.0);
 
   return 0;
@@ -803,10 +1021,12 @@ void AliFJWrapper::SubtractBackground(Double_t median_pt)
   // clear the subtracted jet pt's vector<double>
   fSubtractedJetsPt.clear();
 
+  const fj::ClusterSequenceAreaBase* clustSeq = GetAreaSequence();
+
   // check what was specified (default is -1)
   if (median_pt < 0) {
     try {
-      fClustSeq->get_median_rho_and_sigma(*fRange, fUseArea4Vector, median, sigma, mean_area);
+      clustSeq->get_median_rho_and_sigma(*fRange, fUseArea4Vector, median, sigma, mean_area);
     }
 
     catch (fj::Error) {
@@ -832,13 +1052,13 @@ void AliFJWrapper::SubtractBackground(Double_t median_pt)
   for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
     if ( fUseArea4Vector ) {
       // subtract the background using the area4vector
-      fj::PseudoJet area4v = fClustSeq->area_4vector(fInclusiveJets[i]);
+      fj::PseudoJet area4v = clustSeq->area_4vector(fInclusiveJets[i]);
       fj::PseudoJet jet_sub = fInclusiveJets[i] - area4v * fMedUsedForBgSub;
       fSubtractedJetsPt.push_back(jet_sub.perp()); // here we put only the pt of the jet - note: this can be negative
     } else {
       // subtract the background using scalars
       // fj::PseudoJet jet_sub = fInclusiveJets[i] - area * fMedUsedForBgSub_;
-      Double_t area = fClustSeq->area(fInclusiveJets[i]);
+      Double_t area = clustSeq->area(fInclusiveJets[i]);
       // standard subtraction
       Double_t pt_sub = fInclusiveJets[i].perp() - fMedUsedForBgSub * area;
       fSubtractedJetsPt.push_back(pt_sub); // here we put only the pt of the jet - note: this can be negative
@@ -17,6 +17,7 @@
 #pragma link C++ class AliAnalysisTaskLocalRho+;
 #pragma link C++ class AliAnalysisTaskRhoBaseDev+;
 #pragma link C++ class AliAnalysisTaskRhoDev+;
+#pragma link C++ class AliAnalysisTaskRhoEngine+;
 #pragma link C++ class AliAnalysisTaskRhoTransDev+;
 #pragma link C++ class AliAnalysisTaskDeltaPt+;
 #pragma link C++ class AliAnalysisTaskScale+;